@@ -78,6 +78,33 @@ private:
     using INHERITED = DecodeBench;
 };
 
+// Loads the animation from its compiled binary form, which skips JSON parsing.
+class SkottieCompiledDecodeBench final : public DecodeBench {
+public:
+    SkottieCompiledDecodeBench(const char* name, const char* source)
+        : INHERITED(name, source)
+    {}
+
+    void onDelayedSetup() override {
+        INHERITED::onDelayedSetup();
+        fData = skottie::Animation::Builder::Compile(
+                reinterpret_cast<const char*>(fData->data()), fData->size());
+        SkASSERT(fData);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            const auto anim = skottie::Animation::Builder()
+                .setFontManager(ToolUtils::TestFontMgr())
+                .make(reinterpret_cast<const char*>(fData->data()),
+                                                    fData->size());
+        }
+    }
+
+private:
+    using INHERITED = DecodeBench;
+};
+
 class SkottiePictureDecodeBench final : public DecodeBench {
 public:
     SkottiePictureDecodeBench(const char* name, const char* source)
@@ -172,6 +199,17 @@ DEF_BENCH(
         return new SkottieDecodeBench("skottie_phonehub_svgo_no_frills_onboard_min.json",
                                       "skottie/skottie-phonehub-svgo-no-frills-onboard_min.json"));
 
+DEF_BENCH(return new SkottieCompiledDecodeBench("skottiebin_large",
+                                                "skottie/skottie-text-scale-to-fit-minmax.json"));
+DEF_BENCH(return new SkottieCompiledDecodeBench("skottiebin_medium",
+                                                "skottie/skottie-sphere-effect.json"));
+DEF_BENCH(return new SkottieCompiledDecodeBench("skottiebin_small",
+                                                "skottie/skottie_sample_multiframe.json"));
+DEF_BENCH(return new SkottieCompiledDecodeBench("skottiebin_phonehub_connecting.json",
+                                                "skottie/skottie-phonehub-connecting.json"));
+DEF_BENCH(return new SkottieCompiledDecodeBench("skottiebin_phonehub_onboard.json",
+                                                "skottie/skottie-phonehub-onboard.json"));
+
 DEF_BENCH(return new SkottiePictureDecodeBench("skottiepic_large",
                                                "skottie/skottie-text-scale-to-fit-minmax.json"));
 DEF_BENCH(return new SkottiePictureDecodeBench("skottiepic_medium",
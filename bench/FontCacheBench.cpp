@@ -7,14 +7,32 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkStream.h"
 #include "include/core/SkString.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/core/SkChecksum.h"
+#include "src/core/SkGlyph.h"
+#include "src/core/SkStrike.h"
+#include "src/core/SkStrikeCache.h"
+#include "src/core/SkStrikeSpec.h"
+#include "src/core/SkTaskGroup.h"
+#include "tools/Resources.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#if defined(SK_TYPEFACE_FACTORY_FREETYPE)
+#include "include/core/SkFontArguments.h"
+#include "src/ports/SkTypeface_FreeType.h"
+#endif
+
+#include <memory>
+#include <vector>
+
 #include "bench/gUniqueGlyphIDs.h"
 
 #define gUniqueGlyphIDs_Sentinel    0xFFFF
@@ -148,6 +166,143 @@ DEF_BENCH( return new FontCacheBench(); )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Every thread generates the images of the same glyphs in its own strike, starting from an empty
+// cache. Each thread does a fixed amount of work, so if glyph generation scales with the number
+// of threads the time per loop stays flat as the thread count grows. With FreeType this only
+// happens when scaler contexts own their faces (the _ownfaces variants), otherwise every glyph is
+// generated under one global lock.
+class FontCacheThreadedBench : public Benchmark {
+public:
+    FontCacheThreadedBench(int threadCount, bool ownFaces)
+            : fThreadCount(threadCount)
+            , fOwnFaces(ownFaces) {
+        fName.printf("fontcache_threaded_%d%s", threadCount, ownFaces ? "_ownfaces" : "");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+#if defined(SK_TYPEFACE_FACTORY_FREETYPE)
+        fTypeface = SkTypeface_FreeType::MakeFromStream(
+                GetResourceAsStream("fonts/Roboto-Regular.ttf"), SkFontArguments());
+#else
+        fTypeface = ToolUtils::CreateTypefaceFromResource("fonts/Roboto-Regular.ttf");
+#endif
+        if (!fTypeface) {
+            fTypeface = ToolUtils::DefaultTypeface();
+        }
+        // Make our own executor so the --threads parameter doesn't change the thread count.
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreadCount);
+        for (const uint16_t* glyph = gUniqueGlyphIDs; *glyph != gUniqueGlyphIDs_Sentinel; ++glyph) {
+            fGlyphs.push_back(SkPackedGlyphID{*glyph});
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+#if defined(SK_TYPEFACE_FACTORY_FREETYPE)
+        const bool ownedFaces = SkTypeface_FreeType::ScalerContextsOwnFaces();
+        SkTypeface_FreeType::SetScalerContextsOwnFaces(fOwnFaces);
+#endif
+        const SkSurfaceProps props(0, kUnknown_SkPixelGeometry);
+        for (int i = 0; i < loops; ++i) {
+            SkGraphics::PurgeFontCache();
+            SkTaskGroup(*fExecutor).batch(fThreadCount, [&](int threadIndex) {
+                SkFont font(fTypeface, 12 + threadIndex);
+                font.setEdging(SkFont::Edging::kAntiAlias);
+                SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+                        font, SkPaint(), props, SkScalerContextFlags::kNone, SkMatrix::I());
+                SkBulkGlyphMetricsAndImages images{strikeSpec};
+                (void)images.glyphs(fGlyphs);
+            });
+        }
+#if defined(SK_TYPEFACE_FACTORY_FREETYPE)
+        SkTypeface_FreeType::SetScalerContextsOwnFaces(ownedFaces);
+#endif
+    }
+
+private:
+    const int fThreadCount;
+    const bool fOwnFaces;
+    SkString fName;
+    sk_sp<SkTypeface> fTypeface;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::vector<SkPackedGlyphID> fGlyphs;
+};
+DEF_BENCH( return new FontCacheThreadedBench(1, false); )
+DEF_BENCH( return new FontCacheThreadedBench(2, false); )
+DEF_BENCH( return new FontCacheThreadedBench(4, false); )
+DEF_BENCH( return new FontCacheThreadedBench(8, false); )
+#if defined(SK_TYPEFACE_FACTORY_FREETYPE)
+DEF_BENCH( return new FontCacheThreadedBench(1, true); )
+DEF_BENCH( return new FontCacheThreadedBench(2, true); )
+DEF_BENCH( return new FontCacheThreadedBench(4, true); )
+DEF_BENCH( return new FontCacheThreadedBench(8, true); )
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Draw-time cost of the glyph images of a new strike, either generated one at a time on the
+// drawing thread, or prefilled in parallel with SkStrike::prefillGlyphs first.
+class FontCachePrefillBench : public Benchmark {
+public:
+    explicit FontCachePrefillBench(bool prefill) : fPrefill(prefill) {
+        fName.printf("fontcache_prefill_%s", prefill ? "parallel" : "serial");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fFont = ToolUtils::DefaultFont();
+        fFont.setEdging(SkFont::Edging::kAntiAlias);
+        fExecutor = SkExecutor::MakeFIFOThreadPool();
+        for (const uint16_t* glyph = gUniqueGlyphIDs; *glyph != gUniqueGlyphIDs_Sentinel; ++glyph) {
+            fGlyphs.push_back(SkPackedGlyphID{*glyph});
+        }
+        fResults.resize(fGlyphs.size());
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+                fFont, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+        for (int i = 0; i < loops; ++i) {
+            // A new cache every loop, so every glyph has to be made.
+            SkStrikeCache strikeCache;
+            sk_sp<SkStrike> strike = strikeCache.findOrCreateStrike(strikeSpec);
+            if (fPrefill) {
+                strike->prefillGlyphs(fGlyphs, /*includePaths=*/false, *fExecutor);
+            }
+            (void)strike->prepareImages(fGlyphs, fResults.data());
+        }
+    }
+
+private:
+    const bool fPrefill;
+    SkString fName;
+    SkFont fFont;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::vector<SkPackedGlyphID> fGlyphs;
+    std::vector<const SkGlyph*> fResults;
+};
+DEF_BENCH( return new FontCachePrefillBench(false); )
+DEF_BENCH( return new FontCachePrefillBench(true); )
+
+///////////////////////////////////////////////////////////////////////////////
+
 class FontPathBench : public Benchmark {
     SkFont fFont;
     uint16_t fGlyphs[100];
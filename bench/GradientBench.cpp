@@ -12,9 +12,13 @@
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
 #include "include/effects/SkGradientShader.h"
+#include "src/base/SkRandom.h"
 
 #include "tools/ToolUtils.h"
 
+#include <algorithm>
+#include <vector>
+
 struct GradData {
     int             fCount;
     const SkColor*  fColors;
@@ -353,3 +357,78 @@ private:
 
 DEF_BENCH( return new Gradient2Bench(false); )
 DEF_BENCH( return new Gradient2Bench(true); )
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Recreates a gradient with many stops every time it is drawn, like an animation that rebuilds
+// its shaders every frame. Only the geometry changes, so the stops are the same for every shader.
+class GradientRecreateBench : public Benchmark {
+public:
+    GradientRecreateBench(GradType type, int stopCount)
+            : fType(type)
+            , fStopCount(stopCount) {
+        SkASSERT(type == kLinear_GradType || type == kRadial_GradType ||
+                 type == kConical_GradType);
+        fName.printf("gradient_recreate_%s_%dstops", gGrads[type].fName, stopCount);
+
+        SkRandom random;
+        float pos = 0;
+        for (int i = 0; i < stopCount; ++i) {
+            fColors.push_back(SkColor4f::FromColor(random.nextU() | 0xFF000000));
+            fPositions.push_back(pos);
+            pos = std::min(1.f, pos + random.nextRangeF(0, 2.f / stopCount));
+        }
+        fPositions.back() = 1;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        this->setupPaint(&paint);
+
+        const SkRect r = SkRect::MakeWH(8, 8);
+        for (int i = 0; i < loops; i++) {
+            const float offset = i % 16;
+            const SkPoint pts[] = {{offset, 0}, {offset + 32, 32}};
+            sk_sp<SkShader> shader;
+            switch (fType) {
+                case kLinear_GradType:
+                    shader = SkGradientShader::MakeLinear(pts, fColors.data(), nullptr,
+                                                          fPositions.data(), fStopCount,
+                                                          SkTileMode::kClamp);
+                    break;
+                case kRadial_GradType:
+                    shader = SkGradientShader::MakeRadial(pts[0], 16 + offset, fColors.data(),
+                                                          nullptr, fPositions.data(), fStopCount,
+                                                          SkTileMode::kClamp);
+                    break;
+                default:
+                    SkASSERT(fType == kConical_GradType);
+                    shader = SkGradientShader::MakeTwoPointConical(
+                            pts[0], 2, pts[1], 16 + offset, fColors.data(), nullptr,
+                            fPositions.data(), fStopCount, SkTileMode::kClamp);
+                    break;
+            }
+            paint.setShader(std::move(shader));
+            canvas->drawRect(r, paint);
+        }
+    }
+
+private:
+    SkString fName;
+    GradType fType;
+    int fStopCount;
+    std::vector<SkColor4f> fColors;
+    std::vector<float> fPositions;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new GradientRecreateBench(kLinear_GradType, 16); )
+DEF_BENCH( return new GradientRecreateBench(kLinear_GradType, 256); )
+DEF_BENCH( return new GradientRecreateBench(kRadial_GradType, 256); )
+DEF_BENCH( return new GradientRecreateBench(kConical_GradType, 256); )
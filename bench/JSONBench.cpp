@@ -8,7 +8,9 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkData.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkString.h"
 #include "src/utils/SkJSON.h"
+#include "tools/Resources.h"
 
 #if defined(SK_BUILD_FOR_ANDROID)
 static constexpr const char* kBenchFile = "/data/local/tmp/bench.json";
@@ -55,6 +57,112 @@ private:
 
 DEF_BENCH( return new JsonBench; )
 
+// Loads the same document from a binary image, as written by DOM::writeBinary().
+class JsonBinaryBench : public Benchmark {
+public:
+
+protected:
+    const char* onGetName() override { return "json_skjson_binary"; }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        auto data = SkData::MakeFromFileName(kBenchFile);
+        if (!data) {
+            SkDebugf("!! Could not open bench file: %s\n", kBenchFile);
+            return;
+        }
+
+        skjson::DOM dom(static_cast<const char*>(data->data()), data->size());
+        SkDynamicMemoryWStream stream;
+        dom.writeBinary(&stream);
+        fData = stream.detachAsData();
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        fData = nullptr;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fData) return;
+
+        for (int i = 0; i < loops; i++) {
+            auto dom = skjson::DOM::MakeFromBinary(fData->data(), fData->size());
+            if (!dom || dom->root().is<skjson::NullValue>()) {
+                SkDebugf("!! Loading failed.\n");
+                return;
+            }
+        }
+    }
+
+private:
+    sk_sp<SkData> fData;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new JsonBinaryBench; )
+
+// Parses a large document, made of copies of a Lottie resource ("[doc,doc,...]", ~kTargetSize).
+// Throughput in MB/s: kTargetSize / time-per-iteration.
+class JsonLottieBench : public Benchmark {
+public:
+    JsonLottieBench(const char* name, const char* resource)
+        : fName(SkStringPrintf("json_skjson_lottie_%s", name))
+        , fResource(resource) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        auto doc = GetResourceAsData(fResource);
+        if (!doc) {
+            SkDebugf("!! Could not open resource: %s\n", fResource);
+            return;
+        }
+
+        SkDynamicMemoryWStream stream;
+        stream.write8('[');
+        for (size_t size = 0; size < kTargetSize; size += doc->size()) {
+            if (size) {
+                stream.write8(',');
+            }
+            stream.write(doc->data(), doc->size());
+        }
+        stream.write8(']');
+        fData = stream.detachAsData();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fData) return;
+
+        for (int i = 0; i < loops; i++) {
+            skjson::DOM dom(static_cast<const char*>(fData->data()), fData->size());
+            if (dom.root().is<skjson::NullValue>()) {
+                SkDebugf("!! Parsing failed.\n");
+                return;
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kTargetSize = 4 * 1024 * 1024;
+
+    const SkString fName;
+    const char*    fResource;
+    sk_sp<SkData>  fData;
+
+    using INHERITED = Benchmark;
+};
+
+// Embedded base64 images.
+DEF_BENCH( return new JsonLottieBench("displacement", "skottie/skottie-displacement-rgba.json"); )
+// Pretty-printed.
+DEF_BENCH( return new JsonLottieBench("phonehub", "skottie/skottie-phonehub-onboard.json"); )
+DEF_BENCH( return new JsonLottieBench("glyphs", "skottie/skottie-text-animatedglyphs-01.json"); )
+
 #if (0)
 
 #include "rapidjson/document.h"
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "src/base/SkRandom.h"
+#include "src/utils/SkJSONWriter.h"
+
+#if defined(SK_SUPPORT_PDF)
+#include "src/pdf/SkDeflate.h"
+#endif
+
+#include <memory>
+#include <vector>
+
+// Writes a large dump shaped like the debugger's JSON export of an SKP (draw commands with
+// paints, path verbs and descriptions), to measure the SkJSONWriter output throughput: the dump
+// is ~5MB in kFast mode, ~12MB in kPretty mode.
+class JSONWriterBench final : public Benchmark {
+public:
+    enum class Output {
+        kDefault,     // default writer block
+        kBulk,        // large block, reused across writers
+        kGzip,        // through a gzip SkDeflateWStream
+    };
+
+    JSONWriterBench(SkJSONWriter::Mode mode, Output output)
+        : fMode(mode)
+        , fOutput(output) {
+        fName.printf("json_writer_%s", mode == SkJSONWriter::Mode::kFast ? "fast" : "pretty");
+        switch (output) {
+            case Output::kDefault:                        break;
+            case Output::kBulk:    fName.append("_bulk"); break;
+            case Output::kGzip:    fName.append("_gzip"); break;
+        }
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        // A mix of integral coordinates, simple fractions and arbitrary values.
+        SkRandom rand;
+        fCoords.resize(kCommandCount * kPointsPerPath * 2);
+        for (auto& c : fCoords) {
+            switch (rand.nextULessThan(3)) {
+                case 0: c = static_cast<float>(rand.nextULessThan(2000));           break;
+                case 1: c = static_cast<float>(rand.nextULessThan(8000)) * 0.25f;   break;
+                case 2: c = rand.nextRangeF(-1000, 1000);                           break;
+            }
+        }
+        fColors.resize(kCommandCount);
+        for (auto& c : fColors) {
+            c = rand.nextU();
+        }
+
+        if (fOutput == Output::kBulk) {
+            fBulkBuffer.reset(new char[kBulkBufferSize]);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkNullWStream null_stream;
+#if defined(SK_SUPPORT_PDF)
+            std::unique_ptr<SkDeflateWStream> gzip_stream;
+            if (fOutput == Output::kGzip) {
+                gzip_stream = std::make_unique<SkDeflateWStream>(&null_stream, 1, true);
+            }
+            SkWStream* stream = gzip_stream ? static_cast<SkWStream*>(gzip_stream.get())
+                                            : &null_stream;
+#else
+            SkWStream* stream = &null_stream;
+#endif
+
+            if (fBulkBuffer) {
+                SkJSONWriter writer(stream, {fBulkBuffer.get(), kBulkBufferSize}, fMode);
+                this->writeDump(writer);
+            } else {
+                SkJSONWriter writer(stream, fMode);
+                this->writeDump(writer);
+            }
+        }
+    }
+
+private:
+    static constexpr int    kCommandCount   = 10000;
+    static constexpr int    kPointsPerPath  = 13;
+    static constexpr size_t kBulkBufferSize = 1024 * 1024;
+
+    void writeDump(SkJSONWriter& writer) const {
+        const float* coords = fCoords.data();
+
+        writer.beginObject();
+        writer.appendS32("version", 1);
+        writer.beginArray("commands");
+        for (int i = 0; i < kCommandCount; ++i) {
+            writer.beginObject();
+            writer.appendNString("command", "DrawPath");
+            writer.appendBool("visible", true);
+
+            writer.beginObject("path");
+            writer.appendNString("fillType", "winding");
+            writer.beginArray("verbs");
+            writer.beginObject(nullptr, false);
+            writer.beginArray("move", false);
+            writer.appendFloat(*coords++);
+            writer.appendFloat(*coords++);
+            writer.endArray();
+            writer.endObject();
+            for (int c = 0; c < (kPointsPerPath - 1) / 3; ++c) {
+                writer.beginObject(nullptr, false);
+                writer.beginArray("cubic");
+                for (int p = 0; p < 3; ++p) {
+                    writer.beginArray(nullptr, false);
+                    writer.appendFloat(*coords++);
+                    writer.appendFloat(*coords++);
+                    writer.endArray();
+                }
+                writer.endArray();
+                writer.endObject();
+            }
+            writer.appendNString("close");
+            writer.endArray();
+            writer.endObject();
+
+            const auto color = fColors[i];
+            writer.beginObject("paint");
+            writer.beginArray("color", false);
+            writer.appendS32(color >> 24);
+            writer.appendS32((color >> 16) & 0xff);
+            writer.appendS32((color >>  8) & 0xff);
+            writer.appendS32( color        & 0xff);
+            writer.endArray();
+            writer.appendBool("antiAlias", true);
+            writer.appendFloat("strokeWidth", 1.5f);
+            writer.appendNString("style", "stroke");
+            writer.endObject();
+
+            writer.appendS32("opIndex", i);
+            writer.appendNString("shortDesc", "DrawPath: \"outline\"\t(stroke)");
+            writer.endObject();
+        }
+        writer.endArray();
+        writer.endObject();
+    }
+
+    SkString                      fName;
+    const SkJSONWriter::Mode      fMode;
+    const Output                  fOutput;
+    std::vector<float>            fCoords;
+    std::vector<uint32_t>         fColors;
+    std::unique_ptr<char[]>       fBulkBuffer;
+};
+
+using Mode   = SkJSONWriter::Mode;
+using Output = JSONWriterBench::Output;
+
+DEF_BENCH(return new JSONWriterBench(Mode::kFast  , Output::kDefault);)
+DEF_BENCH(return new JSONWriterBench(Mode::kFast  , Output::kBulk   );)
+DEF_BENCH(return new JSONWriterBench(Mode::kPretty, Output::kDefault);)
+DEF_BENCH(return new JSONWriterBench(Mode::kPretty, Output::kBulk   );)
+#if defined(SK_SUPPORT_PDF)
+DEF_BENCH(return new JSONWriterBench(Mode::kFast  , Output::kGzip   );)
+#endif
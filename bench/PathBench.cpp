@@ -233,6 +233,32 @@ private:
     using INHERITED = PathBench;
 };
 
+// Nearly horizontal edges spanning many pixels, like the roads and coastlines of a vector map.
+// This stresses the coverage accumulation of Analytic AA rather than its edge walking.
+class AAAShallowEdgesPathBench : public PathBench {
+public:
+    AAAShallowEdgesPathBench(Flags flags) : INHERITED(flags) {}
+
+    void appendName(SkString* name) override {
+        name->append("shallow_edges_aaa");
+    }
+
+    void makePath(SkPath* path) override {
+        SkRandom rand(9);
+        path->moveTo(0, 0);
+        for (int i = 1; i <= 16; i++) {
+            path->lineTo(i * 40, rand.nextRangeF(0, 12));
+        }
+        for (int i = 16; i >= 0; i--) {
+            path->lineTo(i * 40, rand.nextRangeF(36, 48));
+        }
+        path->close();
+    }
+
+private:
+    using INHERITED = PathBench;
+};
+
 class SawToothPathBench : public PathBench {
 public:
     SawToothPathBench(Flags flags) : INHERITED(flags) {}
@@ -1190,6 +1216,8 @@ DEF_BENCH( return new AAAConcavePathBench(FLAGS00); )
 DEF_BENCH( return new AAAConcavePathBench(FLAGS10); )
 DEF_BENCH( return new AAAConvexPathBench(FLAGS00); )
 DEF_BENCH( return new AAAConvexPathBench(FLAGS10); )
+DEF_BENCH( return new AAAShallowEdgesPathBench(FLAGS00); )
+DEF_BENCH( return new AAAShallowEdgesPathBench(FLAGS10); )
 
 DEF_BENCH( return new SawToothPathBench(FLAGS00); )
 DEF_BENCH( return new SawToothPathBench(FLAGS01); )
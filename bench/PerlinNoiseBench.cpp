@@ -10,20 +10,29 @@
 #include "include/effects/SkPerlinNoiseShader.h"
 
 class PerlinNoiseBench : public Benchmark {
-    SkISize fSize;
-
 public:
-    PerlinNoiseBench()  {
+    enum class Mode {
+        kUntiled,   // one shader for every draw
+        kStitched,  // a new stitched shader for every draw
+        kCached,    // a new cached, stitched shader for every draw
+    };
+
+    PerlinNoiseBench(Mode mode) : fMode(mode) {
         fSize = SkISize::Make(80, 80);
     }
 
 protected:
     const char* onGetName() override {
-        return "perlinnoise";
+        switch (fMode) {
+            case Mode::kUntiled:  return "perlinnoise";
+            case Mode::kStitched: return "perlinnoise_stitched";
+            case Mode::kCached:   return "perlinnoise_cached";
+        }
+        SkUNREACHABLE;
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
-        this->test(loops, canvas, 0, 0, 0.1f, 0.1f, 3, 0, false);
+        this->test(loops, canvas, 0, 0, 0.1f, 0.1f, 3, 0);
     }
 
 private:
@@ -39,19 +48,33 @@ private:
     }
 
     void test(int loops, SkCanvas* canvas, int x, int y,
-              float baseFrequencyX, float baseFrequencyY, int numOctaves, float seed,
-              bool stitchTiles) {
+              float baseFrequencyX, float baseFrequencyY, int numOctaves, float seed) {
         SkPaint paint;
-        paint.setShader(SkShaders::MakeFractalNoise(
-                baseFrequencyX, baseFrequencyY, numOctaves, seed, stitchTiles ? &fSize : nullptr));
+        if (fMode == Mode::kUntiled) {
+            paint.setShader(SkShaders::MakeFractalNoise(
+                    baseFrequencyX, baseFrequencyY, numOctaves, seed, nullptr));
+        }
         for (int i = 0; i < loops; i++) {
+            // Like an animation that rebuilds its shaders every frame.
+            if (fMode == Mode::kStitched) {
+                paint.setShader(SkShaders::MakeFractalNoise(
+                        baseFrequencyX, baseFrequencyY, numOctaves, seed, &fSize));
+            } else if (fMode == Mode::kCached) {
+                paint.setShader(SkShaders::MakeCachedFractalNoise(
+                        baseFrequencyX, baseFrequencyY, numOctaves, seed, fSize));
+            }
             this->drawClippedRect(canvas, x, y, paint);
         }
     }
 
+    Mode fMode;
+    SkISize fSize;
+
     using INHERITED = Benchmark;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
-DEF_BENCH( return new PerlinNoiseBench(); )
+DEF_BENCH( return new PerlinNoiseBench(PerlinNoiseBench::Mode::kUntiled); )
+DEF_BENCH( return new PerlinNoiseBench(PerlinNoiseBench::Mode::kStitched); )
+DEF_BENCH( return new PerlinNoiseBench(PerlinNoiseBench::Mode::kCached); )
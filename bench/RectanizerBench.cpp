@@ -5,23 +5,77 @@
 * found in the LICENSE file.
 */
 
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
 #include <memory>
+#include <string>
 
 #include "bench/Benchmark.h"
+#include "include/core/SkData.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
+#include "include/core/SkString.h"
 #include "include/private/base/SkTDArray.h"
 #include "src/base/SkRandom.h"
+#include "src/core/SkOSFile.h"
+#include "src/utils/SkOSPath.h"
+#include "tools/flags/CommandLineFlags.h"
+#include "tools/fonts/FontToolUtils.h"
 
+#include "src/gpu/RectanizerGuillotine.h"
+#include "src/gpu/RectanizerMaxRects.h"
 #include "src/gpu/RectanizerPow2.h"
 #include "src/gpu/RectanizerSkyline.h"
 
 using namespace skgpu;
 
+static DEFINE_string(rectanizerTrace, "",
+                     "A file of glyph sizes, \"width height\" on each line, for the "
+                     "rectanizer_trace benches to replay instead of their built in trace.");
+static DEFINE_bool(rectanizerOccupancy, false,
+                   "Print how full the rectanizer_trace benches leave each plot.");
+
+enum RectanizerType {
+    kPow2_RectanizerType,
+    kSkyline_RectanizerType,
+    kGuillotine_RectanizerType,
+    kMaxRects_RectanizerType,
+};
+
+static const char* rectanizer_name(RectanizerType rectanizerType) {
+    switch (rectanizerType) {
+        case kPow2_RectanizerType:       return "pow2";
+        case kSkyline_RectanizerType:    return "skyline";
+        case kGuillotine_RectanizerType: return "guillotine";
+        case kMaxRects_RectanizerType:   return "maxrects";
+    }
+    SkUNREACHABLE;
+}
+
+static std::unique_ptr<Rectanizer> make_rectanizer(RectanizerType rectanizerType,
+                                                   int width, int height) {
+    switch (rectanizerType) {
+        case kPow2_RectanizerType:
+            return std::make_unique<RectanizerPow2>(width, height);
+        case kSkyline_RectanizerType:
+            return std::make_unique<RectanizerSkyline>(width, height);
+        case kGuillotine_RectanizerType:
+            return std::make_unique<RectanizerGuillotine>(width, height);
+        case kMaxRects_RectanizerType:
+            return std::make_unique<RectanizerMaxRects>(width, height);
+    }
+    SkUNREACHABLE;
+}
+
 /**
  * This bench exercises the GPU backend's Rectanizer classes. It exercises the following
  * rectanizers:
  *      Pow2 Rectanizer
  *      Skyline Rectanizer
+ *      Guillotine Rectanizer
+ *      MaxRects Rectanizer
  * in the following cases:
  *      random rects (e.g., pull-save-layers forward use case)
  *      random power of two rects
@@ -32,11 +86,6 @@ public:
     inline static constexpr int kWidth = 1024;
     inline static constexpr int kHeight = 1024;
 
-    enum RectanizerType {
-        kPow2_RectanizerType,
-        kSkyline_RectanizerType,
-    };
-
     enum RectType {
         kRand_RectType,
         kRandPow2_RectType,
@@ -48,12 +97,7 @@ public:
         , fRectanizerType(rectanizerType)
         , fRectType(rectType) {
 
-        if (kPow2_RectanizerType == fRectanizerType) {
-            fName.append("pow2_");
-        } else {
-            SkASSERT(kSkyline_RectanizerType == fRectanizerType);
-            fName.append("skyline_");
-        }
+        fName.appendf("%s_", rectanizer_name(fRectanizerType));
 
         if (kRand_RectType == fRectType) {
             fName.append("rand");
@@ -77,12 +121,7 @@ protected:
     void onDelayedSetup() override {
         SkASSERT(nullptr == fRectanizer.get());
 
-        if (kPow2_RectanizerType == fRectanizerType) {
-            fRectanizer = std::make_unique<RectanizerPow2>(kWidth, kHeight);
-        } else {
-            SkASSERT(kSkyline_RectanizerType == fRectanizerType);
-            fRectanizer = std::make_unique<RectanizerSkyline>(kWidth, kHeight);
-        }
+        fRectanizer = make_rectanizer(fRectanizerType, kWidth, kHeight);
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
@@ -124,15 +163,146 @@ private:
 
 //////////////////////////////////////////////////////////////////////////////
 
-DEF_BENCH(return new RectanizerBench(RectanizerBench::kPow2_RectanizerType,
+DEF_BENCH(return new RectanizerBench(kPow2_RectanizerType,
+                                     RectanizerBench::kRand_RectType);)
+DEF_BENCH(return new RectanizerBench(kPow2_RectanizerType,
+                                     RectanizerBench::kRandPow2_RectType);)
+DEF_BENCH(return new RectanizerBench(kPow2_RectanizerType,
+                                     RectanizerBench::kSmallPow2_RectType);)
+DEF_BENCH(return new RectanizerBench(kSkyline_RectanizerType,
+                                     RectanizerBench::kRand_RectType);)
+DEF_BENCH(return new RectanizerBench(kSkyline_RectanizerType,
+                                     RectanizerBench::kRandPow2_RectType);)
+DEF_BENCH(return new RectanizerBench(kSkyline_RectanizerType,
+                                     RectanizerBench::kSmallPow2_RectType);)
+DEF_BENCH(return new RectanizerBench(kGuillotine_RectanizerType,
                                      RectanizerBench::kRand_RectType);)
-DEF_BENCH(return new RectanizerBench(RectanizerBench::kPow2_RectanizerType,
+DEF_BENCH(return new RectanizerBench(kGuillotine_RectanizerType,
                                      RectanizerBench::kRandPow2_RectType);)
-DEF_BENCH(return new RectanizerBench(RectanizerBench::kPow2_RectanizerType,
+DEF_BENCH(return new RectanizerBench(kGuillotine_RectanizerType,
                                      RectanizerBench::kSmallPow2_RectType);)
-DEF_BENCH(return new RectanizerBench(RectanizerBench::kSkyline_RectanizerType,
+DEF_BENCH(return new RectanizerBench(kMaxRects_RectanizerType,
                                      RectanizerBench::kRand_RectType);)
-DEF_BENCH(return new RectanizerBench(RectanizerBench::kSkyline_RectanizerType,
+DEF_BENCH(return new RectanizerBench(kMaxRects_RectanizerType,
                                      RectanizerBench::kRandPow2_RectType);)
-DEF_BENCH(return new RectanizerBench(RectanizerBench::kSkyline_RectanizerType,
+DEF_BENCH(return new RectanizerBench(kMaxRects_RectanizerType,
                                      RectanizerBench::kSmallPow2_RectType);)
+
+/**
+ * Replays a trace of glyph insertions into one atlas plot, resetting the plot when a glyph
+ * doesn't fit, the way the glyph atlas evicts a plot. This measures insertion throughput for
+ * glyph sized rects, and with --rectanizerOccupancy, how full each plot got before it had to
+ * be evicted. The built in trace is lines of text at a mix of sizes; --rectanizerTrace replays
+ * one recorded from an app instead.
+ */
+class RectanizerTraceBench : public Benchmark {
+public:
+    // The glyph atlas's plot size for ARGB and LCD, and A8 in smaller atlases.
+    inline static constexpr int kPlotWidth = 256;
+    inline static constexpr int kPlotHeight = 256;
+    // The padding the glyph atlas puts around each glyph.
+    inline static constexpr int kPadding = 1;
+
+    explicit RectanizerTraceBench(RectanizerType rectanizerType)
+        : fName("rectanizer_trace_")
+        , fRectanizerType(rectanizerType) {
+        fName.append(rectanizer_name(fRectanizerType));
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return Backend::kNonRendering == backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        if (!FLAGS_rectanizerTrace.isEmpty()) {
+            this->readTrace(FLAGS_rectanizerTrace[0]);
+        } else {
+            this->makeTrace();
+        }
+        fRectanizer = make_rectanizer(fRectanizerType, kPlotWidth, kPlotHeight);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkIPoint16 loc;
+        for (int i = 0; i < loops; ++i) {
+            for (const SkISize& size : fTrace) {
+                if (!fRectanizer->addPaddedRect(size.fWidth, size.fHeight, kPadding, &loc)) {
+                    fOccupancy += fRectanizer->percentFull();
+                    fEvictions += 1;
+                    fRectanizer->reset();
+                    // The trace only has glyphs that fit in an empty plot.
+                    fRectanizer->addPaddedRect(size.fWidth, size.fHeight, kPadding, &loc);
+                }
+            }
+            fRectanizer->reset();
+            fInsertions += fTrace.size();
+        }
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        if (FLAGS_rectanizerOccupancy && fEvictions > 0) {
+            SkDebugf("%s: %d glyphs, %.1f%% full on eviction, %.1f glyphs per plot\n",
+                     fName.c_str(), fTrace.size(), 100 * fOccupancy / fEvictions,
+                     (double)fInsertions / fEvictions);
+        }
+    }
+
+private:
+    // Lines of random text at a random size, from the test font.
+    void makeTrace() {
+        static constexpr SkScalar kSizes[] = {9, 10, 11, 12, 13, 14, 16, 18, 20, 24, 32, 48};
+        SkRandom rand;
+        SkFont font(ToolUtils::DefaultPortableTypeface());
+        for (int line = 0; line < 1000; ++line) {
+            font.setSize(kSizes[rand.nextULessThan(std::size(kSizes))]);
+            for (int i = 0; i < 40; ++i) {
+                SkGlyphID glyph = font.unicharToGlyph('!' + rand.nextULessThan('~' - '!' + 1));
+                SkRect bounds;
+                font.getBounds(&glyph, 1, &bounds, nullptr);
+                this->addToTrace(bounds.roundOut().size());
+            }
+        }
+    }
+
+    void readTrace(const char* path) {
+        sk_sp<SkData> data = SkData::MakeFromFileName(path);
+        if (!data) {
+            SkDebugf("!! Could not open rectanizer trace: %s\n", path);
+            return;
+        }
+        std::string text(static_cast<const char*>(data->data()), data->size());
+        const char* cursor = text.c_str();
+        int width, height, consumed;
+        while (sscanf(cursor, "%d %d%n", &width, &height, &consumed) == 2) {
+            this->addToTrace({width, height});
+            cursor += consumed;
+        }
+        fName.appendf("_%s", SkOSPath::Basename(path).c_str());
+    }
+
+    void addToTrace(SkISize size) {
+        if (size.fWidth > 0 && size.fHeight > 0 &&
+            size.fWidth + 2 * kPadding <= kPlotWidth &&
+            size.fHeight + 2 * kPadding <= kPlotHeight) {
+            fTrace.push_back(size);
+        }
+    }
+
+    SkString                    fName;
+    RectanizerType              fRectanizerType;
+    SkTDArray<SkISize>          fTrace;
+    std::unique_ptr<Rectanizer> fRectanizer;
+    double                      fOccupancy = 0;
+    int64_t                     fEvictions = 0;
+    int64_t                     fInsertions = 0;
+};
+
+DEF_BENCH(return new RectanizerTraceBench(kPow2_RectanizerType);)
+DEF_BENCH(return new RectanizerTraceBench(kSkyline_RectanizerType);)
+DEF_BENCH(return new RectanizerTraceBench(kGuillotine_RectanizerType);)
+DEF_BENCH(return new RectanizerTraceBench(kMaxRects_RectanizerType);)
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+
+#if defined(SK_ENABLE_SVG)
+
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "tools/Resources.h"
+
+// Builds SVG DOMs from memory, either straight from the XML tokens or through the XML DOM.
+// Divide the document size by the time per loop for the parsing throughput.
+class SVGParseBench final : public Benchmark {
+public:
+    SVGParseBench(const char* name, const char* source, bool use_xml_dom)
+        : fName(SkStringPrintf("svg_parse_%s_%s", use_xml_dom ? "xmldom" : "direct", name))
+        , fSource(source)
+        , fUseXMLDOM(use_xml_dom) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        fData = GetResourceAsData(fSource);
+        SkASSERT(fData);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkMemoryStream stream(fData);
+            auto dom = SkSVGDOM::Builder().setUseXMLDOMParser(fUseXMLDOM).make(stream);
+            SkASSERT(dom);
+        }
+    }
+
+private:
+    const SkString fName;
+    const char*    fSource;
+    const bool     fUseXMLDOM;
+    sk_sp<SkData>  fData;
+};
+
+DEF_BENCH(return new SVGParseBench("cowboy" , "Cowboy.svg"                   , false));
+DEF_BENCH(return new SVGParseBench("cowboy" , "Cowboy.svg"                   , true ));
+DEF_BENCH(return new SVGParseBench("earth"  , "fonts/svg/planets/earth.svg"  , false));
+DEF_BENCH(return new SVGParseBench("earth"  , "fonts/svg/planets/earth.svg"  , true ));
+DEF_BENCH(return new SVGParseBench("jupiter", "fonts/svg/planets/jupiter.svg", false));
+DEF_BENCH(return new SVGParseBench("jupiter", "fonts/svg/planets/jupiter.svg", true ));
+
+#endif // SK_ENABLE_SVG
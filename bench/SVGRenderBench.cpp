@@ -0,0 +1,77 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+
+#if defined(SK_ENABLE_SVG)
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "tools/Resources.h"
+#include "tools/fonts/FontToolUtils.h"
+
+// Renders the same SVG DOM repeatedly, with or without picture caching, optionally zoomed in
+// (only part of the document visible).
+class SVGRenderBench final : public Benchmark {
+public:
+    SVGRenderBench(const char* name, const char* source, float zoom, bool cached)
+        : fName(SkStringPrintf("svg_render_%s_%s", cached ? "cached" : "uncached", name))
+        , fSource(source)
+        , fZoom(zoom)
+        , fCached(cached) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    SkISize onGetSize() override { return {kSize, kSize}; }
+
+    bool isSuitableFor(Backend backend) override { return backend != Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        const auto data = GetResourceAsData(fSource);
+        SkASSERT(data);
+
+        SkMemoryStream stream(data);
+        fDOM = SkSVGDOM::Builder()
+                .setFontManager(ToolUtils::TestFontMgr())
+                .setPictureCaching(fCached)
+                .make(stream);
+        SkASSERT(fDOM);
+        fDOM->setContainerSize(SkSize::Make(kSize, kSize));
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        canvas->scale(fZoom, fZoom);
+        for (int i = 0; i < loops; ++i) {
+            fDOM->render(canvas);
+        }
+    }
+
+private:
+    static constexpr int kSize = 400;
+
+    const SkString  fName;
+    const char*     fSource;
+    const float     fZoom;
+    const bool      fCached;
+    sk_sp<SkSVGDOM> fDOM;
+};
+
+DEF_BENCH(return new SVGRenderBench("cowboy"       , "Cowboy.svg"                   , 1, false));
+DEF_BENCH(return new SVGRenderBench("cowboy"       , "Cowboy.svg"                   , 1, true ));
+DEF_BENCH(return new SVGRenderBench("cowboy_zoomed", "Cowboy.svg"                   , 4, false));
+DEF_BENCH(return new SVGRenderBench("cowboy_zoomed", "Cowboy.svg"                   , 4, true ));
+DEF_BENCH(return new SVGRenderBench("earth"        , "fonts/svg/planets/earth.svg"  , 1, false));
+DEF_BENCH(return new SVGRenderBench("earth"        , "fonts/svg/planets/earth.svg"  , 1, true ));
+DEF_BENCH(return new SVGRenderBench("jupiter"      , "fonts/svg/planets/jupiter.svg", 1, false));
+DEF_BENCH(return new SVGRenderBench("jupiter"      , "fonts/svg/planets/jupiter.svg", 1, true ));
+
+#endif // SK_ENABLE_SVG
@@ -3,13 +3,19 @@
 
 #include "bench/Benchmark.h"
 
-#if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
+#if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3) && \
+    defined(SK_SHAPER_PRIMITIVE_AVAILABLE)
 
 #include "modules/skshaper/include/SkShaper.h"
 #include "tools/Resources.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+#include "modules/skshaper/include/SkShaper_harfbuzz.h"
+#endif
+
 #include <cfloat>
+#include <cstring>
 
 namespace {
 struct ShaperBench : public Benchmark {
@@ -75,4 +81,42 @@ SHAPER_BENCH(tifnagh)
 SHAPER_BENCH(vai)
 #undef SHAPER_BENCH
 
-#endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+namespace {
+// Shaping the labels of a UI, which are the same every frame, with and without the run cache.
+struct ShaperRunCacheBench : public Benchmark {
+    ShaperRunCacheBench(bool useCache)
+            : fUseCache(useCache)
+            , fName(useCache ? "shaper_ui_labels_run_cache" : "shaper_ui_labels_no_run_cache") {}
+    std::unique_ptr<SkShaper> fShaper;
+    const bool fUseCache;
+    const char* fName;
+    const char* onGetName() override { return fName; }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    void onDelayedSetup() override { fShaper = SkShaper::Make(); }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fShaper) { return; }
+        static constexpr const char* kLabels[] = {
+            "File", "Edit", "View", "Insert", "Format", "Tools", "Help", "OK", "Cancel", "Apply",
+            "Open Recent", "Save As...", "Print Preview", "Preferences", "Close Window",
+            "Undo Typing", "Redo", "Select All", "Find and Replace", "Zoom In", "Zoom Out",
+        };
+        SkFont font = ToolUtils::DefaultFont();
+        size_t previousLimit = SkShapers::HB::SetRunCacheLimit(fUseCache ? 1 << 20 : 0);
+        while (loops-- > 0) {
+            for (const char* label : kLabels) {
+                SkTextBlobBuilderRunHandler rh(label, {0, 0});
+                fShaper->shape(label, strlen(label), font, true, FLT_MAX, &rh);
+                (void)rh.makeBlob();
+            }
+        }
+        SkShapers::HB::SetRunCacheLimit(previousLimit);
+    }
+};
+}  // namespace
+
+DEF_BENCH(return new ShaperRunCacheBench(true);)
+DEF_BENCH(return new ShaperRunCacheBench(false);)
+#endif  // defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+
+#endif
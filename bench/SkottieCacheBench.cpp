@@ -0,0 +1,84 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "modules/skottie/include/Skottie.h"
+#include "tools/Resources.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <algorithm>
+
+// Plays an animation (up to kMaxFrames) on a raster surface, with and without layer caching
+// (see Animation::Builder::setLayerCacheBudget).  Divide the frame count by the time per loop
+// for frames per second.
+class SkottieCacheBench final : public Benchmark {
+public:
+    SkottieCacheBench(const char* name, const char* source, bool cached)
+        : fName(SkStringPrintf("skottie_cache_%s_%s", name, cached ? "cached" : "uncached"))
+        , fSource(source)
+        , fCached(cached) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        const auto data = GetResourceAsData(fSource);
+        SkASSERT(data);
+        fAnimation = skottie::Animation::Builder()
+                .setFontManager(ToolUtils::TestFontMgr())
+                .setLayerCacheBudget(fCached ? kBudget : 0)
+                .make(static_cast<const char*>(data->data()), data->size());
+        SkASSERT(fAnimation);
+
+        fFrameCount = std::min(kMaxFrames, static_cast<int>(fAnimation->duration() *
+                                                            fAnimation->fps()));
+        fSurface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(fAnimation->size().toCeil()));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkCanvas* canvas = fSurface->getCanvas();
+        for (int i = 0; i < loops; ++i) {
+            for (int frame = 0; frame < fFrameCount; ++frame) {
+                fAnimation->seekFrame(frame);
+                canvas->clear(SK_ColorWHITE);
+                fAnimation->render(canvas);
+            }
+        }
+    }
+
+private:
+    static constexpr int    kMaxFrames = 120;
+    static constexpr size_t kBudget    = 32 * 1024 * 1024;
+
+    const SkString            fName;
+    const char*               fSource;
+    const bool                fCached;
+    sk_sp<skottie::Animation> fAnimation;
+    sk_sp<SkSurface>          fSurface;
+    int                       fFrameCount = 0;
+};
+
+DEF_BENCH(return new SkottieCacheBench("masking_opaque",
+                                       "skottie/skottie-masking-opaque.json", false));
+DEF_BENCH(return new SkottieCacheBench("masking_opaque",
+                                       "skottie/skottie-masking-opaque.json", true));
+DEF_BENCH(return new SkottieCacheBench("text_scale_to_fit",
+                                       "skottie/skottie-text-scale-to-fit.json", false));
+DEF_BENCH(return new SkottieCacheBench("text_scale_to_fit",
+                                       "skottie/skottie-text-scale-to-fit.json", true));
+DEF_BENCH(return new SkottieCacheBench("text_valign",
+                                       "skottie/skottie-text-valign-2.json", false));
+DEF_BENCH(return new SkottieCacheBench("text_valign",
+                                       "skottie/skottie-text-valign-2.json", true));
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRegion.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "modules/skottie/include/Skottie.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
+#include "tools/Resources.h"
+#include "tools/flags/CommandLineFlags.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <algorithm>
+#include <cstdint>
+
+static DEFINE_bool(skottieDamageStats, false,
+                   "Report the pixels repainted per frame by the skottie_damage benches.");
+
+// Plays an animation (up to kMaxFrames) on a retained raster surface, either repainting every
+// frame in full, or only repainting the areas damaged since the previous frame.  Divide the frame
+// count by the time per loop for frames per second, and use --skottieDamageStats to see how many
+// pixels each mode repaints per frame (for dirty rendering, that's the damaged area, which the
+// animation may round up to its bounds when it is too fragmented).
+class SkottieDamageBench final : public Benchmark {
+public:
+    SkottieDamageBench(const char* name, const char* source, bool damage)
+        : fName(SkStringPrintf("skottie_damage_%s_%s", name, damage ? "dirty" : "full"))
+        , fSource(source)
+        , fDamage(damage) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        const auto data = GetResourceAsData(fSource);
+        SkASSERT(data);
+        fAnimation = skottie::Animation::Builder()
+                .setFontManager(ToolUtils::TestFontMgr())
+                .make(static_cast<const char*>(data->data()), data->size());
+        SkASSERT(fAnimation);
+
+        fFrameCount = std::min(kMaxFrames, static_cast<int>(fAnimation->duration() *
+                                                            fAnimation->fps()));
+        fSurface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(fAnimation->size().toCeil()));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkCanvas* canvas = fSurface->getCanvas();
+        const SkIRect bounds = canvas->imageInfo().bounds();
+
+        for (int i = 0; i < loops; ++i) {
+            // Each loop starts from a full repaint of the first frame.
+            fAnimation->seekFrame(0);
+            canvas->clear(SK_ColorTRANSPARENT);
+            fAnimation->render(canvas);
+
+            for (int frame = 1; frame < fFrameCount; ++frame) {
+                if (!fDamage) {
+                    fAnimation->seekFrame(frame);
+                    canvas->clear(SK_ColorTRANSPARENT);
+                    fAnimation->render(canvas);
+                    fPixels += bounds.width() * bounds.height();
+                    continue;
+                }
+
+                sksg::InvalidationController ic;
+                fAnimation->seekFrame(frame, &ic);
+                fAnimation->renderDamage(canvas, ic);
+
+                if (FLAGS_skottieDamageStats) {
+                    SkRegion region;
+                    for (const auto& rect : ic) {
+                        region.op(rect.roundOut(), SkRegion::kUnion_Op);
+                    }
+                    region.op(bounds, SkRegion::kIntersect_Op);
+                    for (SkRegion::Iterator it(region); !it.done(); it.next()) {
+                        fPixels += it.rect().width() * it.rect().height();
+                    }
+                }
+            }
+            fFrames += fFrameCount - 1;
+        }
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        if (FLAGS_skottieDamageStats && fFrames > 0) {
+            const int64_t area = fSurface->width() * fSurface->height();
+            SkDebugf("%s: %lld pixels repainted per frame (%.1f%% of %lld)\n",
+                     fName.c_str(), static_cast<long long>(fPixels / fFrames),
+                     100.0 * fPixels / fFrames / area, static_cast<long long>(area));
+        }
+    }
+
+private:
+    static constexpr int kMaxFrames = 120;
+
+    const SkString            fName;
+    const char*               fSource;
+    const bool                fDamage;
+    sk_sp<skottie::Animation> fAnimation;
+    sk_sp<SkSurface>          fSurface;
+    int                       fFrameCount = 0;
+
+    int64_t                   fPixels = 0,
+                              fFrames = 0;
+};
+
+DEF_BENCH(return new SkottieDamageBench("masking_opaque",
+                                        "skottie/skottie-masking-opaque.json", false));
+DEF_BENCH(return new SkottieDamageBench("masking_opaque",
+                                        "skottie/skottie-masking-opaque.json", true));
+DEF_BENCH(return new SkottieDamageBench("text_animatedglyphs",
+                                        "skottie/skottie-text-animatedglyphs-01.json", false));
+DEF_BENCH(return new SkottieDamageBench("text_animatedglyphs",
+                                        "skottie/skottie-text-animatedglyphs-01.json", true));
+DEF_BENCH(return new SkottieDamageBench("trimpath_fill",
+                                        "skottie/skottie-trimpath-fill.json", false));
+DEF_BENCH(return new SkottieDamageBench("trimpath_fill",
+                                        "skottie/skottie-trimpath-fill.json", true));
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "modules/skottie/include/Skottie.h"
+#include "src/core/SkTaskGroup.h"
+#include "tools/Resources.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// Offline export of an animation: every frame (up to kMaxFrames) is rendered to a raster surface,
+// spread over a number of threads, each with its own copy of the animation. Divide the frame
+// count by the time per loop for frames per second.
+class SkottieExportBench final : public Benchmark {
+public:
+    SkottieExportBench(const char* name, const char* source, int threadCount)
+        : fName(SkStringPrintf("skottie_export_%s_%dthreads", name, threadCount))
+        , fSource(source)
+        , fThreadCount(threadCount) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        const auto data = GetResourceAsData(fSource);
+        SkASSERT(data);
+        const auto animation = skottie::Animation::Builder(
+                                       skottie::Animation::Builder::kRetainSource)
+                .setFontManager(ToolUtils::TestFontMgr())
+                .make(static_cast<const char*>(data->data()), data->size());
+        SkASSERT(animation);
+
+        fFrameCount = std::min(kMaxFrames, static_cast<int>(animation->duration() *
+                                                            animation->fps()));
+        const auto info = SkImageInfo::MakeN32Premul(animation->size().toCeil());
+        for (int i = 0; i < fThreadCount; ++i) {
+            fAnimations.push_back(i ? animation->makeCopy() : animation);
+            fSurfaces.push_back(SkSurfaces::Raster(info));
+        }
+        // Make our own executor so the --threads parameter doesn't change the thread count.
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreadCount);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkTaskGroup(*fExecutor).batch(fThreadCount, [&](int threadIndex) {
+                skottie::Animation* animation = fAnimations[threadIndex].get();
+                SkCanvas* canvas = fSurfaces[threadIndex]->getCanvas();
+                for (int frame = threadIndex; frame < fFrameCount; frame += fThreadCount) {
+                    animation->seekFrame(frame);
+                    canvas->clear(SK_ColorWHITE);
+                    animation->render(canvas);
+                }
+            });
+        }
+    }
+
+private:
+    static constexpr int kMaxFrames = 120;
+
+    const SkString fName;
+    const char*    fSource;
+    const int      fThreadCount;
+
+    int                                    fFrameCount = 0;
+    std::vector<sk_sp<skottie::Animation>> fAnimations;
+    std::vector<sk_sp<SkSurface>>          fSurfaces;
+    std::unique_ptr<SkExecutor>            fExecutor;
+};
+
+static constexpr char kTrimPath[] = "skottie/skottie-trimpath-fill.json";  // 500x500, 600 frames
+
+DEF_BENCH(return new SkottieExportBench("trimpath_fill", kTrimPath, 1);)
+DEF_BENCH(return new SkottieExportBench("trimpath_fill", kTrimPath, 2);)
+DEF_BENCH(return new SkottieExportBench("trimpath_fill", kTrimPath, 4);)
+DEF_BENCH(return new SkottieExportBench("trimpath_fill", kTrimPath, 8);)
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkData.h"
+#include "include/core/SkString.h"
+#include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/src/SkottiePriv.h"
+#include "modules/skottie/src/SkottieValue.h"
+#include "modules/skottie/src/animator/Animator.h"
+#include "src/utils/SkJSON.h"
+#include "tools/Resources.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <optional>
+#include <vector>
+
+// Seeks through a whole animation, in half frame steps, without rendering: this measures the
+// keyframe evaluation and scene graph revalidation throughput. Divide the seek count (twice the
+// frame count) by the time per loop for seeks per second.
+class SkottieSeekBench final : public Benchmark {
+public:
+    SkottieSeekBench(const char* name, const char* source)
+        : fName(SkStringPrintf("skottie_seek_%s", name))
+        , fSource(source) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        const auto data = GetResourceAsData(fSource);
+        SkASSERT(data);
+        fAnimation = skottie::Animation::Builder()
+                .setFontManager(ToolUtils::TestFontMgr())
+                .make(static_cast<const char*>(data->data()), data->size());
+        SkASSERT(fAnimation);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const double frames = fAnimation->duration() * fAnimation->fps();
+        for (int i = 0; i < loops; ++i) {
+            for (double frame = 0; frame < frames; frame += 0.5) {
+                fAnimation->seekFrame(frame);
+            }
+        }
+    }
+
+private:
+    const SkString            fName;
+    const char*               fSource;
+    sk_sp<skottie::Animation> fAnimation;
+};
+
+// Seeks thousands of animated scalar properties, each with its own cubic keyframes, without an
+// animation or scene graph around them: this measures the keyframe evaluation alone, with the
+// properties either evaluated together by a KeyframeBatch or each on its own.
+class SkottieKeyframeSeekBench final : public Benchmark {
+public:
+    explicit SkottieKeyframeSeekBench(bool batched)
+        : fName(SkStringPrintf("skottie_keyframe_seek_%s", batched ? "batched" : "unbatched"))
+        , fBatched(batched) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        using namespace skottie::internal;
+
+        AnimationBuilder abuilder(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                                  nullptr, nullptr, {100, 100}, kDuration, 1, 0);
+        std::optional<AnimationBuilder::AutoKeyframeBatch> akb;
+        if (fBatched) {
+            akb.emplace(&abuilder);
+        }
+
+        for (int i = 0; i < kPropertyCount; ++i) {
+            // Stagger the keyframes, so the properties are in different segments at any t.
+            const float t0 = (i % 7) * 0.25f;
+            const SkString jprop = SkStringPrintf(R"({
+                "a": 1,
+                "k": [
+                  { "t": %g, "s": 0,
+                    "o":{"x":[0.42], "y":[0]}, "i":{"x":[0.58], "y":[1]} },
+                  { "t": %g, "s": 100,
+                    "o":{"x":[0.3], "y":[0.2]}, "i":{"x":[0.2], "y":[0.9]} },
+                  { "t": %g, "s": 20,
+                    "o":{"x":[0.8], "y":[0.1]}, "i":{"x":[0.4], "y":[1.2]} },
+                  { "t": %g, "s": 60 }
+                ]
+            })", t0, t0 + 2.5f, t0 + 5, t0 + 8);
+            skjson::DOM json_dom(jprop.c_str(), jprop.size());
+            auto property = sk_make_sp<Property>();
+            property->bind(abuilder, json_dom.root(), &property->fValue);
+            fProperties.push_back(std::move(property));
+        }
+
+        if (akb) {
+            fBatch = akb->release();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            for (int step = 0; step < kSeekCount; ++step) {
+                const float t = step * kDuration / kSeekCount;
+                if (fBatch) {
+                    fBatch->seek(t);
+                }
+                for (const auto& property : fProperties) {
+                    property->seek(t);
+                }
+            }
+        }
+    }
+
+private:
+    inline static constexpr int   kPropertyCount = 4096,
+                                  kSeekCount     = 64;
+    inline static constexpr float kDuration      = 10;
+
+    class Property final : public skottie::internal::AnimatablePropertyContainer {
+    public:
+        skottie::ScalarValue fValue = 0;
+
+    private:
+        void onSync() override {}
+    };
+
+    const SkString                      fName;
+    const bool                          fBatched;
+    std::vector<sk_sp<Property>>        fProperties;
+    sk_sp<skottie::internal::Animator>  fBatch;
+};
+
+DEF_BENCH(return new SkottieKeyframeSeekBench(true));
+DEF_BENCH(return new SkottieKeyframeSeekBench(false));
+
+DEF_BENCH(return new SkottieSeekBench("masking_opaque", "skottie/skottie-masking-opaque.json"));
+DEF_BENCH(return new SkottieSeekBench("text_animatedglyphs",
+                                      "skottie/skottie-text-animatedglyphs-01.json"));
+DEF_BENCH(return new SkottieSeekBench("trimpath_fill", "skottie/skottie-trimpath-fill.json"));
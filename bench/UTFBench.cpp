@@ -0,0 +1,79 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkString.h"
+#include "src/base/SkUTF.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Each loop converts or counts 1MB of text, so MB/s is 1000 / (ms per loop).
+namespace {
+enum class Op { kCountUTF8, kUTF8ToUTF16, kUTF16ToUTF8 };
+
+class UTFBench : public Benchmark {
+public:
+    UTFBench(Op op, bool ascii) : fOp(op), fASCII(ascii) {
+        static constexpr const char* kOpNames[] = {"count_utf8", "utf8_to_utf16", "utf16_to_utf8"};
+        fName.printf("utf_%s_%s_1MB", kOpNames[(int)op], ascii ? "ascii" : "mixed");
+    }
+
+private:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        // Mostly ASCII with an accented letter or a CJK character every so often, like much
+        // of the text in a document that is not all ASCII.
+        static constexpr char kASCII[] = "The quick brown fox jumps over the lazy dog. ";
+        static constexpr char kMixed[] = "Th\xC3\xA9 quick brown fox jumps over the \xE7\x8A\xAC. ";
+        while (fUTF8.size() < 1024 * 1024) {
+            fUTF8 += fASCII ? kASCII : kMixed;
+        }
+        fUTF16.resize(SkUTF::UTF8ToUTF16(nullptr, 0, fUTF8.data(), fUTF8.size()));
+        SkUTF::UTF8ToUTF16(fUTF16.data(), fUTF16.size(), fUTF8.data(), fUTF8.size());
+        fUTF8Out.resize(fUTF8.size());
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        int result = 0;
+        for (int i = 0; i < loops; ++i) {
+            switch (fOp) {
+                case Op::kCountUTF8:
+                    result += SkUTF::CountUTF8(fUTF8.data(), fUTF8.size());
+                    break;
+                case Op::kUTF8ToUTF16:
+                    result += SkUTF::UTF8ToUTF16(fUTF16.data(), fUTF16.size(),
+                                                 fUTF8.data(), fUTF8.size());
+                    break;
+                case Op::kUTF16ToUTF8:
+                    result += SkUTF::UTF16ToUTF8(fUTF8Out.data(), fUTF8Out.size(),
+                                                 fUTF16.data(), fUTF16.size());
+                    break;
+            }
+        }
+        fResult = result;
+    }
+
+    const Op fOp;
+    const bool fASCII;
+    SkString fName;
+    std::string fUTF8;
+    std::vector<uint16_t> fUTF16;
+    std::vector<char> fUTF8Out;
+    volatile int fResult = 0;
+};
+}  // namespace
+
+DEF_BENCH(return new UTFBench(Op::kCountUTF8, true);)
+DEF_BENCH(return new UTFBench(Op::kCountUTF8, false);)
+DEF_BENCH(return new UTFBench(Op::kUTF8ToUTF16, true);)
+DEF_BENCH(return new UTFBench(Op::kUTF8ToUTF16, false);)
+DEF_BENCH(return new UTFBench(Op::kUTF16ToUTF8, true);)
+DEF_BENCH(return new UTFBench(Op::kUTF16ToUTF8, false);)
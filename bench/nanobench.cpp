@@ -222,7 +222,8 @@ static SkString humanize(double ms) {
 
 bool Target::init(SkImageInfo info, Benchmark* bench) {
     if (Benchmark::Backend::kRaster == config.backend) {
-        this->surface = SkSurfaces::Raster(info);
+        SkSurfaceProps props(config.surfaceFlags, kUnknown_SkPixelGeometry);
+        this->surface = SkSurfaces::Raster(info, &props);
         if (!this->surface) {
             return false;
         }
@@ -653,7 +654,7 @@ static std::optional<Config> create_config(const SkCommandLineConfig* config) {
     }
 #endif
 
-#define CPU_CONFIG(name, backend, color, alpha)                                         \
+#define CPU_CONFIG(name, backend, color, alpha, flags)                                  \
     if (config->getBackend().equals(name)) {                                            \
         if (!FLAGS_cpu) {                                                               \
             SkDebugf("Skipping config '%s' as requested.\n", config->getTag().c_str()); \
@@ -667,18 +668,23 @@ static std::optional<Config> create_config(const SkCommandLineConfig* config) {
                       0,                                                                \
                       kBogusContextType,                                                \
                       kBogusContextOverrides,                                           \
-                      0};                                                               \
+                      flags};                                                           \
     }
 
-    CPU_CONFIG("nonrendering", Backend::kNonRendering, kUnknown_SkColorType, kUnpremul_SkAlphaType)
+    CPU_CONFIG("nonrendering",
+               Backend::kNonRendering, kUnknown_SkColorType, kUnpremul_SkAlphaType, 0)
 
-    CPU_CONFIG("a8",    Backend::kRaster,    kAlpha_8_SkColorType, kPremul_SkAlphaType)
-    CPU_CONFIG("565",   Backend::kRaster,    kRGB_565_SkColorType, kOpaque_SkAlphaType)
-    CPU_CONFIG("8888",  Backend::kRaster,        kN32_SkColorType, kPremul_SkAlphaType)
-    CPU_CONFIG("rgba",  Backend::kRaster,  kRGBA_8888_SkColorType, kPremul_SkAlphaType)
-    CPU_CONFIG("bgra",  Backend::kRaster,  kBGRA_8888_SkColorType, kPremul_SkAlphaType)
-    CPU_CONFIG("f16",   Backend::kRaster,   kRGBA_F16_SkColorType, kPremul_SkAlphaType)
-    CPU_CONFIG("srgba", Backend::kRaster, kSRGBA_8888_SkColorType, kPremul_SkAlphaType)
+    CPU_CONFIG("a8",    Backend::kRaster,    kAlpha_8_SkColorType, kPremul_SkAlphaType, 0)
+    CPU_CONFIG("565",   Backend::kRaster,    kRGB_565_SkColorType, kOpaque_SkAlphaType, 0)
+    CPU_CONFIG("8888",  Backend::kRaster,        kN32_SkColorType, kPremul_SkAlphaType, 0)
+    CPU_CONFIG("rgba",  Backend::kRaster,  kRGBA_8888_SkColorType, kPremul_SkAlphaType, 0)
+    CPU_CONFIG("bgra",  Backend::kRaster,  kBGRA_8888_SkColorType, kPremul_SkAlphaType, 0)
+    CPU_CONFIG("f16",   Backend::kRaster,   kRGBA_F16_SkColorType, kPremul_SkAlphaType, 0)
+    CPU_CONFIG("srgba", Backend::kRaster, kSRGBA_8888_SkColorType, kPremul_SkAlphaType, 0)
+
+    // Same as 8888, but fills anti-aliased paths with the sparse strip rasterizer.
+    CPU_CONFIG("8888sparse", Backend::kRaster, kN32_SkColorType, kPremul_SkAlphaType,
+               SkSurfaceProps::kSparseStripRasterizer_Flag)
 
 #undef CPU_CONFIG
 
@@ -15,6 +15,7 @@
 #include "include/core/SkData.h"
 #include "include/core/SkDocument.h"
 #include "include/core/SkGraphics.h"
+#include "include/core/SkSurfaceProps.h"
 #include "src/base/SkHalf.h"
 #include "src/base/SkLeanWindows.h"
 #include "src/base/SkNoDestructor.h"
@@ -1013,6 +1014,8 @@ static Sink* create_sink(const GrContextOptions& grCtxOptions, const SkCommandLi
         SINK("565",         RasterSink, kRGB_565_SkColorType);
         SINK("4444",        RasterSink, kARGB_4444_SkColorType);
         SINK("8888",        RasterSink, kN32_SkColorType);
+        SINK("8888sparse",  RasterSink, kN32_SkColorType,
+                            SkSurfaceProps::kSparseStripRasterizer_Flag);
         SINK("rgba",        RasterSink, kRGBA_8888_SkColorType);
         SINK("bgra",        RasterSink, kBGRA_8888_SkColorType);
         SINK("rgbx",        RasterSink, kRGB_888x_SkColorType);
@@ -2117,8 +2117,9 @@ Result SVGSink::draw(const Src& src, SkBitmap*, SkWStream* dst, SkString*) const
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
-RasterSink::RasterSink(SkColorType colorType)
-    : fColorType(colorType) {}
+RasterSink::RasterSink(SkColorType colorType, uint32_t surfaceFlags)
+    : fColorType(colorType)
+    , fSurfaceFlags(surfaceFlags) {}
 
 Result RasterSink::draw(const Src& src, SkBitmap* dst, SkWStream*, SkString*) const {
     const SkISize size = src.size();
@@ -2130,7 +2131,7 @@ Result RasterSink::draw(const Src& src, SkBitmap* dst, SkWStream*, SkString*) co
     dst->allocPixelsFlags(SkImageInfo::Make(size, this->colorInfo()),
                           SkBitmap::kZeroPixels_AllocFlag);
 
-    SkSurfaceProps props(/*flags=*/0, kRGB_H_SkPixelGeometry);
+    SkSurfaceProps props(fSurfaceFlags, kRGB_H_SkPixelGeometry);
     auto surface = SkSurfaces::WrapPixels(dst->pixmap(), &props);
     return src.draw(surface->getCanvas(), /*GraphiteTestContext=*/nullptr);
 }
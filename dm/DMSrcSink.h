@@ -514,7 +514,7 @@ public:
 
 class RasterSink : public Sink {
 public:
-    explicit RasterSink(SkColorType);
+    explicit RasterSink(SkColorType, uint32_t surfaceFlags = 0);
 
     Result draw(const Src&, SkBitmap*, SkWStream*, SkString*) const override;
     const char* fileExtension() const override { return "png"; }
@@ -531,6 +531,7 @@ public:
 
 private:
     SkColorType         fColorType;
+    uint32_t            fSurfaceFlags;
     sk_sp<SkColorSpace> fColorSpace;
 };
 
@@ -96,6 +96,23 @@ public:
      */
     static void PurgePinnedFontCache();
 
+    /**
+     *  Serialize the glyph metrics, images and paths in the font cache, so that a later run of the
+     *  same build of the program can pass them to SetFontCacheGlyphStore, e.g. after writing them
+     *  to a file.
+     */
+    static sk_sp<SkData> SerializeFontCacheGlyphs();
+
+    /**
+     *  Use data made by SerializeFontCacheGlyphs as a read-only store of glyphs. When the font
+     *  cache makes a new entry, it takes the entry's glyphs from the store instead of asking the
+     *  typeface to make them again. The data is used in place, so it may be a memory mapped file
+     *  (see SkData::MakeFromFileName). Pass nullptr to stop using a store.
+     *
+     *  Returns false, and leaves the current store in place, if data is not a valid store.
+     */
+    static bool SetFontCacheGlyphStore(sk_sp<SkData> data);
+
     /**
      *  This function returns the memory used for temporary images and other resources.
      */
@@ -60,6 +60,10 @@ public:
         // If set, all rendering will have dithering enabled
         // Currently this only impacts GPU backends
         kAlwaysDither_Flag = 1 << 2,
+        // If set, anti-aliased paths are filled with a tile based sparse strip rasterizer
+        // instead of the analytic AA scan converter. Currently this only impacts the raster
+        // backend.
+        kSparseStripRasterizer_Flag = 1 << 3,
     };
 
     /** No flags, unknown pixel geometry, platform-default contrast/gamma. */
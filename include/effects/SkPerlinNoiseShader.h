@@ -48,6 +48,23 @@ SK_API sk_sp<SkShader> MakeFractalNoise(SkScalar baseFrequencyX, SkScalar baseFr
 SK_API sk_sp<SkShader> MakeTurbulence(SkScalar baseFrequencyX, SkScalar baseFrequencyY,
                                       int numOctaves, SkScalar seed,
                                       const SkISize* tileSize = nullptr);
+
+/**
+ *  Same as MakeFractalNoise and MakeTurbulence with a non-empty tileSize, except that the noise
+ *  is rendered once into a tile image, which is repeated to fill the plane. The tiles are kept in
+ *  the resource cache and shared by all the shaders made with the same parameters, so drawing the
+ *  same noise again (e.g. in every frame of an animation) only costs an image lookup.
+ *
+ *  The noise is sampled at the centers of the tile's pixels, so this matches the uncached shader
+ *  inside the tile when drawn without scaling or rotation. If the tile is too large to cache,
+ *  this returns the uncached shader.
+ */
+SK_API sk_sp<SkShader> MakeCachedFractalNoise(SkScalar baseFrequencyX, SkScalar baseFrequencyY,
+                                              int numOctaves, SkScalar seed,
+                                              const SkISize& tileSize);
+SK_API sk_sp<SkShader> MakeCachedTurbulence(SkScalar baseFrequencyX, SkScalar baseFrequencyY,
+                                            int numOctaves, SkScalar seed,
+                                            const SkISize& tileSize);
 }  // namespace SkShaders
 
 #endif
@@ -0,0 +1,146 @@
+// Copyright 2024 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "bench/Benchmark.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPathBuilder.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkString.h"
+#include "include/pathops/SkPathOps.h"
+#include "modules/bentleyottmann/include/BooleanOps.h"
+#include "src/base/SkRandom.h"
+
+#include <utility>
+
+// Compares the throughput of bentleyottmann::boolean_op with SkPathOps on large, line only
+// inputs. Both engines are given the same paths, so the results with the same suffix are directly
+// comparable.
+namespace {
+
+enum class Engine {
+    kBentleyOttmann,
+    kPathOps,
+};
+
+// A grid of slightly rotated squares, where every square overlaps its neighbors.
+SkPath make_square_grid(int count, float rotation) {
+    SkPathBuilder builder;
+    for (int y = 0; y < count; ++y) {
+        for (int x = 0; x < count; ++x) {
+            const float cx = x * 10.f + 5.f,
+                        cy = y * 10.f + 5.f;
+            const SkVector u = {7.f * SkScalarCos(rotation), 7.f * SkScalarSin(rotation)},
+                           v = {-u.y(), u.x()};
+            builder.moveTo(cx - u.x() - v.x(), cy - u.y() - v.y());
+            builder.lineTo(cx + u.x() - v.x(), cy + u.y() - v.y());
+            builder.lineTo(cx + u.x() + v.x(), cy + u.y() + v.y());
+            builder.lineTo(cx - u.x() + v.x(), cy - u.y() + v.y());
+            builder.close();
+        }
+    }
+    return builder.detach();
+}
+
+// A single self-intersecting polygon with many random vertices.
+SkPath make_random_polygon(int count, uint32_t seed) {
+    SkRandom random{seed};
+    SkPathBuilder builder;
+    builder.moveTo(random.nextRangeF(0, 500), random.nextRangeF(0, 500));
+    for (int i = 1; i < count; ++i) {
+        builder.lineTo(random.nextRangeF(0, 500), random.nextRangeF(0, 500));
+    }
+    builder.close();
+    return builder.detach();
+}
+
+const char* engine_name(Engine engine) {
+    return engine == Engine::kBentleyOttmann ? "bentleyottmann" : "pathops";
+}
+
+class BooleanOpsBench : public Benchmark {
+public:
+    BooleanOpsBench(Engine engine, const char* suffix, SkPath one, SkPath two)
+            : fEngine{engine}
+            , fOne{std::move(one)}
+            , fTwo{std::move(two)} {
+        fName.printf("boolean_ops_%s_%s", engine_name(engine), suffix);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            if (fEngine == Engine::kBentleyOttmann) {
+                SkAssertResult(bentleyottmann::boolean_op(
+                        fOne, fTwo, bentleyottmann::BooleanOp::kUnion).has_value());
+            } else {
+                SkPath result;
+                Op(fOne, fTwo, kUnion_SkPathOp, &result);
+            }
+        }
+    }
+
+private:
+    const Engine fEngine;
+    const SkPath fOne;
+    const SkPath fTwo;
+    SkString fName;
+};
+
+class SimplifyBench : public Benchmark {
+public:
+    SimplifyBench(Engine engine, const char* suffix, SkPath path)
+            : fEngine{engine}
+            , fPath{std::move(path)} {
+        fName.printf("boolean_ops_simplify_%s_%s", engine_name(engine), suffix);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            if (fEngine == Engine::kBentleyOttmann) {
+                SkAssertResult(bentleyottmann::simplify(fPath).has_value());
+            } else {
+                SkPath result;
+                Simplify(fPath, &result);
+            }
+        }
+    }
+
+private:
+    const Engine fEngine;
+    const SkPath fPath;
+    SkString fName;
+};
+}  // namespace
+
+#define DEF_BOOLEAN_OPS_BENCH(suffix, one, two)                                             \
+    DEF_BENCH(return new BooleanOpsBench(Engine::kBentleyOttmann, suffix, one, two);)      \
+    DEF_BENCH(return new BooleanOpsBench(Engine::kPathOps, suffix, one, two);)
+
+#define DEF_SIMPLIFY_BENCH(suffix, path)                                                    \
+    DEF_BENCH(return new SimplifyBench(Engine::kBentleyOttmann, suffix, path);)            \
+    DEF_BENCH(return new SimplifyBench(Engine::kPathOps, suffix, path);)
+
+DEF_BOOLEAN_OPS_BENCH("grid_10", make_square_grid(10, 0.1f), make_square_grid(10, 0.7f))
+DEF_BOOLEAN_OPS_BENCH("grid_40", make_square_grid(40, 0.1f), make_square_grid(40, 0.7f))
+DEF_BOOLEAN_OPS_BENCH("polygons_200", make_random_polygon(200, 1), make_random_polygon(200, 2))
+
+DEF_SIMPLIFY_BENCH("grid_40", make_square_grid(40, 0.3f))
+DEF_SIMPLIFY_BENCH("polygon_100", make_random_polygon(100, 3))
+DEF_SIMPLIFY_BENCH("polygon_500", make_random_polygon(500, 4))
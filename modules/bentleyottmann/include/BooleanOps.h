@@ -0,0 +1,38 @@
+// Copyright 2024 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#ifndef BooleanOps_DEFINED
+#define BooleanOps_DEFINED
+
+#include "include/core/SkPath.h"
+
+#include <optional>
+
+namespace bentleyottmann {
+
+// The operations mirror SkPathOp.
+enum class BooleanOp {
+    kDifference,         // one minus two
+    kIntersect,          // one intersected with two
+    kUnion,              // one unioned with two
+    kXOR,                // one exclusive-ored with two
+    kReverseDifference,  // two minus one
+};
+
+// Combine the areas of one and two using op. The paths are converted to integer coordinates
+// (see contour::Contours) with curves flattened to lines, and the result is found with an exact
+// sweep line, so this is best suited to inputs that are mostly made of lines.
+//
+// The result only contains lines. Its contours do not cross each other, are clockwise around
+// filled areas and counterclockwise around holes, and use the winding fill type; inverse winding
+// if the result is unbounded.
+//
+// A return value of nullopt means that the paths' coordinates are out of range.
+std::optional<SkPath> boolean_op(const SkPath& one, const SkPath& two, BooleanOp op);
+
+// Return a path covering the same area as path, but with no crossing contours. This is
+// boolean_op with an empty second path.
+std::optional<SkPath> simplify(const SkPath& path);
+}  // namespace bentleyottmann
+
+#endif  // BooleanOps_DEFINED
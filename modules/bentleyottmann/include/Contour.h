@@ -57,6 +57,8 @@ class Contours {
     };
 public:
     static constexpr double kScaleFactor = 1024;
+    // The maximum distance, in path units, between a curve and the lines used to approximate it.
+    static constexpr float kFlatteningTolerance = 0.25f;
     static Contours Make(SkPath path);
 
     Contour operator[](size_t i) const {
@@ -95,6 +97,8 @@ private:
     static Point RoundSkPoint(SkPoint p);
     bool currentContourIsEmpty() const;
     void addPointToCurrentContour(SkPoint p);
+    void addQuadToCurrentContour(const SkPoint pts[3]);
+    void addCubicToCurrentContour(const SkPoint pts[4]);
     void moveToStartOfContour(SkPoint p);
     void closeContourIfNeeded();
 
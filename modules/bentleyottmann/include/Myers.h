@@ -84,6 +84,8 @@ template<> inline const myers::Point& get<1>(const myers::Segment& s) { return s
 class Crossing {
 public:
     Crossing(const Segment& s0, const Segment& s1) : Crossing{std::minmax(s0, s1)} {}
+    const Segment& higher() const { return fHigher; }
+    const Segment& lower() const { return fLower; }
     friend bool operator<(const Crossing& c0, const Crossing& c1);
     friend bool operator==(const Crossing& c0, const Crossing& c1);
 
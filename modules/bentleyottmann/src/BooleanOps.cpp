@@ -0,0 +1,577 @@
+// Copyright 2024 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "modules/bentleyottmann/include/BooleanOps.h"
+
+#include "include/core/SkPathBuilder.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTo.h"
+#include "modules/bentleyottmann/include/Contour.h"
+#include "modules/bentleyottmann/include/Int96.h"
+#include "modules/bentleyottmann/include/Myers.h"
+#include "modules/bentleyottmann/include/Point.h"
+#include "modules/bentleyottmann/include/Segment.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace bentleyottmann {
+namespace {
+
+// -- Edge -----------------------------------------------------------------------------------------
+// An input edge stored from top to bottom. Horizontal edges are never stored because they do not
+// change the winding number of a horizontal ray.
+struct Edge {
+    Point top;
+    Point bottom;
+    // +1 if the edge originally pointed down the y-axis, -1 if it pointed up.
+    int32_t winding;
+    // 0 for edges from the first path, and 1 for edges from the second path.
+    int32_t operand;
+};
+
+void add_edges(const contour::Contours& contours, int32_t operand, std::vector<Edge>* edges) {
+    for (const contour::Contour& contour : contours) {
+        // Every contour is implicitly closed, so start with the edge from the last point back to
+        // the first.
+        Point p0 = {contour.points.back().x, contour.points.back().y};
+        for (const contour::Point& point : contour.points) {
+            const Point p1 = {point.x, point.y};
+            if (p0.y != p1.y) {
+                const auto [top, bottom] = std::minmax(p0, p1);
+                edges->push_back({top, bottom, p0.y < p1.y ? 1 : -1, operand});
+            }
+            p0 = p1;
+        }
+    }
+}
+
+// Split the edges once at all the crossings found between them. Returns false if there were no
+// crossings to split at.
+bool split_edges_once(std::vector<Edge>* edges) {
+    // Coincident edges must appear only once in the sweep, so gather the edges for each segment.
+    auto toMyers = [](const Edge& e) {
+        return myers::Segment{{e.top.x, e.top.y}, {e.bottom.x, e.bottom.y}};
+    };
+    std::map<myers::Segment, std::vector<size_t>> edgesForSegment;
+    for (size_t i = 0; i < edges->size(); ++i) {
+        edgesForSegment[toMyers((*edges)[i])].push_back(i);
+    }
+
+    std::vector<myers::Segment> segments;
+    segments.reserve(edgesForSegment.size());
+    for (const auto& [segment, _] : edgesForSegment) {
+        segments.push_back(segment);
+    }
+
+    // Myers' sweep finds all the pairs of segments that touch without any round-off. The
+    // crossing point of each pair is then found, rounded to the integer grid, by intersect.
+    const std::vector<myers::Crossing> crossings = myers::myers_find_crossings(segments);
+    if (crossings.empty()) {
+        return false;
+    }
+
+    auto toSegment = [](const myers::Segment& s) {
+        return Segment{{s.upper().x, s.upper().y}, {s.lower().x, s.lower().y}};
+    };
+    std::vector<std::tuple<size_t, Point>> splits;
+    for (const myers::Crossing& crossing : crossings) {
+        const std::optional<Point> p =
+                intersect(toSegment(crossing.higher()), toSegment(crossing.lower()));
+        if (!p) {
+            // The segments only share an end point, or they are collinear.
+            continue;
+        }
+        for (const myers::Segment& s : {crossing.higher(), crossing.lower()}) {
+            for (size_t i : edgesForSegment[s]) {
+                splits.emplace_back(i, *p);
+            }
+        }
+    }
+    if (splits.empty()) {
+        return false;
+    }
+    std::sort(splits.begin(), splits.end());
+    splits.erase(std::unique(splits.begin(), splits.end()), splits.end());
+
+    // Only the slabs between the stops matter to the sweep, so the pieces of an edge do not have
+    // to stay joined along a horizontal line. This allows a crossing that rounds onto the
+    // horizontal line through an end point to move that end point sideways, instead of producing
+    // a horizontal piece.
+    std::vector<Edge> splitEdges;
+    splitEdges.reserve(edges->size() + splits.size());
+    bool changed = false;
+    auto cursor = splits.begin();
+    for (size_t i = 0; i < edges->size(); ++i) {
+        const Edge& e = (*edges)[i];
+        Point top = e.top,
+              bottom = e.bottom;
+        // The split points are sorted by (y, x), which is the order they appear along the edge.
+        for (; cursor != splits.end() && std::get<0>(*cursor) == i; ++cursor) {
+            const Point& p = std::get<1>(*cursor);
+            if (p.y == e.bottom.y) {
+                bottom = p;
+            } else if (top.y == p.y) {
+                top = p;
+            } else {
+                splitEdges.push_back({top, p, e.winding, e.operand});
+                top = p;
+            }
+        }
+        changed |= top != e.top || bottom != e.bottom;
+        splitEdges.push_back({top, bottom, e.winding, e.operand});
+    }
+    changed |= splitEdges.size() != edges->size();
+    *edges = std::move(splitEdges);
+    return changed;
+}
+
+// Split the edges at their crossings so that, except for round-off in the crossing points, edges
+// only meet at their end points. Returns false if the coordinates are out of range.
+bool split_edges_at_crossings(std::vector<Edge>* edges) {
+    if (edges->empty()) {
+        return true;
+    }
+
+    // All the differences between coordinates must fit in an int32_t. Crossing points lie within
+    // the bounds of their edges, so splitting keeps this true.
+    Point min = Point::Largest(),
+          max = Point::Smallest();
+    for (const Edge& e : *edges) {
+        min = {std::min({min.x, e.top.x, e.bottom.x}), std::min(min.y, e.top.y)};
+        max = {std::max({max.x, e.top.x, e.bottom.x}), std::max(max.y, e.bottom.y)};
+    }
+    if (Point::DifferenceTooBig(min, max)) {
+        return false;
+    }
+
+    // Rounding a crossing point moves the pieces of its edges slightly, which can make them cross
+    // an edge they only touched before, so repeat until no new crossings appear. Every pass
+    // shortens edges on a finite grid, so this settles quickly in practice.
+    static constexpr int kMaxPasses = 16;
+    for (int pass = 0; pass < kMaxPasses && split_edges_once(edges); ++pass) {}
+    return true;
+}
+
+// -- XIntercept -----------------------------------------------------------------------------------
+// The exact x value where an edge crosses a horizontal line, stored as the fraction num / den
+// with den > 0. Because the bounds of all the edges pass Point::DifferenceTooBig, num fits in 63
+// bits, and two intercepts can be compared exactly using Int96.
+struct XIntercept {
+    int64_t num;
+    int32_t den;
+};
+
+XIntercept x_intercept(const Edge& e, int32_t y) {
+    SkASSERT(e.top.y <= y && y <= e.bottom.y);
+    if (y == e.top.y) {
+        return {e.top.x, 1};
+    }
+    if (y == e.bottom.y) {
+        return {e.bottom.x, 1};
+    }
+    const int64_t dx = SkToS64(e.bottom.x) - SkToS64(e.top.x),
+                  dy = SkToS64(e.bottom.y) - SkToS64(e.top.y);
+    return {SkToS64(e.top.x) * dy + (SkToS64(y) - SkToS64(e.top.y)) * dx, SkToS32(dy)};
+}
+
+bool operator<(const XIntercept& a, const XIntercept& b) {
+    if (a.den == b.den) {
+        return a.num < b.num;
+    }
+    return multiply(a.num, b.den) < multiply(b.num, a.den);
+}
+
+bool operator==(const XIntercept& a, const XIntercept& b) {
+    if (a.den == b.den) {
+        return a.num == b.num;
+    }
+    return multiply(a.num, b.den) == multiply(b.num, a.den);
+}
+
+// -- Vertex ---------------------------------------------------------------------------------------
+struct Vertex {
+    XIntercept x;
+    int32_t y;
+
+    friend bool operator<(const Vertex& v0, const Vertex& v1) {
+        if (v0.y != v1.y) {
+            return v0.y < v1.y;
+        }
+        return v0.x < v1.x;
+    }
+
+    friend bool operator==(const Vertex& v0, const Vertex& v1) {
+        return v0.y == v1.y && v0.x == v1.x;
+    }
+
+    SkPoint toSkPoint() const {
+        constexpr double kInvScale = 1.0 / contour::Contours::kScaleFactor;
+        return {static_cast<float>(static_cast<double>(x.num) / x.den * kInvScale),
+                static_cast<float>(y * kInvScale)};
+    }
+};
+
+struct DirectedSegment {
+    Vertex from;
+    Vertex to;
+};
+
+bool is_inside(int32_t winding, SkPathFillType fillType) {
+    const bool inside = SkPathFillType_IsEvenOdd(fillType) ? (winding & 1) != 0 : winding != 0;
+    return SkPathFillType_IsInverse(fillType) ? !inside : inside;
+}
+
+bool apply(BooleanOp op, bool one, bool two) {
+    switch (op) {
+        case BooleanOp::kDifference:        return one && !two;
+        case BooleanOp::kIntersect:         return one && two;
+        case BooleanOp::kUnion:             return one || two;
+        case BooleanOp::kXOR:               return one != two;
+        case BooleanOp::kReverseDifference: return !one && two;
+    }
+    SkUNREACHABLE;
+}
+
+// -- BooleanSweep ---------------------------------------------------------------------------------
+// BooleanSweep sweeps a horizontal line down through the edges, stopping at every y where an edge
+// starts or ends. Between two stops no edges start or end, and, because the edges were split at
+// their crossings, the edges keep their left to right order. In each of these slabs the winding
+// numbers of both paths are accumulated from left to right to find the edges where the result
+// changes from outside to inside. These boundary edges are joined vertically into runs, and the
+// horizontal parts of the boundary are found on each stop by comparing the boundaries in the
+// slabs above and below it.
+class BooleanSweep {
+public:
+    BooleanSweep(std::vector<Edge> edges,
+                 SkPathFillType fillType0,
+                 SkPathFillType fillType1,
+                 BooleanOp op)
+            : fEdges{std::move(edges)}
+            , fFillTypes{fillType0, fillType1}
+            , fOp{op}
+            , fOutputInverse{apply(op,
+                                   SkPathFillType_IsInverse(fillType0),
+                                   SkPathFillType_IsInverse(fillType1))}
+            , fRuns(fEdges.size()) {}
+
+    SkPath run();
+
+private:
+    struct ActiveEdge {
+        uint32_t edge;
+        XIntercept top;
+        XIntercept bottom;
+    };
+
+    // An edge that separates the inside of the result from the outside in a slab.
+    struct Boundary {
+        uint32_t edge;
+        bool insideOnRight;
+    };
+
+    // A section of an edge that is a boundary in consecutive slabs.
+    struct Run {
+        int32_t top;
+        int32_t bottom;
+        bool insideOnRight;
+        bool open = false;
+    };
+
+    bool isInside(const int32_t winding[2]) const {
+        // If the result is unbounded, build its complement so that the sweep always starts and
+        // ends outside.
+        return apply(fOp, is_inside(winding[0], fFillTypes[0]),
+                          is_inside(winding[1], fFillTypes[1])) != fOutputInverse;
+    }
+
+    void sortActiveEdges(int32_t top, int32_t bottom);
+    void findBoundaries(std::vector<Boundary>* boundaries) const;
+    void updateRuns(int32_t top, int32_t bottom,
+                    const std::vector<Boundary>& above, const std::vector<Boundary>& below);
+    void closeRun(uint32_t edge);
+    void addHorizontals(int32_t y,
+                        const std::vector<Boundary>& above, const std::vector<Boundary>& below);
+    SkPath assembleContours() const;
+
+    const std::vector<Edge> fEdges;
+    const SkPathFillType fFillTypes[2];
+    const BooleanOp fOp;
+    const bool fOutputInverse;
+
+    std::vector<ActiveEdge> fActive;
+    std::vector<Run> fRuns;
+    std::vector<DirectedSegment> fSegments;
+};
+
+SkPath BooleanSweep::run() {
+    std::vector<uint32_t> byTop(fEdges.size());
+    std::vector<int32_t> stops;
+    stops.reserve(2 * fEdges.size());
+    for (uint32_t i = 0; i < fEdges.size(); ++i) {
+        byTop[i] = i;
+        stops.push_back(fEdges[i].top.y);
+        stops.push_back(fEdges[i].bottom.y);
+    }
+    std::sort(byTop.begin(), byTop.end(), [&](uint32_t a, uint32_t b) {
+        return fEdges[a].top.y < fEdges[b].top.y;
+    });
+    std::sort(stops.begin(), stops.end());
+    stops.erase(std::unique(stops.begin(), stops.end()), stops.end());
+
+    auto nextEdge = byTop.begin();
+    std::vector<Boundary> above, below;
+    for (size_t i = 0; i < stops.size(); ++i) {
+        const int32_t y = stops[i];
+
+        // Remove the edges that end at this stop, and add the edges that start here.
+        fActive.erase(std::remove_if(fActive.begin(), fActive.end(),
+                                     [&](const ActiveEdge& a) {
+                                         return fEdges[a.edge].bottom.y <= y;
+                                     }),
+                      fActive.end());
+        for (; nextEdge != byTop.end() && fEdges[*nextEdge].top.y == y; ++nextEdge) {
+            fActive.push_back({*nextEdge, {}, {}});
+        }
+
+        below.clear();
+        int32_t nextY = y;
+        if (i + 1 < stops.size()) {
+            nextY = stops[i + 1];
+            this->sortActiveEdges(y, nextY);
+            this->findBoundaries(&below);
+        }
+
+        this->addHorizontals(y, above, below);
+        this->updateRuns(y, nextY, above, below);
+        std::swap(above, below);
+    }
+    SkASSERT(fActive.empty() || stops.size() <= 1);
+
+    return this->assembleContours();
+}
+
+void BooleanSweep::sortActiveEdges(int32_t top, int32_t bottom) {
+    for (ActiveEdge& a : fActive) {
+        a.top = x_intercept(fEdges[a.edge], top);
+        a.bottom = x_intercept(fEdges[a.edge], bottom);
+    }
+
+    // The order from the previous slab is still correct for the edges that were already active,
+    // so an insertion sort only has to place the new edges. Ordering by the top intercept, then
+    // the bottom intercept, also produces a consistent order for any crossings left by rounding.
+    auto less = [](const ActiveEdge& a, const ActiveEdge& b) {
+        if (a.top == b.top) {
+            return a.bottom < b.bottom;
+        }
+        return a.top < b.top;
+    };
+    for (auto cursor = fActive.begin(); cursor != fActive.end(); ++cursor) {
+        const ActiveEdge a = *cursor;
+        auto hole = cursor;
+        for (; hole != fActive.begin() && less(a, *(hole - 1)); --hole) {
+            *hole = *(hole - 1);
+        }
+        *hole = a;
+    }
+}
+
+void BooleanSweep::findBoundaries(std::vector<Boundary>* boundaries) const {
+    int32_t winding[2] = {0, 0};
+    bool inside = false;
+    for (auto cursor = fActive.begin(); cursor != fActive.end();) {
+        // Coincident edges are a single boundary in this slab.
+        const ActiveEdge& first = *cursor;
+        for (; cursor != fActive.end() &&
+               cursor->top == first.top && cursor->bottom == first.bottom; ++cursor) {
+            const Edge& e = fEdges[cursor->edge];
+            winding[e.operand] += e.winding;
+        }
+
+        const bool insideOnRight = this->isInside(winding);
+        if (insideOnRight != inside) {
+            boundaries->push_back({first.edge, insideOnRight});
+            inside = insideOnRight;
+        }
+    }
+    SkASSERT(!inside);
+}
+
+void BooleanSweep::updateRuns(int32_t top, int32_t bottom,
+                              const std::vector<Boundary>& above,
+                              const std::vector<Boundary>& below) {
+    for (const Boundary& b : below) {
+        Run& run = fRuns[b.edge];
+        if (run.open && run.bottom == top && run.insideOnRight == b.insideOnRight) {
+            run.bottom = bottom;
+        } else {
+            if (run.open) {
+                this->closeRun(b.edge);
+            }
+            run = {top, bottom, b.insideOnRight, true};
+        }
+    }
+
+    // Close the runs from the slab above that did not continue into the slab below.
+    for (const Boundary& b : above) {
+        const Run& run = fRuns[b.edge];
+        if (run.open && run.bottom == top) {
+            this->closeRun(b.edge);
+        }
+    }
+}
+
+void BooleanSweep::closeRun(uint32_t edge) {
+    Run& run = fRuns[edge];
+    SkASSERT(run.open);
+    const Edge& e = fEdges[edge];
+    const Vertex top = {x_intercept(e, run.top), run.top},
+                 bottom = {x_intercept(e, run.bottom), run.bottom};
+
+    // Keep the inside of the result on the right when looking along the segment. Because y
+    // increases going down, a segment with the inside on its right heads up the page.
+    if (run.insideOnRight) {
+        fSegments.push_back({bottom, top});
+    } else {
+        fSegments.push_back({top, bottom});
+    }
+    run.open = false;
+}
+
+void BooleanSweep::addHorizontals(int32_t y,
+                                  const std::vector<Boundary>& above,
+                                  const std::vector<Boundary>& below) {
+    if (above.empty() && below.empty()) {
+        return;
+    }
+
+    // The result is on the horizontal line at y if it is inside the slab above or the slab
+    // below, but not both. Each boundary crossing y toggles the inside state of its slab.
+    std::vector<std::tuple<XIntercept, bool>> crossings;
+    crossings.reserve(above.size() + below.size());
+    for (const Boundary& b : above) {
+        crossings.emplace_back(x_intercept(fEdges[b.edge], y), false);
+    }
+    for (const Boundary& b : below) {
+        crossings.emplace_back(x_intercept(fEdges[b.edge], y), true);
+    }
+    std::stable_sort(crossings.begin(), crossings.end(), [](const auto& a, const auto& b) {
+        return std::get<0>(a) < std::get<0>(b);
+    });
+
+    bool insideAbove = false,
+         insideBelow = false;
+    // The start of the horizontal segment being built and whether the inside is below it.
+    std::optional<std::tuple<XIntercept, bool>> start;
+    auto finishSegment = [&](const XIntercept& end) {
+        if (start) {
+            const auto [x, insideIsBelow] = *start;
+            // Keep the inside on the right; it is on the right of a left to right segment if
+            // it is below.
+            if (insideIsBelow) {
+                fSegments.push_back({{x, y}, {end, y}});
+            } else {
+                fSegments.push_back({{end, y}, {x, y}});
+            }
+            start.reset();
+        }
+    };
+
+    for (size_t i = 0; i < crossings.size(); ++i) {
+        const auto& [x, isBelow] = crossings[i];
+        bool& inside = isBelow ? insideBelow : insideAbove;
+        inside = !inside;
+
+        // Wait until all the crossings at x are processed.
+        if (i + 1 < crossings.size() && std::get<0>(crossings[i + 1]) == x) {
+            continue;
+        }
+
+        const bool onBoundary = insideAbove != insideBelow;
+        if (start && (!onBoundary || std::get<1>(*start) != insideBelow)) {
+            finishSegment(x);
+        }
+        if (onBoundary && !start) {
+            start = std::make_tuple(x, insideBelow);
+        }
+    }
+    SkASSERT(!start);
+}
+
+SkPath BooleanSweep::assembleContours() const {
+    SkPathBuilder builder{fOutputInverse ? SkPathFillType::kInverseWinding
+                                         : SkPathFillType::kWinding};
+
+    // Every vertex has as many incoming as outgoing segments, so following unused segments from
+    // vertex to vertex always leads back to the starting vertex.
+    std::map<Vertex, std::vector<size_t>> outgoing;
+    for (size_t i = 0; i < fSegments.size(); ++i) {
+        outgoing[fSegments[i].from].push_back(i);
+    }
+
+    std::vector<bool> used(fSegments.size(), false);
+    auto nextUnused = [&](const Vertex& v) -> std::optional<size_t> {
+        auto found = outgoing.find(v);
+        if (found == outgoing.end()) {
+            return std::nullopt;
+        }
+        std::vector<size_t>& candidates = found->second;
+        while (!candidates.empty()) {
+            const size_t candidate = candidates.back();
+            candidates.pop_back();
+            if (!used[candidate]) {
+                return candidate;
+            }
+        }
+        return std::nullopt;
+    };
+
+    for (size_t i = 0; i < fSegments.size(); ++i) {
+        if (used[i]) {
+            continue;
+        }
+        const Vertex start = fSegments[i].from;
+        builder.moveTo(start.toSkPoint());
+        std::optional<size_t> current = i;
+        while (current) {
+            used[*current] = true;
+            const Vertex& to = fSegments[*current].to;
+            if (to == start) {
+                break;
+            }
+            builder.lineTo(to.toSkPoint());
+            current = nextUnused(to);
+        }
+        builder.close();
+    }
+
+    return builder.detach();
+}
+}  // namespace
+
+std::optional<SkPath> boolean_op(const SkPath& one, const SkPath& two, BooleanOp op) {
+    std::vector<Edge> edges;
+    add_edges(contour::Contours::Make(one), 0, &edges);
+    add_edges(contour::Contours::Make(two), 1, &edges);
+
+    if (!split_edges_at_crossings(&edges)) {
+        return std::nullopt;
+    }
+
+    BooleanSweep sweep{std::move(edges), one.getFillType(), two.getFillType(), op};
+    return sweep.run();
+}
+
+std::optional<SkPath> simplify(const SkPath& path) {
+    return boolean_op(path, SkPath{}, BooleanOp::kUnion);
+}
+}  // namespace bentleyottmann
@@ -8,8 +8,10 @@
 #include "include/private/base/SkPoint_impl.h"
 #include "include/private/base/SkTo.h"
 #include "modules/bentleyottmann/include/Myers.h"
+#include "src/core/SkGeometry.h"
 
 #include <algorithm>
+#include <cmath>
 #include <vector>
 
 namespace contour {
@@ -21,7 +23,12 @@ Contours Contours::Make(SkPath path) {
     while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
         switch (verb) {
             case SkPath::kConic_Verb: {
-                SK_ABORT("Not implemented");
+                SkAutoConicToQuads quadder;
+                const SkPoint* quadPts =
+                        quadder.computeQuads(pts, iter.conicWeight(), kFlatteningTolerance);
+                for (int i = 0; i < quadder.countQuads(); ++i) {
+                    contours.addQuadToCurrentContour(&quadPts[2 * i]);
+                }
                 break;
             }
             case SkPath::kMove_Verb:
@@ -33,11 +40,11 @@ Contours Contours::Make(SkPath path) {
                 break;
             }
             case SkPath::kQuad_Verb: {
-                SK_ABORT("Not implemented");
+                contours.addQuadToCurrentContour(pts);
                 break;
             }
             case SkPath::kCubic_Verb: {
-                SK_ABORT("Not implemented");
+                contours.addCubicToCurrentContour(pts);
                 break;
             }
             case SkPath::kClose_Verb: {
@@ -56,7 +63,56 @@ Contours Contours::Make(SkPath path) {
 }
 
 std::vector<myers::Segment> Contours::segments() const {
-    SK_ABORT("Not implemented");
+    std::vector<myers::Segment> segments;
+    segments.reserve(fPoints.size());
+    for (const Contour& contour : *this) {
+        // Every contour is implicitly closed, so start with the edge from the last point back
+        // to the first.
+        Point p0 = contour.points.back();
+        for (const Point& p1 : contour.points) {
+            // Skip degenerate edges; a Segment must have two distinct points.
+            if (p0.x != p1.x || p0.y != p1.y) {
+                segments.emplace_back(myers::Point{p0.x, p0.y}, myers::Point{p1.x, p1.y});
+            }
+            p0 = p1;
+        }
+    }
+    return segments;
+}
+
+// Wang's formula gives the number of uniform steps in t needed to keep a polynomial Bézier curve
+// of degree n within tolerance of its chords:
+//    steps = ⌈√(n(n - 1) / 8 · max|Pᵢ - 2Pᵢ₊₁ + Pᵢ₊₂| / tolerance)⌉
+static int wangs_formula_steps(float degreeFactor, float maxSecondDifference) {
+    // Bound the number of steps so that huge curves do not explode the number of segments.
+    static constexpr int kMaxSteps = 1024;
+    const float steps = std::ceil(
+            std::sqrt(degreeFactor * maxSecondDifference / Contours::kFlatteningTolerance));
+    // Written so that a NaN or infinite step count also takes the maximum.
+    if (!(steps < kMaxSteps)) {
+        return kMaxSteps;
+    }
+    return std::max(1, static_cast<int>(steps));
+}
+
+void Contours::addQuadToCurrentContour(const SkPoint pts[3]) {
+    const int steps = wangs_formula_steps(2.f / 8.f, (pts[0] - pts[1] * 2 + pts[2]).length());
+    for (int i = 1; i < steps; ++i) {
+        this->addPointToCurrentContour(SkEvalQuadAt(pts, static_cast<float>(i) / steps));
+    }
+    this->addPointToCurrentContour(pts[2]);
+}
+
+void Contours::addCubicToCurrentContour(const SkPoint pts[4]) {
+    const float maxSecondDifference = std::max((pts[0] - pts[1] * 2 + pts[2]).length(),
+                                               (pts[1] - pts[2] * 2 + pts[3]).length());
+    const int steps = wangs_formula_steps(6.f / 8.f, maxSecondDifference);
+    for (int i = 1; i < steps; ++i) {
+        SkPoint p;
+        SkEvalCubicAt(pts, static_cast<float>(i) / steps, &p, nullptr, nullptr);
+        this->addPointToCurrentContour(p);
+    }
+    this->addPointToCurrentContour(pts[3]);
 }
 
 static SkIRect extend_rect(SkIRect r, Point p) {
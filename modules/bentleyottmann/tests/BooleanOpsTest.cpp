@@ -0,0 +1,203 @@
+// Copyright 2024 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "modules/bentleyottmann/include/BooleanOps.h"
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPathBuilder.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRect.h"
+#include "include/private/base/SkTPin.h"
+#include "src/base/SkRandom.h"
+#include "tests/Test.h"
+
+#include <initializer_list>
+#include <optional>
+
+using namespace bentleyottmann;
+
+static bool apply_op(BooleanOp op, bool one, bool two) {
+    switch (op) {
+        case BooleanOp::kDifference:        return one && !two;
+        case BooleanOp::kIntersect:         return one && two;
+        case BooleanOp::kUnion:             return one || two;
+        case BooleanOp::kXOR:               return one != two;
+        case BooleanOp::kReverseDifference: return !one && two;
+    }
+    return false;
+}
+
+// Return true if p is within tolerance of one of the lines of path.
+static bool is_near_edge(const SkPath& path, SkPoint p, float tolerance) {
+    SkPath::Iter iter(path, /*forceClose=*/true);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        if (verb != SkPath::kLine_Verb) {
+            continue;
+        }
+        const SkVector edge = pts[1] - pts[0],
+                       toP = p - pts[0];
+        const float t = SkTPin(toP.dot(edge) / edge.dot(edge), 0.f, 1.f);
+        if (SkPoint::Distance(p, pts[0] + edge * t) <= tolerance) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Check the result against the inputs on a grid of points. Crossing points are rounded to
+// 1/1024, so points that are very close to the edges of the inputs are skipped.
+static void check_op(skiatest::Reporter* r,
+                     const SkPath& one, const SkPath& two, BooleanOp op, const char* name) {
+    std::optional<SkPath> result = boolean_op(one, two, op);
+    REPORTER_ASSERT(r, result.has_value(), "%s", name);
+    if (!result) {
+        return;
+    }
+
+    static constexpr float kTolerance = 1.f / 256;
+    SkRect bounds = one.getBounds();
+    bounds.join(two.getBounds());
+    bounds.outset(2, 2);
+    int mismatches = 0;
+    for (float y = bounds.top() + 0.375f; y < bounds.bottom(); y += 0.5f) {
+        for (float x = bounds.left() + 0.3125f; x < bounds.right(); x += 0.5f) {
+            const bool expected = apply_op(op, one.contains(x, y), two.contains(x, y));
+            if (result->contains(x, y) != expected &&
+                !is_near_edge(one, {x, y}, kTolerance) &&
+                !is_near_edge(two, {x, y}, kTolerance)) {
+                ++mismatches;
+            }
+        }
+    }
+    REPORTER_ASSERT(r, mismatches == 0, "%s: %d mismatches", name, mismatches);
+}
+
+static void check_all_ops(skiatest::Reporter* r, const SkPath& one, const SkPath& two) {
+    check_op(r, one, two, BooleanOp::kDifference, "difference");
+    check_op(r, one, two, BooleanOp::kIntersect, "intersect");
+    check_op(r, one, two, BooleanOp::kUnion, "union");
+    check_op(r, one, two, BooleanOp::kXOR, "xor");
+    check_op(r, one, two, BooleanOp::kReverseDifference, "reverse difference");
+}
+
+DEF_TEST(BO_boolean_op_Rects, r) {
+    {
+        // Overlapping.
+        SkPath one = SkPath::Rect(SkRect::MakeLTRB(0, 0, 10, 10)),
+               two = SkPath::Rect(SkRect::MakeLTRB(5, 5, 15, 15));
+        check_all_ops(r, one, two);
+
+        std::optional<SkPath> result = boolean_op(one, two, BooleanOp::kIntersect);
+        REPORTER_ASSERT(r, result && result->getBounds() == SkRect::MakeLTRB(5, 5, 10, 10));
+    }
+    {
+        // Disjoint.
+        SkPath one = SkPath::Rect(SkRect::MakeLTRB(0, 0, 10, 10)),
+               two = SkPath::Rect(SkRect::MakeLTRB(20, 0, 30, 10));
+        check_all_ops(r, one, two);
+
+        std::optional<SkPath> result = boolean_op(one, two, BooleanOp::kIntersect);
+        REPORTER_ASSERT(r, result && result->isEmpty());
+    }
+    {
+        // Sharing an edge, and opposite directions.
+        SkPath one = SkPath::Rect(SkRect::MakeLTRB(0, 0, 10, 10)),
+               two = SkPath::Rect(SkRect::MakeLTRB(10, 2, 20, 8), SkPathDirection::kCCW);
+        check_all_ops(r, one, two);
+    }
+    {
+        // Touching at a corner.
+        SkPath one = SkPath::Rect(SkRect::MakeLTRB(0, 0, 10, 10)),
+               two = SkPath::Rect(SkRect::MakeLTRB(10, 10, 20, 20));
+        check_all_ops(r, one, two);
+    }
+    {
+        // Nested.
+        SkPath one = SkPath::Rect(SkRect::MakeLTRB(0, 0, 20, 20)),
+               two = SkPath::Rect(SkRect::MakeLTRB(5, 5, 15, 15));
+        check_all_ops(r, one, two);
+    }
+}
+
+DEF_TEST(BO_boolean_op_CrossingPolygons, r) {
+    SkPathBuilder star;
+    star.moveTo(10, 0);
+    star.lineTo(16, 20);
+    star.lineTo(0, 7);
+    star.lineTo(20, 7);
+    star.lineTo(4, 20);
+    star.close();
+
+    SkPath windingStar = star.snapshot();
+    SkPath evenOddStar = star.snapshot();
+    evenOddStar.setFillType(SkPathFillType::kEvenOdd);
+
+    SkPath triangle = SkPathBuilder{}.moveTo(-3, 10).lineTo(23, 3).lineTo(12, 18).close().detach();
+
+    check_all_ops(r, windingStar, triangle);
+    check_all_ops(r, evenOddStar, triangle);
+    check_all_ops(r, triangle, evenOddStar);
+
+    SkPath inverseTriangle = triangle;
+    inverseTriangle.setFillType(SkPathFillType::kInverseWinding);
+    check_all_ops(r, windingStar, inverseTriangle);
+
+    std::optional<SkPath> result = boolean_op(windingStar, inverseTriangle, BooleanOp::kUnion);
+    REPORTER_ASSERT(r, result && result->isInverseFillType());
+}
+
+DEF_TEST(BO_boolean_op_Curves, r) {
+    SkPath one = SkPath::Circle(10, 10, 8),
+           two = SkPath::RRect(SkRRect::MakeRectXY(SkRect::MakeLTRB(6, 2, 26, 14), 3, 3));
+
+    for (BooleanOp op : {BooleanOp::kDifference, BooleanOp::kIntersect, BooleanOp::kUnion,
+                         BooleanOp::kXOR, BooleanOp::kReverseDifference}) {
+        std::optional<SkPath> result = boolean_op(one, two, op);
+        REPORTER_ASSERT(r, result.has_value());
+        if (!result) {
+            continue;
+        }
+        // The curves are flattened, so only check points well away from the edges.
+        for (SkPoint p : {SkPoint{10, 10}, SkPoint{20, 8}, SkPoint{10, 16}, SkPoint{4, 4}}) {
+            const bool inOne = one.contains(p.x(), p.y()),
+                       inTwo = two.contains(p.x(), p.y());
+            REPORTER_ASSERT(r, result->contains(p.x(), p.y()) == apply_op(op, inOne, inTwo));
+        }
+    }
+}
+
+DEF_TEST(BO_boolean_op_RandomTriangles, r) {
+    SkRandom random;
+    for (int trial = 0; trial < 20; ++trial) {
+        SkPathBuilder one, two;
+        for (SkPathBuilder* builder : {&one, &two}) {
+            for (int triangle = 0; triangle < 5; ++triangle) {
+                builder->moveTo(random.nextRangeU(0, 40), random.nextRangeU(0, 40));
+                builder->lineTo(random.nextRangeU(0, 40), random.nextRangeU(0, 40));
+                builder->lineTo(random.nextRangeU(0, 40), random.nextRangeU(0, 40));
+                builder->close();
+            }
+        }
+        check_all_ops(r, one.detach(), two.detach());
+    }
+}
+
+DEF_TEST(BO_simplify_Basic, r) {
+    // A bow tie has two triangles meeting at the crossing point.
+    SkPath bowTie = SkPathBuilder{}.moveTo(0, 0).lineTo(10, 10).lineTo(10, 0).lineTo(0, 10)
+                                   .close().detach();
+    std::optional<SkPath> result = simplify(bowTie);
+    REPORTER_ASSERT(r, result.has_value());
+    if (result) {
+        REPORTER_ASSERT(r, result->getBounds() == SkRect::MakeLTRB(0, 0, 10, 10));
+        REPORTER_ASSERT(r, result->contains(2, 5));
+        REPORTER_ASSERT(r, result->contains(8, 5));
+        REPORTER_ASSERT(r, !result->contains(5, 2));
+        REPORTER_ASSERT(r, !result->contains(5, 8));
+    }
+
+    std::optional<SkPath> empty = simplify(SkPath{});
+    REPORTER_ASSERT(r, empty && empty->isEmpty());
+}
@@ -26,6 +26,7 @@
 #include <vector>
 
 class SkCanvas;
+class SkData;
 class SkStream;
 struct SkRect;
 
@@ -38,6 +39,8 @@ class RenderNode;
 
 namespace SkShapers { class Factory; }
 
+namespace skjson { class ObjectValue; }
+
 namespace skottie {
 
 namespace internal { class Animator; }
@@ -100,6 +103,8 @@ public:
                                          // frames are only resolved when needed, at seek() time.
             kPreferEmbeddedFonts = 0x02, // Attempt to use the embedded fonts (glyph paths,
                                          // normally used as fallback) over native Skia typefaces.
+            kRetainSource        = 0x04, // Keep the parsed animation, so Animation::makeCopy()
+                                         // can instantiate it again without parsing.
         };
 
         explicit Builder(uint32_t flags = 0);
@@ -169,6 +174,17 @@ public:
          */
         Builder& setTextShapingFactory(sk_sp<SkShapers::Factory>);
 
+        /**
+         * Enables caching the content of shape, text and precomp layers which stop changing:
+         * after a couple of frames without changes, a layer's content is drawn into an image
+         * (or recorded into a picture), and reused until the layer changes again.
+         * Image caches are redrawn when the layer scale changes.
+         *
+         * |bytes| is the memory budget for the animation caches (0 disables caching, which is
+         * the default).  Each copy of the animation (see Animation::makeCopy) has its own.
+         */
+        Builder& setLayerCacheBudget(size_t bytes);
+
         /**
          * Animation factories.
          */
@@ -176,12 +192,27 @@ public:
         sk_sp<Animation> make(const char* data, size_t length);
         sk_sp<Animation> makeFromFile(const char path[]);
 
+        /**
+         * Converts Lottie JSON to a compact binary form, which the factories above also accept
+         * and load without parsing any JSON.
+         *
+         * The binary form is meant for caching: it can only be loaded by builds with the same
+         * format version and pointer size, and should be regenerated from the JSON otherwise.
+         *
+         * @return The binary animation, or nullptr if the input is not a JSON object.
+         */
+        static sk_sp<SkData> Compile(const char* data, size_t length);
+
         /**
          * Get handle for SlotManager after animation is built.
          */
         const sk_sp<SlotManager>& getSlotManager() const {return fSlotManager;}
 
     private:
+        friend class Animation;
+
+        sk_sp<Animation> build(const skjson::ObjectValue&);
+
         const uint32_t          fFlags;
 
         sk_sp<ResourceProvider>   fResourceProvider;
@@ -193,6 +224,7 @@ public:
         sk_sp<ExpressionManager>  fExpressionManager;
         sk_sp<SkShapers::Factory> fShapingFactory;
         sk_sp<SlotManager>        fSlotManager;
+        size_t                    fLayerCacheBudget = 0;
         Stats                     fStats;
     };
 
@@ -232,6 +264,23 @@ public:
     void render(SkCanvas* canvas, const SkRect* dst = nullptr) const;
     void render(SkCanvas* canvas, const SkRect* dst, RenderFlags) const;
 
+    /**
+     * Draws only the parts of the current animation frame which changed since the frame
+     * previously drawn to the canvas (dirty-region rendering).
+     *
+     * The damaged areas are cleared to transparent and redrawn, and the rest of the canvas is
+     * left untouched.  Scene nodes outside of the damaged areas are skipped altogether.  This
+     * is meant for canvases backed by a retained buffer which holds the previous frame, drawn
+     * with the same dst and flags.
+     *
+     * @param canvas   destination canvas
+     * @param damage   the damage reported by the seek() calls made since the previous frame
+     * @param dst      optional destination rect
+     * @param flags    optional RenderFlags
+     */
+    void renderDamage(SkCanvas* canvas, const sksg::InvalidationController& damage,
+                      const SkRect* dst = nullptr, RenderFlags = 0) const;
+
     /**
      * [Deprecated: use one of the other versions.]
      *
@@ -285,7 +334,24 @@ public:
     const SkString& version() const { return fVersion; }
     const SkSize&      size() const { return fSize;    }
 
+    /**
+     * Returns a new instance of the animation, with its own scene state, so that the two can
+     * seek and render concurrently (e.g. to render different frames on different threads).
+     *
+     * The copy is built from the parsed animation kept by Builder::kRetainSource, and shares
+     * the original builder's resource provider, font manager, precomp interceptor, expression
+     * manager and shaping factory, which must be thread safe when copies are made or used
+     * concurrently.  Copies don't report to the original's logger or observers.
+     *
+     * Can be called from any thread.
+     *
+     * @return The copy, or nullptr if the animation was not built with kRetainSource.
+     */
+    sk_sp<Animation> makeCopy() const;
+
 private:
+    struct Source;
+
     enum Flags : uint32_t {
         kRequiresTopLevelIsolation = 1 << 0, // Needs to draw into a layer due to layer blending.
     };
@@ -295,6 +361,9 @@ private:
               SkString ver, const SkSize& size,
               double inPoint, double outPoint, double duration, double fps, uint32_t flags);
 
+    void render(SkCanvas*, const SkRect* dst, RenderFlags,
+                const sksg::InvalidationController* damage) const;
+
     const sk_sp<sksg::RenderNode>                fSceneRoot;
     const std::vector<sk_sp<internal::Animator>> fAnimators;
     const SkString                               fVersion;
@@ -304,6 +373,7 @@ private:
                                                  fDuration,
                                                  fFPS;
     const uint32_t                               fFlags;
+    sk_sp<const Source>                          fSource;
 
     using INHERITED = SkNVRefCnt<Animation>;
 };
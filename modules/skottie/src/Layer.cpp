@@ -25,6 +25,7 @@
 #include "modules/skottie/src/animator/Animator.h"
 #include "modules/skottie/src/effects/Effects.h"
 #include "modules/skottie/src/effects/MotionBlurEffect.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
 #include "modules/sksg/include/SkSGClipEffect.h"
 #include "modules/sksg/include/SkSGDraw.h"
 #include "modules/sksg/include/SkSGGeometryNode.h"
@@ -446,18 +447,20 @@ sk_sp<sksg::RenderNode> LayerBuilder::buildRenderTree(const AnimationBuilder& ab
     enum : uint32_t {
         kTransformEffects = 0x01, // The layer transform also applies to its effects.
         kForceSeek        = 0x02, // Dispatch all seek() events even when the layer is inactive.
+        kCacheContent     = 0x04, // The content is worth caching (when layer caching is enabled).
     };
 
     static constexpr struct {
         LayerBuilder                      fBuilder;
         uint32_t                          fFlags;
     } gLayerBuildInfo[] = {
-        { &AnimationBuilder::attachPrecompLayer, kTransformEffects },  // 'ty':  0 -> precomp
+        { &AnimationBuilder::attachPrecompLayer, kTransformEffects |
+                                                 kCacheContent     },  // 'ty':  0 -> precomp
         { &AnimationBuilder::attachSolidLayer  , kTransformEffects },  // 'ty':  1 -> solid
         { &AnimationBuilder::attachFootageLayer, kTransformEffects },  // 'ty':  2 -> image
         { &AnimationBuilder::attachNullLayer   ,                 0 },  // 'ty':  3 -> null
-        { &AnimationBuilder::attachShapeLayer  ,                 0 },  // 'ty':  4 -> shape
-        { &AnimationBuilder::attachTextLayer   ,                 0 },  // 'ty':  5 -> text
+        { &AnimationBuilder::attachShapeLayer  ,     kCacheContent },  // 'ty':  4 -> shape
+        { &AnimationBuilder::attachTextLayer   ,     kCacheContent },  // 'ty':  5 -> text
         { &AnimationBuilder::attachAudioLayer  ,        kForceSeek },  // 'ty':  6 -> audio
         { nullptr                              ,                 0 },  // 'ty':  7 -> pholderVideo
         { nullptr                              ,                 0 },  // 'ty':  8 -> imageSeq
@@ -483,7 +486,18 @@ sk_sp<sksg::RenderNode> LayerBuilder::buildRenderTree(const AnimationBuilder& ab
 
     // Build the layer content fragment.
     if (build_info.fBuilder) {
+        // Track whether the content blends with the layers underneath (precomp layers), in
+        // which case it cannot be cached on its own.
+        const bool had_nontrivial_blending = abuilder.fHasNontrivialBlending;
+        abuilder.fHasNontrivialBlending = false;
+
         layer = (abuilder.*(build_info.fBuilder))(fJlayer, &fInfo);
+
+        if ((build_info.fFlags & kCacheContent) && abuilder.fLayerCacheBudget &&
+            !abuilder.fHasNontrivialBlending) {
+            layer = sksg::CacheEffect::Make(std::move(layer), abuilder.fLayerCacheBudget);
+        }
+        abuilder.fHasNontrivialBlending |= had_nontrivial_blending;
     }
 
     // Clip layers with explicit dimensions.
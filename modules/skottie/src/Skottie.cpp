@@ -8,10 +8,12 @@
 #include "modules/skottie/include/Skottie.h"
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
 #include "include/core/SkData.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkRegion.h"
 #include "include/core/SkStream.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkFloatingPoint.h"
@@ -28,6 +30,8 @@
 #include "modules/skottie/src/Transform.h"  // IWYU pragma: keep
 #include "modules/skottie/src/animator/Animator.h"
 #include "modules/skottie/src/text/TextAdapter.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
 #include "modules/sksg/include/SkSGOpacityEffect.h"
 #include "modules/sksg/include/SkSGRenderNode.h"
 #include "modules/skshaper/include/SkShaper_factory.h"
@@ -39,6 +43,7 @@
 #include <chrono>
 #include <cmath>
 #include <cstdarg>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <functional>
@@ -166,6 +171,7 @@ AnimationBuilder::AnimationInfo AnimationBuilder::parse(const skjson::ObjectValu
     this->dispatchMarkers(jroot["markers"]);
 
     AutoScope ascope(this);
+    AutoKeyframeBatch akb(this);
     AutoPropertyTracker apt(this, jroot, PropertyObserver::NodeType::COMPOSITION);
 
     this->parseAssets(jroot["assets"]);
@@ -177,6 +183,10 @@ AnimationBuilder::AnimationInfo AnimationBuilder::parse(const skjson::ObjectValu
     auto animators = ascope.release();
     fStats->fAnimatorCount = animators.size();
 
+    if (auto batch = akb.release()) {
+        animators.insert(animators.begin(), std::move(batch));
+    }
+
     // Point the revalidator to our final root, and perform initial revalidation.
     fRevalidator->setRoot(root);
     fRevalidator->revalidate();
@@ -301,6 +311,17 @@ void AnimationBuilder::AutoPropertyTracker::updateContext(PropertyObserver* obse
 
 } // namespace internal
 
+// What kRetainSource animations keep for makeCopy(): the parsed animation, and the builder state
+// to instantiate it with.
+struct Animation::Source final : public SkNVRefCnt<Source> {
+    Source(std::unique_ptr<skjson::DOM> dom, Builder builder)
+        : fDOM(std::move(dom))
+        , fBuilder(std::move(builder)) {}
+
+    const std::unique_ptr<skjson::DOM> fDOM;
+    const Builder                      fBuilder;
+};
+
 Animation::Builder::Builder(uint32_t flags) : fFlags(flags) {}
 Animation::Builder::Builder(const Builder&) = default;
 Animation::Builder::Builder(Builder&&) = default;
@@ -346,6 +367,11 @@ Animation::Builder& Animation::Builder::setTextShapingFactory(sk_sp<SkShapers::F
     return *this;
 }
 
+Animation::Builder& Animation::Builder::setLayerCacheBudget(size_t bytes) {
+    fLayerCacheBudget = bytes;
+    return *this;
+}
+
 sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
     if (!stream->hasLength()) {
         // TODO: handle explicit buffering?
@@ -369,31 +395,61 @@ sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
 sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
-    // Sanitize factory args.
-    class NullResourceProvider final : public ResourceProvider {
-        sk_sp<SkData> load(const char[], const char[]) const override { return nullptr; }
-    };
-    auto resolvedProvider = fResourceProvider
-            ? fResourceProvider : sk_make_sp<NullResourceProvider>();
-
     fStats = Stats{};
 
     fStats.fJsonSize = data_len;
     const auto t0 = std::chrono::steady_clock::now();
 
-    const skjson::DOM dom(data, data_len);
-    if (!dom.root().is<skjson::ObjectValue>()) {
+    // Compiled animations (see Compile()) are loaded without parsing any JSON.
+    auto dom = skjson::DOM::IsBinary(data, data_len)
+            ? skjson::DOM::MakeFromBinary(data, data_len)
+            : std::make_unique<skjson::DOM>(data, data_len);
+    if (!dom || !dom->root().is<skjson::ObjectValue>()) {
         // TODO: more error info.
         if (fLogger) {
             fLogger->log(Logger::Level::kError, "Failed to parse JSON input.\n");
         }
         return nullptr;
     }
-    const auto& json = dom.root().as<skjson::ObjectValue>();
+    const auto& json = dom->root().as<skjson::ObjectValue>();
 
     const auto t1 = std::chrono::steady_clock::now();
     fStats.fJsonParseTimeMS = std::chrono::duration<float, std::milli>{t1-t0}.count();
 
+    // Copies share the resources, but not the observers (which build() consumes).
+    sk_sp<const Source> source;
+    if (fFlags & kRetainSource) {
+        Builder copyBuilder(fFlags);
+        copyBuilder.setResourceProvider(fResourceProvider)
+                   .setFontManager(fFontMgr)
+                   .setPrecompInterceptor(fPrecompInterceptor)
+                   .setExpressionManager(fExpressionManager)
+                   .setTextShapingFactory(fShapingFactory)
+                   .setLayerCacheBudget(fLayerCacheBudget);
+        source = sk_make_sp<Source>(std::move(dom), std::move(copyBuilder));
+    }
+
+    auto animation = this->build(json);
+    if (!animation) {
+        return nullptr;
+    }
+    animation->fSource = std::move(source);
+
+    const auto t2 = std::chrono::steady_clock::now();
+    fStats.fSceneParseTimeMS = std::chrono::duration<float, std::milli>{t2-t1}.count();
+    fStats.fTotalLoadTimeMS  = std::chrono::duration<float, std::milli>{t2-t0}.count();
+
+    return animation;
+}
+
+sk_sp<Animation> Animation::Builder::build(const skjson::ObjectValue& json) {
+    // Sanitize factory args.
+    class NullResourceProvider final : public ResourceProvider {
+        sk_sp<SkData> load(const char[], const char[]) const override { return nullptr; }
+    };
+    auto resolvedProvider = fResourceProvider
+            ? fResourceProvider : sk_make_sp<NullResourceProvider>();
+
     const auto version  = ParseDefault<SkString>(json["v"], SkString());
     const auto size     = SkSize::Make(ParseDefault<float>(json["w"], 0.0f),
                                        ParseDefault<float>(json["h"], 0.0f));
@@ -428,14 +484,13 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
                                        std::move(fExpressionManager),
                                        std::move(factory),
                                        &fStats, size, duration, fps, fFlags);
+    if (fLayerCacheBudget) {
+        builder.setLayerCacheBudget(sksg::CacheBudget::Make(fLayerCacheBudget));
+    }
     auto ainfo = builder.parse(json);
 
     fSlotManager = ainfo.fSlotManager;
 
-    const auto t2 = std::chrono::steady_clock::now();
-    fStats.fSceneParseTimeMS = std::chrono::duration<float, std::milli>{t2-t1}.count();
-    fStats.fTotalLoadTimeMS  = std::chrono::duration<float, std::milli>{t2-t0}.count();
-
     if (!ainfo.fSceneRoot && fLogger) {
         fLogger->log(Logger::Level::kError, "Could not parse animation.\n");
     }
@@ -456,6 +511,18 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
                                           flags));
 }
 
+sk_sp<SkData> Animation::Builder::Compile(const char* data, size_t data_len) {
+    const skjson::DOM dom(data, data_len);
+    if (!dom.root().is<skjson::ObjectValue>()) {
+        return nullptr;
+    }
+
+    SkDynamicMemoryWStream stream;
+    dom.writeBinary(&stream);
+
+    return stream.detachAsData();
+}
+
 sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
     const auto data = SkData::MakeFromFileName(path);
 
@@ -479,11 +546,39 @@ Animation::Animation(sk_sp<sksg::RenderNode> scene_root,
 
 Animation::~Animation() = default;
 
+sk_sp<Animation> Animation::makeCopy() const {
+    if (!fSource) {
+        return nullptr;
+    }
+
+    Builder builder(fSource->fBuilder);
+    auto copy = builder.build(fSource->fDOM->root().as<skjson::ObjectValue>());
+    if (copy) {
+        copy->fSource = fSource;
+    }
+
+    return copy;
+}
+
 void Animation::render(SkCanvas* canvas, const SkRect* dstR) const {
     this->render(canvas, dstR, 0);
 }
 
 void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderFlags) const {
+    this->render(canvas, dstR, renderFlags, nullptr);
+}
+
+void Animation::renderDamage(SkCanvas* canvas, const sksg::InvalidationController& damage,
+                             const SkRect* dstR, RenderFlags renderFlags) const {
+    if (damage.bounds().isEmpty()) {
+        return;
+    }
+
+    this->render(canvas, dstR, renderFlags, &damage);
+}
+
+void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderFlags,
+                       const sksg::InvalidationController* damage) const {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
     if (!fSceneRoot)
@@ -496,10 +591,36 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderF
         canvas->concat(SkMatrix::RectToRect(srcR, *dstR, SkMatrix::kCenter_ScaleToFit));
     }
 
+    if (damage) {
+        // Damage is tracked in animation coordinates.  Clip to the device pixels it touches
+        // (rounding out also covers the antialiased edges drawn there).
+        const auto ctm = canvas->getTotalMatrix();
+        SkRegion damage_region;
+        for (const auto& rect : *damage) {
+            damage_region.op(ctm.mapRect(rect).roundOut(), SkRegion::kUnion_Op);
+        }
+
+        // Complex clips slow rasterization down, so only clip to the exact region when it
+        // spares enough of its bounds.
+        int64_t damage_area = 0;
+        for (SkRegion::Iterator it(damage_region); !it.done(); it.next()) {
+            damage_area += it.rect().width64() * it.rect().height64();
+        }
+        const auto& damage_bounds = damage_region.getBounds();
+        if (damage_area * 2 >= damage_bounds.width64() * damage_bounds.height64()) {
+            damage_region.setRect(damage_bounds);
+        }
+        canvas->clipRegion(damage_region);
+    }
+
     if (!(renderFlags & RenderFlag::kDisableTopLevelClipping)) {
         canvas->clipRect(srcR);
     }
 
+    if (damage) {
+        canvas->clear(SK_ColorTRANSPARENT);
+    }
+
     if ((fFlags & Flags::kRequiresTopLevelIsolation) &&
         !(renderFlags & RenderFlag::kSkipTopLevelIsolation)) {
         // The animation uses non-trivial blending, and needs
@@ -507,7 +628,11 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderF
         canvas->saveLayer(srcR, nullptr);
     }
 
-    fSceneRoot->render(canvas);
+    if (damage) {
+        fSceneRoot->renderCulled(canvas);
+    } else {
+        fSceneRoot->render(canvas);
+    }
 }
 
 void Animation::seekFrame(double t, sksg::InvalidationController* ic) {
@@ -19,7 +19,9 @@
 #include "modules/skottie/include/SkottieProperty.h"
 #include "modules/skottie/include/SlotManager.h"
 #include "modules/skottie/src/animator/Animator.h"
+#include "modules/skottie/src/animator/KeyframeBatch.h"
 #include "modules/skottie/src/text/Font.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
 #include "src/base/SkUTF.h"
 #include "src/core/SkTHash.h"
 
@@ -109,6 +111,11 @@ public:
 
     bool hasNontrivialBlending() const { return fHasNontrivialBlending; }
 
+    // Shared by the layer content caches (see Animation::Builder::setLayerCacheBudget).
+    void setLayerCacheBudget(sk_sp<sksg::CacheBudget> budget) {
+        fLayerCacheBudget = std::move(budget);
+    }
+
     class AutoScope final {
     public:
         explicit AutoScope(const AnimationBuilder* builder) : AutoScope(builder, AnimatorScope()) {}
@@ -135,6 +142,33 @@ public:
         AnimatorScope*          fPrevScope;
     };
 
+    // Keyframe animators bound while an AutoKeyframeBatch is active are evaluated together, by a
+    // KeyframeBatch which must be seeked ahead of them (with the same t).
+    class AutoKeyframeBatch final {
+    public:
+        explicit AutoKeyframeBatch(const AnimationBuilder* builder)
+            : fBuilder(builder)
+            , fBatch(sk_make_sp<KeyframeBatch>())
+            , fPrevBatch(fBuilder->fCurrentKeyframeBatch) {
+            fBuilder->fCurrentKeyframeBatch = fBatch.get();
+        }
+
+        // Returns the batch, or null when no keyframe animators were bound.
+        sk_sp<Animator> release() {
+            fBuilder->fCurrentKeyframeBatch = fPrevBatch;
+            SkDEBUGCODE(fBuilder = nullptr);
+
+            return fBatch->empty() ? nullptr : std::move(fBatch);
+        }
+
+        ~AutoKeyframeBatch() { SkASSERT(!fBuilder); }
+
+    private:
+        const AnimationBuilder* fBuilder;
+        sk_sp<KeyframeBatch>    fBatch;
+        KeyframeBatch*          fPrevBatch;
+    };
+
     template <typename T>
     void attachDiscardableAdapter(sk_sp<T> adapter) const {
         if (adapter->isStatic()) {
@@ -249,12 +283,14 @@ private:
     sk_sp<SkShapers::Factory>    fShapingFactory;
     sk_sp<SceneGraphRevalidator> fRevalidator;
     sk_sp<SlotManager>           fSlotManager;
+    sk_sp<sksg::CacheBudget>     fLayerCacheBudget;
     Animation::Builder::Stats*   fStats;
     const SkSize                 fCompSize;
     const float                  fDuration,
                                  fFrameRate;
     const uint32_t               fFlags;
     mutable AnimatorScope*       fCurrentAnimatorScope;
+    mutable KeyframeBatch*       fCurrentKeyframeBatch = nullptr;
     mutable const char*          fPropertyObserverContext = nullptr;
     mutable bool                 fHasNontrivialBlending : 1;
 
@@ -5,13 +5,25 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
 #include "modules/skottie/include/Skottie.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -269,3 +281,278 @@ DEF_TEST(Skottie_Layer_NoType, r) {
     // passes if we don't crash
     REPORTER_ASSERT(r, anim);
 }
+
+DEF_TEST(Skottie_Compiled, r) {
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 1,
+                 "ind": 0,
+                 "ip": 0,
+                 "op": 100,
+                 "ks": {
+                   "o": { "a": 1, "k": [ { "t": 0, "s": [0] }, { "t": 100, "s": [100] } ] },
+                   "p": { "a": 0, "k": [ 25, 25 ] }
+                 },
+                 "sw": 50,
+                 "sh": 50,
+                 "sc": "#ff8000"
+               }
+             ]
+           })";
+
+    const auto binary = Animation::Builder::Compile(json, strlen(json));
+    REPORTER_ASSERT(r, binary);
+    REPORTER_ASSERT(r, !Animation::Builder::Compile("[]", 2));
+
+    const auto expected = Animation::Builder().make(json, strlen(json));
+    const auto actual = Animation::Builder().make(static_cast<const char*>(binary->data()),
+                                                  binary->size());
+    REPORTER_ASSERT(r, expected && actual);
+    REPORTER_ASSERT(r, actual->version()  == expected->version());
+    REPORTER_ASSERT(r, actual->size()     == expected->size());
+    REPORTER_ASSERT(r, actual->duration() == expected->duration());
+    REPORTER_ASSERT(r, actual->fps()      == expected->fps());
+
+    const auto info = SkImageInfo::MakeN32Premul(100, 100);
+    auto expectedSurface = SkSurfaces::Raster(info),
+         actualSurface   = SkSurfaces::Raster(info);
+    for (float t : {0.0f, 0.3f, 1.0f}) {
+        expected->seek(t);
+        actual->seek(t);
+        expectedSurface->getCanvas()->clear(SK_ColorWHITE);
+        actualSurface->getCanvas()->clear(SK_ColorWHITE);
+        expected->render(expectedSurface->getCanvas());
+        actual->render(actualSurface->getCanvas());
+
+        SkPixmap expectedPixels, actualPixels;
+        REPORTER_ASSERT(r, expectedSurface->peekPixels(&expectedPixels) &&
+                           actualSurface->peekPixels(&actualPixels));
+        REPORTER_ASSERT(r, !memcmp(expectedPixels.addr(), actualPixels.addr(),
+                                   expectedPixels.computeByteSize()), "t: %g", t);
+    }
+
+    // A truncated binary animation fails to load, like truncated JSON does.
+    REPORTER_ASSERT(r, !Animation::Builder().make(static_cast<const char*>(binary->data()),
+                                                  binary->size() - 8));
+}
+
+DEF_TEST(Skottie_Copy, r) {
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 1,
+                 "ind": 0,
+                 "ip": 0,
+                 "op": 100,
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [0, 0] }, { "t": 100, "s": [50, 50] } ] }
+                 },
+                 "sw": 50,
+                 "sh": 50,
+                 "sc": "#0080ff"
+               }
+             ]
+           })";
+
+    REPORTER_ASSERT(r, !Animation::Make(json, strlen(json))->makeCopy());
+
+    const auto animation = Animation::Builder(Animation::Builder::kRetainSource)
+                                   .make(json, strlen(json));
+    REPORTER_ASSERT(r, animation);
+    const auto copy = animation->makeCopy();
+    REPORTER_ASSERT(r, copy && copy != animation);
+    REPORTER_ASSERT(r, copy->size() == animation->size());
+    REPORTER_ASSERT(r, copy->duration() == animation->duration());
+    // Copies of copies work too.
+    REPORTER_ASSERT(r, copy->makeCopy());
+
+    const auto info = SkImageInfo::MakeN32Premul(100, 100);
+    auto render = [&](Animation* anim, double frame) {
+        auto surface = SkSurfaces::Raster(info);
+        anim->seekFrame(frame);
+        surface->getCanvas()->clear(SK_ColorWHITE);
+        anim->render(surface->getCanvas());
+        SkBitmap bitmap;
+        bitmap.allocPixels(info);
+        surface->readPixels(bitmap, 0, 0);
+        return bitmap;
+    };
+    auto same = [](const SkBitmap& a, const SkBitmap& b) {
+        return !memcmp(a.getPixels(), b.getPixels(), a.computeByteSize());
+    };
+
+    // The copies seek independently, so they can render different frames concurrently.
+    static constexpr double kFrames[] = {10, 50, 90};
+    SkBitmap expected[std::size(kFrames)], actual[std::size(kFrames)];
+    for (size_t i = 0; i < std::size(kFrames); ++i) {
+        expected[i] = render(animation.get(), kFrames[i]);
+    }
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < std::size(kFrames); ++i) {
+        threads.emplace_back([&, i] {
+            actual[i] = render(animation->makeCopy().get(), kFrames[i]);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < std::size(kFrames); ++i) {
+        REPORTER_ASSERT(r, same(expected[i], actual[i]), "frame %g", kFrames[i]);
+    }
+    REPORTER_ASSERT(r, !same(expected[0], expected[2]));
+}
+
+// Returns the largest per-channel difference between two N32 pixmaps of the same size.
+static int max_channel_diff(const SkPixmap& a, const SkPixmap& b) {
+    int maxDiff = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            const uint32_t pa = *a.addr32(x, y),
+                           pb = *b.addr32(x, y);
+            for (int shift : {0, 8, 16, 24}) {
+                maxDiff = std::max(maxDiff, std::abs(int((pa >> shift) & 0xff) -
+                                                     int((pb >> shift) & 0xff)));
+            }
+        }
+    }
+    return maxDiff;
+}
+
+DEF_TEST(Skottie_RenderDamage, r) {
+    // A static layer, and a moving layer which overlaps it in some frames.
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 1,
+                 "ind": 0,
+                 "ip": 0,
+                 "op": 100,
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [0, 0] }, { "t": 100, "s": [70, 30] } ] }
+                 },
+                 "sw": 30,
+                 "sh": 30,
+                 "sc": "#0080ff"
+               },
+               {
+                 "ty": 1,
+                 "ind": 1,
+                 "ip": 0,
+                 "op": 100,
+                 "ks": {
+                   "o": { "a": 0, "k": 50 },
+                   "p": { "a": 0, "k": [ 40, 40 ] }
+                 },
+                 "sw": 40,
+                 "sh": 40,
+                 "sc": "#ff8000"
+               }
+             ]
+           })";
+
+    const auto animation = Animation::Make(json, strlen(json));
+    REPORTER_ASSERT(r, animation);
+
+    const auto info = SkImageInfo::MakeN32Premul(100, 100);
+    auto expectedSurface = SkSurfaces::Raster(info),
+         actualSurface   = SkSurfaces::Raster(info);
+
+    animation->seekFrame(0);
+    actualSurface->getCanvas()->clear(SK_ColorTRANSPARENT);
+    animation->render(actualSurface->getCanvas());
+
+    for (double frame : {0.0, 3.0, 3.5, 50.0, 77.25, 100.0}) {
+        sksg::InvalidationController ic;
+        animation->seekFrame(frame, &ic);
+        animation->renderDamage(actualSurface->getCanvas(), ic);
+
+        expectedSurface->getCanvas()->clear(SK_ColorTRANSPARENT);
+        animation->render(expectedSurface->getCanvas());
+
+        // Clipping can shift the antialiased edge coverage by one bit.
+        SkPixmap expectedPixels, actualPixels;
+        REPORTER_ASSERT(r, expectedSurface->peekPixels(&expectedPixels) &&
+                           actualSurface->peekPixels(&actualPixels));
+        const int maxDiff = max_channel_diff(expectedPixels, actualPixels);
+        REPORTER_ASSERT(r, maxDiff <= 1, "frame: %g, max diff: %d", frame, maxDiff);
+    }
+}
+
+DEF_TEST(Skottie_LayerCache, r) {
+    // A shape layer which moves (the content is unchanged), then scales, then changes color.
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 4,
+                 "ind": 0,
+                 "ip": 0,
+                 "op": 100,
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [20, 20] }, { "t": 40, "s": [60, 60] } ] },
+                   "s": { "a": 1, "k": [ { "t": 50, "s": [100, 100] },
+                                         { "t": 60, "s": [150, 150] } ] }
+                 },
+                 "shapes": [
+                   { "ty": "rc", "s": { "a": 0, "k": [30, 30] }, "p": { "a": 0, "k": [0, 0] },
+                     "r": { "a": 0, "k": 0 } },
+                   { "ty": "fl", "o": { "a": 0, "k": 100 },
+                     "c": { "a": 1, "k": [ { "t": 70, "s": [1, 0, 0, 1] },
+                                           { "t": 80, "s": [0, 0, 1, 1] } ] } }
+                 ]
+               }
+             ]
+           })";
+
+    const auto expected = Animation::Make(json, strlen(json));
+    const auto actual = Animation::Builder().setLayerCacheBudget(1 << 20)
+                                            .make(json, strlen(json));
+    REPORTER_ASSERT(r, expected && actual);
+
+    const auto info = SkImageInfo::MakeN32Premul(100, 100);
+    auto expectedSurface = SkSurfaces::Raster(info),
+         actualSurface   = SkSurfaces::Raster(info);
+    for (int frame = 0; frame <= 100; ++frame) {
+        expected->seekFrame(frame);
+        actual->seekFrame(frame);
+        expectedSurface->getCanvas()->clear(SK_ColorWHITE);
+        actualSurface->getCanvas()->clear(SK_ColorWHITE);
+        expected->render(expectedSurface->getCanvas());
+        actual->render(actualSurface->getCanvas());
+
+        // Compositing the cached content can round differently.
+        SkPixmap expectedPixels, actualPixels;
+        REPORTER_ASSERT(r, expectedSurface->peekPixels(&expectedPixels) &&
+                           actualSurface->peekPixels(&actualPixels));
+        const int maxDiff = max_channel_diff(expectedPixels, actualPixels);
+        REPORTER_ASSERT(r, maxDiff <= 1, "frame: %d, max diff: %d", frame, maxDiff);
+    }
+}
@@ -83,9 +83,11 @@
 #include "include/ports/SkFontMgr_empty.h"
 #endif
 
-static DEFINE_string2(input    , i, nullptr, "Input .json file.");
+static DEFINE_string2(input    , i, nullptr, "Input .json (or compiled animation) file.");
 static DEFINE_string2(writePath, w, nullptr, "Output directory.  Frames are names [0-9]{6}.png.");
 static DEFINE_string2(format   , f, "png"  , formats_help);
+static DEFINE_string2(compile  , c, nullptr,
+                      "Compile the input to a binary animation file at this path, and exit.");
 
 static DEFINE_double(t0,    0, "Timeline start [0..1].");
 static DEFINE_double(t1,    1, "Timeline stop [0..1].");
@@ -465,6 +467,31 @@ private:
                           fWarnings;
 };
 
+int compile_animation(const char* input, const char* output) {
+    const auto json = SkData::MakeFromFileName(input);
+    if (!json) {
+        SkDebugf("Could not load %s.\n", input);
+        return 1;
+    }
+
+    const auto binary = skottie::Animation::Builder::Compile(
+            static_cast<const char*>(json->data()), json->size());
+    if (!binary) {
+        SkDebugf("Could not parse animation: '%s'.\n", input);
+        return 1;
+    }
+
+    SkFILEWStream stream(output);
+    if (!stream.isValid() || !stream.write(binary->data(), binary->size())) {
+        SkDebugf("Could not write %s.\n", output);
+        return 1;
+    }
+
+    printf("Compiled %s (%zu bytes) to %s (%zu bytes).\n",
+           input, json->size(), output, binary->size());
+    return 0;
+}
+
 } // namespace
 
 extern bool gSkUseThreadLocalStrikeCaches_IAcknowledgeThisIsIncrediblyExperimental;
@@ -474,8 +501,12 @@ int main(int argc, char** argv) {
     CommandLineFlags::Parse(argc, argv);
     SkGraphics::Init();
 
+    if (!FLAGS_input.isEmpty() && !FLAGS_compile.isEmpty()) {
+        return compile_animation(FLAGS_input[0], FLAGS_compile[0]);
+    }
+
     if (FLAGS_input.isEmpty() || FLAGS_writePath.isEmpty()) {
-        SkDebugf("Missing required 'input' and 'writePath' args.\n");
+        SkDebugf("Missing required 'input' and 'writePath' (or 'compile') args.\n");
         return 1;
     }
 
@@ -531,22 +562,17 @@ int main(int argc, char** argv) {
         return 1;
     }
 
-    const auto build_animation = [&fontMgr, &rp, &data](
-            const sk_sp<Logger>& logger,
-            const sk_sp<skottie::PrecompInterceptor>& pint) {
-        return skottie::Animation::Builder()
+    // Instantiate an animation on the main thread for three reasons:
+    //   - we need to know its duration upfront
+    //   - we want to only report parsing errors once
+    //   - the worker threads render copies, which skip parsing
+    const auto anim = skottie::Animation::Builder(skottie::Animation::Builder::kRetainSource)
             .setFontManager(fontMgr)
             .setLogger(logger)
-            .setPrecompInterceptor(pint)
+            .setPrecompInterceptor(precomp_interceptor)
             .setResourceProvider(rp)
             .setTextShapingFactory(SkShapers::BestAvailable())
             .make(static_cast<const char*>(data->data()), data->size());
-    };
-
-    // Instantiate an animation on the main thread for two reasons:
-    //   - we need to know its duration upfront
-    //   - we want to only report parsing errors once
-    const auto anim = build_animation(logger, nullptr);
     if (!anim) {
         SkDebugf("Could not parse animation: '%s'.\n", FLAGS_input[0]);
         return 1;
@@ -603,15 +629,14 @@ int main(int argc, char** argv) {
             i = frame_count - 1 - i;
 
             const auto start = std::chrono::steady_clock::now();
-            thread_local static auto* anim =
-                    build_animation(nullptr, precomp_interceptor).release();
+            thread_local static auto* anim_copy = anim->makeCopy().release();
             thread_local static auto* gen = singleton_generator
                     ? singleton_generator.get()
                     : FrameGenerator::Make(sink.get(), fmt, scale_matrix).release();
 
-            if (gen && anim) {
-                anim->seekFrame(frame0 + i * fps_scale);
-                gen->generateFrame(anim, SkToSizeT(i));
+            if (gen && anim_copy) {
+                anim_copy->seekFrame(frame0 + i * fps_scale);
+                gen->generateFrame(anim_copy, SkToSizeT(i));
             } else {
                 sink->writeFrame(nullptr, SkToSizeT(i));
             }
@@ -11,6 +11,7 @@
 #include "modules/skottie/src/SkottieJson.h"
 #include "modules/skottie/src/SkottiePriv.h"
 #include "modules/skottie/src/animator/KeyframeAnimator.h"
+#include "modules/skottie/src/animator/KeyframeBatch.h"
 #include "src/utils/SkJSON.h"
 
 #include <utility>
@@ -125,6 +126,9 @@ bool AnimatablePropertyContainer::bindImpl(const AnimationBuilder& abuilder,
         // as an animated property - apply immediately and discard the animator.
         animator->seek(0);
     } else {
+        if (abuilder.fCurrentKeyframeBatch) {
+            abuilder.fCurrentKeyframeBatch->add(animator);
+        }
         fAnimators.push_back(std::move(animator));
     }
 
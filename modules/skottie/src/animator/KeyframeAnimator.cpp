@@ -22,6 +22,12 @@ KeyframeAnimator::~KeyframeAnimator() = default;
 KeyframeAnimator::LERPInfo KeyframeAnimator::getLERPInfo(float t) const {
     SkASSERT(!fKFs.empty());
 
+    // Use the LERPInfo precomputed by our KeyframeBatch, if any.
+    fBatchUsed = true;
+    if (t == fBatchT) {
+        return fBatchInfo;
+    }
+
     if (t <= fKFs.front().t) {
         // Constant/clamped segment.
         return { 0, fKFs.front().v, fKFs.front().v };
@@ -83,7 +89,7 @@ float KeyframeAnimator::compute_weight(const KFSegment &seg, float t) const {
     // Optional cubic mapper.
     if (seg.kf0->mapping >= Keyframe::kCubicIndexOffset) {
         const auto mapper_index = SkToSizeT(seg.kf0->mapping - Keyframe::kCubicIndexOffset);
-        w = fCMs[mapper_index].computeYFromX(w);
+        w = fCMs[mapper_index].fMap.computeYFromX(w);
     }
 
     return w;
@@ -16,6 +16,7 @@
 #include "modules/skottie/src/animator/Animator.h"
 
 #include <cstdint>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -32,6 +33,7 @@ class ExpressionManager;
 namespace skottie::internal {
 
 class AnimationBuilder;
+class KeyframeBatch;
 
 struct Keyframe {
     // We can store scalar values inline; other types are stored externally,
@@ -66,6 +68,15 @@ struct Keyframe {
     inline static constexpr uint32_t kCubicIndexOffset = 2;
 };
 
+// A cubic mapper and the control points it was built from (which KeyframeBatch uses to set up
+// its own, vectorized copy).
+struct CubicMapper {
+    CubicMapper(SkPoint c0, SkPoint c1) : fMap(c0, c1), fC0(c0), fC1(c1) {}
+
+    SkCubicMap fMap;
+    SkPoint    fC0, fC1;
+};
+
 class KeyframeAnimator : public Animator {
 public:
     ~KeyframeAnimator() override;
@@ -78,7 +89,7 @@ public:
     }
 
 protected:
-    KeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms)
+    KeyframeAnimator(std::vector<Keyframe> kfs, std::vector<CubicMapper> cms)
         : fKFs(std::move(kfs))
         , fCMs(std::move(cms)) {}
 
@@ -91,6 +102,8 @@ protected:
     LERPInfo getLERPInfo(float t) const;
 
 private:
+    friend class KeyframeBatch;
+
     // Two sequential KFRecs determine how the value varies within [kf0 .. kf1)
     struct KFSegment {
         const Keyframe* kf0;
@@ -110,9 +123,15 @@ private:
     // Given a |t| and a containing KFSegment, compute the local interpolation weight.
     float compute_weight(const KFSegment& seg, float t) const;
 
-    const std::vector<Keyframe>   fKFs; // Keyframe records, one per AE/Lottie keyframe.
-    const std::vector<SkCubicMap> fCMs; // Optional cubic mappers (Bezier interpolation).
-    mutable KFSegment             fCurrentSegment = { nullptr, nullptr }; // Cached segment.
+    const std::vector<Keyframe>    fKFs; // Keyframe records, one per AE/Lottie keyframe.
+    const std::vector<CubicMapper> fCMs; // Optional cubic mappers (Bezier interpolation).
+    mutable KFSegment              fCurrentSegment = { nullptr, nullptr }; // Cached segment.
+
+    // LERPInfo precomputed by KeyframeBatch for fBatchT (NaN when there is none), and whether
+    // the animator was seeked since (animators of inactive layers are not, and are skipped).
+    float                          fBatchT = std::numeric_limits<float>::quiet_NaN();
+    LERPInfo                       fBatchInfo;
+    mutable bool                   fBatchUsed = true;
 };
 
 class AnimatorBuilder : public SkNoncopyable {
@@ -137,8 +156,8 @@ protected:
 
     bool parseKeyframes(const AnimationBuilder&, const skjson::ArrayValue&);
 
-    std::vector<Keyframe>   fKFs; // Keyframe records, one per AE/Lottie keyframe.
-    std::vector<SkCubicMap> fCMs; // Optional cubic mappers (Bezier interpolation).
+    std::vector<Keyframe>    fKFs; // Keyframe records, one per AE/Lottie keyframe.
+    std::vector<CubicMapper> fCMs; // Optional cubic mappers (Bezier interpolation).
 
 private:
     uint32_t parseMapping(const skjson::ObjectValue&);
@@ -0,0 +1,242 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "modules/skottie/src/animator/KeyframeBatch.h"
+
+#include "include/core/SkPoint.h"
+#include "include/core/SkScalar.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTPin.h"
+#include "include/private/base/SkTo.h"
+#include "modules/skottie/src/animator/KeyframeAnimator.h"
+#include "src/base/SkVx.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace skottie::internal {
+
+namespace {
+
+// These mirror the SkCubicMap implementation, so the batch sorts the mappings the same way.
+bool nearly_zero(float x) {
+    SkASSERT(x >= 0);
+    return x <= 0.0000000001f;
+}
+
+bool coeff_nearly_zero(float delta) {
+    return std::fabs(delta) <= 0.0000001f;
+}
+
+} // namespace
+
+KeyframeBatch::KeyframeBatch() = default;
+KeyframeBatch::~KeyframeBatch() = default;
+
+void KeyframeBatch::add(sk_sp<KeyframeAnimator> animator) {
+    SkASSERT(animator && !animator->isConstant());
+    fAnimators.push_back(std::move(animator));
+}
+
+void KeyframeBatch::buildLayout() {
+    for (; fLayoutCount < fAnimators.size(); ++fLayoutCount) {
+        const auto& animator = *fAnimators[fLayoutCount];
+        const auto cubic_base = SkToU32(fCubicTypes.size());
+
+        fRanges.push_back({SkToU32(fTimes.size()), SkToU32(animator.fKFs.size()), 0});
+        for (const auto& kf : animator.fKFs) {
+            fTimes.push_back(kf.t);
+            fMappings.push_back(kf.mapping >= Keyframe::kCubicIndexOffset ? kf.mapping + cubic_base
+                                                                          : kf.mapping);
+        }
+
+        for (const auto& cm : animator.fCMs) {
+            SkPoint p1 = cm.fC0,
+                    p2 = cm.fC1;
+            p1.fX = std::min(std::max(p1.fX, 0.0f), 1.0f);
+            p2.fX = std::min(std::max(p2.fX, 0.0f), 1.0f);
+
+            const SkPoint s1 = {p1.fX * 3, p1.fY * 3},
+                          s2 = {p2.fX * 3, p2.fY * 3};
+
+            fAX.push_back(1 + s1.fX - s2.fX);
+            fAY.push_back(1 + s1.fY - s2.fY);
+            fBX.push_back(s2.fX - s1.fX - s1.fX);
+            fBY.push_back(s2.fY - s1.fY - s1.fY);
+            fCX.push_back(s1.fX);
+            fCY.push_back(s1.fY);
+
+            auto type = CubicType::kSolver;
+            if (SkScalarNearlyEqual(p1.fX, p1.fY) && SkScalarNearlyEqual(p2.fX, p2.fY)) {
+                type = CubicType::kLine;
+            } else if (coeff_nearly_zero(fBX.back()) && coeff_nearly_zero(fCX.back())) {
+                type = CubicType::kCubeRoot;
+            }
+            fCubicTypes.push_back(type);
+        }
+    }
+}
+
+Animator::StateChanged KeyframeBatch::onSeek(float t) {
+    if (fLayoutCount < fAnimators.size()) {
+        this->buildLayout();
+    }
+
+    fWorkAnimators.clear();
+    for (auto* work : {&fWorkX, &fWorkAX, &fWorkBX, &fWorkCX, &fWorkAY, &fWorkBY, &fWorkCY}) {
+        work->clear();
+    }
+
+    for (size_t i = 0; i < fAnimators.size(); ++i) {
+        auto& animator = *fAnimators[i];
+
+        // Skip the animators which were not seeked last time (they are likely in inactive
+        // layers).  Should they be seeked now, they'll evaluate their own keyframes.
+        if (!animator.fBatchUsed) {
+            continue;
+        }
+        animator.fBatchUsed = false;
+        animator.fBatchT = t;
+
+        auto& info  = animator.fBatchInfo;
+        auto& range = fRanges[i];
+        const auto& kfs = animator.fKFs;
+        const float* ts = fTimes.data() + range.fOffset;
+
+        if (t <= ts[0]) {
+            // Constant/clamped segment.
+            info = { 0, kfs.front().v, kfs.front().v };
+            continue;
+        }
+        if (t >= ts[range.fCount - 1]) {
+            // Constant/clamped segment.
+            info = { 0, kfs.back().v, kfs.back().v };
+            continue;
+        }
+
+        auto seg = range.fSegment;
+        if (!(ts[seg] <= t && t < ts[seg + 1])) {
+            // Binary-search, until we reduce to sequential keyframes.
+            uint32_t kf0 = 0,
+                     kf1 = range.fCount - 1;
+            while (kf0 + 1 != kf1) {
+                const auto mid = kf0 + (kf1 - kf0) / 2;
+                if (t >= ts[mid]) {
+                    kf0 = mid;
+                } else {
+                    kf1 = mid;
+                }
+            }
+            seg = range.fSegment = kf0;
+        }
+
+        const auto mapping = fMappings[range.fOffset + seg];
+        if (mapping == Keyframe::kConstantMapping) {
+            // Constant/hold segment.
+            info = { 0, kfs[seg].v, kfs[seg].v };
+            continue;
+        }
+
+        // Linear weight.
+        const auto w = (t - ts[seg]) / (ts[seg + 1] - ts[seg]);
+        info = { w, kfs[seg].v, kfs[seg + 1].v };
+
+        if (mapping < Keyframe::kCubicIndexOffset) {
+            continue;
+        }
+
+        // Cubic mapping: easy cases are resolved here, the others are queued for the solver.
+        const auto c = mapping - Keyframe::kCubicIndexOffset;
+        const auto x = SkTPin(w, 0.0f, 1.0f);
+        if (nearly_zero(x) || nearly_zero(1 - x) || fCubicTypes[c] == CubicType::kLine) {
+            info.weight = x;
+            continue;
+        }
+        if (fCubicTypes[c] == CubicType::kCubeRoot) {
+            const auto ct = std::pow(x / fAX[c], 1.0f / 3);
+            info.weight = ((fAY[c] * ct + fBY[c]) * ct + fCY[c]) * ct;
+            continue;
+        }
+
+        fWorkAnimators.push_back(SkToU32(i));
+        fWorkX .push_back(x);
+        fWorkAX.push_back(fAX[c]);
+        fWorkBX.push_back(fBX[c]);
+        fWorkCX.push_back(fCX[c]);
+        fWorkAY.push_back(fAY[c]);
+        fWorkBY.push_back(fBY[c]);
+        fWorkCY.push_back(fCY[c]);
+    }
+
+    const auto count = fWorkAnimators.size();
+    if (count) {
+        // Pad with y = x, which the solver settles immediately.
+        const auto padded = (count + kLanes - 1) / kLanes * kLanes;
+        fWorkX .resize(padded, 0.5f);
+        fWorkAX.resize(padded, 0);
+        fWorkBX.resize(padded, 0);
+        fWorkCX.resize(padded, 1);
+        fWorkAY.resize(padded, 0);
+        fWorkBY.resize(padded, 0);
+        fWorkCY.resize(padded, 1);
+
+        SolveCubics(padded, fWorkX.data(),
+                    fWorkAX.data(), fWorkBX.data(), fWorkCX.data(),
+                    fWorkAY.data(), fWorkBY.data(), fWorkCY.data());
+
+        for (size_t i = 0; i < count; ++i) {
+            fAnimators[fWorkAnimators[i]]->fBatchInfo.weight = fWorkX[i];
+        }
+    }
+
+    // The animators report their own changes.
+    return false;
+}
+
+void KeyframeBatch::SolveCubics(size_t count, float* x,
+                                const float* ax, const float* bx, const float* cx,
+                                const float* ay, const float* by, const float* cy) {
+    using F = skvx::Vec<kLanes, float>;
+    using I = skvx::Vec<kLanes, int32_t>;
+
+    SkASSERT(count % kLanes == 0);
+    for (size_t i = 0; i < count; i += kLanes) {
+        // Halley's method, as in SkCubicMap: solve At^3 + Bt^2 + Ct + D = 0 for t, with D = -x.
+        // Lanes stop iterating as they converge.  Unlike SkCubicMap, we don't use fused
+        // multiply-adds, which are not vectorized on targets without FMA instructions, so the
+        // results match only to within the solver tolerance.
+        const F A = F::Load(ax + i),
+                B = F::Load(bx + i),
+                C = F::Load(cx + i),
+                D = -F::Load(x + i);
+
+        F t = -D;
+        I active = ~I(0);
+        for (int iters = 0; iters < 8; ++iters) {
+            const F f = ((A * t + B) * t + C) * t + D;
+            active &= ~(skvx::abs(f) <= 0.00005f);
+            if (!skvx::any(active)) {
+                break;
+            }
+            const F fp  = (3 * A * t + 2 * B) * t + C;
+            const F fpp = (3 * A + 3 * A) * t + 2 * B;
+
+            const F numer = 2 * fp * f;
+            const F denom = 2 * fp * fp - f * fpp;
+
+            t = skvx::if_then_else(active, t - numer / denom, t);
+        }
+
+        const F a = F::Load(ay + i),
+                b = F::Load(by + i),
+                c = F::Load(cy + i);
+        (((a * t + b) * t + c) * t).store(x + i);
+    }
+}
+
+} // namespace skottie::internal
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkottieKeyframeBatch_DEFINED
+#define SkottieKeyframeBatch_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "modules/skottie/src/animator/Animator.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace skottie::internal {
+
+class KeyframeAnimator;
+
+// Evaluates the keyframes of a group of animators which are all seeked with the same t.
+//
+// Seeking a KeyframeBatch computes the LERPInfo of every animator in the group in one pass: the
+// keyframe times and cubic mappers are laid out in flat (SoA) arrays, and the cubic mappings
+// which are due are solved together, several per SIMD vector.  Each animator's LERPInfo is then
+// cached for the batch t, so the batch must be seeked before the animators it evaluates.
+//
+// Animators seeked with a different t (e.g. by motion blur) simply miss the cache and evaluate
+// their keyframes on their own, and so do the animators which were not seeked after the previous
+// batch seek (e.g. those of inactive layers), which the batch skips.
+class KeyframeBatch final : public Animator {
+public:
+    KeyframeBatch();
+    ~KeyframeBatch() override;
+
+    void add(sk_sp<KeyframeAnimator>);
+
+    bool empty() const { return fAnimators.empty(); }
+
+    // Solve the given cubic mappings (see SkCubicMap::computeYFromX) for x, in place.
+    // The arrays must be padded to a multiple of kLanes.
+    static constexpr size_t kLanes = 8;
+    static void SolveCubics(size_t count, float* x,
+                            const float* ax, const float* bx, const float* cx,
+                            const float* ay, const float* by, const float* cy);
+
+private:
+    StateChanged onSeek(float t) override;
+
+    void buildLayout();
+
+    std::vector<sk_sp<KeyframeAnimator>> fAnimators;
+
+    // Per animator: where its keyframes start in the arrays below, how many there are,
+    // and the index of the last segment it was in.
+    struct Range {
+        uint32_t fOffset,
+                 fCount,
+                 fSegment;
+    };
+    std::vector<Range>    fRanges;
+
+    // Keyframe times and mappings for all the animators, one after the other.  Cubic mappings
+    // index the coefficient arrays below.
+    std::vector<float>    fTimes;
+    std::vector<uint32_t> fMappings;
+
+    // Cubic coefficients and types, as computed by SkCubicMap.
+    enum class CubicType : uint8_t {
+        kLine,
+        kCubeRoot,
+        kSolver,
+    };
+    std::vector<float>     fAX, fBX, fCX,
+                           fAY, fBY, fCY;
+    std::vector<CubicType> fCubicTypes;
+
+    // The cubic mappings due for the current seek: the animators they belong to, and their
+    // SoA solver inputs.
+    std::vector<uint32_t> fWorkAnimators;
+    std::vector<float>    fWorkX,
+                          fWorkAX, fWorkBX, fWorkCX,
+                          fWorkAY, fWorkBY, fWorkCY;
+
+    size_t                fLayoutCount = 0; // Animators laid out so far.
+};
+
+} // namespace skottie::internal
+
+#endif // SkottieKeyframeBatch_DEFINED
@@ -29,7 +29,7 @@ namespace  {
 class ScalarKeyframeAnimator final : public KeyframeAnimator {
 public:
     ScalarKeyframeAnimator(std::vector<Keyframe> kfs,
-                           std::vector<SkCubicMap> cms,
+                           std::vector<CubicMapper> cms,
                            ScalarValue* target_value)
         : INHERITED(std::move(kfs), std::move(cms))
         , fTarget(target_value) {}
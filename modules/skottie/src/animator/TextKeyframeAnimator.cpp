@@ -26,7 +26,7 @@ class AnimationBuilder;
 namespace  {
 class TextKeyframeAnimator final : public KeyframeAnimator {
 public:
-    TextKeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms,
+    TextKeyframeAnimator(std::vector<Keyframe> kfs, std::vector<CubicMapper> cms,
                          std::vector<TextValue> vs, TextValue* target_value)
         : INHERITED(std::move(kfs), std::move(cms))
         , fValues(std::move(vs))
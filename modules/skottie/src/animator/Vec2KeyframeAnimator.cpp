@@ -41,7 +41,7 @@ public:
         sk_sp<SkContourMeasure> cmeasure;
     };
 
-    Vec2KeyframeAnimator(std::vector<Keyframe> kfs, std::vector<SkCubicMap> cms,
+    Vec2KeyframeAnimator(std::vector<Keyframe> kfs, std::vector<CubicMapper> cms,
                          std::vector<SpatialValue> vs, Vec2Value* vec_target, float* rot_target)
         : INHERITED(std::move(kfs), std::move(cms))
         , fValues(std::move(vs))
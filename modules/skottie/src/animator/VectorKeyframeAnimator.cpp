@@ -86,7 +86,7 @@ namespace {
 class VectorKeyframeAnimator final : public KeyframeAnimator {
 public:
     VectorKeyframeAnimator(std::vector<Keyframe> kfs,
-                           std::vector<SkCubicMap> cms,
+                           std::vector<CubicMapper> cms,
                            std::vector<float> storage,
                            size_t vec_len,
                            std::vector<float>* target_value)
@@ -198,9 +198,12 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachPrecompLayer(const skjson::Objec
     };
     layer_info->fSize = parse_size(jlayer);
 
+    // Time-mapped animators are seeked with their own t, so they get their own keyframe batch.
     SkTLazy<AutoScope> local_scope;
+    SkTLazy<AutoKeyframeBatch> local_batch;
     if (requires_time_mapping) {
         local_scope.init(this);
+        local_batch.init(this);
     }
 
     auto precomp_layer = this->attachExternalPrecompLayer(jlayer, *layer_info);
@@ -223,7 +226,11 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachPrecompLayer(const skjson::Objec
     if (requires_time_mapping) {
         const auto t_bias  = -start_time,
                    t_scale = sk_ieee_float_divide(1, stretch_time);
-        auto time_mapper = sk_make_sp<CompTimeMapper>(local_scope->release(),
+        auto local_animators = local_scope->release();
+        if (auto batch = local_batch->release()) {
+            local_animators.insert(local_animators.begin(), std::move(batch));
+        }
+        auto time_mapper = sk_make_sp<CompTimeMapper>(std::move(local_animators),
                                                       std::move(time_remapper),
                                                       t_bias,
                                                       std::isfinite(t_scale) ? t_scale : 0);
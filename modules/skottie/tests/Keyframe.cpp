@@ -5,14 +5,20 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkCubicMap.h"
 #include "modules/skottie/include/ExternalLayer.h"
 #include "modules/skottie/src/SkottiePriv.h"
 #include "modules/skottie/src/SkottieValue.h"
 #include "modules/skottie/src/animator/Animator.h"
+#include "modules/skottie/src/animator/KeyframeBatch.h"
+#include "src/base/SkRandom.h"
 #include "src/utils/SkJSON.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <vector>
 
 using namespace skottie;
 using namespace skottie::internal;
@@ -22,10 +28,13 @@ namespace  {
 template <typename T>
 class MockProperty final : public AnimatablePropertyContainer {
 public:
-    explicit MockProperty(const char* jprop) {
-        AnimationBuilder abuilder(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
-                                  nullptr, nullptr,
-                                  {100, 100}, 10, 1, 0);
+    explicit MockProperty(const char* jprop)
+        : MockProperty(AnimationBuilder(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                                        nullptr, nullptr, nullptr,
+                                        {100, 100}, 10, 1, 0),
+                       jprop) {}
+
+    MockProperty(const AnimationBuilder& abuilder, const char* jprop) {
         skjson::DOM json_dom(jprop, strlen(jprop));
 
         fDidBind = this->bind(abuilder, json_dom.root(), &fValue);
@@ -198,3 +207,148 @@ DEF_TEST(Skottie_Keyframe, reporter) {
         REPORTER_ASSERT(reporter, prop(0.85f).y > 200);
     }
 }
+
+DEF_TEST(Skottie_KeyframeBatch, reporter) {
+    static constexpr const char* kScalarProps[] = {
+        // Cubic segments, using several mappers.
+        R"({
+             "a": 1,
+             "k": [
+               { "t": 0, "s": 0,
+                 "o":{"x":[0.42], "y":[0]}, "i":{"x":[0.58], "y":[1]} },
+               { "t": 2, "s": 10,
+                 "o":{"x":[0.5], "y":[-0.5]}, "i":{"x":[0.5], "y":[1.5]} },
+               { "t": 3, "s": -5,
+                 "o":{"x":[0.9], "y":[0.1]}, "i":{"x":[0.1], "y":[0.9]} },
+               { "t": 7, "s": 20 }
+             ]
+           })",
+        // Mixed cubic (cube root solvable), linear and hold segments.
+        R"({
+             "a": 1,
+             "k": [
+               { "t": 1, "s": 1,
+                 "o":{"x":[0], "y":[0.3]}, "i":{"x":[0], "y":[1]} },
+               { "t": 2, "s": 2 },
+               { "t": 4, "s": 3, "h": 1 },
+               { "t": 5, "s": 9,
+                 "o":{"x":[0.25], "y":[0.1]}, "i":{"x":[0.25], "y":[1]} },
+               { "t": 6, "s": 0 }
+             ]
+           })",
+        // Legacy style.
+        R"({
+             "a": 1,
+             "k": [
+               { "t": 0.5, "s": [1], "e": [4],
+                 "o":{"x":[0.33], "y":[0]}, "i":{"x":[0.67], "y":[1]} },
+               { "t": 6.5 }
+             ]
+           })",
+    };
+    static constexpr char kVec2Prop[] = R"({
+                                          "a": 1,
+                                          "k": [
+                                            { "t": 0, "s": [0,0],
+                                              "o":{"x":[0.2], "y":[0.8]},
+                                              "i":{"x":[0.6], "y":[0.4]} },
+                                            { "t": 5, "s": [100,50] }
+                                          ]
+                                        })";
+
+    AnimationBuilder abuilder(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                              nullptr, nullptr,
+                              {100, 100}, 10, 1, 0);
+
+    AnimationBuilder::AutoKeyframeBatch akb(&abuilder);
+    std::vector<std::unique_ptr<MockProperty<ScalarValue>>> batched, reference;
+    for (const char* jprop : kScalarProps) {
+        batched.push_back(std::make_unique<MockProperty<ScalarValue>>(abuilder, jprop));
+        REPORTER_ASSERT(reporter, *batched.back());
+    }
+    MockProperty<Vec2Value> batched_vec(abuilder, kVec2Prop);
+    REPORTER_ASSERT(reporter, batched_vec);
+    auto batch = akb.release();
+    REPORTER_ASSERT(reporter, batch);
+
+    for (const char* jprop : kScalarProps) {
+        reference.push_back(std::make_unique<MockProperty<ScalarValue>>(jprop));
+    }
+    MockProperty<Vec2Value> reference_vec(kVec2Prop);
+
+    // The batched cubic solver matches SkCubicMap to within its tolerance (~1e-4 weight), so
+    // the tolerance here is relative to the value ranges.
+    auto check = [&](float t) {
+        for (size_t i = 0; i < batched.size(); ++i) {
+            const float b = (*batched[i])(t),
+                        r = (*reference[i])(t);
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(b, r, 0.005f),
+                            "prop %zu, t %g: %g vs %g", i, t, b, r);
+        }
+        const Vec2Value b = batched_vec(t),
+                        r = reference_vec(t);
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(b.x, r.x, 0.02f) &&
+                                  SkScalarNearlyEqual(b.y, r.y, 0.02f),
+                        "t %g: {%g, %g} vs {%g, %g}", t, b.x, b.y, r.x, r.y);
+    };
+
+    // Forward, including keyframe times and times outside the keyframes.
+    for (float t = -1; t <= 8; t += 0.0625f) {
+        batch->seek(t);
+        check(t);
+    }
+    // Jumping around.
+    for (float t : {6.9f, 0.01f, 4.5f, 2.999f, 3.0f, 1.0f, 5.5f, 0.3f}) {
+        batch->seek(t);
+        check(t);
+    }
+    // Animators seeked with a t other than the batch's evaluate their own keyframes.
+    batch->seek(1.5f);
+    check(2.25f);
+    // So do the animators which the batch skips, because they were not seeked after its
+    // previous seek.
+    batch->seek(3.5f);
+    batch->seek(5.25f);
+    check(5.25f);
+    check(5.25f);
+}
+
+DEF_TEST(Skottie_KeyframeBatchSolver, reporter) {
+    static constexpr size_t kCount = 64;
+    static_assert(kCount % KeyframeBatch::kLanes == 0);
+
+    SkRandom rand;
+    for (int i = 0; i < 1000; ++i) {
+        const SkPoint p1 = {rand.nextF(), rand.nextRangeF(-1, 2)},
+                      p2 = {rand.nextF(), rand.nextRangeF(-1, 2)};
+        const SkCubicMap cm(p1, p2);
+
+        const SkPoint s1 = {p1.fX * 3, p1.fY * 3},
+                      s2 = {p2.fX * 3, p2.fY * 3};
+        float x[kCount], ax[kCount], bx[kCount], cx[kCount], ay[kCount], by[kCount], cy[kCount];
+        for (size_t j = 0; j < kCount; ++j) {
+            x[j]  = (j + 0.5f) / kCount;
+            ax[j] = 1 + s1.fX - s2.fX;
+            bx[j] = s2.fX - s1.fX - s1.fX;
+            cx[j] = s1.fX;
+            ay[j] = 1 + s1.fY - s2.fY;
+            by[j] = s2.fY - s1.fY - s1.fY;
+            cy[j] = s1.fY;
+        }
+        KeyframeBatch::SolveCubics(kCount, x, ax, bx, cx, ay, by, cy);
+
+        for (size_t j = 0; j < kCount; ++j) {
+            // Both solvers stop once x(t) is within 0.00005 of x, so their ts can map x values
+            // up to 0.0001 apart, and the weights can differ by that much times dy/dx.
+            const float xj   = (j + 0.5f) / kCount,
+                        h    = 0.001f,
+                        y    = cm.computeYFromX(xj),
+                        dydx = std::fabs(cm.computeYFromX(xj + h) -
+                                         cm.computeYFromX(xj - h)) / (2 * h);
+            REPORTER_ASSERT(reporter,
+                            std::fabs(x[j] - y) <= 0.0001f * std::max(dydx, 1.0f),
+                            "p1 {%g, %g}, p2 {%g, %g}, x %g: %g vs %g",
+                            p1.fX, p1.fY, p2.fX, p2.fY, xj, x[j], y);
+        }
+    }
+}
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
 
 #if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
 
@@ -13,6 +14,8 @@
 #include "tools/fonts/FontToolUtils.h"
 
 #include <cfloat>
+#include <memory>
+#include <vector>
 #include "include/core/SkPictureRecorder.h"
 #include "modules/skparagraph/utils/TestFontCollection.h"
 
@@ -47,15 +50,143 @@ struct ParagraphBench : public Benchmark {
         SkCanvas* canvas = rec.beginRecording({0,0, 2000,3000});
         while (loops-- > 0) {
             paragraph->layout(fWidth);
-            auto impl = static_cast<ParagraphImpl*>(paragraph.get());
             paragraph->paint(canvas, 0, 0);
             paragraph->markDirty();
-            impl->resetCache();
+            fontCollection->getParagraphCache()->reset();
         }
     }
 };
+
+// Lays out a document of many paragraphs with Paragraph::LayoutAll, shaping every paragraph
+// again on each loop, to measure throughput against the number of threads.
+struct ParagraphLayoutThreadsBench : public Benchmark {
+    static constexpr int kParagraphCount = 256;
+
+    explicit ParagraphLayoutThreadsBench(int threads) : fThreads(threads) {
+        fName.printf("paragraph_layout_threads_%d", threads);
+    }
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    void onDelayedSetup() override {
+        sk_sp<SkData> data = GetResourceAsData("text/english.txt");
+        if (!data) {
+            return;
+        }
+        if (fThreads > 1) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+
+        fFontCollection = sk_make_sp<FontCollection>();
+        fFontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+        SkString text((const char*)data->data(), data->size());
+        for (int i = 0; i < kParagraphCount; ++i) {
+            // Vary the text so that the paragraphs do not share shaping results
+            ParagraphBuilderImpl builder(paragraph_style, fFontCollection);
+            builder.addText(SkStringPrintf("%d. %s", i, text.c_str()).c_str());
+            fParagraphs.push_back(builder.Build());
+            fParagraphPtrs.push_back(fParagraphs.back().get());
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            fFontCollection->getParagraphCache()->reset();
+            for (Paragraph* paragraph : fParagraphPtrs) {
+                paragraph->markDirty();
+            }
+            Paragraph::LayoutAll(fParagraphPtrs, 500, fExecutor.get());
+        }
+    }
+
+    const int fThreads;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+    sk_sp<FontCollection> fFontCollection;
+    std::vector<std::unique_ptr<Paragraph>> fParagraphs;
+    std::vector<Paragraph*> fParagraphPtrs;
+};
+
+// Lays out a shaped paragraph again at alternating widths, as when a window is resized. Only the
+// line breaking and formatting run; the shaping results are reused.
+struct ParagraphResizeBench : public Benchmark {
+    const char* onGetName() override { return "paragraph_resize"; }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    void onDelayedSetup() override {
+        sk_sp<SkData> data = GetResourceAsData("text/english.txt");
+        if (!data) {
+            return;
+        }
+        auto fontCollection = sk_make_sp<FontCollection>();
+        fontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.addText((const char*)data->data(), data->size());
+        fParagraph = builder.Build();
+        fParagraph->layout(500);
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fParagraph) {
+            return;
+        }
+        while (loops-- > 0) {
+            fParagraph->layout(400);
+            fParagraph->layout(500);
+        }
+    }
+
+    std::unique_ptr<Paragraph> fParagraph;
+};
+
+// Types a character in the middle of a 100 KB paragraph and deletes it again, laying the paragraph
+// out after each keystroke, as a text editor does. Only the edited line is shaped again.
+struct ParagraphKeystrokeBench : public Benchmark {
+    const char* onGetName() override { return "paragraph_keystroke"; }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    void onDelayedSetup() override {
+        sk_sp<SkData> data = GetResourceAsData("text/english.txt");
+        if (!data) {
+            return;
+        }
+        SkString text;
+        while (text.size() < 100 * 1024) {
+            text.append((const char*)data->data(), data->size());
+        }
+        auto fontCollection = sk_make_sp<FontCollection>();
+        fontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.addText(text.c_str(), text.size());
+        fParagraph = builder.Build();
+        fParagraph->layout(500);
+        fOffset = text.size() / 2;
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fParagraph) {
+            return;
+        }
+        while (loops-- > 0) {
+            fParagraph->updateText(fOffset, fOffset, SkString("a"));
+            fParagraph->layout(500);
+            fParagraph->updateText(fOffset, fOffset + 1, SkString());
+            fParagraph->layout(500);
+        }
+    }
+
+    std::unique_ptr<Paragraph> fParagraph;
+    size_t fOffset = 0;
+};
 }  // namespace
 
+DEF_BENCH(return new ParagraphLayoutThreadsBench(1);)
+DEF_BENCH(return new ParagraphLayoutThreadsBench(2);)
+DEF_BENCH(return new ParagraphLayoutThreadsBench(4);)
+DEF_BENCH(return new ParagraphLayoutThreadsBench(8);)
+DEF_BENCH(return new ParagraphResizeBench();)
+DEF_BENCH(return new ParagraphKeystrokeBench();)
+
 #define PARAGRAPH_BENCH(X) DEF_BENCH(return new ParagraphBench(50000, "text/" #X ".txt", "paragraph_" #X);)
 //PARAGRAPH_BENCH(arabic)
 //PARAGRAPH_BENCH(emoji)
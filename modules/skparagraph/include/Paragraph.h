@@ -3,6 +3,7 @@
 #define Paragraph_DEFINED
 
 #include "include/core/SkPath.h"
+#include "include/core/SkSpan.h"
 #include "modules/skparagraph/include/FontCollection.h"
 #include "modules/skparagraph/include/Metrics.h"
 #include "modules/skparagraph/include/ParagraphStyle.h"
@@ -10,6 +11,7 @@
 #include <unordered_set>
 
 class SkCanvas;
+class SkExecutor;
 
 namespace skia {
 namespace textlayout {
@@ -41,6 +43,19 @@ public:
 
     virtual void layout(SkScalar width) = 0;
 
+    /* Lays out the paragraphs as if by calling layout(width) on each of them, spreading
+     * the paragraphs over the executor's threads
+     *
+     * @param paragraphs  distinct paragraphs; they may share a font collection but must not be
+     *                    used by other threads until the call returns
+     * @param width       the width to lay out every paragraph with
+     * @param executor    the executor to run on; if null, the paragraphs are laid out on the
+     *                    calling thread
+     */
+    static void LayoutAll(SkSpan<Paragraph* const> paragraphs,
+                          SkScalar width,
+                          SkExecutor* executor);
+
     virtual void paint(SkCanvas* canvas, SkScalar x, SkScalar y) = 0;
 
     virtual void paint(ParagraphPainter* painter, SkScalar x, SkScalar y) = 0;
@@ -74,11 +89,16 @@ public:
     virtual std::unordered_set<SkUnichar> unresolvedCodepoints() = 0;
 
     // Experimental API that allows fast way to update some of "immutable" paragraph attributes
-    // but not the text itself
+    // (and the text itself)
     virtual void updateTextAlign(TextAlign textAlign) = 0;
     virtual void updateFontSize(size_t from, size_t to, SkScalar fontSize) = 0;
     virtual void updateForegroundPaint(size_t from, size_t to, SkPaint paint) = 0;
     virtual void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) = 0;
+    // Replaces the UTF-8 text [from:to) with text that takes the style of the text before it.
+    // The edit must stay within the text between two placeholders. Only the text around the edit
+    // is shaped again on the next layout, and the lines before it are kept when the width is same.
+    // Returns false (and leaves the paragraph as it was) if the edit is not supported.
+    virtual bool updateText(size_t from, size_t to, const SkString& text) { return false; }
 
     enum VisitorFlags {
         kWhiteSpace_VisitorFlag = 1 << 0,
@@ -2,9 +2,13 @@
 #ifndef ParagraphCache_DEFINED
 #define ParagraphCache_DEFINED
 
+#include "include/core/SkString.h"
 #include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
 #include "src/core/SkLRUCache.h"
+#include <atomic>
 #include <functional>  // std::function
+#include <memory>
 
 #define PARAGRAPH_CACHE_STATS
 
@@ -31,7 +35,12 @@ public:
     }
     void printStatistics();
     void turnOn(bool value) { fCacheIsOn = value; }
-    int count() { return fLRUCacheMap.count(); }
+    int count();
+
+    // The cache evicts the least recently used paragraphs to stay within this many bytes of
+    // shaped results. The budget is split evenly between the shards.
+    void setMemoryBudget(size_t bytes);
+    size_t memoryUsage();
 
     bool isPossiblyTextEditing(ParagraphImpl* paragraph);
 
@@ -41,23 +50,44 @@ public:
     void updateFrom(const ParagraphImpl* paragraph, Entry* entry);
     void updateTo(ParagraphImpl* paragraph, const Entry* entry);
 
-     mutable SkMutex fParagraphMutex;
-     std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
+    std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
 
-    static const int kMaxEntries = 128;
+    // Bounds the size of each shard's hash table; the memory budget usually evicts first.
+    static const int kMaxEntriesPerShard = 1024;
+    static const int kShardCount = 16;
+    static constexpr size_t kDefaultMemoryBudget = 16 * 1024 * 1024;
 
     struct KeyHash {
         uint32_t operator()(const ParagraphCacheKey& key) const;
     };
 
-    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
-    bool fCacheIsOn;
-    ParagraphCacheValue* fLastCachedValue;
+    // Paragraphs are spread over the shards by key hash, so that paragraphs laid out on
+    // different threads rarely wait for each other.
+    struct Shard {
+        Shard();
+
+        SkMutex fMutex;
+        // Updated by the entries when they are made and destroyed, under fMutex
+        size_t fMemoryUsage;
+        SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap
+                SK_GUARDED_BY(fMutex);
+    };
+    Shard& shardFor(const ParagraphCacheKey& key);
+    void purgeAsNeeded(Shard& shard) SK_REQUIRES(shard.fMutex);
+
+    Shard fShards[kShardCount];
+    std::atomic<size_t> fShardMemoryBudget;
+    std::atomic<bool> fCacheIsOn;
+
+    // The start and the end of the text last added to the cache (see isPossiblyTextEditing)
+    SkMutex fLastCachedTextMutex;
+    SkString fLastCachedTextPrefix SK_GUARDED_BY(fLastCachedTextMutex);
+    SkString fLastCachedTextSuffix SK_GUARDED_BY(fLastCachedTextMutex);
 
 #ifdef PARAGRAPH_CACHE_STATS
-    int fTotalRequests;
-    int fCacheMisses;
-    int fHashMisses; // cache hit but hash table missed
+    std::atomic<int> fTotalRequests;
+    std::atomic<int> fCacheMisses;
+    std::atomic<int> fHashMisses; // cache hit but hash table missed
 #endif
 };
 
@@ -249,6 +249,30 @@ void OneLineShaper::finish(const Block& block, SkScalar height, SkScalar& advanc
     }
 }
 
+bool OneLineShaper::beginUnit(TextRange text,
+                              uint8_t bidiLevel,
+                              bool placeholder,
+                              SkScalar& advanceX) {
+    fUnit.fText = text;
+    fUnit.fBidiLevel = bidiLevel;
+    fUnit.fPlaceholder = placeholder;
+    fUnit.fRuns = SkRange<size_t>(fParagraph->fRuns.size(), fParagraph->fRuns.size());
+    fUnit.fFontSwitches = SkRange<size_t>(fParagraph->fFontSwitches.size(),
+                                          fParagraph->fFontSwitches.size());
+    fUnit.fUnresolvedGlyphs = fUnresolvedGlyphs;
+    fUnit.fAdvanceX = advanceX;
+    fUnit.fEndAdvanceX = advanceX;
+    return fUnitVisitor && fUnitVisitor(fUnit, advanceX);
+}
+
+void OneLineShaper::endUnit(SkScalar advanceX) {
+    fUnit.fRuns.end = fParagraph->fRuns.size();
+    fUnit.fFontSwitches.end = fParagraph->fFontSwitches.size();
+    fUnit.fUnresolvedGlyphs = fUnresolvedGlyphs - fUnit.fUnresolvedGlyphs;
+    fUnit.fEndAdvanceX = advanceX;
+    fParagraph->fShapingUnits.push_back(fUnit);
+}
+
 // Make it [left:right) regardless of a text direction
 TextRange OneLineShaper::normalizeTextRange(GlyphRange glyphRange) {
 
@@ -559,9 +583,27 @@ bool OneLineShaper::iterateThroughShapingRegions(const ShapeVisitor& shape) {
                 if (!blockRange.empty()) {
                     SkSpan<Block> styleSpan(fParagraph->blocks(blockRange));
 
-                    // Shape the text between placeholders
-                    if (!shape(textRange, styleSpan, advanceX, start, bidiRegion.level)) {
-                        return false;
+                    // Shape the text between placeholders a line at a time: the text after a hard
+                    // line break is shaped the same whatever comes before it, so an edit of the
+                    // text only has to shape its own lines again
+                    auto lineStart = start;
+                    while (lineStart < end) {
+                        auto lineEnd = lineStart;
+                        while (lineEnd < end && fParagraph->fText.c_str()[lineEnd++] != '\n') {
+                        }
+                        while (styleSpan.front().fRange.end <= lineStart) {
+                            styleSpan = styleSpan.subspan(1);
+                        }
+                        size_t lineBlocks = 1;
+                        while (lineBlocks < styleSpan.size() &&
+                               styleSpan[lineBlocks].fRange.start < lineEnd) {
+                            ++lineBlocks;
+                        }
+                        if (!shape(TextRange(lineStart, lineEnd), styleSpan.first(lineBlocks),
+                                   advanceX, lineStart, bidiRegion.level)) {
+                            return false;
+                        }
+                        lineStart = lineEnd;
                     }
                 }
 
@@ -577,6 +619,14 @@ bool OneLineShaper::iterateThroughShapingRegions(const ShapeVisitor& shape) {
             continue;
         }
 
+        uint8_t bidiLevel = (bidiIndex < fParagraph->fBidiRegions.size())
+            ? fParagraph->fBidiRegions[bidiIndex].level
+            : 2;
+        if (this->beginUnit(placeholder.fRange, bidiLevel, true, advanceX)) {
+            this->endUnit(advanceX);
+            continue;
+        }
+
         // Get the placeholder font
         std::vector<sk_sp<SkTypeface>> typefaces = fParagraph->fFontCollection->findTypefaces(
             placeholder.fTextStyle.getFontFamilies(),
@@ -586,9 +636,6 @@ bool OneLineShaper::iterateThroughShapingRegions(const ShapeVisitor& shape) {
         SkFont font(typeface, placeholder.fTextStyle.getFontSize());
 
         // "Shape" the placeholder
-        uint8_t bidiLevel = (bidiIndex < fParagraph->fBidiRegions.size())
-            ? fParagraph->fBidiRegions[bidiIndex].level
-            : 2;
         const SkShaper::RunHandler::RunInfo runInfo = {
             font,
             bidiLevel,
@@ -610,23 +657,32 @@ bool OneLineShaper::iterateThroughShapingRegions(const ShapeVisitor& shape) {
         run.fClusterIndexes[0] = 0;
         run.fPlaceholderIndex = &placeholder - fParagraph->fPlaceholders.begin();
         advanceX += placeholder.fStyle.fWidth;
+        this->endUnit(advanceX);
     }
     return true;
 }
 
 bool OneLineShaper::shape() {
+    return this->shape(nullptr);
+}
+
+bool OneLineShaper::shape(const UnitVisitor& visitor) {
+    fUnitVisitor = visitor;
 
     // The text can be broken into many shaping sequences
     // (by place holders, possibly, by hard line breaks or tabs, too)
     auto limitlessWidth = std::numeric_limits<SkScalar>::max();
 
+    // Set up the shaper (for all the lines of the text)
+    std::unique_ptr<SkShaper> shaper;
     auto result = iterateThroughShapingRegions(
-            [this, limitlessWidth]
+            [this, limitlessWidth, &shaper]
             (TextRange textRange, SkSpan<Block> styleSpan, SkScalar& advanceX, TextIndex textStart, uint8_t defaultBidiLevel) {
 
-        // Set up the shaper and shape the next
-        auto shaper = SkShapers::HB::ShapeDontWrapOrReorder(fParagraph->fUnicode,
-                                                            SkFontMgr::RefEmpty());  // no fallback
+        if (shaper == nullptr) {
+            shaper = SkShapers::HB::ShapeDontWrapOrReorder(fParagraph->fUnicode,
+                                                           SkFontMgr::RefEmpty());  // no fallback
+        }
         if (shaper == nullptr) {
             // For instance, loadICU does not work. We have to stop the process
             return false;
@@ -635,6 +691,10 @@ bool OneLineShaper::shape() {
         iterateThroughFontStyles(textRange, styleSpan,
                 [this, &shaper, defaultBidiLevel, limitlessWidth, &advanceX]
                 (Block block, TArray<SkShaper::Feature> features) {
+            if (this->beginUnit(block.fRange, defaultBidiLevel, false, advanceX)) {
+                this->endUnit(advanceX);
+                return;
+            }
             auto blockSpan = SkSpan<Block>(&block, 1);
 
             // Start from the beginning (hoping that it's a simple case one block - one run)
@@ -719,6 +779,7 @@ bool OneLineShaper::shape() {
             });
 
             this->finish(block, fHeight, advanceX);
+            this->endUnit(advanceX);
         });
 
         return true;
@@ -26,6 +26,11 @@ public:
 
     bool shape();
 
+    // Before each unit of the text is shaped, the visitor can add the runs for it instead
+    // (moving advanceX past them); it returns true if it did
+    using UnitVisitor = std::function<bool(const ShapingUnit& unit, SkScalar& advanceX)>;
+    bool shape(const UnitVisitor& visitor);
+
     size_t unresolvedGlyphs() { return fUnresolvedGlyphs; }
 
     /**
@@ -83,6 +88,9 @@ private:
 #endif
     void finish(const Block& block, SkScalar height, SkScalar& advanceX);
 
+    bool beginUnit(TextRange text, uint8_t bidiLevel, bool placeholder, SkScalar& advanceX);
+    void endUnit(SkScalar advanceX);
+
     void beginLine() override {}
     void runInfo(const RunInfo&) override {}
     void commitRunInfo() override {}
@@ -120,6 +128,8 @@ private:
     SkVector fAdvance;
     size_t fUnresolvedGlyphs;
     size_t fUniqueRunId;
+    UnitVisitor fUnitVisitor;
+    ShapingUnit fUnit;
 
     // TODO: Something that is not thead-safe since we don't need it
     std::shared_ptr<Run> fCurrentRun;
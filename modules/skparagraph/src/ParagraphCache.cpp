@@ -80,6 +80,22 @@ public:
         , fHasWhitespacesInside(paragraph->fHasWhitespacesInside)
         , fTrailingSpaces(paragraph->fTrailingSpaces) { }
 
+    // An estimate of the memory the value holds on to
+    size_t memoryUsage() const {
+        constexpr size_t kBytesPerGlyph =
+                sizeof(SkGlyphID) + 2 * sizeof(SkPoint) + sizeof(uint32_t);
+        size_t bytes = sizeof(ParagraphCacheValue) + fKey.text().size();
+        for (auto& run : fRuns) {
+            bytes += sizeof(Run) + run.size() * kBytesPerGlyph;
+        }
+        bytes += fClusters.size() * sizeof(Cluster);
+        bytes += fClustersIndexFromCodeUnit.size() * sizeof(size_t);
+        bytes += fCodeUnitProperties.size() * sizeof(SkUnicode::CodeUnitFlags);
+        bytes += fWords.size() * sizeof(size_t);
+        bytes += fBidiRegions.size() * sizeof(SkUnicode::BidiRegion);
+        return bytes;
+    }
+
     // Input == key
     ParagraphCacheKey fKey;
 
@@ -234,15 +250,26 @@ bool ParagraphCacheKey::operator==(const ParagraphCacheKey& other) const {
 
 struct ParagraphCache::Entry {
 
-    Entry(ParagraphCacheValue* value) : fValue(value) {}
+    // The entry keeps its shard's memory usage up to date, whether it is evicted by count, by
+    // size or by a reset.
+    Entry(ParagraphCacheValue* value, Shard* shard)
+        : fValue(value), fShard(shard), fMemoryUsage(value->memoryUsage()) {
+        fShard->fMemoryUsage += fMemoryUsage;
+    }
+    ~Entry() {
+        fShard->fMemoryUsage -= fMemoryUsage;
+    }
     std::unique_ptr<ParagraphCacheValue> fValue;
+    Shard* fShard;
+    size_t fMemoryUsage;
 };
 
+ParagraphCache::Shard::Shard() : fMemoryUsage(0), fLRUCacheMap(kMaxEntriesPerShard) {}
+
 ParagraphCache::ParagraphCache()
     : fChecker([](ParagraphImpl* impl, const char*, bool){ })
-    , fLRUCacheMap(kMaxEntries)
+    , fShardMemoryBudget(kDefaultMemoryBudget / kShardCount)
     , fCacheIsOn(true)
-    , fLastCachedValue(nullptr)
 #ifdef PARAGRAPH_CACHE_STATS
     , fTotalRequests(0)
     , fCacheMisses(0)
@@ -256,6 +283,7 @@ void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 
     paragraph->fRuns.clear();
     paragraph->fRuns = entry->fValue->fRuns;
+    paragraph->fShapingUnits.clear();
     paragraph->fClusters = entry->fValue->fClusters;
     paragraph->fClustersIndexFromCodeUnit = entry->fValue->fClustersIndexFromCodeUnit;
     paragraph->fCodeUnitProperties = entry->fValue->fCodeUnitProperties;
@@ -273,12 +301,15 @@ void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 }
 
 void ParagraphCache::printStatistics() {
+    const int totalRequests = fTotalRequests;
+    const int cacheMisses = fCacheMisses;
+    const int hashMisses = fHashMisses;
     SkDebugf("--- Paragraph Cache ---\n");
-    SkDebugf("Total requests: %d\n", fTotalRequests);
-    SkDebugf("Cache misses: %d\n", fCacheMisses);
-    SkDebugf("Cache miss %%: %f\n", (fTotalRequests > 0) ? 100.f * fCacheMisses / fTotalRequests : 0.f);
-    int cacheHits = fTotalRequests - fCacheMisses;
-    SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * fHashMisses / cacheHits : 0.f);
+    SkDebugf("Total requests: %d\n", totalRequests);
+    SkDebugf("Cache misses: %d\n", cacheMisses);
+    SkDebugf("Cache miss %%: %f\n", (totalRequests > 0) ? 100.f * cacheMisses / totalRequests : 0.f);
+    int cacheHits = totalRequests - cacheMisses;
+    SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * hashMisses / cacheHits : 0.f);
     SkDebugf("---------------------\n");
 }
 
@@ -287,14 +318,57 @@ void ParagraphCache::abandon() {
 }
 
 void ParagraphCache::reset() {
-    SkAutoMutexExclusive lock(fParagraphMutex);
 #ifdef PARAGRAPH_CACHE_STATS
     fTotalRequests = 0;
     fCacheMisses = 0;
     fHashMisses = 0;
 #endif
-    fLRUCacheMap.reset();
-    fLastCachedValue = nullptr;
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        shard.fLRUCacheMap.reset();
+        SkASSERT(shard.fMemoryUsage == 0);
+    }
+    SkAutoMutexExclusive lock(fLastCachedTextMutex);
+    fLastCachedTextPrefix.reset();
+    fLastCachedTextSuffix.reset();
+}
+
+int ParagraphCache::count() {
+    int count = 0;
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        count += shard.fLRUCacheMap.count();
+    }
+    return count;
+}
+
+void ParagraphCache::setMemoryBudget(size_t bytes) {
+    fShardMemoryBudget = bytes / kShardCount;
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        this->purgeAsNeeded(shard);
+    }
+}
+
+size_t ParagraphCache::memoryUsage() {
+    size_t bytes = 0;
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        bytes += shard.fMemoryUsage;
+    }
+    return bytes;
+}
+
+ParagraphCache::Shard& ParagraphCache::shardFor(const ParagraphCacheKey& key) {
+    // The low bits of the hash pick the slot in the shard's hash table, so use the high ones.
+    return fShards[(key.hash() >> 24) % kShardCount];
+}
+
+void ParagraphCache::purgeAsNeeded(Shard& shard) {
+    const size_t budget = fShardMemoryBudget;
+    while (shard.fMemoryUsage > budget && shard.fLRUCacheMap.count() > 0) {
+        shard.fLRUCacheMap.removeLRU();
+    }
 }
 
 bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
@@ -304,9 +378,10 @@ bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
 #ifdef PARAGRAPH_CACHE_STATS
     ++fTotalRequests;
 #endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key);
 
     if (!entry) {
         // We have a cache miss
@@ -328,10 +403,10 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
 #ifdef PARAGRAPH_CACHE_STATS
     ++fTotalRequests;
 #endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
-
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key);
     if (!entry) {
         // isTooMuchMemoryWasted(paragraph) not needed for now
         if (isPossiblyTextEditing(paragraph)) {
@@ -339,9 +414,9 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
             return false;
         }
         ParagraphCacheValue* value = new ParagraphCacheValue(std::move(key), paragraph);
-        fLRUCacheMap.insert(value->fKey, std::make_unique<Entry>(value));
+        shard.fLRUCacheMap.insert(value->fKey, std::make_unique<Entry>(value, &shard));
+        this->purgeAsNeeded(shard);
         fChecker(paragraph, "addedParagraph", true);
-        fLastCachedValue = value;
         return true;
     } else {
         // We do not have to update the paragraph
@@ -352,29 +427,34 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
 // Special situation: (very) long paragraph that is close to the last formatted paragraph
 #define NOCACHE_PREFIX_LENGTH 40
 bool ParagraphCache::isPossiblyTextEditing(ParagraphImpl* paragraph) {
-    if (fLastCachedValue == nullptr) {
-        return false;
-    }
-
-    auto& lastText = fLastCachedValue->fKey.text();
     auto& text = paragraph->fText;
 
-    if ((lastText.size() < NOCACHE_PREFIX_LENGTH) || (text.size() < NOCACHE_PREFIX_LENGTH)) {
-        // Either last text or the current are too short
+    SkAutoMutexExclusive lock(fLastCachedTextMutex);
+    auto& lastPrefix = fLastCachedTextPrefix;
+    auto& lastSuffix = fLastCachedTextSuffix;
+
+    if (text.size() < NOCACHE_PREFIX_LENGTH) {
+        // The current text is too short (and it is going to be the last text)
+        lastPrefix.reset();
+        lastSuffix.reset();
         return false;
     }
 
-    if (std::strncmp(lastText.c_str(), text.c_str(), NOCACHE_PREFIX_LENGTH) == 0) {
-        // Texts have the same starts
-        return true;
-    }
+    if (!lastPrefix.isEmpty()) {
+        if (std::strncmp(lastPrefix.c_str(), text.c_str(), NOCACHE_PREFIX_LENGTH) == 0) {
+            // Texts have the same starts
+            return true;
+        }
 
-    if (std::strncmp(lastText.c_str() + lastText.size() - NOCACHE_PREFIX_LENGTH, &text[text.size() - NOCACHE_PREFIX_LENGTH], NOCACHE_PREFIX_LENGTH) == 0) {
-        // Texts have the same ends
-        return true;
+        if (std::strncmp(lastSuffix.c_str(), &text[text.size() - NOCACHE_PREFIX_LENGTH], NOCACHE_PREFIX_LENGTH) == 0) {
+            // Texts have the same ends
+            return true;
+        }
     }
 
-    // It does not look like editing the text
+    // It does not look like editing the text; the caller is going to add it to the cache
+    lastPrefix.set(text.c_str(), NOCACHE_PREFIX_LENGTH);
+    lastSuffix.set(&text[text.size() - NOCACHE_PREFIX_LENGTH], NOCACHE_PREFIX_LENGTH);
     return false;
 }
 }  // namespace textlayout
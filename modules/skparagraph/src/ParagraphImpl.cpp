@@ -21,6 +21,7 @@
 #include "modules/skparagraph/src/TextWrapper.h"
 #include "modules/skunicode/include/SkUnicode.h"
 #include "src/base/SkUTF.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTextBlobPriv.h"
 
 #include <algorithm>
@@ -82,6 +83,7 @@ ParagraphImpl::ParagraphImpl(const SkString& text,
         , fText(text)
         , fState(kUnknown)
         , fUnresolvedGlyphs(0)
+        , fFirstChangedCluster(EMPTY_INDEX)
         , fPicture(nullptr)
         , fStrutMetrics(false)
         , fOldWidth(0)
@@ -156,6 +158,7 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
     }
 
     if (fState < kShaped) {
+        fFirstChangedCluster = EMPTY_INDEX;
         // Check if we have the text in the cache and don't need to shape it again
         if (!fFontCollection->getParagraphCache()->findParagraph(this)) {
             if (fState < kIndexed) {
@@ -167,6 +170,7 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
             }
             this->fRuns.clear();
             this->fClusters.clear();
+            this->fWrapWords.clear();
             this->fClustersIndexFromCodeUnit.clear();
             this->fClustersIndexFromCodeUnit.push_back_n(fText.size() + 1, EMPTY_INDEX);
             if (!this->shapeTextIntoEndlessLine()) {
@@ -197,6 +201,8 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
                 fFontCollection->getParagraphCache()->updateParagraph(this);
             }
         }
+        // Laying out the paragraph again at another width only needs the words
+        TextWrapper::BuildWords(this->clusters(), &fWrapWords);
         fState = kShaped;
     }
 
@@ -204,7 +210,6 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
         this->resetContext();
         this->resolveStrut();
         this->computeEmptyMetrics();
-        this->fLines.clear();
         this->breakShapedTextIntoLines(floorWidth);
         fState = kLineBroken;
     }
@@ -274,6 +279,7 @@ bool ParagraphImpl::computeCodeUnitProperties() {
     auto textDirection = fParagraphStyle.getTextDirection() == TextDirection::kLtr
                               ? SkUnicode::TextDirection::kLTR
                               : SkUnicode::TextDirection::kRTL;
+    fBidiRegions.clear();
     if (!fUnicode->getBidiRegions(fText.c_str(), fText.size(), textDirection, &fBidiRegions)) {
         return false;
     }
@@ -287,7 +293,14 @@ bool ParagraphImpl::computeCodeUnitProperties() {
         return false;
     }
 
-    // Get some information about trailing spaces / hard line breaks
+    this->computeTrailingSpaces();
+    return true;
+}
+
+// Get some information about trailing spaces / hard line breaks
+void ParagraphImpl::computeTrailingSpaces() {
+    fHasLineBreaks = false;
+    fHasWhitespacesInside = false;
     fTrailingSpaces = fText.size();
     TextIndex firstWhitespace = EMPTY_INDEX;
     for (int i = 0; i < fCodeUnitProperties.size(); ++i) {
@@ -310,8 +323,6 @@ bool ParagraphImpl::computeCodeUnitProperties() {
     if (firstWhitespace < fTrailingSpaces) {
         fHasWhitespacesInside = true;
     }
-
-    return true;
 }
 
 static bool is_ascii_7bit_space(int c) {
@@ -560,6 +571,7 @@ bool ParagraphImpl::shapeTextIntoEndlessLine() {
 
     fUnresolvedCodepoints.clear();
     fFontSwitches.clear();
+    fShapingUnits.clear();
 
     OneLineShaper oneLineShaper(this);
     auto result = oneLineShaper.shape();
@@ -572,7 +584,30 @@ bool ParagraphImpl::shapeTextIntoEndlessLine() {
 
 void ParagraphImpl::breakShapedTextIntoLines(SkScalar maxWidth) {
 
-    if (!fHasLineBreaks &&
+    // Keep the lines that the edits of the text since the last layout did not change
+    // and break the rest of the text from where the first changed line started
+    auto keptLines = this->countUnchangedLines(maxWidth);
+    fFirstChangedCluster = EMPTY_INDEX;
+    LineStart resume = {};
+    if (keptLines > 0) {
+        resume = fLineStarts[keptLines];
+        fLines.pop_back_n(fLines.size() - keptLines);
+        fLineStarts.pop_back_n(fLineStarts.size() - keptLines);
+        for (auto& line : fLines) {
+            line.resetTextBlobCache();
+            fLongestLine = std::max(fLongestLine, nearlyZero(line.widthWithoutEllipsis())
+                                                        ? line.widthWithSpaces()
+                                                        : line.widthWithoutEllipsis());
+            fMaxWidthWithTrailingSpaces = std::max(fMaxWidthWithTrailingSpaces,
+                                                   line.widthWithSpaces());
+        }
+    } else {
+        fLines.clear();
+        fLineStarts.clear();
+    }
+
+    if (keptLines == 0 &&
+        !fHasLineBreaks &&
         !fHasWhitespacesInside &&
         fPlaceholders.size() == 1 &&
         fRuns.size() == 1 && fRuns[0].fAdvance.fX <= maxWidth) {
@@ -638,6 +673,7 @@ void ParagraphImpl::breakShapedTextIntoLines(SkScalar maxWidth) {
     textWrapper.breakTextIntoLines(
             this,
             maxWidth,
+            keptLines > 0 ? &resume : nullptr,
             [&](TextRange textExcludingSpaces,
                 TextRange text,
                 TextRange textWithNewlines,
@@ -992,6 +1028,7 @@ void ParagraphImpl::setState(InternalState state) {
         case kIndexed:
             fRuns.clear();
             fClusters.clear();
+            fWrapWords.clear();
             [[fallthrough]];
 
         case kShaped:
@@ -1092,6 +1129,8 @@ void ParagraphImpl::updateFontSize(size_t from, size_t to, SkScalar fontSize) {
 
 void ParagraphImpl::updateTextAlign(TextAlign textAlign) {
     fParagraphStyle.setTextAlign(textAlign);
+    // Justified lines cannot be kept for another alignment
+    fLineStarts.clear();
 
     if (fState >= kLineBroken) {
         fState = kLineBroken;
@@ -1120,6 +1159,362 @@ void ParagraphImpl::updateBackgroundPaint(size_t from, size_t to, SkPaint paint)
     }
 }
 
+bool ParagraphImpl::updateText(size_t from, size_t to, const SkString& text) {
+    auto isCharStart = [this](size_t index) {
+        return index == fText.size() || (fText.c_str()[index] & 0xC0) != 0x80;
+    };
+    if (from > to || to > fText.size() || !isCharStart(from) || !isCharStart(to) ||
+        SkUTF::CountUTF8(text.c_str(), text.size()) < 0) {
+        return false;
+    }
+
+    // The edit has to stay within the text before one placeholder
+    auto placeholder = std::find_if(fPlaceholders.begin(), fPlaceholders.end(),
+                                    [to](const Placeholder& p) { return p.fTextBefore.end >= to; });
+    if (placeholder == fPlaceholders.end() || placeholder->fTextBefore.start > from) {
+        return false;
+    }
+
+    // The new text takes the style of the text before it
+    // (or after it, at the start of the text between the placeholders)
+    auto findStyle = [this, from](bool after) {
+        for (int i = 0; i < fTextStyles.size(); ++i) {
+            auto& range = fTextStyles[i].fRange;
+            if (!fTextStyles[i].fStyle.isPlaceholder() &&
+                (after ? range.start == from && range.end > from
+                       : range.start < from && from <= range.end)) {
+                return i;
+            }
+        }
+        return -1;
+    };
+    int styleIndex = findStyle(from == placeholder->fTextBefore.start);
+    if (styleIndex < 0) {
+        // There is no text around to take the style from
+        styleIndex = std::find_if(fTextStyles.begin(), fTextStyles.end(),
+                                  [from](const Block& block) { return block.fRange.start >= from; })
+                     - fTextStyles.begin();
+        fTextStyles.emplace_back(from, from, placeholder->fTextStyle);
+        std::rotate(fTextStyles.begin() + styleIndex, fTextStyles.end() - 1, fTextStyles.end());
+    }
+
+    // Move the styles and the placeholders with the text
+    const size_t length = text.size();
+    auto moveStart = [from, to, length](TextIndex index) {
+        return index < from ? index : index < to ? from + length : index - to + from + length;
+    };
+    auto moveEnd = [from, to, length](TextIndex index) {
+        return index <= from ? index : index <= to ? from + length : index - to + from + length;
+    };
+    for (int i = styleIndex; i < fTextStyles.size(); ++i) {
+        auto& range = fTextStyles[i].fRange;
+        if (i == styleIndex) {
+            range = TextRange(range.start, std::max(moveEnd(range.end), from + length));
+        } else {
+            auto start = moveStart(range.start);
+            range = TextRange(start, std::max(moveEnd(range.end), start));
+        }
+    }
+    // (the placeholders after the edit move as a whole, even when the edit only inserts text)
+    auto shift = [from, to, length](TextIndex index) { return index - to + from + length; };
+    for (auto p = placeholder; p != fPlaceholders.end(); ++p) {
+        p->fTextBefore = TextRange(p == placeholder ? p->fTextBefore.start
+                                                    : shift(p->fTextBefore.start),
+                                   shift(p->fTextBefore.end));
+        p->fRange = TextRange(shift(p->fRange.start), shift(p->fRange.end));
+    }
+
+    fText.remove(from, to - from);
+    fText.insert(from, text);
+
+    fWords.clear();
+    if (!fUTF16IndexForUTF8Index.empty()) {
+        fUTF8IndexForUTF16Index.clear();
+        fUTF16IndexForUTF8Index.clear();
+        this->extractUTF16Mapping();
+    }
+
+    bool hasSpacing = std::any_of(fTextStyles.begin(), fTextStyles.end(), [](const Block& block) {
+        return !SkScalarNearlyZero(block.fStyle.getLetterSpacing()) ||
+               !SkScalarNearlyZero(block.fStyle.getWordSpacing());
+    });
+    if (fState < kShaped || fShapingUnits.empty() || fText.isEmpty() || hasSpacing ||
+        !this->shapeEditedText(from, to, length)) {
+        // Index and shape the entire text again
+        fState = kUnknown;
+    }
+    return true;
+}
+
+// Shapes again only the units of the text that the edit [from:to) -> [from:from + length)
+// could have changed, and copies the runs of the rest
+bool ParagraphImpl::shapeEditedText(TextIndex from, TextIndex to, size_t length) {
+    const TextIndex editEnd = from + length;
+    const size_t oldSize = fText.size() - length + (to - from);
+    // Indexes after the edit moved by editEnd - to
+    auto oldIndex = [editEnd, to](TextIndex index) { return index - editEnd + to; };
+    auto newIndex = [editEnd, to](TextIndex index) { return index - to + editEnd; };
+
+    // Bidi regions, line breaks and graphemes do not go across hard line breaks,
+    // so only the lines with the edit (and the units shaped again) are indexed again
+    auto lineStart = [this](TextIndex index) {
+        while (index > 0 && fText.c_str()[index - 1] != '\n') {
+            --index;
+        }
+        return index;
+    };
+    auto lineEnd = [this](TextIndex index) {
+        while (index < fText.size()) {
+            if (fText.c_str()[index++] == '\n') {
+                break;
+            }
+        }
+        return index;
+    };
+    TextRange lines(lineStart(from), lineEnd(editEnd));
+    if (lines.width() == 0) {
+        lines.start = lineStart(lines.start - 1);
+    }
+
+    auto textDirection = fParagraphStyle.getTextDirection() == TextDirection::kLtr
+                              ? SkUnicode::TextDirection::kLTR
+                              : SkUnicode::TextDirection::kRTL;
+    auto oldUnits = std::move(fShapingUnits);
+    auto oldBidiRegions = std::move(fBidiRegions);
+    auto oldFontSwitches = std::move(fFontSwitches);
+    TArray<ShapingUnit, true> units;
+    TArray<size_t, true> oldUnitIndexes;  // EMPTY_INDEX if the unit has to be shaped again
+    while (true) {
+        std::vector<SkUnicode::BidiRegion> regions;
+        if (!fUnicode->getBidiRegions(fText.c_str() + lines.start, lines.width(), textDirection, &regions)) {
+            return false;
+        }
+        fBidiRegions.clear();
+        auto addRegion = [this](size_t start, size_t end, SkUnicode::BidiLevel level) {
+            if (start >= end) {
+                return;
+            }
+            if (!fBidiRegions.empty() &&
+                fBidiRegions.back().end == start && fBidiRegions.back().level == level) {
+                fBidiRegions.back().end = end;
+            } else {
+                fBidiRegions.emplace_back(start, end, level);
+            }
+        };
+        const TextIndex oldLinesEnd = oldIndex(lines.end);
+        for (auto& region : oldBidiRegions) {
+            if (region.start < lines.start) {
+                addRegion(region.start, std::min(region.end, lines.start), region.level);
+            }
+        }
+        for (auto& region : regions) {
+            addRegion(region.start + lines.start, region.end + lines.start, region.level);
+        }
+        for (auto& region : oldBidiRegions) {
+            if (region.end > oldLinesEnd) {
+                addRegion(newIndex(std::max(region.start, oldLinesEnd)), newIndex(region.end),
+                          region.level);
+            }
+        }
+
+        // Find the units without shaping them and match them with the old ones
+        fShapingUnits.clear();
+        if (!OneLineShaper(this).shape([](const ShapingUnit&, SkScalar&) { return true; })) {
+            return false;
+        }
+        units = std::move(fShapingUnits);
+        oldUnitIndexes.clear();
+        TextRange changedLines = lines;
+        for (auto& unit : units) {
+            size_t oldUnitIndex = EMPTY_INDEX;
+            if (unit.fPlaceholder || unit.fText.start > editEnd || unit.fText.end < from) {
+                TextRange oldText = unit.fText.end <= from
+                        ? unit.fText
+                        : TextRange(oldIndex(unit.fText.start), oldIndex(unit.fText.end));
+                auto old = std::lower_bound(oldUnits.begin(), oldUnits.end(), oldText.start,
+                                            [](const ShapingUnit& u, TextIndex start) {
+                                                return u.fText.start < start;
+                                            });
+                if (old != oldUnits.end() && old->fText == oldText &&
+                    old->fBidiLevel == unit.fBidiLevel && old->fPlaceholder == unit.fPlaceholder &&
+                    old->fUnresolvedGlyphs == 0) {
+                    oldUnitIndex = old - oldUnits.begin();
+                }
+            }
+            if (oldUnitIndex == EMPTY_INDEX && unit.fText.width() > 0) {
+                changedLines.start = std::min(changedLines.start, lineStart(unit.fText.start));
+                changedLines.end = std::max(changedLines.end, lineEnd(unit.fText.end - 1));
+            }
+            oldUnitIndexes.push_back(oldUnitIndex);
+        }
+        if (changedLines == lines) {
+            break;
+        }
+        lines = changedLines;
+    }
+
+    // Index the lines again
+    TArray<SkUnicode::CodeUnitFlags, true> lineProperties;
+    if (!fUnicode->computeCodeUnitFlags(fText.data() + lines.start,
+                                        lines.width(),
+                                        this->paragraphStyle().getReplaceTabCharacters(),
+                                        &lineProperties)) {
+        return false;
+    }
+    const auto lineBreaks = SkUnicode::CodeUnitFlags::kSoftLineBreakBefore |
+                            SkUnicode::CodeUnitFlags::kHardLineBreakBefore;
+    TArray<SkUnicode::CodeUnitFlags, true> properties;
+    properties.reserve_exact(fText.size() + 1);
+    properties.push_back_n(lines.start, fCodeUnitProperties.begin());
+    properties.push_back_n(lines.width(), lineProperties.begin());
+    if (fText.c_str()[lines.end - 1] == '\n') {
+        // The hard line break after the lines is the one the lines end with
+        properties.push_back_n(oldSize + 1 - oldIndex(lines.end),
+                               fCodeUnitProperties.begin() + oldIndex(lines.end));
+        properties[lines.end] = (properties[lines.end] & ~lineBreaks) |
+                                (lineProperties[lines.width()] & lineBreaks);
+    } else {
+        properties.push_back(lineProperties[lines.width()]);
+    }
+    if (lines.start > 0) {
+        // The line break before the lines is the one after the previous line
+        properties[lines.start] = (lineProperties[0] & ~lineBreaks) |
+                                  (fCodeUnitProperties[lines.start] & lineBreaks);
+    }
+    // Keep the old clusters before the edit to see which of them did not change
+    TArray<SkUnicode::CodeUnitFlags, true> oldProperties;
+    oldProperties.push_back_n(from - lines.start + 1, fCodeUnitProperties.begin() + lines.start);
+    fCodeUnitProperties = std::move(properties);
+    auto oldClusters = std::move(fClusters);
+    auto oldRuns = std::move(fRuns);
+
+    // Shape the units that could have changed and copy the runs of the others
+    fRuns.clear();
+    fClusters.clear();
+    fFontSwitches.clear();
+    fShapingUnits.clear();
+    fUnresolvedCodepoints.clear();
+    size_t unitIndex = 0;
+    OneLineShaper oneLineShaper(this);
+    auto result = oneLineShaper.shape([&](const ShapingUnit& unit, SkScalar& advanceX) {
+        SkASSERT(unitIndex < SkToSizeT(oldUnitIndexes.size()));
+        SkASSERT(unit.fText == units[unitIndex].fText);
+        auto oldUnitIndex = oldUnitIndexes[unitIndex++];
+        if (oldUnitIndex == EMPTY_INDEX) {
+            return false;
+        }
+        const ShapingUnit& old = oldUnits[oldUnitIndex];
+        TextIndex textShift = unit.fText.start - old.fText.start;
+        SkScalar shiftX = advanceX - old.fAdvanceX;
+        for (auto i = old.fRuns.start; i < old.fRuns.end; ++i) {
+            fRuns.emplace_back(oldRuns[i], fRuns.size(), textShift, shiftX);
+        }
+        for (auto i = old.fFontSwitches.start; i < old.fFontSwitches.end; ++i) {
+            fFontSwitches.emplace_back(oldFontSwitches[i].fTextStart + textShift,
+                                       oldFontSwitches[i].fFont);
+        }
+        advanceX = old.fEndAdvanceX + shiftX;
+        return true;
+    });
+    if (!result) {
+        return false;
+    }
+    fUnresolvedGlyphs = oneLineShaper.unresolvedGlyphs();
+
+    fClustersIndexFromCodeUnit.clear();
+    fClustersIndexFromCodeUnit.push_back_n(fText.size() + 1, EMPTY_INDEX);
+    this->buildClusterTable();
+    TextWrapper::BuildWords(this->clusters(), &fWrapWords);
+    this->computeTrailingSpaces();
+
+    // Find the first cluster that is not the same as before (with the same glyphs)
+    auto sameRuns = [](const Run& run, const Run& old) {
+        return run.fFont == old.fFont &&
+               run.fBidiLevel == old.fBidiLevel &&
+               run.fPlaceholderIndex == old.fPlaceholderIndex &&
+               run.fTextRange.start == old.fTextRange.start &&
+               run.fClusterStart == old.fClusterStart &&
+               run.fOffset == old.fOffset &&
+               run.fHeightMultiplier == old.fHeightMultiplier &&
+               run.fUseHalfLeading == old.fUseHalfLeading &&
+               run.fBaselineShift == old.fBaselineShift &&
+               run.fFontMetrics.fAscent == old.fFontMetrics.fAscent &&
+               run.fFontMetrics.fDescent == old.fFontMetrics.fDescent &&
+               run.fFontMetrics.fLeading == old.fFontMetrics.fLeading;
+    };
+    auto sameClusters = [&](const Cluster& cluster, const Cluster& old) {
+        if (!(cluster.textRange() == old.textRange()) ||
+            cluster.runIndex() != old.runIndex() ||
+            cluster.startPos() != old.startPos() ||
+            cluster.endPos() != old.endPos() ||
+            cluster.width() != old.width() ||
+            cluster.height() != old.height() ||
+            cluster.isWhitespaceBreak() != old.isWhitespaceBreak() ||
+            cluster.isIntraWordBreak() != old.isIntraWordBreak() ||
+            cluster.isHardBreak() != old.isHardBreak() ||
+            cluster.isIdeographic() != old.isIdeographic()) {
+            return false;
+        }
+        for (auto i = std::max(cluster.textRange().start, lines.start);
+             i <= cluster.textRange().end; ++i) {
+            if (fCodeUnitProperties[i] != oldProperties[i - lines.start]) {
+                return false;
+            }
+        }
+        if (cluster.runIndex() == EMPTY_RUN) {
+            return false;
+        }
+        const Run& run = fRuns[cluster.runIndex()];
+        const Run& oldRun = oldRuns[cluster.runIndex()];
+        if (run.fGlyphData == oldRun.fGlyphData) {
+            return true;
+        }
+        if (!sameRuns(run, oldRun)) {
+            return false;
+        }
+        auto start = std::min(cluster.startPos(), cluster.endPos());
+        auto end = std::max(cluster.startPos(), cluster.endPos());
+        for (auto i = start; i <= end; ++i) {
+            if ((i < end && run.fGlyphs[i] != oldRun.fGlyphs[i]) ||
+                run.fPositions[i] != oldRun.fPositions[i] ||
+                run.fOffsets[i] != oldRun.fOffsets[i] ||
+                run.fClusterIndexes[i] != oldRun.fClusterIndexes[i]) {
+                return false;
+            }
+        }
+        return true;
+    };
+    // The clusters before the lines came out of the same runs
+    ClusterIndex firstChanged = fClustersIndexFromCodeUnit[lines.start];
+    while (firstChanged + 1 < SkToSizeT(fClusters.size()) &&
+           firstChanged + 1 < SkToSizeT(oldClusters.size()) &&
+           fClusters[firstChanged].textRange().end <= from &&
+           sameClusters(fClusters[firstChanged], oldClusters[firstChanged])) {
+        ++firstChanged;
+    }
+    fFirstChangedCluster = std::min(fFirstChangedCluster, firstChanged);
+    fState = kShaped;
+    return true;
+}
+
+// The number of lines at the start that come out the same after the edits of the text
+size_t ParagraphImpl::countUnchangedLines(SkScalar maxWidth) const {
+    if (fFirstChangedCluster == EMPTY_INDEX || maxWidth != fOldWidth ||
+        fLines.empty() || fLines.size() != fLineStarts.size() ||
+        !fParagraphStyle.unlimited_lines() || fParagraphStyle.ellipsized() ||
+        fParagraphStyle.effective_align() == TextAlign::kJustify) {
+        return 0;
+    }
+
+    // A line comes out the same if the lines before it only looked at the clusters before
+    // the first changed one (the last line is always broken again)
+    size_t lines = fLines.size() - 1;
+    while (lines > 0 && fLineStarts[lines].fLastClusterRead >= fFirstChangedCluster) {
+        --lines;
+    }
+    return lines;
+}
+
 TArray<TextIndex> ParagraphImpl::countSurroundingGraphemes(TextRange textRange) const {
     textRange = textRange.intersection({0, fText.size()});
     TArray<TextIndex> graphemes;
@@ -1169,13 +1564,17 @@ TextIndex ParagraphImpl::findPreviousGlyphClusterBoundary(TextIndex utf8) const
 
 void ParagraphImpl::ensureUTF16Mapping() {
     fillUTF16MappingOnce([&] {
-        SkUnicode::extractUtfConversionMapping(
-                this->text(),
-                [&](size_t index) { fUTF8IndexForUTF16Index.emplace_back(index); },
-                [&](size_t index) { fUTF16IndexForUTF8Index.emplace_back(index); });
+        this->extractUTF16Mapping();
     });
 }
 
+void ParagraphImpl::extractUTF16Mapping() {
+    SkUnicode::extractUtfConversionMapping(
+            this->text(),
+            [&](size_t index) { fUTF8IndexForUTF16Index.emplace_back(index); },
+            [&](size_t index) { fUTF16IndexForUTF8Index.emplace_back(index); });
+}
+
 void ParagraphImpl::visit(const Visitor& visitor) {
     int lineNumber = 0;
     for (auto& line : fLines) {
@@ -1501,6 +1900,25 @@ int ParagraphImpl::getPath(int lineNumber, SkPath* dest) {
     return notConverted;
 }
 
+void Paragraph::LayoutAll(SkSpan<Paragraph* const> paragraphs,
+                          SkScalar width,
+                          SkExecutor* executor) {
+    if (executor == nullptr || paragraphs.size() < 2) {
+        for (Paragraph* paragraph : paragraphs) {
+            paragraph->layout(width);
+        }
+        return;
+    }
+
+    // Each paragraph is a task: the paragraphs of a document vary too much in length for
+    // fixed size batches to balance well, and a layout costs much more than a task.
+    SkTaskGroup taskGroup(*executor);
+    taskGroup.batch(SkToInt(paragraphs.size()), [paragraphs, width](int i) {
+        paragraphs[i]->layout(width);
+    });
+    taskGroup.wait();
+}
+
 SkPath Paragraph::GetPath(SkTextBlob* textBlob) {
     SkPath path;
     SkTextBlobRunIterator iter(textBlob);
@@ -68,6 +68,30 @@ struct ResolvedFontDescriptor {
     TextIndex fTextStart;
 };
 
+// A piece of the text that is shaped on its own (the text of one font between bidi region,
+// placeholder and hard line break boundaries, or a placeholder), and what its shaping added
+// to the paragraph
+struct ShapingUnit {
+    TextRange fText;
+    uint8_t fBidiLevel;
+    bool fPlaceholder;
+    SkRange<size_t> fRuns;
+    SkRange<size_t> fFontSwitches;
+    size_t fUnresolvedGlyphs;
+    SkScalar fAdvanceX;     // Where the unit starts on the endless line
+    SkScalar fEndAdvanceX;  // and where it ends
+};
+
+// What the line breaking had added up before a line started, so it can start again from there
+struct LineStart {
+    ClusterIndex fCluster;
+    ClusterIndex fLastClusterRead;  // The last cluster the lines before looked at
+    SkScalar fHeight;
+    SkScalar fMinIntrinsicWidth;
+    SkScalar fMaxIntrinsicWidth;
+    SkScalar fSoftLineMaxIntrinsicWidth;
+};
+
 enum InternalState {
   kUnknown = 0,
   kIndexed = 1,     // Text is indexed
@@ -138,6 +162,11 @@ public:
     SkSpan<TextLine> lines() { return SkSpan<TextLine>(fLines.data(), fLines.size()); }
     const ParagraphStyle& paragraphStyle() const { return fParagraphStyle; }
     SkSpan<Cluster> clusters() { return SkSpan<Cluster>(fClusters.begin(), fClusters.size()); }
+    SkSpan<const WrapWord> wrapWords() const {
+        return SkSpan<const WrapWord>(fWrapWords.begin(), fWrapWords.size());
+    }
+    // Without the words, the lines are wrapped a cluster at a time until the text is shaped again
+    void clearWrapWordsForTesting() { fWrapWords.clear(); }
     sk_sp<FontCollection> fontCollection() const { return fFontCollection; }
     void formatLines(SkScalar maxWidth);
     void ensureUTF16Mapping();
@@ -207,6 +236,7 @@ public:
     void updateFontSize(size_t from, size_t to, SkScalar fontSize) override;
     void updateForegroundPaint(size_t from, size_t to, SkPaint paint) override;
     void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) override;
+    bool updateText(size_t from, size_t to, const SkString& text) override;
 
     void visit(const Visitor&) override;
     void extendedVisit(const ExtendedVisitor&) override;
@@ -256,6 +286,10 @@ private:
     friend class OneLineShaper;
 
     void computeEmptyMetrics();
+    void computeTrailingSpaces();
+    void extractUTF16Mapping();
+    bool shapeEditedText(TextIndex from, TextIndex to, size_t length);
+    size_t countUnchangedLines(SkScalar maxWidth) const;
 
     // Input
     skia_private::TArray<StyleBlock<SkScalar>> fLetterSpaceStyles;
@@ -271,7 +305,9 @@ private:
     // Internal structures
     InternalState fState;
     skia_private::TArray<Run, false> fRuns;         // kShaped
+    skia_private::TArray<ShapingUnit, true> fShapingUnits;  // kShaped (not cached)
     skia_private::TArray<Cluster, true> fClusters;  // kClusterized (cached: text, word spacing, letter spacing, resolved fonts)
+    skia_private::TArray<WrapWord, true> fWrapWords;  // kShaped
     skia_private::TArray<SkUnicode::CodeUnitFlags, true> fCodeUnitProperties;
     skia_private::TArray<size_t, true> fClustersIndexFromCodeUnit;
     std::vector<size_t> fWords;
@@ -285,6 +321,9 @@ private:
     std::unordered_set<SkUnichar> fUnresolvedCodepoints;
 
     skia_private::TArray<TextLine, false> fLines;   // kFormatted   (cached: width, max lines, ellipsis, text align)
+    skia_private::TArray<LineStart, true> fLineStarts;  // kLineBroken (one for each line)
+    // The lines made of the clusters before this one did not change with the edits of the text
+    ClusterIndex fFirstChangedCluster;
     sk_sp<SkPicture> fPicture;          // kRecorded    (cached: text styles)
 
     skia_private::TArray<ResolvedFontDescriptor> fFontSwitches;
@@ -58,6 +58,40 @@ Run::Run(ParagraphImpl* owner,
     fPlaceholderIndex = std::numeric_limits<size_t>::max();
 }
 
+Run::Run(const Run& run, size_t index, TextIndex textShift, SkScalar shiftX)
+    : fOwner(run.fOwner)
+    , fTextRange(run.fTextRange.start + textShift, run.fTextRange.end + textShift)
+    , fClusterRange(EMPTY_CLUSTERS)
+    , fFont(run.fFont)
+    , fPlaceholderIndex(run.fPlaceholderIndex)
+    , fIndex(index)
+    , fAdvance(run.fAdvance)
+    , fOffset(run.fOffset + SkVector::Make(shiftX, 0))
+    , fClusterStart(run.fClusterStart + textShift)
+    , fUtf8Range(run.fUtf8Range)
+    // Only the positions change, so the glyphs are shared unless the run moves along the line
+    , fGlyphData(shiftX == 0 ? run.fGlyphData : std::make_shared<GlyphData>(*run.fGlyphData))
+    , fGlyphs(fGlyphData->glyphs)
+    , fPositions(fGlyphData->positions)
+    , fOffsets(fGlyphData->offsets)
+    , fClusterIndexes(fGlyphData->clusterIndexes)
+    , fFontMetrics(run.fFontMetrics)
+    , fHeightMultiplier(run.fHeightMultiplier)
+    , fUseHalfLeading(run.fUseHalfLeading)
+    , fBaselineShift(run.fBaselineShift)
+    , fCorrectAscent(run.fCorrectAscent)
+    , fCorrectDescent(run.fCorrectDescent)
+    , fCorrectLeading(run.fCorrectLeading)
+    , fEllipsis(run.fEllipsis)
+    , fBidiLevel(run.fBidiLevel)
+{
+    if (shiftX != 0) {
+        for (auto& position : fPositions) {
+            position.fX += shiftX;
+        }
+    }
+}
+
 void Run::calculateMetrics() {
     fCorrectAscent = fFontMetrics.fAscent - fFontMetrics.fLeading * 0.5;
     fCorrectDescent = fFontMetrics.fDescent + fFontMetrics.fLeading * 0.5;
@@ -62,6 +62,9 @@ public:
         SkScalar baselineShift,
         size_t index,
         SkScalar shiftX);
+    // The same glyphs moved along the text by textShift and along the line by shiftX
+    // (when an edit of the text does not change them)
+    Run(const Run& run, size_t index, TextIndex textShift, SkScalar shiftX);
     Run(const Run&) = default;
     Run& operator=(const Run&) = delete;
     Run(Run&&) = default;
@@ -516,6 +519,17 @@ private:
 
     bool fForceStrut;
 };
+
+// The clusters [fStart:fEnd) of a word that ends with a soft line break and has no hard line
+// breaks or placeholders in it. Words only depend on shaping, so the paragraph keeps them between
+// layouts and TextWrapper places a whole word at once when it fits the line.
+struct WrapWord {
+    ClusterIndex fStart;
+    ClusterIndex fEnd;
+    SkScalar fWidth;
+    SkScalar fTrimmedWidth;
+    InternalLineMetrics fMetrics;
+};
 }  // namespace textlayout
 }  // namespace skia
 
@@ -162,8 +162,18 @@ TextLine::TextLine(ParagraphImpl* owner,
 
     AutoSTArray<kPreallocCount, int32_t> logicalOrder(numRuns);
 
-    // TODO: hide all these logic in SkUnicode?
-    fOwner->getUnicode()->reorderVisual(runLevels.data(), numRuns, logicalOrder.data());
+    // Most lines have a single bidi level; they don't need the Unicode reordering
+    bool oneLevel = std::all_of(runLevels.data(), runLevels.data() + numRuns,
+                                [&](SkUnicode::BidiLevel level) { return level == runLevels[0]; });
+    if (oneLevel) {
+        bool rightToLeft = runLevels[0] % 2 == 1;
+        for (size_t i = 0; i < numRuns; ++i) {
+            logicalOrder[i] = SkToS32(rightToLeft ? numRuns - 1 - i : i);
+        }
+    } else {
+        // TODO: hide all these logic in SkUnicode?
+        fOwner->getUnicode()->reorderVisual(runLevels.data(), numRuns, logicalOrder.data());
+    }
     auto firstRunIndex = start.runIndex();
     auto placeholderIter = placeholdersInOriginalOrder.begin();
     for (auto index : logicalOrder) {
@@ -79,6 +79,7 @@ public:
         return fAdvance.fX + (fEllipsis != nullptr ? fEllipsis->fAdvance.fX : 0);
     }
     SkScalar widthWithoutEllipsis() const { return fAdvance.fX; }
+    SkScalar widthWithSpaces() const { return fWidthWithSpaces; }
     SkVector offset() const;
 
     SkScalar alphabeticBaseline() const { return fSizes.alphabeticBaseline(); }
@@ -106,6 +107,11 @@ public:
     void paint(ParagraphPainter* painter, SkScalar x, SkScalar y);
     void visit(SkScalar x, SkScalar y);
     void ensureTextBlobCachePopulated();
+    // The text blobs point to the runs (when the paragraph makes its runs again)
+    void resetTextBlobCache() {
+        fTextBlobCachePopulated = false;
+        fTextBlobCache.clear();
+    }
 
     void createEllipsis(SkScalar maxWidth, const SkString& ellipsis, bool ltr);
 
@@ -60,6 +60,24 @@ void TextWrapper::lookAhead(SkScalar maxWidth, Cluster* endOfClusters, bool appl
     LineBreakerWithLittleRounding breaker(maxWidth, applyRoundingHack);
     Cluster* nextNonBreakingSpace = nullptr;
     for (auto cluster = fEndLine.endCluster(); cluster < endOfClusters; ++cluster) {
+        this->read(cluster);
+        if (fClusters.empty()) {
+            // Place the whole word if none of its clusters can come close to breaking the line
+            // (with some slack for adding up the widths in a different order)
+            if (const WrapWord* word = this->wordStartingAt(cluster)) {
+                SkScalar width = fWords.width() + word->fWidth;
+                SkScalar slack = (std::fabs(fWords.width()) + word->fWidth) * 1e-5f;
+                if (width + slack < breaker.fLower) {
+                    Cluster* last = fFirstCluster + word->fEnd - 1;
+                    fClusters.extend(cluster, last, *word);
+                    fMinIntrinsicWidth = std::max(fMinIntrinsicWidth, word->fTrimmedWidth);
+                    fWords.extend(fClusters);
+                    cluster = last;
+                    continue;
+                }
+            }
+        }
+
         if (cluster->isHardBreak()) {
         } else if (
                 // TODO: Trying to deal with flutter rounding problem. Must be removed...
@@ -94,6 +112,7 @@ void TextWrapper::lookAhead(SkScalar maxWidth, Cluster* endOfClusters, bool appl
             SkScalar nextWordLength = fClusters.width();
             SkScalar nextShortWordLength = nextWordLength;
             for (auto further = cluster; further != endOfClusters; ++further) {
+                this->read(further);
                 if (further->isSoftBreak() || further->isHardBreak() || further->isWhitespaceBreak()) {
                     break;
                 }
@@ -221,10 +240,14 @@ void TextWrapper::trimEndSpaces(TextAlign align) {
 }
 
 SkScalar TextWrapper::getClustersTrimmedWidth() {
+    return TrimmedWidth(fClusters.startCluster(), fClusters.endCluster());
+}
+
+SkScalar TextWrapper::TrimmedWidth(Cluster* start, Cluster* end) {
     // Move the end of the line to the left
     SkScalar width = 0;
     bool trailingSpaces = true;
-    for (auto cluster = fClusters.endCluster(); cluster >= fClusters.startCluster(); --cluster) {
+    for (auto cluster = end; cluster >= start; --cluster) {
         if (cluster->run().isPlaceholder()) {
             continue;
         }
@@ -240,6 +263,60 @@ SkScalar TextWrapper::getClustersTrimmedWidth() {
     return width;
 }
 
+void TextWrapper::BuildWords(SkSpan<Cluster> clusters,
+                             skia_private::TArray<WrapWord, true>* words) {
+    words->clear();
+    if (clusters.empty()) {
+        return;
+    }
+    Cluster* begin = clusters.begin();
+    Cluster* end = clusters.end() - 1;
+    Cluster* start = begin;
+    SkScalar width = 0;
+    InternalLineMetrics metrics;
+    for (auto cluster = begin; cluster < end; ++cluster) {
+        if (cluster->isHardBreak() || cluster->run().isPlaceholder() || !(cluster->width() >= 0)) {
+            // Leave these to lookAhead
+            start = cluster + 1;
+            width = 0;
+            metrics.clean();
+            continue;
+        }
+        // Add up the widths in the same order as lookAhead does
+        width += cluster->width();
+        metrics.add(&cluster->run());
+        if (cluster->isSoftBreak()) {
+            words->push_back({SkToSizeT(start - begin),
+                              SkToSizeT(cluster - begin) + 1,
+                              width,
+                              TrimmedWidth(start, cluster),
+                              metrics});
+            start = cluster + 1;
+            width = 0;
+            metrics.clean();
+        }
+    }
+}
+
+const WrapWord* TextWrapper::wordStartingAt(Cluster* cluster) {
+    ClusterIndex index = cluster - fFirstCluster;
+    if (fNextWord > 0 && fWrapWords[fNextWord - 1].fStart >= index) {
+        // Lines may start before the point the previous line looked ahead to
+        fNextWord = std::lower_bound(fWrapWords.begin(), fWrapWords.end(), index,
+                                     [](const WrapWord& word, ClusterIndex i) {
+                                         return word.fStart < i;
+                                     }) - fWrapWords.begin();
+    }
+    while (fNextWord < fWrapWords.size() && fWrapWords[fNextWord].fStart < index) {
+        ++fNextWord;
+    }
+    if (fNextWord < fWrapWords.size() && fWrapWords[fNextWord].fStart == index) {
+        this->read(fFirstCluster + fWrapWords[fNextWord].fEnd - 1);
+        return &fWrapWords[fNextWord++];
+    }
+    return nullptr;
+}
+
 // Trim the beginning spaces in case of soft line break
 std::tuple<Cluster*, size_t, SkScalar> TextWrapper::trimStartSpaces(Cluster* endOfClusters) {
 
@@ -276,6 +353,7 @@ std::tuple<Cluster*, size_t, SkScalar> TextWrapper::trimStartSpaces(Cluster* end
 // TODO: refactor the code for line ending (with/without ellipsis)
 void TextWrapper::breakTextIntoLines(ParagraphImpl* parent,
                                      SkScalar maxWidth,
+                                     const LineStart* resume,
                                      const AddLineToParagraph& addLine) {
     fHeight = 0;
     fMinIntrinsicWidth = std::numeric_limits<SkScalar>::min();
@@ -285,6 +363,9 @@ void TextWrapper::breakTextIntoLines(ParagraphImpl* parent,
     if (span.empty()) {
         return;
     }
+    fWrapWords = parent->wrapWords();
+    fFirstCluster = span.begin();
+    fNextWord = 0;
     auto maxLines = parent->paragraphStyle().getMaxLines();
     auto align = parent->paragraphStyle().effective_align();
     auto unlimitedLines = maxLines == std::numeric_limits<size_t>::max();
@@ -301,7 +382,30 @@ void TextWrapper::breakTextIntoLines(ParagraphImpl* parent,
     auto start = span.begin();
     InternalLineMetrics maxRunMetrics;
     bool needEllipsis = false;
+    fLastClusterRead = start;
+    if (resume != nullptr) {
+        // Carry on after the lines the paragraph has kept, as if it had just broken them
+        fHeight = resume->fHeight;
+        fMinIntrinsicWidth = resume->fMinIntrinsicWidth;
+        fMaxIntrinsicWidth = resume->fMaxIntrinsicWidth;
+        softLineMaxIntrinsicWidth = resume->fSoftLineMaxIntrinsicWidth;
+        fLastClusterRead = start + resume->fLastClusterRead;
+        fLineNumber = parent->lines().size() + 1;
+        firstLine = false;
+        fEndLine.clean();
+        fEndLine.startFrom(start + resume->fCluster, 0);
+        fNextWord = std::lower_bound(fWrapWords.begin(), fWrapWords.end(), resume->fCluster,
+                                     [](const WrapWord& word, ClusterIndex i) {
+                                         return word.fStart < i;
+                                     }) - fWrapWords.begin();
+    }
     while (fEndLine.endCluster() != end) {
+        LineStart lineStart = {SkToSizeT(fEndLine.startCluster() - start),
+                               SkToSizeT(fLastClusterRead - start),
+                               fHeight,
+                               fMinIntrinsicWidth,
+                               fMaxIntrinsicWidth,
+                               softLineMaxIntrinsicWidth};
 
         this->lookAhead(maxWidth, end, parent->getApplyRoundingHack());
 
@@ -319,6 +423,7 @@ void TextWrapper::breakTextIntoLines(ParagraphImpl* parent,
         size_t pos;
         SkScalar widthWithSpaces;
         std::tie(startLine, pos, widthWithSpaces) = this->trimStartSpaces(end);
+        this->read(startLine);
 
         if (needEllipsis && !fHardLineBreak) {
             // This is what we need to do to preserve a space before the ellipsis
@@ -387,6 +492,7 @@ void TextWrapper::breakTextIntoLines(ParagraphImpl* parent,
         // In case of a force wrapping we don't have a break cluster and have to use the end cluster
         text.end = std::max(text.end, textExcludingSpaces.end);
 
+        parent->fLineStarts.push_back(lineStart);
         addLine(textExcludingSpaces,
                 text,
                 textIncludingNewlines, clusters, clustersWithGhosts, widthWithSpaces,
@@ -485,6 +591,13 @@ void TextWrapper::breakTextIntoLines(ParagraphImpl* parent,
         }
 
         ClusterRange clusters(fEndLine.breakCluster() - start, fEndLine.endCluster() - start);
+        // This line depends on the end of the text, so it is never kept
+        parent->fLineStarts.push_back({clusters.start,
+                                       SkToSizeT(end - start),
+                                       fHeight,
+                                       fMinIntrinsicWidth,
+                                       fMaxIntrinsicWidth,
+                                       softLineMaxIntrinsicWidth});
         addLine(fEndLine.breakCluster()->textRange(),
                 fEndLine.breakCluster()->textRange(),
                 fEndLine.endCluster()->textRange(),
@@ -2,6 +2,7 @@
 #ifndef TextWrapper_DEFINED
 #define TextWrapper_DEFINED
 
+#include <algorithm>
 #include <string>
 #include "include/core/SkSpan.h"
 #include "modules/skparagraph/src/TextLine.h"
@@ -10,6 +11,7 @@ namespace skia {
 namespace textlayout {
 
 class ParagraphImpl;
+struct LineStart;
 
 class TextWrapper {
     class ClusterPos {
@@ -88,6 +90,18 @@ class TextWrapper {
             fWidth += cluster->width();
         }
 
+        // Same as extending with each cluster of the word in turn
+        void extend(Cluster* start, Cluster* end, const WrapWord& word) {
+            if (fStart.cluster() == nullptr) {
+                fStart = ClusterPos(start, start->startPos());
+            }
+            fEnd = ClusterPos(end, end->endPos());
+            if (!fMetrics.getForceStrut()) {
+                fMetrics.add(word.fMetrics);
+            }
+            fWidth += word.fWidth;
+        }
+
         void extend(Cluster* cluster, size_t pos) {
             fEnd = ClusterPos(cluster, pos);
             if (auto r = cluster->runOrNull()) {
@@ -165,6 +179,9 @@ public:
          fLineNumber = 1;
          fHardLineBreak = false;
          fExceededMaxLines = false;
+         fFirstCluster = nullptr;
+         fNextWord = 0;
+         fLastClusterRead = nullptr;
     }
 
     using AddLineToParagraph = std::function<void(TextRange textExcludingSpaces,
@@ -179,10 +196,16 @@ public:
                                                   SkVector advance,
                                                   InternalLineMetrics metrics,
                                                   bool addEllipsis)>;
+    // Starts from the beginning of the text, or from resume if the paragraph has kept the lines
+    // before it
     void breakTextIntoLines(ParagraphImpl* parent,
                             SkScalar maxWidth,
+                            const LineStart* resume,
                             const AddLineToParagraph& addLine);
 
+    // Find the words in the shaped clusters (the last cluster is the end of the text)
+    static void BuildWords(SkSpan<Cluster> clusters, skia_private::TArray<WrapWord, true>* words);
+
     SkScalar height() const { return fHeight; }
     SkScalar minIntrinsicWidth() const { return fMinIntrinsicWidth; }
     SkScalar maxIntrinsicWidth() const { return fMaxIntrinsicWidth; }
@@ -200,6 +223,12 @@ private:
     bool fHardLineBreak;
     bool fExceededMaxLines;
 
+    SkSpan<const WrapWord> fWrapWords;
+    Cluster* fFirstCluster;
+    size_t fNextWord;
+    // The lines so far depend on the clusters up to this one
+    Cluster* fLastClusterRead;
+
     SkScalar fHeight;
     SkScalar fMinIntrinsicWidth;
     SkScalar fMaxIntrinsicWidth;
@@ -218,6 +247,9 @@ private:
     void trimEndSpaces(TextAlign align);
     std::tuple<Cluster*, size_t, SkScalar> trimStartSpaces(Cluster* endOfClusters);
     SkScalar getClustersTrimmedWidth();
+    const WrapWord* wordStartingAt(Cluster* cluster);
+    void read(Cluster* cluster) { fLastClusterRead = std::max(fLastClusterRead, cluster); }
+    static SkScalar TrimmedWidth(Cluster* start, Cluster* end);
 };
 }  // namespace textlayout
 }  // namespace skia
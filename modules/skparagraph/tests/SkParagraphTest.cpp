@@ -7,6 +7,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkPaint.h"
@@ -36,6 +37,7 @@
 #include "modules/skparagraph/tests/SkShaperJSONWriter.h"
 #include "modules/skparagraph/utils/TestFontCollection.h"
 #include "modules/skshaper/utils/FactoryHelpers.h"
+#include "src/base/SkRandom.h"
 #include "src/base/SkTSort.h"
 #include "src/core/SkOSFile.h"
 #include "src/utils/SkOSPath.h"
@@ -6417,6 +6419,383 @@ UNIX_ONLY_TEST(SkParagraph_NoCache1, reporter) {
     test("different strings", "0123456789 0123456789 0123456789 0123456789 0123456789", false);
 }
 
+// This test does not produce an image
+UNIX_ONLY_TEST(SkParagraph_CacheMemoryBudget, reporter) {
+    ParagraphCache cache;
+    cache.turnOn(true);
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+
+    ParagraphStyle paragraph_style;
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    auto add = [&](const char* text) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        builder.pushStyle(text_style);
+        builder.addText(text);
+        builder.pop();
+        auto paragraph = builder.Build();
+        return cache.updateParagraph(static_cast<ParagraphImpl*>(paragraph.get()));
+    };
+
+    // Nothing fits into an empty budget
+    cache.setMemoryBudget(0);
+    REPORTER_ASSERT(reporter, add("text1"));
+    REPORTER_ASSERT(reporter, cache.count() == 0);
+    REPORTER_ASSERT(reporter, cache.memoryUsage() == 0);
+
+    cache.setMemoryBudget(1024 * 1024);
+    REPORTER_ASSERT(reporter, add("text1"));
+    REPORTER_ASSERT(reporter, add("text2"));
+    REPORTER_ASSERT(reporter, add("text3"));
+    REPORTER_ASSERT(reporter, cache.count() == 3);
+    REPORTER_ASSERT(reporter, cache.memoryUsage() > 0);
+
+    // Shrinking the budget evicts what does not fit
+    cache.setMemoryBudget(0);
+    REPORTER_ASSERT(reporter, cache.count() == 0);
+    REPORTER_ASSERT(reporter, cache.memoryUsage() == 0);
+}
+
+// This test does not produce an image
+UNIX_ONLY_TEST(SkParagraph_LayoutAll, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+
+    ParagraphStyle paragraph_style;
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(20);
+    text_style.setColor(SK_ColorBLACK);
+
+    auto build = [&](int i) {
+        SkString text;
+        for (int j = 0; j <= i % 7; ++j) {
+            text.appendf("Paragraph %d has some words to wrap into lines. ", i);
+        }
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        builder.pushStyle(text_style);
+        builder.addText(text.c_str());
+        builder.pop();
+        return builder.Build();
+    };
+
+    constexpr int kCount = 50;
+    std::vector<std::unique_ptr<Paragraph>> expected, actual;
+    std::vector<Paragraph*> paragraphs;
+    for (int i = 0; i < kCount; ++i) {
+        expected.push_back(build(i));
+        expected.back()->layout(300);
+        actual.push_back(build(i));
+        paragraphs.push_back(actual.back().get());
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    fontCollection->getParagraphCache()->reset();
+    Paragraph::LayoutAll(paragraphs, 300, executor.get());
+    for (int i = 0; i < kCount; ++i) {
+        REPORTER_ASSERT(reporter, actual[i]->lineNumber() == expected[i]->lineNumber());
+        REPORTER_ASSERT(reporter, actual[i]->getHeight() == expected[i]->getHeight());
+        REPORTER_ASSERT(reporter, actual[i]->getLongestLine() == expected[i]->getLongestLine());
+    }
+
+    // Without an executor the paragraphs are laid out on this thread
+    Paragraph::LayoutAll(paragraphs, 200, nullptr);
+    for (int i = 0; i < kCount; ++i) {
+        REPORTER_ASSERT(reporter, actual[i]->getMaxWidth() == 200);
+    }
+}
+
+// This test does not produce an image
+UNIX_ONLY_TEST(SkParagraph_RelayoutAtOtherWidths, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    ParagraphStyle paragraph_style;
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    auto build = [&]() {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        text_style.setFontSize(14);
+        builder.pushStyle(text_style);
+        builder.addText("Words of different lengths wrap differently at every width. ");
+        builder.addPlaceholder(PlaceholderStyle(40, 20, PlaceholderAlignment::kBaseline,
+                                                TextBaseline::kAlphabetic, 0));
+        text_style.setFontSize(28);
+        builder.pushStyle(text_style);
+        builder.addText("Bigger words, then a hard break\nand ");
+        builder.pop();
+        builder.addText("averyveryverylongwordthatdoesnotfitonanarrowline and the end.");
+        builder.pop();
+        return builder.Build();
+    };
+
+    // The paragraph laid out again keeps the words it found when it was shaped and places whole
+    // words at once; it should break the lines in the same places, with the same widths, as a
+    // paragraph that wraps a cluster at a time, and as a paragraph laid out for the first time
+    auto relaid = build();
+    relaid->layout(1000);
+    auto byCluster = build();
+    byCluster->layout(1000);
+    static_cast<ParagraphImpl*>(byCluster.get())->clearWrapWordsForTesting();
+    REPORTER_ASSERT(reporter, !static_cast<ParagraphImpl*>(relaid.get())->wrapWords().empty());
+
+    auto compare = [&](Paragraph* actual, Paragraph* expected) {
+        REPORTER_ASSERT(reporter, actual->lineNumber() == expected->lineNumber());
+        REPORTER_ASSERT(reporter, actual->getHeight() == expected->getHeight());
+        REPORTER_ASSERT(reporter, actual->getLongestLine() == expected->getLongestLine());
+        REPORTER_ASSERT(reporter,
+                        actual->getMinIntrinsicWidth() == expected->getMinIntrinsicWidth());
+        REPORTER_ASSERT(reporter,
+                        actual->getMaxIntrinsicWidth() == expected->getMaxIntrinsicWidth());
+
+        std::vector<LineMetrics> actualLines, expectedLines;
+        actual->getLineMetrics(actualLines);
+        expected->getLineMetrics(expectedLines);
+        REPORTER_ASSERT(reporter, actualLines.size() == expectedLines.size());
+        if (actualLines.size() != expectedLines.size()) {
+            return;
+        }
+        for (size_t i = 0; i < actualLines.size(); ++i) {
+            REPORTER_ASSERT(reporter, actualLines[i].fStartIndex == expectedLines[i].fStartIndex);
+            REPORTER_ASSERT(reporter, actualLines[i].fEndIndex == expectedLines[i].fEndIndex);
+            REPORTER_ASSERT(reporter, actualLines[i].fWidth == expectedLines[i].fWidth);
+            REPORTER_ASSERT(reporter, actualLines[i].fBaseline == expectedLines[i].fBaseline);
+        }
+    };
+
+    for (SkScalar width : {1000.f, 50.f, 120.5f, 200.f, 333.f, 80.f, 0.f, 10000.f}) {
+        relaid->layout(width);
+        byCluster->layout(width);
+        REPORTER_ASSERT(reporter,
+                        static_cast<ParagraphImpl*>(byCluster.get())->wrapWords().empty());
+        compare(relaid.get(), byCluster.get());
+
+        auto fresh = build();
+        fresh->layout(width);
+        compare(relaid.get(), fresh.get());
+    }
+}
+
+UNIX_ONLY_TEST(SkParagraph_IncrementalRelayoutAfterEdits, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    ParagraphStyle paragraph_style;
+    TextStyle text_styles[3];
+    for (int i = 0; i < 3; ++i) {
+        text_styles[i].setFontFamilies({SkString("Roboto")});
+        text_styles[i].setColor(SK_ColorBLACK);
+        text_styles[i].setFontSize(12 + 8 * i);
+    }
+
+    // The text of the paragraph, with the style of every byte (-1 for the placeholders)
+    static constexpr char kPlaceholder[] = "\xEF\xBF\xBC";
+    std::string text;
+    std::vector<int> styles;
+    auto append = [&](const char* utf8, int style) {
+        for (const char* c = utf8; *c; ++c) {
+            text.push_back(*c);
+            styles.push_back(style);
+        }
+    };
+    append("Words of different lengths wrap differently at every width. ", 0);
+    append(kPlaceholder, -1);
+    append("Bigger words, then a hard break\nand ", 1);
+    append("small ", 2);
+    append("words that אבג wrap again", 0);
+    append(kPlaceholder, -1);
+    append("and the end.", 1);
+
+    auto build = [&]() {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        for (size_t start = 0; start < text.size();) {
+            if (styles[start] < 0) {
+                builder.addPlaceholder(PlaceholderStyle(40, 20, PlaceholderAlignment::kBaseline,
+                                                        TextBaseline::kAlphabetic, 0));
+                start += strlen(kPlaceholder);
+                continue;
+            }
+            size_t end = start;
+            while (end < text.size() && styles[end] == styles[start]) {
+                ++end;
+            }
+            builder.pushStyle(text_styles[styles[start]]);
+            builder.addText(text.data() + start, end - start);
+            builder.pop();
+            start = end;
+        }
+        return builder.Build();
+    };
+
+    struct Glyphs {
+        int lineNumber;
+        SkScalar fontSize;
+        std::vector<uint16_t> glyphs;
+        std::vector<SkPoint> positions;
+    };
+    auto visit = [](Paragraph* paragraph) {
+        std::vector<Glyphs> result;
+        paragraph->visit([&](int lineNumber, const Paragraph::VisitorInfo* info) {
+            if (info) {
+                Glyphs& glyphs = result.emplace_back();
+                glyphs.lineNumber = lineNumber;
+                glyphs.fontSize = info->font.getSize();
+                glyphs.glyphs.assign(info->glyphs, info->glyphs + info->count);
+                for (int i = 0; i < info->count; ++i) {
+                    glyphs.positions.push_back(info->positions[i] + info->origin);
+                }
+            }
+        });
+        return result;
+    };
+
+    auto compare = [&](Paragraph* actual, Paragraph* expected) {
+        REPORTER_ASSERT(reporter, actual->lineNumber() == expected->lineNumber());
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(actual->getHeight(),
+                                                      expected->getHeight(), EPSILON100));
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(actual->getLongestLine(),
+                                                      expected->getLongestLine(), EPSILON100));
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(actual->getMinIntrinsicWidth(),
+                                                      expected->getMinIntrinsicWidth(),
+                                                      EPSILON100));
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(actual->getMaxIntrinsicWidth(),
+                                                      expected->getMaxIntrinsicWidth(),
+                                                      EPSILON100));
+
+        std::vector<LineMetrics> actualLines, expectedLines;
+        actual->getLineMetrics(actualLines);
+        expected->getLineMetrics(expectedLines);
+        REPORTER_ASSERT(reporter, actualLines.size() == expectedLines.size());
+        if (actualLines.size() != expectedLines.size()) {
+            return;
+        }
+        for (size_t i = 0; i < actualLines.size(); ++i) {
+            auto& a = actualLines[i];
+            auto& e = expectedLines[i];
+            REPORTER_ASSERT(reporter, a.fStartIndex == e.fStartIndex);
+            REPORTER_ASSERT(reporter, a.fEndIndex == e.fEndIndex);
+            REPORTER_ASSERT(reporter, a.fEndIncludingNewline == e.fEndIncludingNewline);
+            REPORTER_ASSERT(reporter, a.fHardBreak == e.fHardBreak);
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(a.fAscent, e.fAscent, EPSILON100));
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(a.fDescent, e.fDescent, EPSILON100));
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(a.fWidth, e.fWidth, EPSILON100));
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(a.fLeft, e.fLeft, EPSILON100));
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(a.fBaseline, e.fBaseline, EPSILON100));
+        }
+
+        auto actualGlyphs = visit(actual);
+        auto expectedGlyphs = visit(expected);
+        REPORTER_ASSERT(reporter, actualGlyphs.size() == expectedGlyphs.size());
+        if (actualGlyphs.size() != expectedGlyphs.size()) {
+            return;
+        }
+        for (size_t i = 0; i < actualGlyphs.size(); ++i) {
+            auto& a = actualGlyphs[i];
+            auto& e = expectedGlyphs[i];
+            REPORTER_ASSERT(reporter, a.lineNumber == e.lineNumber);
+            REPORTER_ASSERT(reporter, a.fontSize == e.fontSize);
+            REPORTER_ASSERT(reporter, a.glyphs == e.glyphs);
+            for (size_t j = 0; j < a.positions.size() && j < e.positions.size(); ++j) {
+                auto& ap = a.positions[j];
+                auto& ep = e.positions[j];
+                REPORTER_ASSERT(reporter, SkScalarNearlyEqual(ap.fX, ep.fX, EPSILON100) &&
+                                          SkScalarNearlyEqual(ap.fY, ep.fY, EPSILON100));
+            }
+        }
+
+        auto actualRects = actual->getRectsForRange(0, 1000, RectHeightStyle::kTight,
+                                                    RectWidthStyle::kTight);
+        auto expectedRects = expected->getRectsForRange(0, 1000, RectHeightStyle::kTight,
+                                                        RectWidthStyle::kTight);
+        REPORTER_ASSERT(reporter, actualRects.size() == expectedRects.size());
+        for (size_t i = 0; i < actualRects.size() && i < expectedRects.size(); ++i) {
+            auto& a = actualRects[i].rect;
+            auto& e = expectedRects[i].rect;
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(a.fLeft, e.fLeft, EPSILON100) &&
+                                      SkScalarNearlyEqual(a.fTop, e.fTop, EPSILON100) &&
+                                      SkScalarNearlyEqual(a.fRight, e.fRight, EPSILON100) &&
+                                      SkScalarNearlyEqual(a.fBottom, e.fBottom, EPSILON100));
+        }
+    };
+
+    // Random edits of the text between the placeholders, made to one paragraph,
+    // should lay it out the same way as a paragraph built with the edited text
+    const char* insertions[] = {"a", "W", " ", "word ", "\n", ", ", "longerword", "דה "};
+    SkScalar width = 200;
+    auto edited = build();
+    edited->layout(width);
+    auto impl = static_cast<ParagraphImpl*>(edited.get());
+
+    // Edits across a placeholder, past the end of the text or inside a character are refused
+    const size_t placeholderStart = text.find(kPlaceholder);
+    REPORTER_ASSERT(reporter, !edited->updateText(placeholderStart - 1, placeholderStart + 1,
+                                                  SkString()));
+    REPORTER_ASSERT(reporter, !edited->updateText(text.size(), text.size() + 1, SkString()));
+    REPORTER_ASSERT(reporter, !edited->updateText(placeholderStart + 1, placeholderStart + 1,
+                                                  SkString("a")));
+    REPORTER_ASSERT(reporter, impl->state() > kShaped);
+
+    SkRandom rand;
+    auto isCharStart = [&](size_t index) {
+        return index == text.size() || (text[index] & 0xC0) != 0x80;
+    };
+    int kept = 0;
+    for (int edit = 0; edit < 300; ++edit) {
+        // The text between two placeholders (or before the first one)
+        std::vector<std::pair<size_t, size_t>> regions;
+        size_t regionStart = 0;
+        for (size_t i = 0; i <= text.size(); ++i) {
+            if (i == text.size() || styles[i] < 0) {
+                regions.emplace_back(regionStart, i);
+                i += strlen(kPlaceholder) - 1;
+                regionStart = i + 1;
+            }
+        }
+        auto [start, end] = regions[rand.nextULessThan(regions.size())];
+        size_t from = start + rand.nextULessThan(end - start + 1);
+        size_t to = std::min(end, from + rand.nextULessThan(6));
+        while (!isCharStart(from)) {
+            --from;
+        }
+        while (!isCharStart(to)) {
+            ++to;
+        }
+        SkString insertion(rand.nextULessThan(4) != 0
+                                   ? insertions[rand.nextULessThan(std::size(insertions))]
+                                   : "");
+        if (end - start - (to - from) + insertion.size() == 0) {
+            continue;
+        }
+
+        int style = styles[from > start ? from - 1 : from];
+        text.replace(from, to - from, insertion.c_str());
+        styles.erase(styles.begin() + from, styles.begin() + to);
+        styles.insert(styles.begin() + from, insertion.size(), style);
+
+        REPORTER_ASSERT(reporter, edited->updateText(from, to, insertion));
+        if (impl->state() == kShaped) {
+            ++kept;
+        }
+        if (rand.nextULessThan(10) == 0) {
+            width = rand.nextRangeF(50, 400);
+        }
+        edited->layout(width);
+
+        auto fresh = build();
+        fresh->layout(width);
+        compare(edited.get(), fresh.get());
+    }
+    // Most edits reshape only the text around them
+    REPORTER_ASSERT(reporter, kept > 150, "kept %d", kept);
+}
+
 UNIX_ONLY_TEST(SkParagraph_HeightCalculations, reporter) {
     sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
     SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
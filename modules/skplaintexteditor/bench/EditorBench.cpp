@@ -0,0 +1,63 @@
+// Copyright 2024 Google LLC.
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "bench/Benchmark.h"
+#include "include/core/SkFont.h"
+#include "modules/skplaintexteditor/include/editor.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <string>
+
+using namespace SkPlainTextEditor;
+
+namespace {
+// Typing one character in the middle of a 100KB document, which is either one paragraph or many
+// short ones, and drawing the document again.
+class EditorKeystrokeBench : public Benchmark {
+public:
+    EditorKeystrokeBench(bool oneParagraph)
+            : fOneParagraph(oneParagraph)
+            , fName(oneParagraph ? "editor_keystroke_one_paragraph"
+                                 : "editor_keystroke_paragraphs") {}
+
+private:
+    const char* onGetName() override { return fName; }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        static constexpr char kSentence[] = "The quick brown fox jumps over the lazy dog. ";
+        std::string text;
+        while (text.size() < 100 * 1024) {
+            text += kSentence;
+            if (!fOneParagraph && text.size() % 10 < 3) {
+                text += '\n';
+            }
+        }
+        fEditor.setFontMgr(ToolUtils::TestFontMgr());
+        fEditor.setFont(SkFont(ToolUtils::DefaultPortableTypeface(), 14));
+        fEditor.setWidth(600);
+        fEditor.insert({0, 0}, text.data(), text.size());
+        fEditor.paint(nullptr, Editor::PaintOpts());
+
+        size_t paragraph = fEditor.lineCount() / 2;
+        fPosition = {fEditor.line(paragraph).size / 2, paragraph};
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            Editor::TextPosition end = fEditor.insert(fPosition, "x", 1);
+            fEditor.paint(nullptr, Editor::PaintOpts());
+            fEditor.remove(fPosition, end);
+            fEditor.paint(nullptr, Editor::PaintOpts());
+        }
+    }
+
+    const bool fOneParagraph;
+    const char* fName;
+    Editor fEditor;
+    Editor::TextPosition fPosition;
+};
+}  // namespace
+
+DEF_BENCH(return new EditorKeystrokeBench(true);)
+DEF_BENCH(return new EditorKeystrokeBench(false);)
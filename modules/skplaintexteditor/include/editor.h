@@ -105,14 +105,25 @@ public:
 private:
     // TODO: rename this to TextParagraph. fLines to fParas.
     struct TextLine {
+        // The bytes of fText replaced since it was last shaped.
+        struct Edit {
+            size_t fOffset = 0;
+            size_t fRemoved = 0;
+            size_t fInserted = 0;
+        };
+
         StringSlice fText;
-        sk_sp<const SkTextBlob> fBlob;
+        std::vector<sk_sp<SkTextBlob>> fLineBlobs;  // relative to fLineTops
+        std::vector<float> fLineTops;
         std::vector<SkRect> fCursorPos;
         std::vector<size_t> fLineEndOffsets;
         std::vector<bool> fWordBoundaries;
         SkIPoint fOrigin = {0, 0};
         int fHeight = 0;
         bool fShaped = false;
+        // If set, only the lines around fEdit need shaping again.
+        bool fEdited = false;
+        Edit fEdit;
 
         TextLine(StringSlice t) : fText(std::move(t)) {}
         TextLine() {}
@@ -126,6 +137,7 @@ private:
     const char* fLocale = "en";  // TODO: make this setable
 
     void markDirty(TextLine*);
+    void markEdited(TextLine*, size_t offset, size_t removed, size_t inserted);
     void reshapeAll();
 };
 }  // namespace SkPlainTextEditor
@@ -46,11 +46,29 @@ static StringSlice remove_newline(const char* str, size_t len) {
 }
 
 void Editor::markDirty(TextLine* line) {
-    line->fBlob = nullptr;
+    line->fLineBlobs = std::vector<sk_sp<SkTextBlob>>();
     line->fShaped = false;
+    line->fEdited = false;
     line->fWordBoundaries = std::vector<bool>();
 }
 
+void Editor::markEdited(TextLine* line, size_t offset, size_t removed, size_t inserted) {
+    if (line->fShaped) {
+        line->fShaped = false;
+        line->fEdited = true;
+        line->fEdit = {offset, removed, inserted};
+    } else if (line->fEdited) {
+        // Merge with the edit since the last shaping: the union of the two edits, in the text
+        // before the first one and after the second one.
+        TextLine::Edit& edit = line->fEdit;
+        size_t begin = std::min(edit.fOffset, offset);
+        size_t end = std::max(edit.fOffset + edit.fInserted, offset + removed);
+        edit = {begin,
+                end - edit.fInserted + edit.fRemoved - begin,
+                end - removed + inserted - begin};
+    }
+}
+
 void Editor::setFont(SkFont font) {
     if (font != fFont) {
         fFont = std::move(font);
@@ -83,10 +101,12 @@ Editor::TextPosition Editor::getPosition(SkIPoint xy) {
                             line.fOrigin.y(),
                             fWidth,
                             j + 1 < fLines.size() ? fLines[j + 1].fOrigin.y() : INT_MAX};
-        if (const SkTextBlob* b = line.fBlob.get()) {
-            SkIRect r = b->bounds().roundOut();
-            r.offset(line.fOrigin);
-            lineRect.join(r);
+        for (size_t i = 0; i < line.fLineBlobs.size(); ++i) {
+            if (const SkTextBlob* b = line.fLineBlobs[i].get()) {
+                SkIRect r = b->bounds().makeOffset(0, line.fLineTops[i]).roundOut();
+                r.offset(line.fOrigin);
+                lineRect.join(r);
+            }
         }
         if (!lineRect.contains(xy.x(), xy.y())) {
             continue;
@@ -158,7 +178,7 @@ Editor::TextPosition Editor::insert(TextPosition pos, const char* utf8Text, size
     fNeedsReshape = true;
     if (pos.fParagraphIndex < fLines.size()) {
         fLines[pos.fParagraphIndex].fText.insert(pos.fTextByteIndex, utf8Text, byteLen);
-        this->markDirty(&fLines[pos.fParagraphIndex]);
+        this->markEdited(&fLines[pos.fParagraphIndex], pos.fTextByteIndex, 0, byteLen);
     } else {
         SkASSERT(pos.fParagraphIndex == fLines.size());
         SkASSERT(pos.fTextByteIndex == 0);
@@ -174,6 +194,9 @@ Editor::TextPosition Editor::insert(TextPosition pos, const char* utf8Text, size
         readlines(src.begin(), src.size(), [&line](const char* str, size_t l) {
             (line++)->fText = remove_newline(str, l);
         });
+        // The text after the first newline moved to the new paragraphs.
+        size_t firstSize = fLines[pos.fParagraphIndex].fText.size();
+        this->markEdited(&fLines[pos.fParagraphIndex], firstSize, src.size() - firstSize, 0);
     }
     return pos;
 }
@@ -192,16 +215,18 @@ Editor::TextPosition Editor::remove(TextPosition pos1, TextPosition pos2) {
         SkASSERT(end.fTextByteIndex > start.fTextByteIndex);
         fLines[start.fParagraphIndex].fText.remove(
                 start.fTextByteIndex, end.fTextByteIndex - start.fTextByteIndex);
-        this->markDirty(&fLines[start.fParagraphIndex]);
+        this->markEdited(&fLines[start.fParagraphIndex], start.fTextByteIndex,
+                         end.fTextByteIndex - start.fTextByteIndex, 0);
     } else {
         SkASSERT(end.fParagraphIndex < fLines.size());
         auto& line = fLines[start.fParagraphIndex];
-        line.fText.remove(start.fTextByteIndex,
-                          line.fText.size() - start.fTextByteIndex);
+        size_t removed = line.fText.size() - start.fTextByteIndex;
+        size_t inserted = fLines[end.fParagraphIndex].fText.size() - end.fTextByteIndex;
+        line.fText.remove(start.fTextByteIndex, removed);
         line.fText.insert(start.fTextByteIndex,
                           fLines[end.fParagraphIndex].fText.begin() + end.fTextByteIndex,
-                          fLines[end.fParagraphIndex].fText.size() - end.fTextByteIndex);
-        this->markDirty(&line);
+                          inserted);
+        this->markEdited(&line, start.fTextByteIndex, removed, inserted);
         fLines.erase(fLines.begin() + start.fParagraphIndex + 1,
                      fLines.begin() + end.fParagraphIndex + 1);
     }
@@ -458,8 +483,11 @@ void Editor::paint(SkCanvas* c, PaintOpts options) {
 
     SkPaint foreground = SkPaint(options.fForegroundColor);
     for (const TextLine& line : fLines) {
-        if (line.fBlob) {
-            c->drawTextBlob(line.fBlob.get(), line.fOrigin.x(), line.fOrigin.y(), foreground);
+        for (size_t i = 0; i < line.fLineBlobs.size(); ++i) {
+            if (const SkTextBlob* blob = line.fLineBlobs[i].get()) {
+                c->drawTextBlob(blob, line.fOrigin.x(), line.fOrigin.y() + line.fLineTops[i],
+                                foreground);
+            }
         }
     }
 }
@@ -470,6 +498,32 @@ void Editor::reshapeAll() {
             fLines.push_back(TextLine());
         }
         float shape_width = (float)(fWidth);
+        auto shapeLine = [&](TextLine& line) {
+            ShapeResult result;
+            if (line.fEdited) {
+                ShapeResult previous{std::move(line.fLineBlobs),
+                                     std::move(line.fLineTops),
+                                     std::move(line.fLineEndOffsets),
+                                     std::move(line.fCursorPos),
+                                     std::move(line.fWordBoundaries),
+                                     line.fHeight};
+                result = Reshape(std::move(previous),
+                                 line.fEdit.fOffset, line.fEdit.fRemoved, line.fEdit.fInserted,
+                                 line.fText.begin(), line.fText.size(),
+                                 fFont, fFontMgr, fLocale, shape_width);
+            } else {
+                result = Shape(line.fText.begin(), line.fText.size(),
+                               fFont, fFontMgr, fLocale, shape_width);
+            }
+            line.fLineBlobs      = std::move(result.lineBlobs);
+            line.fLineTops       = std::move(result.lineTops);
+            line.fLineEndOffsets = std::move(result.lineBreakOffsets);
+            line.fCursorPos      = std::move(result.glyphBounds);
+            line.fWordBoundaries = std::move(result.wordBreaks);
+            line.fHeight         = result.verticalAdvance;
+            line.fShaped = true;
+            line.fEdited = false;
+        };
         #ifdef SK_EDITOR_GO_FAST
         SkSemaphore semaphore;
         std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(100);
@@ -477,31 +531,17 @@ void Editor::reshapeAll() {
         for (TextLine& line : fLines) {
             if (!line.fShaped) {
                 executor->add([&]() {
-                    ShapeResult result = Shape(line.fText.begin(), line.fText.size(),
-                                               fFont, fLocale, shape_width);
-                    line.fBlob           = std::move(result.blob);
-                    line.fLineEndOffsets = std::move(result.lineBreakOffsets);
-                    line.fCursorPos      = std::move(result.glyphBounds);
-                    line.fWordBoundaries = std::move(result.wordBreaks);
-                    line.fHeight         = result.verticalAdvance;
-                    line.fShaped = true;
+                    shapeLine(line);
                     semaphore.signal();
-                }
+                });
                 ++jobCount;
-            });
+            }
         }
         while (jobCount-- > 0) { semaphore.wait(); }
         #else
         for (TextLine& line : fLines) {
             if (!line.fShaped) {
-                ShapeResult result = Shape(line.fText.begin(), line.fText.size(),
-                                           fFont, fFontMgr, fLocale, shape_width);
-                line.fBlob           = std::move(result.blob);
-                line.fLineEndOffsets = std::move(result.lineBreakOffsets);
-                line.fCursorPos      = std::move(result.glyphBounds);
-                line.fWordBoundaries = std::move(result.wordBreaks);
-                line.fHeight         = result.verticalAdvance;
-                line.fShaped = true;
+                shapeLine(line);
             }
         }
         #endif
@@ -514,4 +554,3 @@ void Editor::reshapeAll() {
         fNeedsReshape = false;
     }
 }
-
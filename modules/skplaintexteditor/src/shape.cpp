@@ -36,6 +36,7 @@ class SkUnicode;
 #include "modules/skunicode/include/SkUnicode_icu4x.h"
 #endif
 
+#include <algorithm>
 #include <cfloat>
 #include <climits>
 #include <cstring>
@@ -45,7 +46,8 @@ using namespace SkPlainTextEditor;
 namespace {
 class RunHandler final : public SkShaper::RunHandler {
 public:
-    RunHandler(const char* utf8Text, size_t) : fUtf8Text(utf8Text) {}
+    RunHandler(const char* utf8Text, size_t, float top)
+        : fUtf8Text(utf8Text), fOffset{0, top}, fLineTop(top) {}
     using RunCallback = void (*)(void* context,
                                  const char* utf8Text,
                                   size_t utf8TextBytes,
@@ -53,13 +55,13 @@ public:
                                   const SkGlyphID* glyphs,
                                   const SkPoint* positions,
                                   const uint32_t* clusters,
-                                  const SkFont& font);
+                                  const SkFont& font,
+                                  float lineTop);
     void setRunCallback(RunCallback f, void* context) {
         fCallbackContext = context;
         fCallbackFunction = f;
     }
 
-    sk_sp<SkTextBlob> makeBlob();
     SkPoint endPoint() const { return fOffset; }
     SkPoint finalPosition() const { return fCurrentPosition; }
 
@@ -70,21 +72,24 @@ public:
     void commitRunBuffer(const RunInfo&) override;
     void commitLine() override;
 
-    const std::vector<size_t>& lineEndOffsets() const { return fLineEndOffsets; }
+    // The text offset at the end of each line, its blob and its top.
+    std::vector<size_t>& lineEndOffsets() { return fLineEndOffsets; }
+    std::vector<sk_sp<SkTextBlob>>& lineBlobs() { return fLineBlobs; }
+    std::vector<float>& lineTops() { return fLineTops; }
 
     SkRect finalRect(const SkFont& font) const {
         if (0 == fMaxRunAscent || 0 == fMaxRunDescent) {
             SkFontMetrics metrics;
             font.getMetrics(&metrics);
             return {fCurrentPosition.x(),
-                    fCurrentPosition.y(),
+                    fLineTop + fCurrentPosition.y(),
                     fCurrentPosition.x() + font.getSize(),
-                    fCurrentPosition.y() + metrics.fDescent - metrics.fAscent};
+                    fLineTop + fCurrentPosition.y() + metrics.fDescent - metrics.fAscent};
         } else {
             return {fCurrentPosition.x(),
-                    fCurrentPosition.y() + fMaxRunAscent,
+                    fLineTop + fCurrentPosition.y() + fMaxRunAscent,
                     fCurrentPosition.x() + font.getSize(),
-                    fCurrentPosition.y() + fMaxRunDescent};
+                    fLineTop + fCurrentPosition.y() + fMaxRunDescent};
         }
     }
 
@@ -92,6 +97,8 @@ public:
 private:
     SkTextBlobBuilder fBuilder;
     std::vector<size_t> fLineEndOffsets;
+    std::vector<sk_sp<SkTextBlob>> fLineBlobs;
+    std::vector<float> fLineTops;
     const SkGlyphID* fCurrentGlyphs = nullptr;
     const SkPoint* fCurrentPoints = nullptr;
     void* fCallbackContext = nullptr;
@@ -106,6 +113,7 @@ private:
     SkScalar fMaxRunLeading = 0;
     SkPoint fCurrentPosition = {0, 0};
     SkPoint fOffset = {0, 0};
+    float fLineTop = 0;
 };
 
 // TODO(kjlubick,jlavrova) Remove these defines by having clients register something or somehow
@@ -133,7 +141,9 @@ sk_sp<SkUnicode> get_unicode() {
 }  // namespace
 
 void RunHandler::beginLine() {
-    fCurrentPosition = fOffset;
+    // Each line gets its own blob, positioned relative to the top of the line.
+    fLineTop = fOffset.y();
+    fCurrentPosition = {fOffset.x(), 0};
     fMaxRunAscent = 0;
     fMaxRunDescent = 0;
     fMaxRunLeading = 0;
@@ -187,7 +197,8 @@ void RunHandler::commitRunBuffer(const RunInfo& info) {
                           fCurrentGlyphs,
                           fCurrentPoints,
                           fClusters,
-                          info.fFont);
+                          info.fFont,
+                          fLineTop);
     }
     SkASSERT(0 <= fClusterOffset);
     for (int i = 0; i < fGlyphCount; ++i) {
@@ -199,17 +210,13 @@ void RunHandler::commitRunBuffer(const RunInfo& info) {
 }
 
 void RunHandler::commitLine() {
-    if (fLineEndOffsets.empty() || fTextOffset > fLineEndOffsets.back()) {
-        // Ensure that fLineEndOffsets is monotonic.
-        fLineEndOffsets.push_back(fTextOffset);
-    }
+    // fTextOffset never decreases, so fLineEndOffsets is monotonic.
+    fLineEndOffsets.push_back(fTextOffset);
+    fLineBlobs.push_back(fBuilder.make());
+    fLineTops.push_back(fLineTop);
     fOffset += { 0, fMaxRunDescent + fMaxRunLeading - fMaxRunAscent };
 }
 
-sk_sp<SkTextBlob> RunHandler::makeBlob() {
-    return fBuilder.make();
-}
-
 static SkRect selection_box(const SkFontMetrics& metrics,
                             float advance,
                             SkPoint pos) {
@@ -229,7 +236,8 @@ static void set_character_bounds(void* context,
                                  const SkGlyphID* glyphs,
                                  const SkPoint* positions,
                                  const uint32_t* clusters,
-                                 const SkFont& font)
+                                 const SkFont& font,
+                                 float lineTop)
 {
     SkASSERT(context);
     SkASSERT(glyphCount > 0);
@@ -270,6 +278,7 @@ static void set_character_bounds(void* context,
         for (unsigned i = 1; i < clusterGlyphCount; ++i) { // multiple glyphs
             clusterBox.join(selection_box(metrics, clusterAdvances[i], clusterGlyphPositions[i]));
         }
+        clusterBox.offset(0, lineTop);
         if (textBegin + 1 == textEnd) {  // single byte, fast path.
             cursors[textBegin] = clusterBox;
             continue;
@@ -298,6 +307,92 @@ static void set_character_bounds(void* context,
     }
 }
 
+namespace {
+struct ShapedLines {
+    std::vector<size_t> lineEndOffsets;
+    std::vector<sk_sp<SkTextBlob>> lineBlobs;
+    std::vector<float> lineTops;  // and the bottom of the last line
+    SkRect finalRect;
+};
+}  // namespace
+
+static constexpr SkRect kUnsetRect{-FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+// Shape and wrap utf8Text[begin, end) as if it was a paragraph of its own, with its first line at
+// top. The bounds of the text go to glyphBounds[begin, end).
+static ShapedLines shape_lines(const char* utf8Text,
+                               size_t begin,
+                               size_t end,
+                               float top,
+                               const SkFont& font,
+                               sk_sp<SkFontMgr> fontMgr,
+                               float width,
+                               SkRect* glyphBounds) {
+    SkASSERT(begin < end);
+    const char* text = utf8Text + begin;
+    const size_t textByteLen = end - begin;
+
+    std::unique_ptr<SkShaper> shaper = nullptr;
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE) && defined(SK_SHAPER_UNICODE_AVAILABLE)
+    auto unicode = get_unicode();
+    shaper = SkShapers::HB::ShaperDrivenWrapper(unicode, fontMgr);
+#else
+    shaper = SkShapers::Primitive::PrimitiveText();
+#endif
+    SkASSERT(shaper);
+
+    RunHandler runHandler(text, textByteLen, top);
+    for (size_t i = begin; i < end; ++i) {
+        glyphBounds[i] = kUnsetRect;
+    }
+    runHandler.setRunCallback(set_character_bounds, glyphBounds + begin);
+
+    static constexpr uint8_t kBidiLevelLTR = 0;
+    std::unique_ptr<SkShaper::BiDiRunIterator> bidi = nullptr;
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE) && defined(SK_SHAPER_UNICODE_AVAILABLE)
+    bidi = SkShapers::unicode::BidiRunIterator(
+            unicode, text, textByteLen, kBidiLevelLTR);
+#endif
+    if (!bidi) {
+        bidi = std::make_unique<SkShaper::TrivialBiDiRunIterator>(kBidiLevelLTR, textByteLen);
+    }
+    SkASSERT(bidi);
+
+    std::unique_ptr<SkShaper::LanguageRunIterator> language =
+            SkShaper::MakeStdLanguageRunIterator(text, textByteLen);
+    SkASSERT(language);
+
+    std::unique_ptr<SkShaper::ScriptRunIterator> script =
+            SkShaper::MakeScriptRunIterator(text, textByteLen, SkSetFourByteTag('Z','z','z','z'));
+    SkASSERT(script);
+
+    std::unique_ptr<SkShaper::FontRunIterator> fontRuns =
+            SkShaper::MakeFontMgrRunIterator(text, textByteLen, font, fontMgr);
+    SkASSERT(fontRuns);
+
+    shaper->shape(text,
+                  textByteLen,
+                  *fontRuns,
+                  *bidi,
+                  *script,
+                  *language,
+                  nullptr,
+                  0,
+                  width,
+                  &runHandler);
+
+    ShapedLines result;
+    result.lineEndOffsets = std::move(runHandler.lineEndOffsets());
+    for (size_t& offset : result.lineEndOffsets) {
+        offset += begin;
+    }
+    result.lineBlobs = std::move(runHandler.lineBlobs());
+    result.lineTops = std::move(runHandler.lineTops());
+    result.lineTops.push_back(runHandler.endPoint().y());
+    result.finalRect = runHandler.finalRect(font);
+    return result;
+}
+
 ShapeResult SkPlainTextEditor::Shape(const char* utf8Text,
                                      size_t textByteLen,
                                      const SkFont& font,
@@ -310,67 +405,192 @@ ShapeResult SkPlainTextEditor::Shape(const char* utf8Text,
         utf8Text = nullptr;
         textByteLen = 0;
     }
-    std::unique_ptr<SkShaper> shaper = nullptr;
-#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE) && defined(SK_SHAPER_UNICODE_AVAILABLE)
-    auto unicode = get_unicode();
-    shaper = SkShapers::HB::ShaperDrivenWrapper(unicode, fontMgr);
-#else
-    shaper = SkShapers::Primitive::PrimitiveText();
-#endif
-    SkASSERT(shaper);
 
     float height = font.getSpacing();
-    RunHandler runHandler(utf8Text, textByteLen);
     if (textByteLen) {
-        result.glyphBounds.resize(textByteLen);
-        for (SkRect& c : result.glyphBounds) {
-            c = SkRect{-FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX};
-        }
-        runHandler.setRunCallback(set_character_bounds, result.glyphBounds.data());
-
-        static constexpr uint8_t kBidiLevelLTR = 0;
-        std::unique_ptr<SkShaper::BiDiRunIterator> bidi = nullptr;
-#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE) && defined(SK_SHAPER_UNICODE_AVAILABLE)
-        bidi = SkShapers::unicode::BidiRunIterator(
-                unicode, utf8Text, textByteLen, kBidiLevelLTR);
-#endif
-        if (!bidi) {
-            bidi = std::make_unique<SkShaper::TrivialBiDiRunIterator>(kBidiLevelLTR, textByteLen);
-        }
-        SkASSERT(bidi);
-
-        std::unique_ptr<SkShaper::LanguageRunIterator> language =
-                SkShaper::MakeStdLanguageRunIterator(utf8Text, textByteLen);
-        SkASSERT(language);
-
-        std::unique_ptr<SkShaper::ScriptRunIterator> script =
-                SkShaper::MakeScriptRunIterator(utf8Text, textByteLen, SkSetFourByteTag('Z','z','z','z'));
-        SkASSERT(script);
-
-        std::unique_ptr<SkShaper::FontRunIterator> fontRuns =
-                SkShaper::MakeFontMgrRunIterator(utf8Text, textByteLen, font, fontMgr);
-        SkASSERT(fontRuns);
-
-        shaper->shape(utf8Text,
-                      textByteLen,
-                      *fontRuns,
-                      *bidi,
-                      *script,
-                      *language,
-                      nullptr,
-                      0,
-                      width,
-                      &runHandler);
-        if (runHandler.lineEndOffsets().size() > 1) {
-            result.lineBreakOffsets = runHandler.lineEndOffsets();
-            SkASSERT(result.lineBreakOffsets.size() > 0);
+        result.glyphBounds.resize(textByteLen + 1);
+        ShapedLines lines = shape_lines(utf8Text, 0, textByteLen, 0, font, fontMgr, width,
+                                        result.glyphBounds.data());
+        if (lines.lineEndOffsets.size() > 1) {
+            result.lineBreakOffsets = std::move(lines.lineEndOffsets);
             result.lineBreakOffsets.pop_back();
         }
-        height = std::max(height, runHandler.endPoint().y());
-        result.blob = runHandler.makeBlob();
+        result.lineBlobs = std::move(lines.lineBlobs);
+        result.lineTops = std::move(lines.lineTops);
+        height = std::max(height, result.lineTops.back());
+        result.glyphBounds.back() = lines.finalRect;
+    } else {
+        result.glyphBounds.push_back(RunHandler(nullptr, 0, 0).finalRect(font));
     }
-    result.glyphBounds.push_back(runHandler.finalRect(font));
     result.verticalAdvance = (int)ceilf(height);
     result.wordBreaks = GetUtf8WordBoundaries(utf8Text, textByteLen, locale);
     return result;
 }
+
+ShapeResult SkPlainTextEditor::Reshape(ShapeResult previous,
+                                       size_t editOffset,
+                                       size_t removedBytes,
+                                       size_t insertedBytes,
+                                       const char* utf8Text,
+                                       size_t textByteLen,
+                                       const SkFont& font,
+                                       sk_sp<SkFontMgr> fontMgr,
+                                       const char* locale,
+                                       float width)
+{
+    const size_t editEnd = editOffset + insertedBytes;
+    const size_t lineCount = previous.lineBlobs.size();
+    if (textByteLen < editEnd || SkUTF::CountUTF8(utf8Text, textByteLen) < 0) {
+        return Shape(utf8Text, textByteLen, font, fontMgr, locale, width);
+    }
+    const size_t previousByteLen = textByteLen - insertedBytes + removedBytes;
+    if (textByteLen == 0 ||
+        lineCount == 0 ||
+        previous.lineTops.size() != lineCount + 1 ||
+        previous.lineBreakOffsets.size() + 1 != lineCount ||
+        previous.glyphBounds.size() != previousByteLen + 1 ||
+        previous.wordBreaks.size() != previousByteLen) {
+        return Shape(utf8Text, textByteLen, font, fontMgr, locale, width);
+    }
+    const std::vector<size_t>& breaks = previous.lineBreakOffsets;
+
+    // Deleting text may let the first word of the edited line move up to the line before it, so
+    // start shaping there. The lines before that one stay as they are.
+    size_t firstLine = std::upper_bound(breaks.begin(), breaks.end(), editOffset) - breaks.begin();
+    if (firstLine > 0) {
+        --firstLine;
+    }
+    // The shaper may drop the whitespace a line was wrapped at, so that the next line starts after
+    // its break. Only start at a line that starts where its break is.
+    while (firstLine > 0 && previous.glyphBounds[breaks[firstLine - 1]] == kUnsetRect) {
+        --firstLine;
+    }
+    const size_t begin = firstLine > 0 ? breaks[firstLine - 1] : 0;
+    const float top = previous.lineTops[firstLine];
+
+    // Once a line ends at a line break that came after the edit in the previous text, wrapping
+    // goes on exactly as it did, so the rest of the lines can be reused. Shape up to a few of
+    // those breaks, and twice as many each time wrapping has not settled yet.
+    const size_t firstKeptBreak =
+            std::lower_bound(breaks.begin(), breaks.end(), editOffset + removedBytes) -
+            breaks.begin();
+    auto newOffset = [&](size_t previousOffset) {
+        return previousOffset - removedBytes + insertedBytes;
+    };
+
+    std::vector<SkRect> glyphBounds(textByteLen + 1);
+    ShapedLines lines;
+    size_t resyncLine = 0;          // the last shaped line that is used
+    size_t resyncPreviousLine = 0;  // the previous line that ends where it does
+    bool resynced = false;
+    for (size_t breakCount = 2; !resynced; breakCount *= 2) {
+        const size_t lastBreak = firstKeptBreak + breakCount - 1;
+        const size_t end = lastBreak < breaks.size() ? newOffset(breaks[lastBreak]) : textByteLen;
+        lines = shape_lines(utf8Text, begin, end, top, font, fontMgr, width, glyphBounds.data());
+
+        // The last line ends only because the shaped text does.
+        for (size_t i = 0; i + 1 < lines.lineEndOffsets.size(); ++i) {
+            size_t lineEnd = lines.lineEndOffsets[i];
+            if (lineEnd < editEnd) {
+                continue;
+            }
+            size_t previousLineEnd = lineEnd + removedBytes - insertedBytes;
+            auto found = std::lower_bound(breaks.begin() + firstKeptBreak, breaks.end(),
+                                          previousLineEnd);
+            if (found != breaks.end() && *found == previousLineEnd) {
+                resyncLine = i;
+                resyncPreviousLine = found - breaks.begin();
+                resynced = true;
+                break;
+            }
+        }
+        if (end == textByteLen) {
+            break;
+        }
+    }
+
+    ShapeResult result;
+    const size_t usedLines = resynced ? resyncLine + 1 : lines.lineBlobs.size();
+    const size_t shapedEnd = resynced ? lines.lineEndOffsets[resyncLine] : textByteLen;
+    const float dy = resynced ? lines.lineTops[resyncLine + 1] -
+                                previous.lineTops[resyncPreviousLine + 1]
+                              : 0;
+
+    // Lines
+    result.lineBlobs.reserve(lineCount);
+    result.lineTops.reserve(lineCount + 1);
+    result.lineBreakOffsets.reserve(lineCount);
+    for (size_t i = 0; i < firstLine; ++i) {
+        result.lineBlobs.push_back(std::move(previous.lineBlobs[i]));
+        result.lineTops.push_back(previous.lineTops[i]);
+        result.lineBreakOffsets.push_back(breaks[i]);
+    }
+    for (size_t i = 0; i < usedLines; ++i) {
+        result.lineBlobs.push_back(std::move(lines.lineBlobs[i]));
+        result.lineTops.push_back(lines.lineTops[i]);
+        result.lineBreakOffsets.push_back(lines.lineEndOffsets[i]);
+    }
+    if (resynced) {
+        for (size_t i = resyncPreviousLine + 1; i < lineCount; ++i) {
+            result.lineBlobs.push_back(std::move(previous.lineBlobs[i]));
+            result.lineTops.push_back(previous.lineTops[i] + dy);
+            if (i < breaks.size()) {
+                result.lineBreakOffsets.push_back(newOffset(breaks[i]));
+            }
+        }
+        result.lineTops.push_back(previous.lineTops.back() + dy);
+    } else {
+        result.lineBreakOffsets.pop_back();  // the end of the text
+        result.lineTops.push_back(lines.lineTops.back());
+    }
+
+    // Glyph bounds: the shaped ones are in place already.
+    std::copy(previous.glyphBounds.begin(), previous.glyphBounds.begin() + begin,
+              glyphBounds.begin());
+    if (resynced) {
+        auto previousBounds =
+                previous.glyphBounds.begin() + (shapedEnd + removedBytes - insertedBytes);
+        for (size_t i = shapedEnd; i <= textByteLen; ++i, ++previousBounds) {
+            SkRect r = *previousBounds;
+            if (r != kUnsetRect) {
+                r.offset(0, dy);
+            }
+            glyphBounds[i] = r;
+        }
+    } else {
+        glyphBounds.back() = lines.finalRect;
+    }
+    result.glyphBounds = std::move(glyphBounds);
+
+    // Word breaks: a space followed by a printable ASCII character is a word break which does
+    // not depend on the text around it, so find the words again between two of those.
+    auto isWordStart = [&](size_t i) {
+        return utf8Text[i - 1] == ' ' && utf8Text[i] > ' ' && utf8Text[i] < 0x7F;
+    };
+    size_t wordsBegin = begin;
+    while (wordsBegin > 0 && !isWordStart(wordsBegin)) {
+        --wordsBegin;
+    }
+    size_t wordsEnd = std::max(shapedEnd, std::min(editEnd + 1, textByteLen));
+    while (wordsEnd < textByteLen && !(utf8Text[wordsEnd] == ' ' &&
+                                       utf8Text[wordsEnd - 1] > ' ' &&
+                                       utf8Text[wordsEnd - 1] < 0x7F)) {
+        ++wordsEnd;
+    }
+    std::vector<bool> wordBreaks =
+            GetUtf8WordBoundaries(utf8Text + wordsBegin, wordsEnd - wordsBegin, locale);
+    if (wordBreaks.size() != wordsEnd - wordsBegin) {
+        result.wordBreaks = GetUtf8WordBoundaries(utf8Text, textByteLen, locale);
+    } else {
+        result.wordBreaks.resize(textByteLen);
+        std::copy(previous.wordBreaks.begin(), previous.wordBreaks.begin() + wordsBegin,
+                  result.wordBreaks.begin());
+        std::copy(wordBreaks.begin(), wordBreaks.end(), result.wordBreaks.begin() + wordsBegin);
+        std::copy(previous.wordBreaks.begin() + (wordsEnd + removedBytes - insertedBytes),
+                  previous.wordBreaks.end(),
+                  result.wordBreaks.begin() + wordsEnd);
+    }
+
+    result.verticalAdvance = (int)ceilf(std::max(font.getSpacing(), result.lineTops.back()));
+    return result;
+}
@@ -10,7 +10,10 @@
 namespace SkPlainTextEditor {
 
 struct ShapeResult {
-    sk_sp<SkTextBlob> blob;
+    // One blob for each line, with glyph positions relative to the top of the line.
+    std::vector<sk_sp<SkTextBlob>> lineBlobs;
+    // The top of each line, followed by the bottom of the last line.
+    std::vector<float> lineTops;
     std::vector<std::size_t> lineBreakOffsets;
     std::vector<SkRect> glyphBounds;
     std::vector<bool> wordBreaks;
@@ -24,4 +27,19 @@ ShapeResult Shape(const char* ut8text,
                   const char* locale,
                   float width);
 
+// Shape text in which insertedBytes bytes at editOffset replaced removedBytes bytes of the text
+// that previous was shaped from, with the same font, locale and width. Only the lines from the
+// one before the edit up to the first line break that is unchanged are shaped again; the other
+// lines are reused from previous.
+ShapeResult Reshape(ShapeResult previous,
+                    size_t editOffset,
+                    size_t removedBytes,
+                    size_t insertedBytes,
+                    const char* utf8Text,
+                    size_t textByteLen,
+                    const SkFont& font,
+                    sk_sp<SkFontMgr> fontMgr,
+                    const char* locale,
+                    float width);
+
 }  // namespace SkPlainTextEditor
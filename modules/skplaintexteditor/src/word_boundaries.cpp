@@ -45,14 +45,21 @@ std::vector<bool> GetUtf8WordBoundaries(const char* begin, size_t byteCount, con
     if (nullptr == unicode) {
         return {};
     }
+    if (byteCount == 0) {
+        return {};
+    }
+    // getWords returns UTF-16 offsets, so only use it if there are no UTF-8 ones.
     std::vector<SkUnicode::Position> positions;
-    if (!unicode->getWords(begin, byteCount, locale, &positions) || byteCount == 0) {
+    if (!unicode->getUtf8Words(begin, byteCount, locale, &positions) &&
+        !unicode->getWords(begin, byteCount, locale, &positions)) {
         return {};
     }
     std::vector<bool> result;
     result.resize(byteCount);
     for (auto& pos : positions) {
-        result[pos] = true;
+        if ((size_t)pos < byteCount) {
+            result[pos] = true;
+        }
     }
     return result;
 }
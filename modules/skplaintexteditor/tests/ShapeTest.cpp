@@ -0,0 +1,113 @@
+// Copyright 2026 Google LLC.
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "include/core/SkFont.h"
+#include "include/core/SkFontMgr.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkTextBlob.h"
+#include "modules/skplaintexteditor/src/shape.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkTextBlobPriv.h"
+#include "tests/Test.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <cstring>
+#include <iterator>
+#include <set>
+#include <string>
+
+using namespace SkPlainTextEditor;
+
+static bool nearly_equal(const SkRect& a, const SkRect& b) {
+    return SkScalarNearlyEqual(a.fLeft, b.fLeft) && SkScalarNearlyEqual(a.fTop, b.fTop) &&
+           SkScalarNearlyEqual(a.fRight, b.fRight) && SkScalarNearlyEqual(a.fBottom, b.fBottom);
+}
+
+static bool same_glyphs(const SkTextBlob* a, const SkTextBlob* b) {
+    if (!a || !b) {
+        return a == b;
+    }
+    SkTextBlobRunIterator itA(a), itB(b);
+    for (; !itA.done() && !itB.done(); itA.next(), itB.next()) {
+        if (itA.glyphCount() != itB.glyphCount() || itA.positioning() != itB.positioning() ||
+            memcmp(itA.glyphs(), itB.glyphs(), itA.glyphCount() * sizeof(SkGlyphID))) {
+            return false;
+        }
+        const uint32_t scalars = itA.glyphCount() * itA.scalarsPerGlyph();
+        for (uint32_t i = 0; i < scalars; ++i) {
+            if (!SkScalarNearlyEqual(itA.pos()[i], itB.pos()[i])) {
+                return false;
+            }
+        }
+    }
+    return itA.done() && itB.done();
+}
+
+// Reshape after random edits of one paragraph should give the same lines, glyph bounds and word
+// breaks as shaping the edited paragraph from scratch, while it reuses the lines away from the
+// edits.
+DEF_TEST(SkPlainTextEditor_ReshapeAfterEdits, r) {
+    sk_sp<SkFontMgr> fontMgr = ToolUtils::TestFontMgr();
+    const SkFont font(ToolUtils::DefaultPortableTypeface(), 14);
+    static constexpr float kWidth = 150;
+    static constexpr char kLocale[] = "en";
+
+    std::string text;
+    while (text.size() < 2000) {
+        text += "The quick brown fox jumps over the lazy dog, then naïve café words. ";
+    }
+    ShapeResult reshaped = Shape(text.data(), text.size(), font, fontMgr, kLocale, kWidth);
+
+    const char* insertions[] = {"a", " ", "word ", ", ", "averyveryverylongword", "é", "  "};
+    SkRandom rand;
+    auto isCharStart = [&](size_t index) {
+        return index == text.size() || (text[index] & 0xC0) != 0x80;
+    };
+    int reusedLines = 0;
+    for (int edit = 0; edit < 200; ++edit) {
+        size_t from = rand.nextULessThan(text.size() + 1);
+        size_t to = std::min(text.size(), from + rand.nextULessThan(6));
+        while (!isCharStart(from)) {
+            --from;
+        }
+        while (!isCharStart(to)) {
+            ++to;
+        }
+        const char* insertion = rand.nextULessThan(4) != 0
+                                        ? insertions[rand.nextULessThan(std::size(insertions))]
+                                        : "";
+        text.replace(from, to - from, insertion);
+
+        std::set<const SkTextBlob*> previousBlobs;
+        for (const sk_sp<SkTextBlob>& blob : reshaped.lineBlobs) {
+            previousBlobs.insert(blob.get());
+        }
+        reshaped = Reshape(std::move(reshaped), from, to - from, strlen(insertion),
+                           text.data(), text.size(), font, fontMgr, kLocale, kWidth);
+        const ShapeResult shaped = Shape(text.data(), text.size(), font, fontMgr, kLocale, kWidth);
+
+        REPORTER_ASSERT(r, reshaped.lineBreakOffsets == shaped.lineBreakOffsets, "edit %d", edit);
+        REPORTER_ASSERT(r, reshaped.wordBreaks == shaped.wordBreaks, "edit %d", edit);
+        REPORTER_ASSERT(r, reshaped.verticalAdvance == shaped.verticalAdvance, "edit %d", edit);
+        REPORTER_ASSERT(r, reshaped.lineTops.size() == shaped.lineTops.size(), "edit %d", edit);
+        for (size_t i = 0; i < reshaped.lineTops.size() && i < shaped.lineTops.size(); ++i) {
+            REPORTER_ASSERT(r, SkScalarNearlyEqual(reshaped.lineTops[i], shaped.lineTops[i]),
+                            "edit %d, line %zu", edit, i);
+        }
+        REPORTER_ASSERT(r, reshaped.lineBlobs.size() == shaped.lineBlobs.size(), "edit %d", edit);
+        for (size_t i = 0; i < reshaped.lineBlobs.size() && i < shaped.lineBlobs.size(); ++i) {
+            REPORTER_ASSERT(r, same_glyphs(reshaped.lineBlobs[i].get(), shaped.lineBlobs[i].get()),
+                            "edit %d, line %zu", edit, i);
+            reusedLines += previousBlobs.count(reshaped.lineBlobs[i].get());
+        }
+        REPORTER_ASSERT(r, reshaped.glyphBounds.size() == shaped.glyphBounds.size(),
+                        "edit %d", edit);
+        for (size_t i = 0; i < reshaped.glyphBounds.size() && i < shaped.glyphBounds.size(); ++i) {
+            REPORTER_ASSERT(r, nearly_equal(reshaped.glyphBounds[i], shaped.glyphBounds[i]),
+                            "edit %d, byte %zu", edit, i);
+        }
+    }
+    // Most of the lines of each edit are reused
+    REPORTER_ASSERT(r, reusedLines > 200 * 50, "reused %d lines", reusedLines);
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSGCacheEffect_DEFINED
+#define SkSGCacheEffect_DEFINED
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkAssert.h"
+#include "modules/sksg/include/SkSGEffectNode.h"
+#include "modules/sksg/include/SkSGRenderNode.h"
+
+#include <cstddef>
+#include <utility>
+
+class SkCanvas;
+class SkImage;
+class SkPicture;
+
+namespace sksg {
+class InvalidationController;
+
+/**
+ * Memory budget shared by a group of CacheEffect nodes.
+ *
+ * Caches are granted on a first come, first served basis: nodes which would exceed the budget
+ * render uncached, until other caches are released.
+ */
+class CacheBudget final : public SkRefCnt {
+public:
+    static sk_sp<CacheBudget> Make(size_t limit) {
+        return sk_sp<CacheBudget>(new CacheBudget(limit));
+    }
+
+    size_t limit() const { return fLimit; }
+    size_t used()  const { return fUsed;  }
+
+private:
+    explicit CacheBudget(size_t limit) : fLimit(limit) {}
+
+    bool acquire(size_t bytes) {
+        if (bytes > fLimit - fUsed) {
+            return false;
+        }
+        fUsed += bytes;
+        return true;
+    }
+
+    void release(size_t bytes) {
+        SkASSERT(bytes <= fUsed);
+        fUsed -= bytes;
+    }
+
+    const size_t fLimit;
+    size_t       fUsed = 0;
+
+    friend class CacheEffect;
+};
+
+/**
+ * Concrete Effect node, caching the rendering of its descendants while they don't change.
+ *
+ * Once the node renders for a number of frames without being invalidated, its content is
+ * rasterized into an image at the current device scale, and the image is drawn instead until
+ * the next invalidation.  Canvases which cannot allocate surfaces (e.g. recorders) and content
+ * too large for the budget get a picture instead.
+ *
+ * Image caches are dropped when the device scale changes, and rebuilt once it settles.
+ *
+ * Notes: content is only cached when rendered without pending paint overrides (which could
+ * change without invalidating this node), and cached content is isolated: it must not blend
+ * with what is drawn underneath.
+ */
+class CacheEffect final : public EffectNode {
+public:
+    static sk_sp<CacheEffect> Make(sk_sp<RenderNode> child, sk_sp<CacheBudget> budget,
+                                   int stable_frames = 2) {
+        return child && budget
+            ? sk_sp<CacheEffect>(new CacheEffect(std::move(child), std::move(budget),
+                                                 stable_frames))
+            : nullptr;
+    }
+
+    ~CacheEffect() override;
+
+    enum class CacheType {
+        kNone,
+        kImage,
+        kPicture,
+    };
+
+    CacheType cacheType() const {
+        return fImage ? CacheType::kImage : fPicture ? CacheType::kPicture : CacheType::kNone;
+    }
+
+protected:
+    void onRender(SkCanvas*, const RenderContext*) const override;
+
+    SkRect onRevalidate(InvalidationController*, const SkMatrix&) override;
+
+private:
+    CacheEffect(sk_sp<RenderNode>, sk_sp<CacheBudget>, int stable_frames);
+
+    void buildCache(SkCanvas*, const SkMatrix& ctm) const;
+    void purge() const;
+
+    const sk_sp<CacheBudget> fBudget;
+    const int                fStableFramesThreshold;
+
+    // Render-time state.
+    mutable sk_sp<SkImage>   fImage;
+    mutable sk_sp<SkPicture> fPicture;
+    mutable SkMatrix         fImageCTM;    // the ctm fImage was rasterized with
+    mutable SkPoint          fImageOrigin; // the device origin of fImage for fImageCTM
+    mutable size_t           fCacheBytes     = 0;
+    mutable int              fStableFrames   = 0;
+    mutable bool             fCacheAttempted = false;
+
+    using INHERITED = EffectNode;
+};
+
+} // namespace sksg
+
+#endif // SkSGCacheEffect_DEFINED
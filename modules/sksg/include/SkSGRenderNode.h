@@ -39,6 +39,10 @@ public:
     // Render the node and its descendants to the canvas.
     void render(SkCanvas*, const RenderContext* = nullptr) const;
 
+    // Like render(), but skips the nodes which fall outside of the canvas clip.  Use when the clip
+    // is expected to exclude most of the content (e.g. when only repainting damaged areas).
+    void renderCulled(SkCanvas*) const;
+
     // Perform a front-to-back hit-test, and return the RenderNode located at |point|.
     // Normally, hit-testing stops at leaf Draw nodes.
     const RenderNode* nodeAt(const SkPoint& point) const;
@@ -66,6 +70,9 @@ protected:
                              fMaskCTM   = SkMatrix::I();
         float                fOpacity   = 1;
 
+        // Not a paint override: skip the nodes which fall outside of the canvas clip.
+        bool                 fCullToClip = false;
+
         // Returns true if the paint overrides require a layer when applied to non-atomic draws.
         bool requiresIsolation() const;
 
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "modules/sksg/include/SkSGCacheEffect.h"
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkSurface.h"
+
+#include <cmath>
+
+namespace sksg {
+
+namespace {
+
+// True when |a| and |b| only differ in translation (i.e. cached pixels can be reused).
+bool same_scale(const SkMatrix& a, const SkMatrix& b) {
+    return SkScalarNearlyEqual(a.getScaleX(), b.getScaleX()) &&
+           SkScalarNearlyEqual(a.getSkewX() , b.getSkewX() ) &&
+           SkScalarNearlyEqual(a.getSkewY() , b.getSkewY() ) &&
+           SkScalarNearlyEqual(a.getScaleY(), b.getScaleY());
+}
+
+} // namespace
+
+CacheEffect::CacheEffect(sk_sp<RenderNode> child, sk_sp<CacheBudget> budget, int stable_frames)
+    : INHERITED(std::move(child))
+    , fBudget(std::move(budget))
+    , fStableFramesThreshold(stable_frames) {}
+
+CacheEffect::~CacheEffect() {
+    this->purge();
+}
+
+void CacheEffect::purge() const {
+    fBudget->release(fCacheBytes);
+    fCacheBytes = 0;
+    fImage      = nullptr;
+    fPicture    = nullptr;
+}
+
+void CacheEffect::onRender(SkCanvas* canvas, const RenderContext* ctx) const {
+    // Paint overrides come from ancestors, and can change without invalidating us.
+    const auto has_overrides = ctx && (ctx->requiresIsolation() || ctx->fShader);
+    const auto& ctm = canvas->getTotalMatrix();
+
+    if (fStableFrames < fStableFramesThreshold) {
+        fStableFrames++;
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    if (has_overrides || ctm.hasPerspective()) {
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    if (fImage && !same_scale(ctm, fImageCTM)) {
+        // Don't rasterize again until the scale settles.
+        this->purge();
+        fStableFrames = 0;
+        fCacheAttempted = false;
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    if (!fCacheAttempted) {
+        // Whatever the outcome, only try once per invalidation.
+        this->buildCache(canvas, ctm);
+        fCacheAttempted = true;
+    }
+
+    if (fImage) {
+        // Same scale: the content only moved by the change in translation.
+        const auto x = fImageOrigin.fX + ctm.getTranslateX() - fImageCTM.getTranslateX(),
+                   y = fImageOrigin.fY + ctm.getTranslateY() - fImageCTM.getTranslateY();
+        const auto sampling = (x == std::floor(x) && y == std::floor(y))
+                ? SkSamplingOptions()
+                : SkSamplingOptions(SkFilterMode::kLinear);
+
+        canvas->save();
+        canvas->resetMatrix();
+        canvas->drawImage(fImage, x, y, sampling);
+        canvas->restore();
+    } else if (fPicture) {
+        canvas->drawPicture(fPicture);
+    } else {
+        this->INHERITED::onRender(canvas, ctx);
+    }
+}
+
+void CacheEffect::buildCache(SkCanvas* canvas, const SkMatrix& ctm) const {
+    SkASSERT(!fImage && !fPicture && !fCacheBytes);
+
+    const auto device_bounds = ctm.mapRect(this->bounds()).roundOut();
+    const auto info = canvas->imageInfo().makeDimensions(device_bounds.size());
+    const auto image_bytes = info.computeMinByteSize();
+
+    if (!device_bounds.isEmpty() && fBudget->acquire(image_bytes)) {
+        if (auto surface = canvas->makeSurface(info)) {
+            auto* cache_canvas = surface->getCanvas();
+            cache_canvas->clear(SK_ColorTRANSPARENT);
+            cache_canvas->setMatrix(SkMatrix::Translate(-device_bounds.fLeft,
+                                                        -device_bounds.fTop) * ctm);
+            this->INHERITED::onRender(cache_canvas, nullptr);
+
+            fImage       = surface->makeImageSnapshot();
+            fImageCTM    = ctm;
+            fImageOrigin = SkPoint::Make(device_bounds.fLeft, device_bounds.fTop);
+            fCacheBytes  = image_bytes;
+            return;
+        }
+        fBudget->release(image_bytes);
+    }
+
+    SkRTreeFactory bbh_factory;
+    SkPictureRecorder recorder;
+    this->INHERITED::onRender(recorder.beginRecording(this->bounds(), &bbh_factory), nullptr);
+    auto picture = recorder.finishRecordingAsPicture();
+
+    if (picture && fBudget->acquire(picture->approximateBytesUsed())) {
+        fCacheBytes = picture->approximateBytesUsed();
+        fPicture    = std::move(picture);
+    }
+}
+
+SkRect CacheEffect::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
+    SkASSERT(this->hasInval());
+
+    this->purge();
+    fStableFrames = 0;
+    fCacheAttempted = false;
+
+    return this->INHERITED::onRevalidate(ic, ctm);
+}
+
+} // namespace sksg
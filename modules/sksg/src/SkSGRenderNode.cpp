@@ -48,12 +48,20 @@ void RenderNode::setVisible(bool v) {
 
 void RenderNode::render(SkCanvas* canvas, const RenderContext* ctx) const {
     SkASSERT(!this->hasInval());
-    if (this->isVisible() && !this->bounds().isEmpty()) {
+    if (this->isVisible() && !this->bounds().isEmpty() &&
+        !(ctx && ctx->fCullToClip && canvas->quickReject(this->bounds()))) {
         this->onRender(canvas, ctx);
     }
     SkASSERT(!this->hasInval());
 }
 
+void RenderNode::renderCulled(SkCanvas* canvas) const {
+    RenderContext ctx;
+    ctx.fCullToClip = true;
+
+    this->render(canvas, &ctx);
+}
+
 const RenderNode* RenderNode::nodeAt(const SkPoint& p) const {
     return this->bounds().contains(p.x(), p.y()) ? this->onNodeAt(p) : nullptr;
 }
@@ -228,7 +236,10 @@ RenderNode::ScopedRenderContext::setFilterIsolation(const SkRect& bounds, const
         SkASSERT(!layer_paint.getImageFilter());
         layer_paint.setImageFilter(std::move(filter));
         fCanvas->saveLayer(bounds, &layer_paint);
+
+        const auto cull_to_clip = fCtx.fCullToClip;
         fCtx = RenderContext();
+        fCtx.fCullToClip = cull_to_clip;
     }
 
     return std::move(*this);
@@ -9,8 +9,14 @@
 
 #if !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkSurface.h"
 #include "include/private/base/SkTo.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
 #include "modules/sksg/include/SkSGDraw.h"
 #include "modules/sksg/include/SkSGGroup.h"
 #include "modules/sksg/include/SkSGInvalidationController.h"
@@ -22,6 +28,7 @@
 
 #include "tests/Test.h"
 
+#include <cstring>
 #include <vector>
 
 static void check_inval(skiatest::Reporter* reporter, const sk_sp<sksg::Node>& root,
@@ -355,4 +362,83 @@ DEF_TEST(SGInvalidation, reporter) {
     inval_group_remove(reporter);
 }
 
+DEF_TEST(SGCacheEffect, reporter) {
+    auto budget = sksg::CacheBudget::Make(1 << 20);
+    auto color  = sksg::Color::Make(SK_ColorRED);
+    auto matrix = sksg::Matrix<SkMatrix>::Make(SkMatrix::I());
+    auto cache  = sksg::CacheEffect::Make(
+                          sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeLTRB(10, 10, 50, 50)),
+                                           color),
+                          budget);
+    auto root   = sksg::TransformEffect::Make(cache, matrix);
+
+    // Renders the scene, cached and uncached, and checks that both match.
+    const auto info = SkImageInfo::MakeN32Premul(100, 100);
+    auto surface = SkSurfaces::Raster(info),
+         expected_surface = SkSurfaces::Raster(info);
+    auto render = [&]() {
+        root->revalidate(nullptr, SkMatrix::I());
+        surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+        root->render(surface->getCanvas());
+
+        expected_surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+        expected_surface->getCanvas()->concat(matrix->getMatrix());
+        expected_surface->getCanvas()->drawRect(SkRect::MakeLTRB(10, 10, 50, 50),
+                                                color->makePaint());
+        expected_surface->getCanvas()->resetMatrix();
+
+        SkPixmap pixels, expected_pixels;
+        REPORTER_ASSERT(reporter, surface->peekPixels(&pixels) &&
+                                  expected_surface->peekPixels(&expected_pixels));
+        REPORTER_ASSERT(reporter, !memcmp(pixels.addr(), expected_pixels.addr(),
+                                          pixels.computeByteSize()));
+    };
+
+    // Content is cached after it renders unchanged for a couple of frames.
+    render();
+    render();
+    REPORTER_ASSERT(reporter, cache->cacheType() == sksg::CacheEffect::CacheType::kNone);
+    REPORTER_ASSERT(reporter, budget->used() == 0);
+    render();
+    REPORTER_ASSERT(reporter, cache->cacheType() == sksg::CacheEffect::CacheType::kImage);
+    REPORTER_ASSERT(reporter, budget->used() == 40 * 40 * 4);
+
+    // Translating the cached content doesn't drop the cache.
+    matrix->setMatrix(SkMatrix::Translate(5, 7));
+    render();
+    REPORTER_ASSERT(reporter, cache->cacheType() == sksg::CacheEffect::CacheType::kImage);
+
+    // Scaling it does.
+    matrix->setMatrix(SkMatrix::Scale(2, 2));
+    render();
+    REPORTER_ASSERT(reporter, cache->cacheType() == sksg::CacheEffect::CacheType::kNone);
+    REPORTER_ASSERT(reporter, budget->used() == 0);
+    render();
+    render();
+    render();
+    REPORTER_ASSERT(reporter, cache->cacheType() == sksg::CacheEffect::CacheType::kImage);
+    REPORTER_ASSERT(reporter, budget->used() == 80 * 80 * 4);
+
+    // So does changing it.
+    color->setColor(SK_ColorBLUE);
+    render();
+    REPORTER_ASSERT(reporter, cache->cacheType() == sksg::CacheEffect::CacheType::kNone);
+    REPORTER_ASSERT(reporter, budget->used() == 0);
+
+    // Content too large for the budget is recorded into a picture instead.
+    auto small_budget = sksg::CacheBudget::Make(80 * 80 * 4 - 1);
+    cache = sksg::CacheEffect::Make(
+                    sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeLTRB(10, 10, 50, 50)), color),
+                    small_budget, 0);
+    root = sksg::TransformEffect::Make(cache, matrix);
+    render();
+    REPORTER_ASSERT(reporter, cache->cacheType() == sksg::CacheEffect::CacheType::kPicture);
+    REPORTER_ASSERT(reporter, small_budget->used() > 0);
+
+    // The budget is released along with the node.
+    root  = nullptr;
+    cache = nullptr;
+    REPORTER_ASSERT(reporter, small_budget->used() == 0);
+}
+
 #endif // !defined(SK_BUILD_FOR_GOOGLE3)
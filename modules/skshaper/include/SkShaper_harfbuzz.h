@@ -13,6 +13,7 @@
 #include "modules/skshaper/include/SkShaper.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 
 class SkFontMgr;
@@ -33,6 +34,21 @@ SKSHAPER_API std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(cons
                                                                             SkFourByteTag script);
 
 SKSHAPER_API void PurgeCaches();
+
+// Shaped runs are cached by font, direction, script, language, features and text, so that text
+// which is shaped again, like the labels of a UI, is not shaped by HarfBuzz again.
+struct RunCacheStats {
+    size_t   fBytesUsed;
+    size_t   fByteLimit;
+    int      fCount;
+    uint64_t fHits;
+    uint64_t fMisses;
+};
+
+// Set the most memory the run cache may use and return the previous limit. A limit of 0 turns the
+// cache off.
+SKSHAPER_API size_t SetRunCacheLimit(size_t bytes);
+SKSHAPER_API RunCacheStats GetRunCacheStats();
 }  // namespace SkShapers::HB
 
 #endif
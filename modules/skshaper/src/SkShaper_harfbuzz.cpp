@@ -28,6 +28,7 @@
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkThreadAnnotations.h"
 #include "include/private/base/SkTo.h"
 #include "include/private/base/SkTypeTraits.h"
 #include "modules/skshaper/include/SkShaper.h"
@@ -43,9 +44,13 @@
 #include <hb-ot.h>
 #include <hb.h>
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -1275,6 +1280,195 @@ static HBLockedFaceCache get_hbFace_cache() {
     return HBLockedFaceCache(gHBFaceCache, gHBFaceCacheMutex);
 }
 
+// The glyphs of shaped runs, keyed by everything hb_shape looks at. Clusters are relative to the
+// start of the run.
+class RunCache {
+public:
+    static constexpr size_t kDefaultByteLimit = 1 << 20;
+
+    // Runs longer than this are seldom shaped again, so don't spend time and memory on them.
+    static constexpr size_t kMaxRunBytes = 1024;
+
+    // HarfBuzz keeps up to 5 code points of the text around a run as context.
+    static constexpr size_t kContextBytes = 5 * SkUTF::kMaxBytesInUTF8Sequence;
+
+    // Make the key for shaping utf8[utf8Start, utf8End). Returns false if the run is not cached.
+    static bool MakeKey(const char* utf8, size_t utf8Bytes,
+                        const char* utf8Start, const char* utf8End,
+                        const SkFont& font,
+                        hb_direction_t direction,
+                        hb_script_t script,
+                        hb_language_t language,
+                        const SkShaper::Feature* features, size_t featuresSize,
+                        std::string* key);
+
+    // Whether runs should be looked up at all: checked without locking, so that a disabled cache
+    // costs neither key building nor contention.
+    bool enabled() const { return fByteLimit.load(std::memory_order_relaxed) > 0; }
+
+    // Returns false if the key is not in the cache.
+    bool find(const std::string& key, size_t runStart, ShapedRun* run) SK_EXCLUDES(fMutex);
+    void insert(const std::string& key, size_t runStart, const ShapedRun& run)
+            SK_EXCLUDES(fMutex);
+
+    size_t setByteLimit(size_t bytes) SK_EXCLUDES(fMutex);
+    SkShapers::HB::RunCacheStats stats() const SK_EXCLUDES(fMutex);
+    void reset() SK_EXCLUDES(fMutex);
+
+private:
+    struct Entry {
+        Entry(std::unique_ptr<ShapedGlyph[]> glyphs, size_t numGlyphs, SkVector advance,
+              size_t bytes, size_t* bytesUsed)
+                : fGlyphs(std::move(glyphs)), fNumGlyphs(numGlyphs), fAdvance(advance)
+                , fBytes(bytes), fBytesUsed(bytesUsed) {
+            *fBytesUsed += fBytes;
+        }
+        ~Entry() { *fBytesUsed -= fBytes; }
+
+        std::unique_ptr<ShapedGlyph[]> fGlyphs;
+        size_t fNumGlyphs;
+        SkVector fAdvance;
+        size_t fBytes;
+        size_t* fBytesUsed;
+    };
+
+    void purgeAsNeeded() SK_REQUIRES(fMutex);
+
+    mutable SkMutex fMutex;
+    // Entries update this when they are destroyed, so it must outlive fEntries.
+    size_t fBytesUsed = 0;
+    SkLRUCache<std::string, std::unique_ptr<Entry>> fEntries SK_GUARDED_BY(fMutex){INT_MAX};
+    // Written under fMutex, read without it by enabled().
+    std::atomic<size_t> fByteLimit = kDefaultByteLimit;
+    uint64_t fHits SK_GUARDED_BY(fMutex) = 0;
+    uint64_t fMisses SK_GUARDED_BY(fMutex) = 0;
+};
+
+bool RunCache::MakeKey(const char* utf8, size_t utf8Bytes,
+                       const char* utf8Start, const char* utf8End,
+                       const SkFont& font,
+                       hb_direction_t direction,
+                       hb_script_t script,
+                       hb_language_t language,
+                       const SkShaper::Feature* features, size_t featuresSize,
+                       std::string* key) {
+    const size_t runStart = utf8Start - utf8;
+    const size_t runEnd = utf8End - utf8;
+    if (runEnd - runStart > kMaxRunBytes) {
+        return false;
+    }
+
+    key->clear();
+    auto append = [key](const auto& value) {
+        key->append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    // Features which only apply to part of the run are rare, don't cache those runs.
+    uint32_t featureCount = 0;
+    for (const auto& feature : SkSpan(features, featuresSize)) {
+        if (feature.end < runStart || runEnd <= feature.start) {
+            continue;
+        }
+        if (runStart < feature.start || feature.end < runEnd) {
+            return false;
+        }
+        append(feature.tag);
+        append(feature.value);
+        featureCount += 1;
+    }
+    append(featureCount);
+
+    append(font.getTypeface()->uniqueID());
+    append(font.getSize());
+    append(font.getScaleX());
+    append(font.getSkewX());
+    append(font.getEdging());
+    append(font.getHinting());
+    const uint8_t flags = (font.isForceAutoHinting() << 0) |
+                          (font.isEmbeddedBitmaps()  << 1) |
+                          (font.isSubpixel()         << 2) |
+                          (font.isLinearMetrics()    << 3) |
+                          (font.isEmbolden()         << 4) |
+                          (font.isBaselineSnap()     << 5);
+    append(flags);
+    append(direction);
+    append(script);
+    key->append(hb_language_to_string(language));
+    key->push_back('\0');
+
+    const size_t preContext = std::min(runStart, kContextBytes);
+    const size_t postContext = std::min(utf8Bytes - runEnd, kContextBytes);
+    append(preContext);
+    append(postContext);
+    key->append(utf8Start - preContext, preContext + (runEnd - runStart) + postContext);
+    return true;
+}
+
+bool RunCache::find(const std::string& key, size_t runStart, ShapedRun* run) {
+    SkAutoMutexExclusive lock(fMutex);
+    std::unique_ptr<Entry>* found = fEntries.find(key);
+    if (!found) {
+        fMisses += 1;
+        return false;
+    }
+    fHits += 1;
+
+    const Entry& entry = **found;
+    *run = ShapedRun(run->fUtf8Range, run->fFont, run->fLevel,
+                     std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[entry.fNumGlyphs]),
+                     entry.fNumGlyphs, entry.fAdvance);
+    for (size_t i = 0; i < entry.fNumGlyphs; ++i) {
+        run->fGlyphs[i] = entry.fGlyphs[i];
+        run->fGlyphs[i].fCluster += runStart;
+    }
+    return true;
+}
+
+void RunCache::insert(const std::string& key, size_t runStart, const ShapedRun& run) {
+    SkAutoMutexExclusive lock(fMutex);
+    if (!this->enabled() || fEntries.find(key)) {
+        return;
+    }
+    std::unique_ptr<ShapedGlyph[]> glyphs(new ShapedGlyph[run.fNumGlyphs]);
+    for (size_t i = 0; i < run.fNumGlyphs; ++i) {
+        glyphs[i] = run.fGlyphs[i];
+        glyphs[i].fCluster -= runStart;
+    }
+    const size_t bytes = sizeof(Entry) + key.size() + run.fNumGlyphs * sizeof(ShapedGlyph);
+    fEntries.insert(key, std::make_unique<Entry>(std::move(glyphs), run.fNumGlyphs,
+                                                 run.fAdvance, bytes, &fBytesUsed));
+    this->purgeAsNeeded();
+}
+
+size_t RunCache::setByteLimit(size_t bytes) {
+    SkAutoMutexExclusive lock(fMutex);
+    const size_t previous = fByteLimit.exchange(bytes, std::memory_order_relaxed);
+    this->purgeAsNeeded();
+    return previous;
+}
+
+SkShapers::HB::RunCacheStats RunCache::stats() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return {fBytesUsed, fByteLimit.load(std::memory_order_relaxed), fEntries.count(), fHits,
+            fMisses};
+}
+
+void RunCache::reset() {
+    SkAutoMutexExclusive lock(fMutex);
+    fEntries.reset();
+}
+
+void RunCache::purgeAsNeeded() {
+    while (fBytesUsed > fByteLimit.load(std::memory_order_relaxed)) {
+        fEntries.removeLRU();
+    }
+}
+
+static RunCache& get_run_cache() {
+    static RunCache gRunCache;
+    return gRunCache;
+}
+
 ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
                                   size_t const utf8Bytes,
                                   char const * const utf8Start,
@@ -1289,6 +1483,26 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     ShapedRun run(RunHandler::Range(utf8Start - utf8, utf8runLength),
                   font.currentFont(), bidi.currentLevel(), nullptr, 0);
 
+    hb_direction_t direction = is_LTR(bidi.currentLevel()) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
+    hb_script_t hbScript = hb_script_from_iso15924_tag((hb_tag_t)script.currentScript());
+    // Buffers with HB_LANGUAGE_INVALID race since hb_language_get_default is not thread safe.
+    // The user must provide a language, but may provide data hb_language_from_string cannot use.
+    // Use "und" for the undefined language in this case (RFC5646 4.1 5).
+    hb_language_t hbLanguage = hb_language_from_string(language.currentLanguage(), -1);
+    if (hbLanguage == HB_LANGUAGE_INVALID) {
+        hbLanguage = fUndefinedLanguage;
+    }
+
+    RunCache& runCache = get_run_cache();
+    std::string runKey;
+    const bool cacheRun = runCache.enabled() &&
+                          RunCache::MakeKey(utf8, utf8Bytes, utf8Start, utf8End,
+                                            font.currentFont(), direction, hbScript, hbLanguage,
+                                            features, featuresSize, &runKey);
+    if (cacheRun && runCache.find(runKey, utf8Start - utf8, &run)) {
+        return run;
+    }
+
     hb_buffer_t* buffer = fBuffer.get();
     SkAutoTCallVProc<hb_buffer_t, hb_buffer_clear_contents> autoClearBuffer(buffer);
     hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
@@ -1313,16 +1527,8 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     // Add postcontext.
     hb_buffer_add_utf8(buffer, utf8Current, utf8 + utf8Bytes - utf8Current, 0, 0);
 
-    hb_direction_t direction = is_LTR(bidi.currentLevel()) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
     hb_buffer_set_direction(buffer, direction);
-    hb_buffer_set_script(buffer, hb_script_from_iso15924_tag((hb_tag_t)script.currentScript()));
-    // Buffers with HB_LANGUAGE_INVALID race since hb_language_get_default is not thread safe.
-    // The user must provide a language, but may provide data hb_language_from_string cannot use.
-    // Use "und" for the undefined language in this case (RFC5646 4.1 5).
-    hb_language_t hbLanguage = hb_language_from_string(language.currentLanguage(), -1);
-    if (hbLanguage == HB_LANGUAGE_INVALID) {
-        hbLanguage = fUndefinedLanguage;
-    }
+    hb_buffer_set_script(buffer, hbScript);
     hb_buffer_set_language(buffer, hbLanguage);
     hb_buffer_guess_segment_properties(buffer);
 
@@ -1415,6 +1621,9 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     }
     run.fAdvance = runAdvance;
 
+    if (cacheRun) {
+        runCache.insert(runKey, utf8Start - utf8, run);
+    }
     return run;
 }
 }  // namespace
@@ -1534,5 +1743,14 @@ std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(const char* utf8,
 void PurgeCaches() {
     HBLockedFaceCache cache = get_hbFace_cache();
     cache.reset();
+    get_run_cache().reset();
+}
+
+size_t SetRunCacheLimit(size_t bytes) {
+    return get_run_cache().setByteLimit(bytes);
+}
+
+RunCacheStats GetRunCacheStats() {
+    return get_run_cache().stats();
 }
 }  // namespace SkShapers::HB
@@ -20,6 +20,7 @@
 #include "tools/Resources.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#include <cfloat>
 #include <cinttypes>
 #include <cstdint>
 #include <memory>
@@ -271,4 +272,64 @@ SHAPER_TEST(taitham)
 SHAPER_TEST(tamil)
 #undef SHAPER_TEST
 
+DEF_TEST(Shaper_RunCache, r) {
+    auto shaper = SkShapers::HB::ShapeDontWrapOrReorder(get_unicode(), SkFontMgr::RefEmpty());
+    if (!shaper) {
+        ERRORF(r, "Could not create shaper.");
+        return;
+    }
+    size_t previousLimit = SkShapers::HB::SetRunCacheLimit(1 << 20);
+    SkShapers::HB::PurgeCaches();
+
+    constexpr char kText[] = "Hello, World!";
+    constexpr size_t kTextBytes = sizeof(kText) - 1;
+    SkFont font = ToolUtils::DefaultFont();
+    auto shape = [&](RunHandler* rh) {
+        auto fontIterator = SkShaper::TrivialFontRunIterator(font, kTextBytes);
+        auto bidiIterator = SkShaper::TrivialBiDiRunIterator(0, kTextBytes);
+        auto scriptIterator =
+                SkShaper::TrivialScriptRunIterator(SkSetFourByteTag('l','a','t','n'), kTextBytes);
+        auto languageIterator = SkShaper::TrivialLanguageRunIterator("en-US", kTextBytes);
+        shaper->shape(kText, kTextBytes, fontIterator, bidiIterator, scriptIterator,
+                      languageIterator, nullptr, 0, FLT_MAX, rh);
+    };
+
+    RunHandler shaped("Shaper_RunCache", r, kText, kTextBytes);
+    shape(&shaped);
+    SkShapers::HB::RunCacheStats stats = SkShapers::HB::GetRunCacheStats();
+    REPORTER_ASSERT(r, stats.fCount == 1);
+    REPORTER_ASSERT(r, 0 < stats.fBytesUsed && stats.fBytesUsed <= stats.fByteLimit);
+
+    RunHandler cached("Shaper_RunCache", r, kText, kTextBytes);
+    shape(&cached);
+    REPORTER_ASSERT(r, SkShapers::HB::GetRunCacheStats().fHits == stats.fHits + 1);
+    REPORTER_ASSERT(r, cached.fGlyphCount == shaped.fGlyphCount);
+    for (unsigned i = 0; i < shaped.fGlyphCount && i < cached.fGlyphCount; ++i) {
+        REPORTER_ASSERT(r, cached.fGlyphs[i] == shaped.fGlyphs[i]);
+        REPORTER_ASSERT(r, cached.fPositions[i] == shaped.fPositions[i]);
+        REPORTER_ASSERT(r, cached.fClusters[i] == shaped.fClusters[i]);
+    }
+
+    // A different size is shaped again.
+    font.setSize(font.getSize() * 2);
+    RunHandler larger("Shaper_RunCache", r, kText, kTextBytes);
+    shape(&larger);
+    REPORTER_ASSERT(r, SkShapers::HB::GetRunCacheStats().fCount == 2);
+
+    SkShapers::HB::SetRunCacheLimit(0);
+    stats = SkShapers::HB::GetRunCacheStats();
+    REPORTER_ASSERT(r, stats.fCount == 0);
+    REPORTER_ASSERT(r, stats.fBytesUsed == 0);
+
+    // A disabled cache is not looked up at all.
+    RunHandler uncached("Shaper_RunCache", r, kText, kTextBytes);
+    shape(&uncached);
+    const SkShapers::HB::RunCacheStats disabledStats = SkShapers::HB::GetRunCacheStats();
+    REPORTER_ASSERT(r, disabledStats.fCount == 0);
+    REPORTER_ASSERT(r, disabledStats.fHits == stats.fHits);
+    REPORTER_ASSERT(r, disabledStats.fMisses == stats.fMisses);
+
+    SkShapers::HB::SetRunCacheLimit(previousLimit);
+}
+
 #endif  // #if defined(SK_SHAPER_HARFBUZZ_AVAILABLE) && defined(SK_SHAPER_UNICODE_AVAILABLE)
@@ -198,6 +198,15 @@ class SKUNICODE_API SkUnicode : public SkRefCnt {
             while (ptr < end) {
 
                 size_t index = SkToSizeT(ptr - utf8.begin());
+                if ((uint8_t)*ptr < 0x80) {
+                    // ASCII is one code unit in both encodings
+                    appender16(size8);
+                    ++size16;
+                    appender8(index);
+                    ++size8;
+                    ++ptr;
+                    continue;
+                }
                 SkUnichar u = SkUTF::NextUTF8(&ptr, end);
 
                 // All UTF8 code units refer to the same codepoint
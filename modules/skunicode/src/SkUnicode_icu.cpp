@@ -408,9 +408,19 @@ class SkUnicode_icu : public SkUnicode {
             // (ICU line break iterator does not work correctly on Thai text with new lines)
             // So, we only use the iterator to collect soft line breaks and
             // scan the text for all hard line breaks ourselves
+            const ASCIIProperties& ascii = GetASCIIProperties();
             const char* end = utf8 + utf8Units;
             const char* ch = utf8;
             while (ch < end) {
+                const char* asciiEnd = ch + SkUTF::CountASCIIPrefix(ch, end - ch);
+                for (; ch < asciiEnd; ++ch) {
+                    if (ascii.fHardLineBreak[(uint8_t)*ch]) {
+                        setBreak(ch + 1 - utf8, UBRK_LINE_HARD);
+                    }
+                }
+                if (ch == end) {
+                    break;
+                }
                 auto unichar = utf8_next(&ch, end);
                 if (SkUnicode_icu::isHardLineBreak(unichar)) {
                     setBreak(ch - utf8, UBRK_LINE_HARD);
@@ -469,6 +479,37 @@ class SkUnicode_icu : public SkUnicode {
         return property == U_LB_LINE_FEED || property == U_LB_MANDATORY_BREAK;
     }
 
+    // The properties computeCodeUnitFlags and extractPositions look up, for each ASCII codepoint
+    struct ASCIIProperties {
+        CodeUnitFlags fFlags[128];
+        bool fHardLineBreak[128];
+    };
+
+    static const ASCIIProperties& GetASCIIProperties() {
+        static const ASCIIProperties properties = [] {
+            ASCIIProperties p;
+            for (SkUnichar c = 0; c < 128; ++c) {
+                CodeUnitFlags flags = CodeUnitFlags::kNoCodeUnitFlag;
+                if (sk_u_isspace(c)) {
+                    flags |= SkUnicode::kPartOfIntraWordBreak;
+                }
+                if (sk_u_isWhitespace(c)) {
+                    flags |= SkUnicode::kPartOfWhiteSpaceBreak;
+                }
+                if (sk_u_iscntrl(c)) {
+                    flags |= SkUnicode::kControl;
+                }
+                if (sk_u_hasBinaryProperty(c, UCHAR_IDEOGRAPHIC)) {
+                    flags |= SkUnicode::kIdeographic;
+                }
+                p.fFlags[c] = flags;
+                p.fHardLineBreak[c] = isHardLineBreak(c);
+            }
+            return p;
+        }();
+        return properties;
+    }
+
 public:
     ~SkUnicode_icu() override { }
     std::unique_ptr<SkBidiIterator> makeBidiIterator(const uint16_t text[], int count,
@@ -585,9 +626,26 @@ public:
             (*results)[pos] |= CodeUnitFlags::kGraphemeStart;
         });
 
+        const ASCIIProperties& ascii = GetASCIIProperties();
         const char* current = utf8;
         const char* end = utf8 + utf8Units;
         while (current < end) {
+            // Runs of ASCII only need a table lookup for each code unit
+            const char* asciiEnd = current + SkUTF::CountASCIIPrefix(current, end - current);
+            for (; current < asciiEnd; ++current) {
+                auto index = current - utf8;
+                SkUnichar unichar = (uint8_t)*current;
+                if (replaceTabs && this->isTabulation(unichar)) {
+                    results->at(index) |= SkUnicode::kTabulation;
+                    unichar = ' ';
+                    utf8[index] = ' ';
+                }
+                (*results)[index] |= ascii.fFlags[unichar];
+            }
+            if (current == end) {
+                break;
+            }
+
             auto before = current - utf8;
             SkUnichar unichar = SkUTF::NextUTF8(&current, end);
             if (unichar < 0) unichar = 0xFFFD;
@@ -93,6 +93,13 @@ bool SkBidiFactory::ExtractBidi(const char utf8[],
                                 int utf8Units,
                                 SkUnicode::TextDirection dir,
                                 std::vector<SkUnicode::BidiRegion>* bidiRegions) const {
+    if (dir == SkUnicode::TextDirection::kLTR && utf8Units > 0 &&
+        SkUTF::CountASCIIPrefix(utf8, utf8Units) == SkToSizeT(utf8Units)) {
+        // ASCII has no right to left characters or bidi controls
+        bidiRegions->emplace_back(0, utf8Units, UBIDI_LTR);
+        return true;
+    }
+
     // Convert to UTF16 since for now bidi iterator only operates on utf16
     auto utf16 = SkUnicode::convertUtf8ToUtf16(utf8, utf8Units);
 
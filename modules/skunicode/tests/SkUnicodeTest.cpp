@@ -10,6 +10,7 @@
 #include "include/core/SkString.h"
 #include "include/core/SkTypeface.h"
 #include "src/base/SkBitmaskEnum.h"
+#include "src/base/SkUTF.h"
 #include "tests/Test.h"
 
 #include "modules/skunicode/include/SkUnicode.h"
@@ -283,6 +284,61 @@ DEF_TEST_ICU_UNICODES(SkUnicode_ComputeCodeUnitFlags, reporter) {
     }
 }
 
+DEF_TEST_ICU_UNICODES(SkUnicode_ComputeCodeUnitFlagsMixed, reporter) {
+    if (!unicode) {
+        return;
+    }
+    // Long ASCII runs with tabs, controls and hard breaks between other scripts and spaces
+    SkString text("Lorem ipsum\tdolor sit amet,\vconsectetur\x01 \u00A0\u4E2D\u6587 adipiscing "
+                  "elit\r\n\u0417\u0434\u0440\u0430\u0432\u0441\u0442\u0432\u0443\u0439\u0442\u0435"
+                  "\u3000sed do eiusmod tempor incididunt ut labore\u2028et dolore magna");
+    SkString original = text;
+    TArray<SkUnicode::CodeUnitFlags, true> results;
+    REPORTER_ASSERT(reporter, unicode->computeCodeUnitFlags(text.data(), text.size(),
+                                                            /*replaceTabs=*/true, &results));
+    REPORTER_ASSERT(reporter, results.size() == SkToInt(text.size() + 1));
+
+    constexpr auto kClassFlags = SkUnicode::kPartOfWhiteSpaceBreak |
+                                 SkUnicode::kPartOfIntraWordBreak |
+                                 SkUnicode::kControl |
+                                 SkUnicode::kIdeographic;
+    const char* ptr = original.c_str();
+    const char* end = ptr + original.size();
+    while (ptr < end) {
+        size_t start = ptr - original.c_str();
+        SkUnichar unichar = SkUTF::NextUTF8(&ptr, end);
+        auto tab = unicode->isTabulation(unichar) ? SkUnicode::kTabulation
+                                                  : SkUnicode::kNoCodeUnitFlag;
+        if (tab) {
+            REPORTER_ASSERT(reporter, text[start] == ' ');
+            unichar = ' ';
+        }
+        auto expected = SkUnicode::kNoCodeUnitFlag;
+        if (unicode->isSpace(unichar)) {
+            expected |= SkUnicode::kPartOfIntraWordBreak;
+        }
+        if (unicode->isWhitespace(unichar)) {
+            expected |= SkUnicode::kPartOfWhiteSpaceBreak;
+        }
+        if (unicode->isControl(unichar)) {
+            expected |= SkUnicode::kControl;
+        }
+        if (unicode->isIdeographic(unichar)) {
+            expected |= SkUnicode::kIdeographic;
+        }
+        REPORTER_ASSERT(reporter, (results[start] & SkUnicode::kTabulation) == tab);
+        for (size_t i = start; i < SkToSizeT(ptr - original.c_str()); ++i) {
+            REPORTER_ASSERT(reporter, (results[i] & kClassFlags) == expected,
+                            "U+%04X at %zu", unichar, i);
+        }
+        // Hard line breaks are found for ASCII and other codepoints
+        bool hardBreakAfter = (results[ptr - original.c_str()] &
+                               SkUnicode::kHardLineBreakBefore) == SkUnicode::kHardLineBreakBefore;
+        REPORTER_ASSERT(reporter, hardBreakAfter == unicode->isHardBreak(unichar),
+                        "U+%04X at %zu", unichar, start);
+    }
+}
+
 DEF_TEST_UNICODES(SkUnicode_ReorderVisual, reporter) {
     if (!unicode) {
         return;
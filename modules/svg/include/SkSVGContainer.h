@@ -26,6 +26,10 @@ protected:
 
     bool hasChildren() const final;
 
+    size_t onApproximateBytesUsed() const override;
+
+    uint64_t onDescendantMutationCount() const override;
+
     template <typename NodeType, typename Func>
     void forEachChild(Func func) const {
         for (const auto& child : fChildren) {
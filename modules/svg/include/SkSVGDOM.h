@@ -11,13 +11,18 @@
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTemplates.h"
 #include "modules/skresources/include/SkResources.h"
 #include "modules/skshaper/include/SkShaper_factory.h"
 #include "modules/svg/include/SkSVGIDMapper.h"
 
+#include <cstdint>
+#include <vector>
+
 class SkCanvas;
 class SkDOM;
+class SkPicture;
 class SkStream;
 class SkSVGNode;
 struct SkSVGPresentationContext;
@@ -46,18 +51,42 @@ public:
          */
         Builder& setTextShapingFactory(sk_sp<SkShapers::Factory>);
 
+        /**
+         * By default, documents are tokenized and turned into SVG nodes in a single pass, and
+         * only documents using XML features the tokenizer doesn't support (e.g. DTD internal
+         * subsets, or encodings other than UTF-8) are parsed into an intermediate XML DOM.
+         *
+         * This forces the XML DOM path for all documents.
+         */
+        Builder& setUseXMLDOMParser(bool);
+
+        /**
+         * When enabled, render() records the document into a picture (with a bounding box
+         * hierarchy) and draws that instead, reusing it until the DOM is modified.  Pictures are
+         * cached per container size, for documents sized relative to their container.
+         *
+         * This trades memory for faster repeated renders: style resolution, paint and path
+         * construction are not repeated, and the BBH culls the content outside the canvas clip.
+         * Checking for modifications walks the node tree on each render.
+         */
+        Builder& setPictureCaching(bool);
+
         sk_sp<SkSVGDOM> make(SkStream&) const;
 
     private:
         sk_sp<SkFontMgr>                             fFontMgr;
         sk_sp<skresources::ResourceProvider>         fResourceProvider;
         sk_sp<SkShapers::Factory>                    fTextShapingFactory;
+        bool                                         fUseXMLDOMParser = false;
+        bool                                         fPictureCaching  = false;
     };
 
     static sk_sp<SkSVGDOM> MakeFromStream(SkStream& str) {
         return Builder().make(str);
     }
 
+    ~SkSVGDOM() override;
+
     /**
      * Returns the root (outermost) SVG element.
      */
@@ -96,19 +125,44 @@ public:
     /** Render the node with the given id as if it were the only child of the root. */
     void renderNode(SkCanvas*, SkSVGPresentationContext&, const char* id) const;
 
+    /**
+     * Returns the approximate memory used by the document: nodes and attribute values, child
+     * lists, the id map and cached pictures.  Storage allocated for nodes created outside of
+     * the builder is not accounted for.
+     */
+    size_t approximateBytesUsed() const;
+
 private:
     SkSVGDOM(sk_sp<SkSVGSVG>,
              sk_sp<SkFontMgr>,
              sk_sp<skresources::ResourceProvider>,
              SkSVGIDMapper&&,
-             sk_sp<SkShapers::Factory>);
+             sk_sp<SkShapers::Factory>,
+             size_t nodeBytes,
+             bool pictureCaching);
+
+    void renderUncached(SkCanvas*) const;
+    sk_sp<SkPicture> cachedPicture() const;
 
     const sk_sp<SkSVGSVG>                       fRoot;
     const sk_sp<SkFontMgr>                      fFontMgr;
     const sk_sp<SkShapers::Factory>             fTextShapingFactory;
     const sk_sp<skresources::ResourceProvider>  fResourceProvider;
     const SkSVGIDMapper                         fIDMapper;
+    const size_t                                fNodeBytes;
     SkSize                                      fContainerSize;
+
+    // Recorded renders, most recently used last.
+    struct CachedPicture {
+        SkSize           fContainerSize;
+        sk_sp<SkPicture> fPicture;
+    };
+    const bool                                  fPictureCaching;
+    mutable SkMutex                             fPictureCacheMutex;
+    mutable std::vector<CachedPicture>          fPictureCache SK_GUARDED_BY(fPictureCacheMutex);
+    // The tree mutation count the cached pictures were recorded at.
+    mutable uint64_t                            fPictureCacheMutationCount
+            SK_GUARDED_BY(fPictureCacheMutex) = 0;
 };
 
 #endif // SkSVGDOM_DEFINED
@@ -78,31 +78,37 @@ private:                                                                     \
                                                                              \
 public:                                                                      \
     const SkSVGProperty<attr_type, attr_inherited>& get##attr_name() const { \
-        return fPresentationAttributes.f##attr_name;                         \
+        return this->presentationAttributes().f##attr_name;                  \
     }                                                                        \
     void set##attr_name(const SkSVGProperty<attr_type, attr_inherited>& v) { \
-        auto* dest = &fPresentationAttributes.f##attr_name;                  \
+        auto* dest = &this->writablePresentationAttributes().f##attr_name;   \
         if (!dest->isInheritable() || v.isValue()) {                         \
             /* TODO: If dest is not inheritable, handle v == "inherit" */    \
             *dest = v;                                                       \
         } else {                                                             \
             dest->set(SkSVGPropertyState::kInherit);                         \
         }                                                                    \
+        this->notifyMutation();                                              \
     }                                                                        \
     void set##attr_name(SkSVGProperty<attr_type, attr_inherited>&& v) {      \
-        auto* dest = &fPresentationAttributes.f##attr_name;                  \
+        auto* dest = &this->writablePresentationAttributes().f##attr_name;   \
         if (!dest->isInheritable() || v.isValue()) {                         \
             /* TODO: If dest is not inheritable, handle v == "inherit" */    \
             *dest = std::move(v);                                            \
         } else {                                                             \
             dest->set(SkSVGPropertyState::kInherit);                         \
         }                                                                    \
+        this->notifyMutation();                                              \
     }
 
 class SK_API SkSVGNode : public SkRefCnt {
 public:
     ~SkSVGNode() override;
 
+    // Accounts for the nodes built by SkSVGDOM::Builder.
+    static void* operator new(size_t);
+    static void operator delete(void*);
+
     SkSVGTag tag() const { return fTag; }
 
     virtual void appendChild(sk_sp<SkSVGNode>) = 0;
@@ -158,6 +164,10 @@ protected:
 
     static SkMatrix ComputeViewboxMatrix(const SkRect&, const SkRect&, SkSVGPreserveAspectRatio);
 
+    // Must be called whenever a node attribute or child list changes, to invalidate the
+    // renders cached by SkSVGDOM.
+    void notifyMutation() { fMutationCount++; }
+
     // Called before onRender(), to apply local attributes to the context.  Unlike onRender(),
     // onPrepareToRender() bubbles up the inheritance chain: overriders should always call
     // INHERITED::onPrepareToRender(), unless they intend to short-circuit rendering
@@ -180,11 +190,31 @@ protected:
         return SkRect::MakeEmpty();
     }
 
+    // Returns the approximate size of the out-of-line storage owned by the node (e.g. paths
+    // or child lists), including its descendants'.  Overriders should add INHERITED's.
+    virtual size_t onApproximateBytesUsed() const { return 0; }
+
+    // Returns the sum of the descendants' mutation counts.  Overridden by nodes with children.
+    virtual uint64_t onDescendantMutationCount() const { return 0; }
+
 private:
-    SkSVGTag                    fTag;
+    friend class SkSVGNodePriv;
+
+    static const SkSVGPresentationAttributes& DefaultPresentationAttributes();
 
-    // FIXME: this should be sparse
-    SkSVGPresentationAttributes fPresentationAttributes;
+    const SkSVGPresentationAttributes& presentationAttributes() const {
+        return fPresentationAttributes ? *fPresentationAttributes
+                                       : DefaultPresentationAttributes();
+    }
+    SkSVGPresentationAttributes& writablePresentationAttributes();
+
+    SkSVGTag                     fTag;
+
+    // Number of notifyMutation() calls.
+    uint32_t                     fMutationCount = 0;
+
+    // Most nodes don't set any presentation attributes: only allocated when needed.
+    SkSVGPresentationAttributes* fPresentationAttributes = nullptr;
 
     using INHERITED = SkRefCnt;
 };
@@ -204,8 +234,14 @@ private:
             return pr.isValid();                                              \
         }                                                                     \
     public:                                                                   \
-        void set##attr_name(const attr_type& a) { set_cp(a); }                \
-        void set##attr_name(attr_type&& a) { set_mv(std::move(a)); }
+        void set##attr_name(const attr_type& a) {                             \
+            set_cp(a);                                                        \
+            this->notifyMutation();                                           \
+        }                                                                     \
+        void set##attr_name(attr_type&& a) {                                  \
+            set_mv(std::move(a));                                             \
+            this->notifyMutation();                                           \
+        }
 
 #define SVG_ATTR(attr_name, attr_type, attr_default)                        \
     private:                                                                \
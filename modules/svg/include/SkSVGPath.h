@@ -27,6 +27,8 @@ protected:
 
     SkRect onObjectBoundingBox(const SkSVGRenderContext&) const override;
 
+    size_t onApproximateBytesUsed() const override;
+
 private:
     SkSVGPath();
 
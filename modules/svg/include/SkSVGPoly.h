@@ -34,6 +34,8 @@ protected:
 
     SkRect onObjectBoundingBox(const SkSVGRenderContext&) const override;
 
+    size_t onApproximateBytesUsed() const override;
+
 private:
     SkSVGPoly(SkSVGTag);
 
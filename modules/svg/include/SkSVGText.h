@@ -54,6 +54,10 @@ protected:
 
     bool parseAndSetAttribute(const char*, const char*) override;
 
+    size_t onApproximateBytesUsed() const override;
+
+    uint64_t onDescendantMutationCount() const override;
+
 private:
     std::vector<sk_sp<SkSVGTextFragment>> fChildren;
 
@@ -100,6 +104,8 @@ private:
 
     void appendChild(sk_sp<SkSVGNode>) override {}
 
+    size_t onApproximateBytesUsed() const override;
+
     using INHERITED = SkSVGTextFragment;
 };
 
@@ -13,7 +13,10 @@
 
 class SK_API SkSVGTransformableNode : public SkSVGNode {
 public:
-    void setTransform(const SkSVGTransformType& t) { fTransform = t; }
+    void setTransform(const SkSVGTransformType& t) {
+        fTransform = t;
+        this->notifyMutation();
+    }
 
 protected:
     SkSVGTransformableNode(SkSVGTag);
@@ -9,18 +9,39 @@
 
 #include "include/core/SkPath.h"
 #include "include/pathops/SkPathOps.h"
+#include "modules/svg/src/SkSVGNodePriv.h"
 
 SkSVGContainer::SkSVGContainer(SkSVGTag t) : INHERITED(t) { }
 
 void SkSVGContainer::appendChild(sk_sp<SkSVGNode> node) {
     SkASSERT(node);
     fChildren.push_back(std::move(node));
+    this->notifyMutation();
 }
 
 bool SkSVGContainer::hasChildren() const {
     return !fChildren.empty();
 }
 
+size_t SkSVGContainer::onApproximateBytesUsed() const {
+    size_t bytes = INHERITED::onApproximateBytesUsed()
+                 + fChildren.capacity() * sizeof(sk_sp<SkSVGNode>);
+    for (const auto& child : fChildren) {
+        bytes += SkSVGNodePriv::ApproximateBytesUsed(child.get());
+    }
+
+    return bytes;
+}
+
+uint64_t SkSVGContainer::onDescendantMutationCount() const {
+    uint64_t count = 0;
+    for (const auto& child : fChildren) {
+        count += SkSVGNodePriv::MutationCount(child.get());
+    }
+
+    return count;
+}
+
 void SkSVGContainer::onRender(const SkSVGRenderContext& ctx) const {
     for (int i = 0; i < fChildren.size(); ++i) {
         fChildren[i]->render(ctx);
@@ -7,8 +7,13 @@
 
 #include "modules/svg/include/SkSVGDOM.h"
 
+#include "include/core/SkBBHFactory.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
 #include "include/core/SkFontMgr.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkTo.h"
 #include "modules/skshaper/include/SkShaper_factory.h"
@@ -50,10 +55,16 @@
 #include "modules/svg/include/SkSVGTypes.h"
 #include "modules/svg/include/SkSVGUse.h"
 #include "modules/svg/include/SkSVGValue.h"
+#include "modules/svg/src/SkSVGNodePriv.h"
+#include "modules/svg/src/SkSVGXMLTokenizer.h"
 #include "src/base/SkTSearch.h"
+#include "src/core/SkRectPriv.h"
+#include "src/core/SkStreamPriv.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/xml/SkDOM.h"
 
+#include <vector>
+
 namespace {
 
 bool SetIRIAttribute(const sk_sp<SkSVGNode>& node, SkSVGAttribute attr,
@@ -323,6 +334,27 @@ bool set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const
     return true;
 }
 
+sk_sp<SkSVGNode> make_node(const SkSVGNode* parent, const char* elem) {
+    if (strcmp(elem, "svg") == 0) {
+        // Outermost SVG element must be tagged as such.
+        return SkSVGSVG::Make(parent ? SkSVGSVG::Type::kInner
+                                     : SkSVGSVG::Type::kRoot);
+    }
+
+    const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
+                                     SkTo<int>(std::size(gTagFactories)),
+                                     elem, sizeof(gTagFactories[0]));
+    if (tagIndex < 0) {
+#if defined(SK_VERBOSE_SVG_PARSING)
+        SkDebugf("unhandled element: <%s>\n", elem);
+#endif
+        return nullptr;
+    }
+    SkASSERT(SkTo<size_t>(tagIndex) < std::size(gTagFactories));
+
+    return gTagFactories[tagIndex].fValue();
+}
+
 void parse_node_attributes(const SkDOM& xmlDom, const SkDOM::Node* xmlNode,
                            const sk_sp<SkSVGNode>& svgNode, SkSVGIDMapper* mapper) {
     const char* name, *value;
@@ -354,28 +386,7 @@ sk_sp<SkSVGNode> construct_svg_node(const SkDOM& dom, const ConstructionContext&
 
     SkASSERT(elemType == SkDOM::kElement_Type);
 
-    auto make_node = [](const ConstructionContext& ctx, const char* elem) -> sk_sp<SkSVGNode> {
-        if (strcmp(elem, "svg") == 0) {
-            // Outermost SVG element must be tagged as such.
-            return SkSVGSVG::Make(ctx.fParent ? SkSVGSVG::Type::kInner
-                                              : SkSVGSVG::Type::kRoot);
-        }
-
-        const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
-                                         SkTo<int>(std::size(gTagFactories)),
-                                         elem, sizeof(gTagFactories[0]));
-        if (tagIndex < 0) {
-#if defined(SK_VERBOSE_SVG_PARSING)
-            SkDebugf("unhandled element: <%s>\n", elem);
-#endif
-            return nullptr;
-        }
-        SkASSERT(SkTo<size_t>(tagIndex) < std::size(gTagFactories));
-
-        return gTagFactories[tagIndex].fValue();
-    };
-
-    auto node = make_node(ctx, elem);
+    auto node = make_node(ctx.fParent, elem);
     if (!node) {
         return nullptr;
     }
@@ -394,6 +405,90 @@ sk_sp<SkSVGNode> construct_svg_node(const SkDOM& dom, const ConstructionContext&
     return node;
 }
 
+sk_sp<SkSVGNode> construct_from_xml_dom(SkStream& stream, SkSVGIDMapper* mapper) {
+    SkDOM xmlDom;
+    if (!xmlDom.build(stream)) {
+        return nullptr;
+    }
+
+    ConstructionContext ctx(mapper);
+    return construct_svg_node(xmlDom, ctx, xmlDom.getRootNode());
+}
+
+// Same as construct_from_xml_dom, but building the tree straight from the XML tokens: there is
+// no intermediate XML DOM, and attributes are parsed into node properties as they are tokenized.
+sk_sp<SkSVGNode> construct_from_tokens(SkSVGXMLTokenizer* tokenizer, SkSVGIDMapper* mapper) {
+    sk_sp<SkSVGNode> root;
+
+    // The elements under construction, innermost last.
+    std::vector<sk_sp<SkSVGNode>> stack;
+    // Nesting depth within an unhandled element, which is skipped along with its descendants.
+    size_t skipDepth = 0;
+
+    for (;;) {
+        switch (tokenizer->next()) {
+            case SkSVGXMLTokenizer::Token::kStartElement: {
+                if (skipDepth) {
+                    skipDepth++;
+                    break;
+                }
+
+                auto node = make_node(stack.empty() ? nullptr : stack.back().get(),
+                                      tokenizer->name());
+                if (!node) {
+                    if (stack.empty()) {
+                        return nullptr;
+                    }
+                    skipDepth = 1;
+                    break;
+                }
+                stack.push_back(std::move(node));
+            } break;
+            case SkSVGXMLTokenizer::Token::kAttribute: {
+                if (skipDepth) {
+                    break;
+                }
+
+                // We're handling id attributes out of band for now.
+                if (!strcmp(tokenizer->name(), "id")) {
+                    mapper->set(SkString(tokenizer->value(), tokenizer->valueSize()),
+                                stack.back());
+                    break;
+                }
+                set_string_attribute(stack.back(), tokenizer->name(), tokenizer->value());
+            } break;
+            case SkSVGXMLTokenizer::Token::kEndElement: {
+                if (skipDepth) {
+                    skipDepth--;
+                    break;
+                }
+
+                auto node = std::move(stack.back());
+                stack.pop_back();
+                if (stack.empty()) {
+                    root = std::move(node);
+                } else {
+                    stack.back()->appendChild(std::move(node));
+                }
+            } break;
+            case SkSVGXMLTokenizer::Token::kText: {
+                if (skipDepth) {
+                    break;
+                }
+
+                // Text literals require special handling.
+                auto txt = SkSVGTextLiteral::Make();
+                txt->setText(SkString(tokenizer->value(), tokenizer->valueSize()));
+                stack.back()->appendChild(std::move(txt));
+            } break;
+            case SkSVGXMLTokenizer::Token::kEndDocument:
+                return root;
+            case SkSVGXMLTokenizer::Token::kError:
+                return nullptr;
+        }
+    }
+}
+
 } // anonymous namespace
 
 SkSVGDOM::Builder& SkSVGDOM::Builder::setFontManager(sk_sp<SkFontMgr> fmgr) {
@@ -411,17 +506,56 @@ SkSVGDOM::Builder& SkSVGDOM::Builder::setTextShapingFactory(sk_sp<SkShapers::Fac
     return *this;
 }
 
+SkSVGDOM::Builder& SkSVGDOM::Builder::setUseXMLDOMParser(bool use) {
+    fUseXMLDOMParser = use;
+    return *this;
+}
+
+SkSVGDOM::Builder& SkSVGDOM::Builder::setPictureCaching(bool enabled) {
+    fPictureCaching = enabled;
+    return *this;
+}
+
 sk_sp<SkSVGDOM> SkSVGDOM::Builder::make(SkStream& str) const {
     TRACE_EVENT0("skia", TRACE_FUNC);
-    SkDOM xmlDom;
-    if (!xmlDom.build(str)) {
-        return nullptr;
-    }
-
     SkSVGIDMapper mapper;
-    ConstructionContext ctx(&mapper);
+    sk_sp<SkSVGNode> root;
+
+    // Only the nodes of the last construction attempt are kept.
+    size_t nodeBytes;
+    const auto construct = [&](auto&& constructor) {
+        mapper.reset();
+        nodeBytes = 0;
+        SkSVGNodePriv::AutoCountNodeBytes countNodeBytes(&nodeBytes);
+        return constructor();
+    };
+
+    if (fUseXMLDOMParser) {
+        root = construct([&] { return construct_from_xml_dom(str, &mapper); });
+    } else {
+        // Memory streams are tokenized in place.
+        sk_sp<SkData> data;
+        const char* base;
+        size_t size;
+        if (str.getMemoryBase() && str.hasLength()) {
+            base = static_cast<const char*>(str.getMemoryBase()) + str.getPosition();
+            size = str.getLength() - str.getPosition();
+        } else {
+            data = SkCopyStreamToData(&str);
+            base = static_cast<const char*>(data->data());
+            size = data->size();
+        }
+
+        SkSVGXMLTokenizer tokenizer(base, size);
+        root = construct([&] { return construct_from_tokens(&tokenizer, &mapper); });
+
+        if (!root) {
+            // The document may use XML features the tokenizer doesn't support.
+            SkMemoryStream stream(base, size, /*copyData=*/false);
+            root = construct([&] { return construct_from_xml_dom(stream, &mapper); });
+        }
+    }
 
-    auto root = construct_svg_node(xmlDom, ctx, xmlDom.getRootNode());
     if (!root || root->tag() != SkSVGTag::kSvg) {
         return nullptr;
     }
@@ -439,26 +573,84 @@ sk_sp<SkSVGDOM> SkSVGDOM::Builder::make(SkStream& str) const {
                                         std::move(fFontMgr),
                                         std::move(resource_provider),
                                         std::move(mapper),
-                                        std::move(factory)));
+                                        std::move(factory),
+                                        nodeBytes,
+                                        fPictureCaching));
 }
 
 SkSVGDOM::SkSVGDOM(sk_sp<SkSVGSVG> root,
                    sk_sp<SkFontMgr> fmgr,
                    sk_sp<skresources::ResourceProvider> rp,
                    SkSVGIDMapper&& mapper,
-                   sk_sp<SkShapers::Factory> fact)
+                   sk_sp<SkShapers::Factory> fact,
+                   size_t nodeBytes,
+                   bool pictureCaching)
         : fRoot(std::move(root))
         , fFontMgr(std::move(fmgr))
         , fTextShapingFactory(std::move(fact))
         , fResourceProvider(std::move(rp))
         , fIDMapper(std::move(mapper))
-        , fContainerSize(fRoot->intrinsicSize(SkSVGLengthContext(SkSize::Make(0, 0)))) {
+        , fNodeBytes(nodeBytes)
+        , fContainerSize(fRoot->intrinsicSize(SkSVGLengthContext(SkSize::Make(0, 0))))
+        , fPictureCaching(pictureCaching) {
     SkASSERT(fResourceProvider);
     SkASSERT(fTextShapingFactory);
 }
 
+SkSVGDOM::~SkSVGDOM() = default;
+
 void SkSVGDOM::render(SkCanvas* canvas) const {
     TRACE_EVENT0("skia", TRACE_FUNC);
+    if (fRoot && fPictureCaching) {
+        canvas->drawPicture(this->cachedPicture());
+        return;
+    }
+
+    this->renderUncached(canvas);
+}
+
+sk_sp<SkPicture> SkSVGDOM::cachedPicture() const {
+    SkASSERT(fRoot);
+
+    // Concurrent renders record the picture once, and share it.
+    SkAutoMutexExclusive lock(fPictureCacheMutex);
+
+    const auto mutationCount = SkSVGNodePriv::MutationCount(fRoot.get());
+    if (mutationCount != fPictureCacheMutationCount) {
+        fPictureCache.clear();
+        fPictureCacheMutationCount = mutationCount;
+    }
+
+    // The container size only affects roots sized relative to it.
+    const auto sizedByContainer =
+            fRoot->getWidth().unit()  == SkSVGLength::Unit::kPercentage ||
+            fRoot->getHeight().unit() == SkSVGLength::Unit::kPercentage;
+    const auto key = sizedByContainer ? fContainerSize : SkSize::MakeEmpty();
+
+    for (auto it = fPictureCache.begin(); it != fPictureCache.end(); ++it) {
+        if (it->fContainerSize == key) {
+            auto entry = std::move(*it);
+            fPictureCache.erase(it);
+            fPictureCache.push_back(std::move(entry));
+            return fPictureCache.back().fPicture;
+        }
+    }
+
+    // Content is not clipped to the viewport, so record everything.
+    SkRTreeFactory bbhFactory;
+    SkPictureRecorder recorder;
+    this->renderUncached(recorder.beginRecording(SkRectPriv::MakeLargeS32(), &bbhFactory));
+
+    static constexpr size_t kMaxCachedPictures = 4;
+    if (fPictureCache.size() == kMaxCachedPictures) {
+        fPictureCache.erase(fPictureCache.begin());
+    }
+    fPictureCache.push_back({key, recorder.finishRecordingAsPicture()});
+
+    return fPictureCache.back().fPicture;
+}
+
+void SkSVGDOM::renderUncached(SkCanvas* canvas) const {
     if (fRoot) {
         SkSVGLengthContext       lctx(fContainerSize);
         SkSVGPresentationContext pctx;
@@ -490,12 +682,27 @@ void SkSVGDOM::renderNode(SkCanvas* canvas, SkSVGPresentationContext& pctx, cons
     }
 }
 
+size_t SkSVGDOM::approximateBytesUsed() const {
+    size_t bytes = sizeof(*this) + fNodeBytes + fIDMapper.approxBytesUsed();
+
+    fIDMapper.foreach([&](const SkString& id, const sk_sp<SkSVGNode>&) { bytes += id.size(); });
+    if (fRoot) {
+        bytes += SkSVGNodePriv::ApproximateBytesUsed(fRoot.get());
+    }
+    SkAutoMutexExclusive lock(fPictureCacheMutex);
+    for (const auto& cached : fPictureCache) {
+        bytes += cached.fPicture->approximateBytesUsed();
+    }
+
+    return bytes;
+}
+
 const SkSize& SkSVGDOM::containerSize() const {
     return fContainerSize;
 }
 
 void SkSVGDOM::setContainerSize(const SkSize& containerSize) {
-    // TODO: inval
+    // Cached pictures are keyed by container size: no need to invalidate.
     fContainerSize = containerSize;
 }
 
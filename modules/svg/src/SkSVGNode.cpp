@@ -8,22 +8,73 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkMatrix.h"
 #include "include/pathops/SkPathOps.h"
+#include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTPin.h"
 #include "modules/svg/include/SkSVGNode.h"
 #include "modules/svg/include/SkSVGRenderContext.h"
 #include "modules/svg/include/SkSVGValue.h"
+#include "modules/svg/src/SkSVGNodePriv.h"
+#include "src/base/SkNoDestructor.h"
 #include "src/base/SkTLazy.h"
 
-SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t) {
-    // Uninherited presentation attributes need a non-null default value.
-    fPresentationAttributes.fStopColor.set(SkSVGColor(SK_ColorBLACK));
-    fPresentationAttributes.fStopOpacity.set(SkSVGNumberType(1.0f));
-    fPresentationAttributes.fFloodColor.set(SkSVGColor(SK_ColorBLACK));
-    fPresentationAttributes.fFloodOpacity.set(SkSVGNumberType(1.0f));
-    fPresentationAttributes.fLightingColor.set(SkSVGColor(SK_ColorWHITE));
+
+namespace {
+
+thread_local size_t* gNodeBytes = nullptr;
+
+} // namespace
+
+SkSVGNodePriv::AutoCountNodeBytes::AutoCountNodeBytes(size_t* bytes)
+        : fPrevBytes(gNodeBytes) {
+    gNodeBytes = bytes;
+}
+
+SkSVGNodePriv::AutoCountNodeBytes::~AutoCountNodeBytes() {
+    gNodeBytes = fPrevBytes;
+}
+
+void* SkSVGNode::operator new(size_t size) {
+    if (gNodeBytes) {
+        *gNodeBytes += size;
+    }
+
+    return sk_malloc_throw(size);
+}
+
+void SkSVGNode::operator delete(void* ptr) {
+    sk_free(ptr);
 }
 
-SkSVGNode::~SkSVGNode() { }
+SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t) { }
+
+SkSVGNode::~SkSVGNode() {
+    delete fPresentationAttributes;
+}
+
+const SkSVGPresentationAttributes& SkSVGNode::DefaultPresentationAttributes() {
+    static const SkNoDestructor<SkSVGPresentationAttributes> gDefaults([] {
+        SkSVGPresentationAttributes attrs;
+
+        // Uninherited presentation attributes need a non-null default value.
+        attrs.fStopColor.set(SkSVGColor(SK_ColorBLACK));
+        attrs.fStopOpacity.set(SkSVGNumberType(1.0f));
+        attrs.fFloodColor.set(SkSVGColor(SK_ColorBLACK));
+        attrs.fFloodOpacity.set(SkSVGNumberType(1.0f));
+        attrs.fLightingColor.set(SkSVGColor(SK_ColorWHITE));
+
+        return attrs;
+    }());
+
+    return *gDefaults;
+}
+
+SkSVGPresentationAttributes& SkSVGNode::writablePresentationAttributes() {
+    if (!fPresentationAttributes) {
+        fPresentationAttributes = new SkSVGPresentationAttributes(DefaultPresentationAttributes());
+    }
+
+    return *fPresentationAttributes;
+}
 
 void SkSVGNode::render(const SkSVGRenderContext& ctx) const {
     SkSVGRenderContext localContext(ctx, this);
@@ -60,20 +111,21 @@ SkRect SkSVGNode::objectBoundingBox(const SkSVGRenderContext& ctx) const {
 }
 
 bool SkSVGNode::onPrepareToRender(SkSVGRenderContext* ctx) const {
-    ctx->applyPresentationAttributes(fPresentationAttributes,
+    ctx->applyPresentationAttributes(this->presentationAttributes(),
                                      this->hasChildren() ? 0 : SkSVGRenderContext::kLeaf);
 
     // visibility:hidden and display:none disable rendering.
     // TODO: if display is not a value (true when display="inherit"), we currently
     //   ignore it. Eventually we should be able to add SkASSERT(display.isValue()).
     const auto visibility = ctx->presentationContext().fInherited.fVisibility->type();
-    const auto display = fPresentationAttributes.fDisplay;  // display is uninherited
+    const auto& display = this->presentationAttributes().fDisplay;  // display is uninherited
     return visibility != SkSVGVisibility::Type::kHidden &&
            (!display.isValue() || *display != SkSVGDisplay::kNone);
 }
 
 void SkSVGNode::setAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
     this->onSetAttribute(attr, v);
+    this->notifyMutation();
 }
 
 template <typename T>
@@ -88,10 +140,10 @@ void SetInheritedByDefault(SkTLazy<T>& presentation_attribute, const T& value) {
 }
 
 bool SkSVGNode::parseAndSetAttribute(const char* n, const char* v) {
-#define PARSE_AND_SET(svgName, attrName)                                                        \
-    this->set##attrName(                                                                        \
-            SkSVGAttributeParser::parseProperty<decltype(fPresentationAttributes.f##attrName)>( \
-                    svgName, n, v))
+#define PARSE_AND_SET(svgName, attrName)                                                   \
+    this->set##attrName(                                                                   \
+            SkSVGAttributeParser::parseProperty<                                           \
+                    decltype(SkSVGPresentationAttributes::f##attrName)>(svgName, n, v))
 
     return PARSE_AND_SET(   "clip-path"                  , ClipPath)
            || PARSE_AND_SET("clip-rule"                  , ClipRule)
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSVGNodePriv_DEFINED
+#define SkSVGNodePriv_DEFINED
+
+#include "modules/svg/include/SkSVGAttribute.h"
+#include "modules/svg/include/SkSVGNode.h"
+
+#include <cstddef>
+#include <cstdint>
+
+class SkSVGNodePriv {
+public:
+    // Adds the size of the nodes allocated on the current thread to the given count.
+    class AutoCountNodeBytes {
+    public:
+        explicit AutoCountNodeBytes(size_t* bytes);
+        ~AutoCountNodeBytes();
+
+    private:
+        size_t* fPrevBytes;
+    };
+
+    // Out-of-line storage owned by the node and its descendants (presentation attributes,
+    // child lists, paths, text...).
+    static size_t ApproximateBytesUsed(const SkSVGNode* node) {
+        return (node->fPresentationAttributes ? sizeof(SkSVGPresentationAttributes) : 0)
+             + node->onApproximateBytesUsed();
+    }
+
+    // Number of mutations of the node and its descendants, for SkSVGDOM render caching.
+    //
+    // Nodes don't know their parent, so a tree's count is collected when rendering it.  Counts
+    // only grow, and appending a child counts as a mutation of its parent: any change to the
+    // tree increases its count.
+    static uint64_t MutationCount(const SkSVGNode* node) {
+        return node->fMutationCount + node->onDescendantMutationCount();
+    }
+};
+
+#endif // SkSVGNodePriv_DEFINED
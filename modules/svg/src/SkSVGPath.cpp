@@ -43,3 +43,7 @@ SkPath SkSVGPath::onAsPath(const SkSVGRenderContext& ctx) const {
 SkRect SkSVGPath::onObjectBoundingBox(const SkSVGRenderContext& ctx) const {
     return fPath.computeTightBounds();
 }
+
+size_t SkSVGPath::onApproximateBytesUsed() const {
+    return INHERITED::onApproximateBytesUsed() + fPath.approximateBytesUsed() - sizeof(SkPath);
+}
@@ -49,3 +49,9 @@ SkPath SkSVGPoly::onAsPath(const SkSVGRenderContext& ctx) const {
 SkRect SkSVGPoly::onObjectBoundingBox(const SkSVGRenderContext& ctx) const {
     return fPath.getBounds();
 }
+
+size_t SkSVGPoly::onApproximateBytesUsed() const {
+    return INHERITED::onApproximateBytesUsed()
+         + fPoints.capacity() * sizeof(SkPoint)
+         + fPath.approximateBytesUsed() - sizeof(SkPath);
+}
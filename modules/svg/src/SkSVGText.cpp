@@ -20,6 +20,7 @@
 #include "modules/skshaper/include/SkShaper.h"
 #include "modules/svg/include/SkSVGRenderContext.h"
 #include "modules/svg/include/SkSVGValue.h"
+#include "modules/svg/src/SkSVGNodePriv.h"
 #include "modules/svg/src/SkSVGTextPriv.h"
 #include "src/base/SkUTF.h"
 #include "src/core/SkTextBlobPriv.h"
@@ -552,12 +553,32 @@ void SkSVGTextContainer::appendChild(sk_sp<SkSVGNode> child) {
     case SkSVGTag::kTSpan:
         fChildren.push_back(
             sk_sp<SkSVGTextFragment>(static_cast<SkSVGTextFragment*>(child.release())));
+        this->notifyMutation();
         break;
     default:
         break;
     }
 }
 
+size_t SkSVGTextContainer::onApproximateBytesUsed() const {
+    size_t bytes = INHERITED::onApproximateBytesUsed()
+                 + fChildren.capacity() * sizeof(sk_sp<SkSVGTextFragment>);
+    for (const auto& child : fChildren) {
+        bytes += SkSVGNodePriv::ApproximateBytesUsed(child.get());
+    }
+
+    return bytes;
+}
+
+uint64_t SkSVGTextContainer::onDescendantMutationCount() const {
+    uint64_t count = 0;
+    for (const auto& child : fChildren) {
+        count += SkSVGNodePriv::MutationCount(child.get());
+    }
+
+    return count;
+}
+
 void SkSVGTextContainer::onShapeText(const SkSVGRenderContext& ctx, SkSVGTextContext* tctx,
                                      SkSVGXmlSpace) const {
     SkASSERT(tctx);
@@ -600,6 +621,10 @@ void SkSVGTextLiteral::onShapeText(const SkSVGRenderContext& ctx, SkSVGTextConte
     tctx->shapeFragment(this->getText(), ctx, xs);
 }
 
+size_t SkSVGTextLiteral::onApproximateBytesUsed() const {
+    return INHERITED::onApproximateBytesUsed() + fText.size();
+}
+
 void SkSVGText::onRender(const SkSVGRenderContext& ctx) const {
     const SkSVGTextContext::ShapedTextCallback render_text = [](const SkSVGRenderContext& ctx,
                                                                 const sk_sp<SkTextBlob>& blob,
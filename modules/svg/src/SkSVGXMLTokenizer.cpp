@@ -0,0 +1,509 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "modules/svg/src/SkSVGXMLTokenizer.h"
+
+#include "include/core/SkTypes.h"
+#include "src/base/SkUTF.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Non-ASCII UTF-8 bytes are accepted as name characters: we're not validating names.
+bool is_name_start(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':' ||
+           static_cast<unsigned char>(c) >= 0x80;
+}
+
+bool is_name_char(char c) {
+    return is_name_start(c) || (c >= '0' && c <= '9') || c == '-' || c == '.';
+}
+
+bool starts_with(const char* p, const char* end, std::string_view s) {
+    return static_cast<size_t>(end - p) >= s.size() && !memcmp(p, s.data(), s.size());
+}
+
+const char* find(const char* p, const char* end, std::string_view s) {
+    while ((p = static_cast<const char*>(memchr(p, s[0], end - p)))) {
+        if (starts_with(p, end, s)) {
+            return p;
+        }
+        ++p;
+    }
+    return nullptr;
+}
+
+// Appends [p, end) to dst, normalizing line breaks (\r\n and \r) to \n.
+void append_normalized(const char* p, const char* end, std::vector<char>* dst) {
+    while (p < end) {
+        const auto* cr = static_cast<const char*>(memchr(p, '\r', end - p));
+        if (!cr) {
+            dst->insert(dst->end(), p, end);
+            break;
+        }
+        dst->insert(dst->end(), p, cr);
+        dst->push_back('\n');
+        p = cr + 1;
+        if (p < end && *p == '\n') {
+            ++p;
+        }
+    }
+}
+
+bool is_xml_char(SkUnichar c) {
+    return c == 0x09 || c == 0x0A || c == 0x0D ||
+           (c >= 0x20    && c <= 0xD7FF) ||
+           (c >= 0xE000  && c <= 0xFFFD) ||
+           (c >= 0x10000 && c <= 0x10FFFF);
+}
+
+bool equals_lowercase(std::string_view s, std::string_view lowercase) {
+    if (s.size() != lowercase.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < s.size(); ++i) {
+        const char c = s[i] >= 'A' && s[i] <= 'Z' ? s[i] - 'A' + 'a' : s[i];
+        if (c != lowercase[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks the encoding declared by an XML declaration (the text between "<?xml" and "?>").
+bool is_supported_encoding(std::string_view decl) {
+    const auto pos = decl.find("encoding");
+    if (pos == std::string_view::npos) {
+        return true;  // UTF-8 is the default.
+    }
+
+    decl.remove_prefix(pos + strlen("encoding"));
+    while (!decl.empty() && (is_space(decl.front()) || decl.front() == '=')) {
+        decl.remove_prefix(1);
+    }
+    if (decl.empty() || (decl.front() != '"' && decl.front() != '\'')) {
+        return false;
+    }
+
+    const auto end = decl.find(decl.front(), 1);
+    if (end == std::string_view::npos) {
+        return false;
+    }
+
+    const auto encoding = decl.substr(1, end - 1);
+    return equals_lowercase(encoding, "utf-8") || equals_lowercase(encoding, "us-ascii");
+}
+
+} // namespace
+
+SkSVGXMLTokenizer::SkSVGXMLTokenizer(const char* data, size_t size)
+    : fPos(data)
+    , fEnd(data + size) {
+    // Skip the UTF-8 BOM, if any.
+    if (starts_with(fPos, fEnd, "\xEF\xBB\xBF")) {
+        fPos += 3;
+    }
+}
+
+SkSVGXMLTokenizer::Token SkSVGXMLTokenizer::next() {
+    switch (fState) {
+        case State::kProlog:
+        case State::kEpilog:  return this->scanMisc();
+        case State::kTag:     return this->scanTag();
+        case State::kContent: return this->scanContent();
+        case State::kDone:    return Token::kEndDocument;
+        case State::kError:   return Token::kError;
+    }
+    SkUNREACHABLE;
+}
+
+SkSVGXMLTokenizer::Token SkSVGXMLTokenizer::error() {
+    fState = State::kError;
+    return Token::kError;
+}
+
+// Comments, processing instructions and (in the prolog) the document type declaration,
+// up to the root element or the end of the document.
+SkSVGXMLTokenizer::Token SkSVGXMLTokenizer::scanMisc() {
+    for (;;) {
+        while (fPos < fEnd && is_space(*fPos)) {
+            ++fPos;
+        }
+
+        if (fPos == fEnd) {
+            if (fState != State::kEpilog) {
+                return this->error();
+            }
+            fState = State::kDone;
+            return Token::kEndDocument;
+        }
+
+        if (*fPos != '<') {
+            return this->error();
+        }
+
+        bool ok;
+        if (starts_with(fPos, fEnd, "<?")) {
+            ok = this->skipPI();
+        } else if (starts_with(fPos, fEnd, "<!--")) {
+            ok = this->skipComment();
+        } else if (fState == State::kProlog && starts_with(fPos, fEnd, "<!DOCTYPE")) {
+            ok = this->skipDoctype();
+        } else if (fState == State::kProlog && fPos + 1 < fEnd && is_name_start(fPos[1])) {
+            return this->scanStartElement();
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            return this->error();
+        }
+    }
+}
+
+// Character data, up to the next element tag.  Comments, CDATA sections and processing
+// instructions don't break text runs.
+SkSVGXMLTokenizer::Token SkSVGXMLTokenizer::scanContent() {
+    fValue.clear();
+
+    for (;;) {
+        const auto* run = fPos;
+        while (fPos < fEnd && *fPos != '<' && *fPos != '&' && *fPos != '\r') {
+            ++fPos;
+        }
+        fValue.insert(fValue.end(), run, fPos);
+
+        if (fPos == fEnd) {
+            // Unterminated root element.
+            return this->error();
+        }
+
+        if (*fPos == '\r') {
+            fValue.push_back('\n');
+            fPos += starts_with(fPos, fEnd, "\r\n") ? 2 : 1;
+            continue;
+        }
+
+        bool ok;
+        if (*fPos == '&') {
+            ok = this->scanReference(&fValue);
+        } else if (starts_with(fPos, fEnd, "<!--")) {
+            ok = this->skipComment();
+        } else if (starts_with(fPos, fEnd, "<![CDATA[")) {
+            ok = this->scanCDATA();
+        } else if (starts_with(fPos, fEnd, "<?")) {
+            ok = this->skipPI();
+        } else if (!fValue.empty()) {
+            // Element tag: flush the pending text first.
+            return this->emitText();
+        } else if (fPos + 1 < fEnd && fPos[1] == '/') {
+            return this->scanEndElement();
+        } else if (fPos + 1 < fEnd && is_name_start(fPos[1])) {
+            return this->scanStartElement();
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            return this->error();
+        }
+    }
+}
+
+SkSVGXMLTokenizer::Token SkSVGXMLTokenizer::emitText() {
+    fValue.push_back('\0');
+    return Token::kText;
+}
+
+SkSVGXMLTokenizer::Token SkSVGXMLTokenizer::scanStartElement() {
+    SkASSERT(*fPos == '<');
+    ++fPos;
+
+    const auto* name = fPos;
+    if (!this->scanName(&fName)) {
+        return this->error();
+    }
+
+    fOpenElements.emplace_back(name, fPos - name);
+    fState = State::kTag;
+
+    return Token::kStartElement;
+}
+
+SkSVGXMLTokenizer::Token SkSVGXMLTokenizer::scanEndElement() {
+    SkASSERT(starts_with(fPos, fEnd, "</"));
+    fPos += 2;
+
+    const auto* name = fPos;
+    if (!this->scanName(&fName) ||
+        std::string_view(name, fPos - name) != fOpenElements.back()) {
+        return this->error();
+    }
+
+    while (fPos < fEnd && is_space(*fPos)) {
+        ++fPos;
+    }
+    if (fPos == fEnd || *fPos != '>') {
+        return this->error();
+    }
+    ++fPos;
+
+    fOpenElements.pop_back();
+    fState = fOpenElements.empty() ? State::kEpilog : State::kContent;
+
+    return Token::kEndElement;
+}
+
+// Attributes, up to the end of the start tag.
+SkSVGXMLTokenizer::Token SkSVGXMLTokenizer::scanTag() {
+    const auto* tag_end = fPos;
+    while (fPos < fEnd && is_space(*fPos)) {
+        ++fPos;
+    }
+    const bool separated = fPos > tag_end;
+
+    if (fPos == fEnd) {
+        return this->error();
+    }
+
+    if (*fPos == '>') {
+        ++fPos;
+        fState = State::kContent;
+        return this->scanContent();
+    }
+
+    if (*fPos == '/') {
+        if (!starts_with(fPos, fEnd, "/>")) {
+            return this->error();
+        }
+        fPos += 2;
+
+        fOpenElements.pop_back();
+        fState = fOpenElements.empty() ? State::kEpilog : State::kContent;
+
+        return Token::kEndElement;
+    }
+
+    // Attributes must be separated from the element name and from each other.
+    if (!separated || !this->scanName(&fName)) {
+        return this->error();
+    }
+
+    while (fPos < fEnd && is_space(*fPos)) {
+        ++fPos;
+    }
+    if (fPos == fEnd || *fPos != '=') {
+        return this->error();
+    }
+    ++fPos;
+    while (fPos < fEnd && is_space(*fPos)) {
+        ++fPos;
+    }
+    if (fPos == fEnd || (*fPos != '"' && *fPos != '\'')) {
+        return this->error();
+    }
+    const char quote = *fPos++;
+
+    // Attribute values are normalized: references are decoded, and literal whitespace
+    // characters (\r\n counting as one) are replaced with spaces.
+    fValue.clear();
+    for (;;) {
+        const auto* run = fPos;
+        while (fPos < fEnd && *fPos != quote && *fPos != '&' && *fPos != '<' &&
+               *fPos != '\t' && *fPos != '\n' && *fPos != '\r') {
+            ++fPos;
+        }
+        fValue.insert(fValue.end(), run, fPos);
+
+        if (fPos == fEnd || *fPos == '<') {
+            return this->error();
+        }
+
+        if (*fPos == quote) {
+            ++fPos;
+            break;
+        }
+
+        if (*fPos == '&') {
+            if (!this->scanReference(&fValue)) {
+                return this->error();
+            }
+            continue;
+        }
+
+        if (starts_with(fPos, fEnd, "\r\n")) {
+            ++fPos;
+        }
+        ++fPos;
+        fValue.push_back(' ');
+    }
+    fValue.push_back('\0');
+
+    return Token::kAttribute;
+}
+
+bool SkSVGXMLTokenizer::scanName(std::vector<char>* dst) {
+    if (fPos == fEnd || !is_name_start(*fPos)) {
+        return false;
+    }
+
+    const auto* name = fPos;
+    while (fPos < fEnd && is_name_char(*fPos)) {
+        ++fPos;
+    }
+
+    dst->assign(name, fPos);
+    dst->push_back('\0');
+
+    return true;
+}
+
+// Character and predefined entity references.  Documents referencing other entities would need
+// a DTD, which we don't support.
+bool SkSVGXMLTokenizer::scanReference(std::vector<char>* dst) {
+    SkASSERT(*fPos == '&');
+
+    // The longest reference we support is &#x10FFFF; (with leading zeros, if any).
+    static constexpr size_t kMaxReferenceLength = 32;
+    const auto* ref = fPos + 1;
+    const auto* semicolon = static_cast<const char*>(
+            memchr(ref, ';', std::min<size_t>(fEnd - ref, kMaxReferenceLength)));
+    if (!semicolon || semicolon == ref) {
+        return false;
+    }
+    const std::string_view name(ref, semicolon - ref);
+    fPos = semicolon + 1;
+
+    if (name[0] != '#') {
+        static constexpr struct {
+            std::string_view fName;
+            char             fChar;
+        } gPredefinedEntities[] = {
+            { "amp" , '&'  },
+            { "apos", '\'' },
+            { "gt"  , '>'  },
+            { "lt"  , '<'  },
+            { "quot", '"'  },
+        };
+
+        for (const auto& entity : gPredefinedEntities) {
+            if (name == entity.fName) {
+                dst->push_back(entity.fChar);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const bool hex = name.size() > 1 && name[1] == 'x';
+    const auto digits = name.substr(hex ? 2 : 1);
+    if (digits.empty()) {
+        return false;
+    }
+
+    SkUnichar c = 0;
+    for (const char d : digits) {
+        int v;
+        if (d >= '0' && d <= '9') {
+            v = d - '0';
+        } else if (hex && d >= 'a' && d <= 'f') {
+            v = d - 'a' + 10;
+        } else if (hex && d >= 'A' && d <= 'F') {
+            v = d - 'A' + 10;
+        } else {
+            return false;
+        }
+        c = c * (hex ? 16 : 10) + v;
+        if (c > 0x10FFFF) {
+            return false;
+        }
+    }
+
+    if (!is_xml_char(c)) {
+        return false;
+    }
+
+    char utf8[SkUTF::kMaxBytesInUTF8Sequence];
+    const auto count = SkUTF::ToUTF8(c, utf8);
+    dst->insert(dst->end(), utf8, utf8 + count);
+
+    return true;
+}
+
+bool SkSVGXMLTokenizer::scanCDATA() {
+    SkASSERT(starts_with(fPos, fEnd, "<![CDATA["));
+    const auto* data = fPos + strlen("<![CDATA[");
+    const auto* end = find(data, fEnd, "]]>");
+    if (!end) {
+        return false;
+    }
+
+    append_normalized(data, end, &fValue);
+    fPos = end + 3;
+
+    return true;
+}
+
+bool SkSVGXMLTokenizer::skipComment() {
+    SkASSERT(starts_with(fPos, fEnd, "<!--"));
+    const auto* end = find(fPos + 4, fEnd, "-->");
+    if (!end) {
+        return false;
+    }
+
+    fPos = end + 3;
+    return true;
+}
+
+bool SkSVGXMLTokenizer::skipPI() {
+    SkASSERT(starts_with(fPos, fEnd, "<?"));
+    const auto* end = find(fPos + 2, fEnd, "?>");
+    if (!end) {
+        return false;
+    }
+
+    // The XML declaration may specify an encoding we don't support.
+    const std::string_view pi(fPos + 2, end - fPos - 2);
+    if (pi.size() > 3 && pi.substr(0, 3) == "xml" && is_space(pi[3]) &&
+        !is_supported_encoding(pi.substr(4))) {
+        return false;
+    }
+
+    fPos = end + 2;
+    return true;
+}
+
+bool SkSVGXMLTokenizer::skipDoctype() {
+    SkASSERT(starts_with(fPos, fEnd, "<!DOCTYPE"));
+    for (const auto* p = fPos + strlen("<!DOCTYPE"); p < fEnd; ++p) {
+        switch (*p) {
+            case '"':
+            case '\'':
+                p = static_cast<const char*>(memchr(p + 1, *p, fEnd - p - 1));
+                if (!p) {
+                    return false;
+                }
+                break;
+            case '[':
+                // Internal subsets can declare entities, which we don't support.
+                return false;
+            case '>':
+                fPos = p + 1;
+                return true;
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSVGXMLTokenizer_DEFINED
+#define SkSVGXMLTokenizer_DEFINED
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+// A minimal XML pull tokenizer, for building SVG DOMs without an intermediate XML DOM.
+//
+// The tokenizer scans the source buffer in place: element and attribute names, attribute values
+// and text runs are produced one at a time, as NUL-terminated strings in reusable scratch
+// buffers (with references decoded and line breaks normalized as expat would), so tokenizing a
+// document allocates next to nothing.
+//
+// It only handles UTF-8 documents without DTD internal subsets, and reports errors for anything
+// else: callers are expected to fall back to SkDOM (expat) for those.  It is also not a
+// validating parser, and accepts some malformed documents which expat would reject (e.g. with
+// duplicate attributes).
+class SkSVGXMLTokenizer {
+public:
+    SkSVGXMLTokenizer(const char* data, size_t size);
+
+    enum class Token {
+        kStartElement,  // name()
+        kAttribute,     // name(), value() -- for the last started element
+        kEndElement,    // also emitted for empty-element tags (<foo/>)
+        kText,          // value(), valueSize() -- character data, CDATA sections included
+        kEndDocument,
+        kError,         // malformed or unsupported document; sticky
+    };
+
+    Token next();
+
+    const char* name()      const { return fName.data(); }
+    const char* value()     const { return fValue.data(); }
+    size_t      valueSize() const { return fValue.size() - 1; }
+
+private:
+    enum class State {
+        kProlog,   // before the root element
+        kTag,      // in a start tag, between attributes
+        kContent,  // in the root element
+        kEpilog,   // after the root element
+        kDone,
+        kError,
+    };
+
+    Token error();
+
+    Token scanMisc();
+    Token scanContent();
+    Token scanTag();
+    Token scanStartElement();
+    Token scanEndElement();
+
+    bool skipComment();
+    bool skipPI();
+    bool skipDoctype();
+    bool scanCDATA();
+    bool scanReference(std::vector<char>*);
+    bool scanName(std::vector<char>*);
+
+    Token emitText();
+
+    const char*       fPos;
+    const char* const fEnd;
+    State             fState = State::kProlog;
+
+    // Names of the open elements, pointing into the source.
+    std::vector<std::string_view> fOpenElements;
+
+    std::vector<char> fName,
+                      fValue;
+};
+
+#endif // SkSVGXMLTokenizer_DEFINED
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <string>
+
+#include "include/core/SkStream.h"
+#include "modules/svg/include/SkSVGAttribute.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "modules/svg/include/SkSVGRect.h"
+#include "tests/Test.h"
+#include "tools/fonts/FontToolUtils.h"
+
+DEF_TEST(Svg_NodeStorage_SparsePresentationAttributes, r) {
+    static constexpr int kRectCount = 100;
+
+    std::string svg = R"(<svg width="100" height="100" xmlns="http://www.w3.org/2000/svg">)";
+    for (int i = 0; i < kRectCount; ++i) {
+        svg += "<rect id=\"r" + std::to_string(i) + "\" width=\"10\" height=\"10\"/>";
+    }
+    svg += "</svg>";
+
+    SkMemoryStream stream(svg.c_str(), svg.size());
+    auto dom = SkSVGDOM::Builder().setFontManager(ToolUtils::TestFontMgr()).make(stream);
+    REPORTER_ASSERT(r, dom);
+
+    // Storing presentation attributes in every node would take more than the whole document.
+    const auto bytes = dom->approximateBytesUsed();
+    REPORTER_ASSERT(r, bytes > 0);
+    REPORTER_ASSERT(r, bytes < kRectCount * sizeof(SkSVGPresentationAttributes),
+                    "%zu bytes", bytes);
+
+    // Presentation attributes are allocated (and accounted for) when first set.
+    auto* rect = dom->findNodeById("r0");
+    REPORTER_ASSERT(r, rect);
+    REPORTER_ASSERT(r, !(*rect)->getFill().isValue());
+    (*rect)->setAttribute("fill", "lime");
+    REPORTER_ASSERT(r, (*rect)->getFill().isValue());
+    REPORTER_ASSERT(r, dom->approximateBytesUsed() == bytes + sizeof(SkSVGPresentationAttributes));
+
+    (*rect)->setAttribute("stroke", "blue");
+    REPORTER_ASSERT(r, (*rect)->getStroke().isValue());
+    REPORTER_ASSERT(r, dom->approximateBytesUsed() == bytes + sizeof(SkSVGPresentationAttributes));
+
+    // Unset attributes still read as their defaults.
+    REPORTER_ASSERT(r, !(*rect)->getOpacity().isValue());
+    auto* other = dom->findNodeById("r1");
+    REPORTER_ASSERT(r, other);
+    REPORTER_ASSERT(r, !(*other)->getFill().isValue());
+
+    // So do nodes created outside of the builder.
+    auto detached = SkSVGRect::Make();
+    REPORTER_ASSERT(r, !detached->getFill().isValue());
+    detached->setAttribute("fill", "blue");
+    REPORTER_ASSERT(r, detached->getFill().isValue());
+}
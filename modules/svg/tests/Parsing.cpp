@@ -0,0 +1,186 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkStream.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/src/SkSVGXMLTokenizer.h"
+#include "tests/Test.h"
+#include "tools/Resources.h"
+#include "tools/fonts/FontToolUtils.h"
+
+using Token = SkSVGXMLTokenizer::Token;
+
+DEF_TEST(Svg_XMLTokenizer, r) {
+    const std::string doc =
+        "\xEF\xBB\xBF<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n"
+        "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\" "
+                             "\"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n"
+        "<!-- <comment/> -->\n"
+        "<svg a='1 &amp; &#x41;&#66;\"' b = \"x\r\ny\tz&#10;\">"
+            "<g/>"
+            "<text>a &lt;<!-- c -->b<![CDATA[<c>]]>\r\n</text >"
+        "</svg>\n"
+        "<?pi?>\n";
+
+    static const struct {
+        Token       fToken;
+        const char* fString;
+    } gExpected[] = {
+        { Token::kStartElement, "svg"           },
+        { Token::kAttribute   , "a"             },
+        { Token::kAttribute   , "b"             },
+        { Token::kStartElement, "g"             },
+        { Token::kEndElement  , nullptr         },
+        { Token::kStartElement, "text"          },
+        { Token::kText        , "a <b<c>\n"     },
+        { Token::kEndElement  , nullptr         },
+        { Token::kEndElement  , nullptr         },
+        { Token::kEndDocument , nullptr         },
+        { Token::kEndDocument , nullptr         },
+    };
+
+    SkSVGXMLTokenizer tokenizer(doc.c_str(), doc.size());
+    for (const auto& expected : gExpected) {
+        const auto token = tokenizer.next();
+        REPORTER_ASSERT(r, token == expected.fToken);
+        if (token == Token::kStartElement || token == Token::kAttribute) {
+            REPORTER_ASSERT(r, !strcmp(tokenizer.name(), expected.fString));
+        } else if (token == Token::kText) {
+            REPORTER_ASSERT(r, !strcmp(tokenizer.value(), expected.fString));
+            REPORTER_ASSERT(r, tokenizer.valueSize() == strlen(expected.fString));
+        }
+        if (token == Token::kAttribute) {
+            REPORTER_ASSERT(r, !strcmp(tokenizer.value(), !strcmp(tokenizer.name(), "a")
+                                                            ? "1 & AB\""
+                                                            : "x y z\n"));
+        }
+    }
+}
+
+DEF_TEST(Svg_XMLTokenizer_Errors, r) {
+    static const char* gDocs[] = {
+        "",
+        "<svg>",
+        "<svg></g>",
+        "<svg><g></svg>",
+        "<svg a=1/>",
+        "<svg a='1'b='2'/>",
+        "<svg a='<'/>",
+        "<svg a='&foo;'/>",
+        "<svg a='&#0;'/>",
+        "<svg a='&#x110000;'/>",
+        "<svg>&amp</svg>",
+        "<svg><![CDATA[</svg>",
+        "<svg><!-- </svg>",
+        "text<svg/>",
+        "<svg/>text",
+        "<svg/><svg/>",
+        // Supported by expat, but not by the tokenizer.
+        "<!DOCTYPE svg [ <!ELEMENT svg ANY> ]><svg/>",
+        "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?><svg/>",
+    };
+
+    for (const auto* doc : gDocs) {
+        SkSVGXMLTokenizer tokenizer(doc, strlen(doc));
+        auto token = tokenizer.next();
+        while (token != Token::kEndDocument && token != Token::kError) {
+            token = tokenizer.next();
+        }
+        REPORTER_ASSERT(r, token == Token::kError, "%s", doc);
+    }
+}
+
+static SkBitmap render(const sk_sp<SkSVGDOM>& dom) {
+    SkBitmap bm;
+    bm.allocN32Pixels(200, 200);
+    bm.eraseColor(SK_ColorTRANSPARENT);
+
+    SkCanvas canvas(bm);
+    dom->setContainerSize(SkSize::Make(200, 200));
+    dom->render(&canvas);
+
+    return bm;
+}
+
+static bool equal_pixels(const SkBitmap& a, const SkBitmap& b) {
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.getAddr32(0, y), b.getAddr32(0, y), a.width() * sizeof(uint32_t))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Documents built directly from the tokenizer must match the XML DOM ones.
+DEF_TEST(Svg_Parsing_MatchesXMLDOM, r) {
+    const std::string inline_svg = R"EOF(<?xml version="1.0"?>
+    <svg width="200" height="200" xmlns="http://www.w3.org/2000/svg"
+         xmlns:xlink="http://www.w3.org/1999/xlink">
+        <defs>
+            <linearGradient id="grad">
+                <stop offset="0" stop-color="red"/>
+                <stop offset="1" stop-color="blue"/>
+            </linearGradient>
+            <rect id="r" width="50" height="50" style="fill: url(#grad); stroke: &#x23;0f0"/>
+        </defs>
+        <unknown><rect width="200" height="200"/></unknown>
+        <use xlink:href="#r" x="10" y="10"/>
+        <g transform="translate(100,
+                                100)">
+            <use xlink:href="#r"/>
+            <text x="0" y="80" font-family="Noto Mono" font-size="20">A &amp; <![CDATA[B]]></text>
+        </g>
+    </svg>
+    )EOF";
+
+    // Unsupported by the tokenizer, which falls back to the XML DOM.
+    const std::string fallback_svg = R"EOF(<!DOCTYPE svg [ <!ELEMENT svg ANY> ]>
+    <svg width="200" height="200" xmlns="http://www.w3.org/2000/svg">
+        <circle cx="100" cy="100" r="50" fill="green"/>
+    </svg>
+    )EOF";
+
+    const auto parse = [](std::unique_ptr<SkStreamAsset> stream, bool use_xml_dom) {
+        return SkSVGDOM::Builder()
+                .setFontManager(ToolUtils::TestFontMgr())
+                .setUseXMLDOMParser(use_xml_dom)
+                .make(*stream);
+    };
+
+    const std::function<std::unique_ptr<SkStreamAsset>()> gSources[] = {
+        [&]() { return SkMemoryStream::MakeDirect(inline_svg.c_str(), inline_svg.size()); },
+        [&]() { return SkMemoryStream::MakeDirect(fallback_svg.c_str(), fallback_svg.size()); },
+        []() { return GetResourceAsStream("Cowboy.svg"); },
+    };
+
+    for (const auto& source : gSources) {
+        if (!source()) {
+            continue;  // Missing resources.
+        }
+
+        auto direct  = parse(source(), false),
+             xml_dom = parse(source(), true);
+        REPORTER_ASSERT(r, direct && xml_dom);
+        if (!direct || !xml_dom) {
+            continue;
+        }
+
+        REPORTER_ASSERT(r, equal_pixels(render(direct), render(xml_dom)));
+    }
+
+    // Malformed documents are rejected either way.
+    const std::string malformed_svg = "<svg><g></svg>";
+    REPORTER_ASSERT(r, !parse(SkMemoryStream::MakeDirect(malformed_svg.c_str(),
+                                                         malformed_svg.size()), false));
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkStream.h"
+#include "modules/skresources/include/SkResources.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "modules/svg/include/SkSVGRect.h"
+#include "modules/svg/include/SkSVGSVG.h"
+#include "tests/Test.h"
+#include "tools/Resources.h"
+#include "tools/fonts/FontToolUtils.h"
+
+static sk_sp<SkSVGDOM> make_dom(SkStream& stream, bool picture_caching) {
+    return SkSVGDOM::Builder()
+            .setFontManager(ToolUtils::TestFontMgr())
+            .setPictureCaching(picture_caching)
+            .make(stream);
+}
+
+static SkBitmap render(const sk_sp<SkSVGDOM>& dom, const SkMatrix& ctm = SkMatrix::I()) {
+    SkBitmap bm;
+    bm.allocN32Pixels(200, 200);
+    bm.eraseColor(SK_ColorTRANSPARENT);
+
+    SkCanvas canvas(bm);
+    canvas.setMatrix(ctm);
+    dom->render(&canvas);
+
+    return bm;
+}
+
+static int max_channel_diff(const SkBitmap& a, const SkBitmap& b) {
+    int diff = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            const auto ca = *a.getAddr32(x, y),
+                       cb = *b.getAddr32(x, y);
+            for (int shift = 0; shift < 32; shift += 8) {
+                diff = std::max(diff, std::abs(static_cast<int>((ca >> shift) & 0xff) -
+                                               static_cast<int>((cb >> shift) & 0xff)));
+            }
+        }
+    }
+    return diff;
+}
+
+DEF_TEST(Svg_PictureCache_MatchesUncached, r) {
+    auto data = GetResourceAsData("Cowboy.svg");
+    if (!data) {
+        return;
+    }
+
+    SkMemoryStream cached_stream(data),
+                   uncached_stream(data);
+    auto cached   = make_dom(cached_stream, true),
+         uncached = make_dom(uncached_stream, false);
+    REPORTER_ASSERT(r, cached && uncached);
+
+    const SkMatrix ctms[] = {
+        SkMatrix::I(),
+        SkMatrix::I(),
+        SkMatrix::Scale(3, 3),
+        SkMatrix::Translate(-50, -70) * SkMatrix::Scale(2, 2),
+    };
+
+    for (const auto size : { SkSize::Make(200, 200), SkSize::Make(120, 80) }) {
+        cached->setContainerSize(size);
+        uncached->setContainerSize(size);
+
+        for (const auto& ctm : ctms) {
+            REPORTER_ASSERT(r, max_channel_diff(render(cached, ctm), render(uncached, ctm)) <= 1);
+        }
+    }
+}
+
+DEF_TEST(Svg_PictureCache_Invalidation, r) {
+    const std::string svg = R"EOF(
+    <svg width="100%" height="100%" xmlns="http://www.w3.org/2000/svg">
+        <rect id="r" width="50%" height="100%" fill="red"/>
+    </svg>
+    )EOF";
+
+    SkMemoryStream stream(svg.c_str(), svg.size());
+    auto dom = make_dom(stream, true);
+    REPORTER_ASSERT(r, dom);
+
+    dom->setContainerSize(SkSize::Make(100, 100));
+    auto bm = render(dom);
+    REPORTER_ASSERT(r, bm.getColor( 25, 50) == SK_ColorRED);
+    REPORTER_ASSERT(r, bm.getColor( 75, 50) == SK_ColorTRANSPARENT);
+
+    // Container size changes.
+    dom->setContainerSize(SkSize::Make(200, 200));
+    bm = render(dom);
+    REPORTER_ASSERT(r, bm.getColor( 75, 50) == SK_ColorRED);
+    REPORTER_ASSERT(r, bm.getColor(125, 50) == SK_ColorTRANSPARENT);
+
+    // DOM changes.
+    auto* rect = dom->findNodeById("r");
+    REPORTER_ASSERT(r, rect);
+    (*rect)->setAttribute("fill", "lime");
+    bm = render(dom);
+    REPORTER_ASSERT(r, bm.getColor( 75, 50) == SK_ColorGREEN);
+
+    // Back to the first size, after the DOM change.
+    dom->setContainerSize(SkSize::Make(100, 100));
+    bm = render(dom);
+    REPORTER_ASSERT(r, bm.getColor( 25, 50) == SK_ColorGREEN);
+    REPORTER_ASSERT(r, bm.getColor( 75, 50) == SK_ColorTRANSPARENT);
+}
+
+namespace {
+
+// Counts the image loads, i.e. the renders of documents with one image.
+class CountingResourceProvider final : public skresources::ResourceProvider {
+public:
+    int loadCount() const { return fLoadCount.load(); }
+
+    sk_sp<skresources::ImageAsset> loadImageAsset(const char[],
+                                                  const char[],
+                                                  const char[]) const override {
+        class SolidImageAsset final : public skresources::ImageAsset {
+            bool isMultiFrame() override { return false; }
+            sk_sp<SkImage> getFrame(float) override {
+                SkBitmap bm;
+                bm.allocN32Pixels(1, 1);
+                bm.eraseColor(SK_ColorBLUE);
+                return bm.asImage();
+            }
+        };
+
+        fLoadCount++;
+        return sk_make_sp<SolidImageAsset>();
+    }
+
+private:
+    mutable std::atomic<int> fLoadCount{0};
+};
+
+static constexpr char kImageDocument[] = R"EOF(
+<svg width="100" height="100" xmlns="http://www.w3.org/2000/svg"
+     xmlns:xlink="http://www.w3.org/1999/xlink">
+    <image xlink:href="blue.png" width="50" height="100"/>
+    <rect id="r" x="50" width="50" height="100" fill="red"/>
+</svg>
+)EOF";
+
+static sk_sp<SkSVGDOM> make_image_dom(sk_sp<CountingResourceProvider> rp) {
+    SkMemoryStream stream(kImageDocument, strlen(kImageDocument));
+    return SkSVGDOM::Builder()
+            .setFontManager(ToolUtils::TestFontMgr())
+            .setResourceProvider(std::move(rp))
+            .setPictureCaching(true)
+            .make(stream);
+}
+
+}  // namespace
+
+DEF_TEST(Svg_PictureCache_PerDOMInvalidation, r) {
+    auto rp0 = sk_make_sp<CountingResourceProvider>(),
+         rp1 = sk_make_sp<CountingResourceProvider>();
+    auto dom0 = make_image_dom(rp0),
+         dom1 = make_image_dom(rp1);
+    REPORTER_ASSERT(r, dom0 && dom1);
+
+    render(dom0);
+    render(dom0);
+    render(dom1);
+    REPORTER_ASSERT(r, rp0->loadCount() == 1);
+    REPORTER_ASSERT(r, rp1->loadCount() == 1);
+
+    // Changes to a DOM don't invalidate the other DOMs' renders.
+    auto* rect = dom1->findNodeById("r");
+    REPORTER_ASSERT(r, rect);
+    (*rect)->setAttribute("fill", "lime");
+    auto bm0 = render(dom0),
+         bm1 = render(dom1);
+    REPORTER_ASSERT(r, rp0->loadCount() == 1);
+    REPORTER_ASSERT(r, rp1->loadCount() == 2);
+    REPORTER_ASSERT(r, bm0.getColor(25, 50) == SK_ColorBLUE);
+    REPORTER_ASSERT(r, bm0.getColor(75, 50) == SK_ColorRED);
+    REPORTER_ASSERT(r, bm1.getColor(25, 50) == SK_ColorBLUE);
+    REPORTER_ASSERT(r, bm1.getColor(75, 50) == SK_ColorGREEN);
+
+    // Nor do changes to nodes outside of the DOM.
+    auto detached = SkSVGRect::Make();
+    detached->setAttribute("fill", "lime");
+    render(dom0);
+    REPORTER_ASSERT(r, rp0->loadCount() == 1);
+
+    // Appending a child is a change.
+    detached->setWidth(SkSVGLength(10));
+    detached->setHeight(SkSVGLength(10));
+    dom0->getRoot()->appendChild(detached);
+    bm0 = render(dom0);
+    REPORTER_ASSERT(r, rp0->loadCount() == 2);
+    REPORTER_ASSERT(r, bm0.getColor(5, 5) == SK_ColorGREEN);
+
+    // So are changes to the appended child.
+    detached->setAttribute("fill", "red");
+    bm0 = render(dom0);
+    REPORTER_ASSERT(r, rp0->loadCount() == 3);
+    REPORTER_ASSERT(r, bm0.getColor(5, 5) == SK_ColorRED);
+}
+
+DEF_TEST(Svg_PictureCache_ConcurrentRender, r) {
+    auto rp = sk_make_sp<CountingResourceProvider>();
+    auto dom = make_image_dom(rp);
+    REPORTER_ASSERT(r, dom);
+
+    static constexpr int kThreads = 4;
+    std::vector<SkBitmap> bitmaps(kThreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&, i] { bitmaps[i] = render(dom); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // The document is recorded once, and all renders draw the same picture.
+    REPORTER_ASSERT(r, rp->loadCount() == 1);
+    for (const auto& bm : bitmaps) {
+        REPORTER_ASSERT(r, bm.getColor(25, 50) == SK_ColorBLUE);
+        REPORTER_ASSERT(r, bm.getColor(75, 50) == SK_ColorRED);
+    }
+}
@@ -4,6 +4,9 @@
 #include "src/base/SkUTF.h"
 
 #include "include/private/base/SkTFitsIn.h"
+#include "src/base/SkVx.h"
+
+#include <cstring>
 
 static constexpr inline int32_t left_shift(int32_t value, int32_t shift) {
     return (int32_t) ((uint32_t) value << shift);
@@ -42,6 +45,20 @@ static bool utf8_type_is_valid_leading_byte(int type) { return type > 0; }
 
 static bool utf8_byte_is_continuation(uint8_t c) { return utf8_byte_type(c) == 0; }
 
+// The bulk functions below handle runs of ASCII 16 code units at a time. The high bits are tested
+// in 64 bit lanes, since any() on SSE only looks at the sign bit of each 32 bit lane.
+static constexpr size_t kASCIIChunk = 16;
+
+static bool is_ascii_chunk(const char* utf8) {
+    auto v = skvx::Vec<2, uint64_t>::Load(utf8) & 0x8080808080808080;
+    return (v[0] | v[1]) == 0;
+}
+
+static bool is_ascii_chunk(const uint16_t* utf16) {
+    auto v = skvx::Vec<4, uint64_t>::Load(utf16) & 0xFF80FF80FF80FF80;
+    return (v[0] | v[1] | v[2] | v[3]) == 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 int SkUTF::CountUTF8(const char* utf8, size_t byteLength) {
@@ -51,6 +68,11 @@ int SkUTF::CountUTF8(const char* utf8, size_t byteLength) {
     int count = 0;
     const char* stop = utf8 + byteLength;
     while (utf8 < stop) {
+        if (stop - utf8 >= (ptrdiff_t)kASCIIChunk && is_ascii_chunk(utf8)) {
+            utf8 += kASCIIChunk;
+            count += kASCIIChunk;
+            continue;
+        }
         int type = utf8_byte_type(*(const uint8_t*)utf8);
         if (!utf8_type_is_valid_leading_byte(type) || utf8 + type > stop) {
             return -1;  // Sequence extends beyond end.
@@ -109,6 +131,17 @@ int SkUTF::CountUTF32(const int32_t* utf32, size_t byteLength) {
     return (int)(byteLength >> 2);
 }
 
+size_t SkUTF::CountASCIIPrefix(const char* utf8, size_t byteLength) {
+    size_t count = 0;
+    while (byteLength - count >= kASCIIChunk && is_ascii_chunk(utf8 + count)) {
+        count += kASCIIChunk;
+    }
+    while (count < byteLength && (uint8_t)utf8[count] < 0x80) {
+        count += 1;
+    }
+    return count;
+}
+
 template <typename T>
 static SkUnichar next_fail(const T** ptr, const T* end) {
     *ptr = end;
@@ -265,6 +298,19 @@ int SkUTF::UTF8ToUTF16(uint16_t dst[], int dstCapacity, const char src[], size_t
     uint16_t* endDst = dst + dstCapacity;
     const char* endSrc = src + srcByteLength;
     while (src < endSrc) {
+        if (endSrc - src >= (ptrdiff_t)kASCIIChunk && is_ascii_chunk(src)) {
+            if (dst && endDst - dst >= (ptrdiff_t)kASCIIChunk) {
+                skvx::cast<uint16_t>(skvx::Vec<kASCIIChunk, uint8_t>::Load(src)).store(dst);
+                dst += kASCIIChunk;
+            } else {
+                for (size_t i = 0; dst < endDst && i < kASCIIChunk; ++i) {
+                    *dst++ = (uint8_t)src[i];
+                }
+            }
+            src += kASCIIChunk;
+            dstLength += kASCIIChunk;
+            continue;
+        }
         SkUnichar uni = NextUTF8(&src, endSrc);
         if (uni < 0) {
             return -1;
@@ -297,6 +343,20 @@ int SkUTF::UTF16ToUTF8(char dst[], int dstCapacity, const uint16_t src[], size_t
     const char* endDst = dst + dstCapacity;
     const uint16_t* endSrc = src + srcLength;
     while (src < endSrc) {
+        if (endSrc - src >= (ptrdiff_t)kASCIIChunk && is_align2(intptr_t(src)) &&
+            is_ascii_chunk(src)) {
+            if (dst && endDst - dst >= (ptrdiff_t)kASCIIChunk) {
+                skvx::cast<uint8_t>(skvx::Vec<kASCIIChunk, uint16_t>::Load(src)).store(dst);
+                dst += kASCIIChunk;
+            } else {
+                for (size_t i = 0; dst < endDst && i < kASCIIChunk; ++i) {
+                    *dst++ = (char)src[i];
+                }
+            }
+            src += kASCIIChunk;
+            dstLength += kASCIIChunk;
+            continue;
+        }
         SkUnichar uni = NextUTF16(&src, endSrc);
         if (uni < 0) {
             return -1;
@@ -29,6 +29,11 @@ SK_SPI int CountUTF16(const uint16_t* utf16, size_t byteLength);
 */
 SK_SPI int CountUTF32(const int32_t* utf32, size_t byteLength);
 
+/** Return the number of bytes at the start of utf8 that are ASCII (less than 0x80). Those
+    bytes are each a whole codepoint, so callers can skip decoding them.
+*/
+SK_SPI size_t CountASCIIPrefix(const char* utf8, size_t byteLength);
+
 /** Given a sequence of UTF-8 bytes, return the first unicode codepoint.
     The pointer will be incremented to point at the next codepoint's start.  If
     invalid UTF-8 is encountered, set *ptr to end and return -1.
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkAlphaSpans_DEFINED
+#define SkAlphaSpans_DEFINED
+
+#include "include/core/SkColor.h"
+#include "include/private/base/SkFixed.h"
+#include "src/base/SkVx.h"
+
+#include <algorithm>
+
+// Coverage accumulation over spans of alphas for the analytic AA scan converter. Each works on 16
+// (or 8) alphas at a time with SkVx, and gives the same results as the one pixel at a time loops.
+namespace SkAlphaSpans {
+
+// alphas[i] = min(alphas[i] + deltas[i], 0xFF)
+inline void SaturatedAdd(SkAlpha* alphas, const SkAlpha deltas[], int len) {
+    int i = 0;
+    for (; i + 16 <= len; i += 16) {
+        skvx::saturated_add(skvx::byte16::Load(alphas + i), skvx::byte16::Load(deltas + i))
+                .store(alphas + i);
+    }
+    for (; i < len; ++i) {
+        alphas[i] = std::min(0xFF, alphas[i] + deltas[i]);
+    }
+}
+
+// alphas[i] = min(alphas[i] + delta, 0xFF)
+inline void SaturatedAdd(SkAlpha* alphas, SkAlpha delta, int len) {
+    const skvx::byte16 deltas(delta);
+    int i = 0;
+    for (; i + 16 <= len; i += 16) {
+        skvx::saturated_add(skvx::byte16::Load(alphas + i), deltas).store(alphas + i);
+    }
+    for (; i < len; ++i) {
+        alphas[i] = std::min(0xFF, alphas[i] + delta);
+    }
+}
+
+// alphas[i] = max(alphas[i] - deltas[i], 0)
+inline void SaturatedSubtract(SkAlpha* alphas, const SkAlpha deltas[], int len) {
+    int i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const skvx::byte16 a = skvx::byte16::Load(alphas + i),
+                           d = skvx::byte16::Load(deltas + i);
+        (a - min(a, d)).store(alphas + i);
+    }
+    for (; i < len; ++i) {
+        alphas[i] = alphas[i] > deltas[i] ? alphas[i] - deltas[i] : 0;
+    }
+}
+
+// alphas[i] = (alpha16 + i * dY) >> 8, keeping the low 8 bits as the scalar assignment does.
+inline void FillRamp(SkAlpha* alphas, int len, SkFixed alpha16, SkFixed dY) {
+    int i = 0;
+    if (len >= 8) {
+        skvx::int8 ramp = alpha16 + skvx::int8{0, 1, 2, 3, 4, 5, 6, 7} * dY;
+        for (; i + 8 <= len; i += 8) {
+            skvx::cast<uint8_t>((ramp >> 8) & 0xFF).store(alphas + i);
+            ramp += dY * 8;
+        }
+        alpha16 += i * dY;
+    }
+    for (; i < len; ++i) {
+        alphas[i] = (alpha16 >> 8) & 0xFF;
+        alpha16 += dY;
+    }
+}
+
+}  // namespace SkAlphaSpans
+
+#endif
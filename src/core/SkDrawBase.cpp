@@ -17,6 +17,7 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkStrokeRec.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkCPUTypes.h"
 #include "include/private/base/SkDebug.h"
@@ -346,7 +347,11 @@ void SkDrawBase::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool d
     void (*proc)(const SkPath&, const SkRasterClip&, SkBlitter*);
     if (doFill) {
         if (paint.isAntiAlias()) {
-            proc = SkScan::AntiFillPath;
+            if (fProps && (fProps->flags() & SkSurfaceProps::kSparseStripRasterizer_Flag)) {
+                proc = SkScan::SparseStripFillPath;
+            } else {
+                proc = SkScan::AntiFillPath;
+            }
         } else {
             proc = SkScan::FillPath;
         }
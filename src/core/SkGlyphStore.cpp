@@ -0,0 +1,200 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkGlyphStore.h"
+
+#include "include/core/SkFontArguments.h"
+#include "include/core/SkFontStyle.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypeface.h"
+#include "include/private/base/SkAlign.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkDescriptor.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkScalerContext.h"
+#include "src/core/SkStrike.h"
+#include "src/core/SkStrikeSpec.h"
+#include "src/core/SkWriteBuffer.h"
+
+#include <cstring>
+#include <optional>
+#include <utility>
+
+using namespace skia_private;
+
+// Layout:
+//   uint32_t magic, version, entry count
+//   for each entry:
+//     uint32_t descriptor length, glyphs length
+//     descriptor, padded to 4 bytes
+//     glyphs as written by SkStrike::flattenGlyphs, padded to 4 bytes
+static constexpr uint32_t kMagic = SkSetFourByteTag('s', 'k', 'g', 's');
+// Bump this whenever the layout above, SkDescriptor, SkScalerContextRec or the serialization of
+// SkGlyph changes.
+static constexpr uint32_t kVersion = 1;
+
+SkGlyphStore::SkGlyphStore(sk_sp<SkData> data) : fData{std::move(data)} {}
+
+sk_sp<SkData> SkGlyphStore::Serialize(SkSpan<const sk_sp<SkStrike>> strikes) {
+    THashMap<uint32_t, uint32_t> stableIDs;
+    SkBinaryWriteBuffer entries({});
+    SkBinaryWriteBuffer glyphs({});
+    uint32_t count = 0;
+    for (const sk_sp<SkStrike>& strike : strikes) {
+        const SkTypeface& typeface = strike->strikeSpec().typeface();
+        const uint32_t* stableID = stableIDs.find(typeface.uniqueID());
+        if (stableID == nullptr) {
+            stableID = stableIDs.set(typeface.uniqueID(), StableTypefaceID(typeface));
+        }
+
+        SkAutoDescriptor descriptor{strike->getDescriptor()};
+        if (!SetTypefaceID(descriptor.getDesc(), *stableID)) {
+            continue;
+        }
+
+        glyphs.reset();
+        strike->flattenGlyphs(glyphs);
+        sk_sp<SkData> glyphData = glyphs.snapshotAsData();
+
+        entries.writeUInt(descriptor.getDesc()->getLength());
+        entries.writeUInt(SkToU32(glyphData->size()));
+        entries.writePad32(descriptor.getDesc(), descriptor.getDesc()->getLength());
+        entries.writePad32(glyphData->data(), glyphData->size());
+        count += 1;
+    }
+
+    SkBinaryWriteBuffer store({});
+    store.writeUInt(kMagic);
+    store.writeUInt(kVersion);
+    store.writeUInt(count);
+    sk_sp<SkData> entryData = entries.snapshotAsData();
+    store.writePad32(entryData->data(), entryData->size());
+    return store.snapshotAsData();
+}
+
+sk_sp<SkGlyphStore> SkGlyphStore::Make(sk_sp<SkData> data) {
+    // The descriptors are used in place.
+    if (data == nullptr || !SkIsAlign4(reinterpret_cast<uintptr_t>(data->data()))) {
+        return nullptr;
+    }
+
+    sk_sp<SkGlyphStore> store{new SkGlyphStore(data)};
+    SkReadBuffer buffer{data->data(), data->size()};
+    if (buffer.readUInt() != kMagic || buffer.readUInt() != kVersion) {
+        return nullptr;
+    }
+    const uint32_t count = buffer.readUInt();
+    for (uint32_t i = 0; i < count && buffer.isValid(); ++i) {
+        const uint32_t descriptorLength = buffer.readUInt();
+        const uint32_t glyphsLength = buffer.readUInt();
+        auto descriptor = static_cast<const SkDescriptor*>(buffer.skip(descriptorLength));
+        auto glyphs = static_cast<const uint8_t*>(buffer.skip(glyphsLength));
+        if (!buffer.validate(descriptor != nullptr &&
+                             glyphs != nullptr &&
+                             descriptorLength >= sizeof(SkDescriptor) &&
+                             descriptor->getLength() == descriptorLength &&
+                             descriptor->isValid())) {
+            return nullptr;
+        }
+        store->fEntries.set({descriptor, {glyphs, glyphsLength}});
+    }
+    if (!buffer.isValid()) {
+        return nullptr;
+    }
+    return store;
+}
+
+bool SkGlyphStore::mergeInto(SkStrike* strike) const {
+    if (fEntries.count() == 0) {
+        return false;
+    }
+
+    const SkTypeface& typeface = strike->strikeSpec().typeface();
+    std::optional<uint32_t> stableID;
+    {
+        SkAutoMutexExclusive lock{fStableIDsLock};
+        if (const uint32_t* found = fStableIDs.find(typeface.uniqueID())) {
+            stableID = *found;
+        }
+    }
+    if (!stableID) {
+        // Computing the ID reads font tables, so don't hold the lock.
+        stableID = StableTypefaceID(typeface);
+        SkAutoMutexExclusive lock{fStableIDsLock};
+        fStableIDs.set(typeface.uniqueID(), *stableID);
+    }
+
+    SkAutoDescriptor descriptor{strike->getDescriptor()};
+    if (!SetTypefaceID(descriptor.getDesc(), *stableID)) {
+        return false;
+    }
+    const Entry* entry = fEntries.find(*descriptor.getDesc());
+    if (entry == nullptr) {
+        return false;
+    }
+    SkReadBuffer buffer{entry->fGlyphs.data(), entry->fGlyphs.size()};
+    return strike->mergeFromBuffer(buffer);
+}
+
+uint32_t SkGlyphStore::StableTypefaceID(const SkTypeface& typeface) {
+    SkBinaryWriteBuffer buffer({});
+
+    SkString name;
+    typeface.getFamilyName(&name);
+    buffer.writeString(name.c_str());
+    if (typeface.getPostScriptName(&name)) {
+        buffer.writeString(name.c_str());
+    }
+
+    const SkFontStyle style = typeface.fontStyle();
+    buffer.writeInt(style.weight());
+    buffer.writeInt(style.width());
+    buffer.writeInt(style.slant());
+    buffer.writeInt(typeface.countGlyphs());
+    buffer.writeInt(typeface.getUnitsPerEm());
+
+    // The 'head' table has the font's revision, checksum and modification time.
+    if (sk_sp<SkData> head = typeface.copyTableData(SkSetFourByteTag('h', 'e', 'a', 'd'))) {
+        buffer.writeByteArray(head->data(), head->size());
+    }
+
+    using Coordinate = SkFontArguments::VariationPosition::Coordinate;
+    const int axisCount = typeface.getVariationDesignPosition(nullptr, 0);
+    if (axisCount > 0) {
+        AutoSTMalloc<4, Coordinate> coordinates(axisCount);
+        if (typeface.getVariationDesignPosition(coordinates.get(), axisCount) == axisCount) {
+            buffer.writeByteArray(coordinates.get(), axisCount * sizeof(Coordinate));
+        }
+    }
+
+    sk_sp<SkData> data = buffer.snapshotAsData();
+    return SkChecksum::Hash32(data->data(), data->size());
+}
+
+bool SkGlyphStore::SetTypefaceID(SkDescriptor* descriptor, uint32_t typefaceID) {
+    uint32_t size;
+    // findEntry returns a const void*, remove the const in order to update in place.
+    void* ptr = const_cast<void*>(descriptor->findEntry(kRec_SkDescriptorTag, &size));
+    SkScalerContextRec rec;
+    if (!ptr || size != sizeof(rec)) {
+        return false;
+    }
+    std::memcpy((void*)&rec, ptr, size);
+    rec.fTypefaceID = typefaceID;
+    std::memcpy(ptr, &rec, size);
+    descriptor->computeChecksum();
+    return true;
+}
+
+const SkDescriptor& SkGlyphStore::EntryTraits::GetKey(const Entry& entry) {
+    return *entry.fDescriptor;
+}
+
+uint32_t SkGlyphStore::EntryTraits::Hash(const SkDescriptor& descriptor) {
+    return descriptor.getChecksum();
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGlyphStore_DEFINED
+#define SkGlyphStore_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkTHash.h"
+
+#include <cstddef>
+#include <cstdint>
+
+class SkDescriptor;
+class SkStrike;
+class SkTypeface;
+
+// A read-only store of glyph metrics, images and paths, keyed by strike descriptor, which can
+// outlive the process that made it. The SkStrikeCache consults the store when it creates a
+// strike, so a program can start with the glyphs it made in an earlier run instead of making
+// them again with the scaler context.
+//
+// The glyphs are stored in the format SkStrike::mergeFromBuffer reads, which is what
+// SkStrikeServer sends to SkStrikeClient. Typeface IDs are only unique within a process, so the
+// descriptors in the store use an ID computed from the typeface's name, style and 'head' table
+// instead. The data is only meant to be read by the same build of Skia that wrote it.
+class SkGlyphStore final : public SkRefCnt {
+public:
+    // Serialize the glyphs in strikes.
+    static sk_sp<SkData> Serialize(SkSpan<const sk_sp<SkStrike>> strikes);
+
+    // Use data made by Serialize in place. The data may be a memory mapped file. Returns nullptr
+    // if the data is not a valid glyph store.
+    static sk_sp<SkGlyphStore> Make(sk_sp<SkData> data);
+
+    // If there are glyphs for the strike's descriptor, merge them into the strike, which should
+    // not be visible to other threads yet. Returns true if any glyphs were merged.
+    bool mergeInto(SkStrike* strike) const SK_EXCLUDES(fStableIDsLock);
+
+    int count() const { return fEntries.count(); }
+
+private:
+    struct Entry {
+        const SkDescriptor* fDescriptor;
+        SkSpan<const uint8_t> fGlyphs;
+    };
+    struct EntryTraits {
+        static const SkDescriptor& GetKey(const Entry& entry);
+        static uint32_t Hash(const SkDescriptor& descriptor);
+    };
+
+    explicit SkGlyphStore(sk_sp<SkData> data);
+
+    // Return an ID for the typeface that is the same in every process.
+    static uint32_t StableTypefaceID(const SkTypeface& typeface);
+
+    // Replace the typeface ID in the descriptor. Returns false if it has no scaler context rec.
+    static bool SetTypefaceID(SkDescriptor* descriptor, uint32_t typefaceID);
+
+    const sk_sp<SkData> fData;
+    skia_private::THashTable<Entry, SkDescriptor, EntryTraits> fEntries;
+
+    mutable SkMutex fStableIDsLock;
+    mutable skia_private::THashMap<uint32_t, uint32_t> fStableIDs SK_GUARDED_BY(fStableIDsLock);
+};
+
+#endif  // SkGlyphStore_DEFINED
@@ -7,10 +7,12 @@
 
 #include "include/core/SkGraphics.h"
 
+#include "include/core/SkData.h"
 #include "src/core/SkBitmapProcState.h"
 #include "src/core/SkBlitMask.h"
 #include "src/core/SkBlitRow.h"
 #include "src/core/SkCpu.h"
+#include "src/core/SkGlyphStore.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkMemset.h"
 #include "src/core/SkOpts.h"
@@ -78,6 +80,22 @@ void SkGraphics::PurgePinnedFontCache() {
     SkStrikeCache::GlobalStrikeCache()->purgePinned();
 }
 
+sk_sp<SkData> SkGraphics::SerializeFontCacheGlyphs() {
+    return SkStrikeCache::GlobalStrikeCache()->serializeGlyphs();
+}
+
+bool SkGraphics::SetFontCacheGlyphStore(sk_sp<SkData> data) {
+    sk_sp<SkGlyphStore> glyphStore;
+    if (data != nullptr) {
+        glyphStore = SkGlyphStore::Make(std::move(data));
+        if (glyphStore == nullptr) {
+            return false;
+        }
+    }
+    SkStrikeCache::GlobalStrikeCache()->setGlyphStore(std::move(glyphStore));
+    return true;
+}
+
 static int gTypefaceCacheCountLimit = 1024; // historical default value
 
 int SkGraphics::GetTypefaceCacheCountLimit() {
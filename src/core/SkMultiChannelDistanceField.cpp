@@ -0,0 +1,544 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkMultiChannelDistanceField.h"
+
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkScalar.h"
+#include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTPin.h"
+#include "include/private/base/SkTo.h"
+#include "src/core/SkDistanceFieldGen.h"
+#include "src/core/SkGeometry.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+using namespace skia_private;
+
+#if !defined(SK_DISABLE_SDF_TEXT)
+
+// This follows the approach of Viktor Chlumsky's msdfgen: color the edges with the simple
+// coloring, take the pseudo-distance to the nearest edge of each channel, fix the sign of texels
+// whose median disagrees with the path's fill, and flatten texels whose channels would clash
+// when interpolated with a neighbor.
+
+namespace {
+// The channels an edge contributes to.
+enum Color : uint8_t {
+    kBlack   = 0,
+    kRed     = 1,
+    kGreen   = 2,
+    kYellow  = kRed | kGreen,
+    kBlue    = 4,
+    kMagenta = kRed | kBlue,
+    kCyan    = kGreen | kBlue,
+    kWhite   = kRed | kGreen | kBlue,
+};
+
+// Edges are compared by the magnitude of their distance. Between two edges that are the same
+// distance away, which happens at their shared end point, the one that points less directly
+// at the point is nearer, so that the point is on its side.
+struct SignedDistance {
+    float fDistance = SK_FloatInfinity;
+    float fDot = 1;
+
+    bool operator<(const SignedDistance& that) const {
+        const float a = std::fabs(fDistance), b = std::fabs(that.fDistance);
+        return a < b || (a == b && fDot < that.fDot);
+    }
+};
+
+float cross(SkVector a, SkVector b) { return SkPoint::CrossProduct(a, b); }
+float dot(SkVector a, SkVector b) { return SkPoint::DotProduct(a, b); }
+float non_zero_sign(float x) { return x > 0 ? 1 : -1; }
+
+SkVector unit(SkVector v) {
+    // Leaves zero vectors as zero.
+    (void)v.normalize();
+    return v;
+}
+
+// A line, or a cubic. Quads and conics are turned into cubics.
+struct Edge {
+    SkPoint fPts[4];
+    bool fIsLine;
+    uint8_t fColor = kWhite;
+
+    SkPoint start() const { return fPts[0]; }
+    SkPoint end() const { return fIsLine ? fPts[1] : fPts[3]; }
+
+    SkVector direction(float t) const {
+        if (fIsLine) {
+            return fPts[1] - fPts[0];
+        }
+        SkVector a = fPts[1] - fPts[0],
+                 b = fPts[2] - fPts[1],
+                 c = fPts[3] - fPts[2];
+        SkVector ab = a + (b - a) * t,
+                 bc = b + (c - b) * t;
+        SkVector tangent = ab + (bc - ab) * t;
+        if (tangent.isZero()) {
+            // Use the control point on the other side if the one at this end is on the end.
+            if (t == 0) { return fPts[2] - fPts[0]; }
+            if (t == 1) { return fPts[3] - fPts[1]; }
+        }
+        return tangent;
+    }
+
+    // Return the signed distance from p to the edge, and the parameter of the nearest point,
+    // which is outside [0, 1] when the nearest point is an end point that the edge leaves
+    // behind p.
+    SignedDistance signedDistance(SkPoint p, float* t) const {
+        if (fIsLine) {
+            const SkVector aq = p - fPts[0],
+                           ab = fPts[1] - fPts[0];
+            *t = dot(aq, ab) / dot(ab, ab);
+            const SkVector eq = fPts[*t > 0.5f] - p;
+            const float endDistance = eq.length();
+            if (0 < *t && *t < 1) {
+                const float orthoDistance = cross(aq, ab) / ab.length();
+                if (std::fabs(orthoDistance) < endDistance) {
+                    return {orthoDistance, 0};
+                }
+            }
+            return {non_zero_sign(cross(aq, ab)) * endDistance,
+                    std::fabs(dot(unit(ab), unit(eq)))};
+        }
+
+        const SkVector qa = fPts[0] - p,
+                       ab = fPts[1] - fPts[0],
+                       br = fPts[2] - fPts[1] - ab,
+                       as = (fPts[3] - fPts[2]) - (fPts[2] - fPts[1]) - br;
+
+        // Start with the nearer end point.
+        SkVector startDir = this->direction(0);
+        float minDistance = non_zero_sign(cross(startDir, qa)) * qa.length();
+        *t = -dot(qa, startDir) / dot(startDir, startDir);
+        {
+            const SkVector endDir = this->direction(1),
+                           bq = fPts[3] - p;
+            const float distance = bq.length();
+            if (distance < std::fabs(minDistance)) {
+                minDistance = non_zero_sign(cross(endDir, bq)) * distance;
+                *t = dot(endDir - bq, endDir) / dot(endDir, endDir);
+            }
+        }
+
+        // Then look for a nearer point along the curve with Newton's method from a few starts.
+        static constexpr int kStarts = 4;
+        static constexpr int kSteps = 4;
+        for (int i = 0; i <= kStarts; ++i) {
+            float s = (float)i / kStarts;
+            SkVector qe = qa + ab * (3 * s) + br * (3 * s * s) + as * (s * s * s);
+            for (int step = 0; step < kSteps; ++step) {
+                const SkVector d1 = ab * 3 + br * (6 * s) + as * (3 * s * s),
+                               d2 = br * 6 + as * (6 * s);
+                s -= dot(qe, d1) / (dot(d1, d1) + dot(qe, d2));
+                if (!(0 < s && s < 1)) {
+                    break;
+                }
+                qe = qa + ab * (3 * s) + br * (3 * s * s) + as * (s * s * s);
+                const float distance = qe.length();
+                if (distance < std::fabs(minDistance)) {
+                    minDistance = non_zero_sign(cross(d1, qe)) * distance;
+                    *t = s;
+                }
+            }
+        }
+
+        if (0 <= *t && *t <= 1) {
+            return {minDistance, 0};
+        }
+        if (*t < 0.5f) {
+            return {minDistance, std::fabs(dot(unit(this->direction(0)), unit(qa)))};
+        }
+        return {minDistance, std::fabs(dot(unit(this->direction(1)), unit(fPts[3] - p)))};
+    }
+
+    // Past the ends of the edge, measure the distance to the edge's tangent line instead, so
+    // that the distance of a channel doesn't round off the corner it meets another edge at.
+    void toPseudoDistance(SignedDistance* distance, SkPoint p, float t) const {
+        if (t < 0) {
+            const SkVector dir = unit(this->direction(0)),
+                           aq = p - this->start();
+            if (dot(aq, dir) < 0) {
+                const float pseudoDistance = cross(aq, dir);
+                if (std::fabs(pseudoDistance) <= std::fabs(distance->fDistance)) {
+                    *distance = {pseudoDistance, 0};
+                }
+            }
+        } else if (t > 1) {
+            const SkVector dir = unit(this->direction(1)),
+                           bq = p - this->end();
+            if (dot(bq, dir) > 0) {
+                const float pseudoDistance = cross(bq, dir);
+                if (std::fabs(pseudoDistance) <= std::fabs(distance->fDistance)) {
+                    *distance = {pseudoDistance, 0};
+                }
+            }
+        }
+    }
+
+    void splitInThirds(Edge parts[3]) const {
+        if (fIsLine) {
+            const SkVector step = (fPts[1] - fPts[0]) * (1.0f / 3);
+            const SkPoint points[4] = {fPts[0], fPts[0] + step, fPts[0] + step * 2, fPts[1]};
+            for (int i = 0; i < 3; ++i) {
+                parts[i] = {{points[i], points[i + 1]}, true, fColor};
+            }
+            return;
+        }
+        SkPoint chopped[10];
+        SkChopCubicAt(fPts, chopped, 1.0f / 3, 2.0f / 3);
+        for (int i = 0; i < 3; ++i) {
+            const SkPoint* pts = chopped + 3 * i;
+            parts[i] = {{pts[0], pts[1], pts[2], pts[3]}, false, fColor};
+        }
+    }
+};
+
+using Contour = TArray<Edge, true>;
+
+void add_line(Contour* contour, SkPoint p0, SkPoint p1) {
+    if (p0 != p1) {
+        contour->push_back({{p0, p1}, true});
+    }
+}
+
+void add_cubic(Contour* contour, SkPoint p0, SkPoint p1, SkPoint p2, SkPoint p3) {
+    if (p0 == p1 && p1 == p2 && p2 == p3) {
+        return;
+    }
+    contour->push_back({{p0, p1, p2, p3}, false});
+}
+
+void add_quad(Contour* contour, const SkPoint pts[3]) {
+    // Elevate to a cubic with the same curve.
+    add_cubic(contour, pts[0],
+                       pts[0] + (pts[1] - pts[0]) * (2.0f / 3),
+                       pts[2] + (pts[1] - pts[2]) * (2.0f / 3),
+                       pts[2]);
+}
+
+TArray<Contour> contours_from_path(const SkPath& path) {
+    TArray<Contour> contours;
+    SkAutoConicToQuads converter;
+    SkPath::Iter iter{path, /*forceClose=*/true};
+    SkPoint pts[4];
+    for (SkPath::Verb verb; (verb = iter.next(pts)) != SkPath::kDone_Verb;) {
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                if (contours.empty() || !contours.back().empty()) {
+                    contours.push_back();
+                }
+                break;
+            case SkPath::kLine_Verb:
+                add_line(&contours.back(), pts[0], pts[1]);
+                break;
+            case SkPath::kQuad_Verb:
+                add_quad(&contours.back(), pts);
+                break;
+            case SkPath::kConic_Verb: {
+                const SkPoint* quads = converter.computeQuads(pts, iter.conicWeight(), 0.25f);
+                for (int i = 0; i < converter.countQuads(); ++i) {
+                    add_quad(&contours.back(), quads + 2 * i);
+                }
+                break;
+            }
+            case SkPath::kCubic_Verb:
+                add_cubic(&contours.back(), pts[0], pts[1], pts[2], pts[3]);
+                break;
+            default:
+                break;
+        }
+    }
+    if (!contours.empty() && contours.back().empty()) {
+        contours.pop_back();
+    }
+    return contours;
+}
+
+bool is_corner(SkVector a, SkVector b, float crossThreshold) {
+    return dot(a, b) <= 0 || std::fabs(cross(a, b)) > crossThreshold;
+}
+
+// Move color on to the next pair of channels. If color and banned share a single channel, use
+// the pair that doesn't have it instead.
+void switch_color(uint8_t* color, uint8_t banned = kBlack) {
+    const uint8_t combined = *color & banned;
+    if (combined == kRed || combined == kGreen || combined == kBlue) {
+        *color = combined ^ kWhite;
+        return;
+    }
+    if (*color == kBlack || *color == kWhite) {
+        *color = kCyan;
+        return;
+    }
+    const int shifted = *color << 1;
+    *color = (shifted | shifted >> 3) & kWhite;
+}
+
+// Give each edge two or three channels so that the edges meeting at a corner share only one.
+void color_edges(Contour* contour) {
+    // Directions that turn by more than this many radians are corners.
+    static const float kCrossThreshold = std::sin(3.0f);
+
+    STArray<16, int> corners;
+    SkVector prevDirection = contour->back().direction(1);
+    for (int i = 0; i < contour->size(); ++i) {
+        const Edge& edge = (*contour)[i];
+        if (is_corner(unit(prevDirection), unit(edge.direction(0)), kCrossThreshold)) {
+            corners.push_back(i);
+        }
+        prevDirection = edge.direction(1);
+    }
+
+    if (corners.empty()) {
+        // Smooth contours only need the one channel.
+        for (Edge& edge : *contour) {
+            edge.fColor = kWhite;
+        }
+    } else if (corners.size() == 1) {
+        // A teardrop. Spread three colors out around it so the corner is between two of them.
+        uint8_t colors[3] = {kWhite, kWhite, kBlack};
+        switch_color(&colors[0]);
+        colors[2] = colors[0];
+        switch_color(&colors[2]);
+        const int corner = corners[0];
+        const int count = contour->size();
+        if (count >= 3) {
+            for (int i = 0; i < count; ++i) {
+                const int third = (int)(3 + 2.875f * i / (count - 1) - 1.4375f + 0.5f) - 3;
+                (*contour)[(corner + i) % count].fColor = colors[1 + third];
+            }
+        } else {
+            // Too few edges to spread three colors over, so split them into thirds.
+            Edge parts[6];
+            (*contour)[0].splitInThirds(parts + 3 * corner);
+            if (count == 2) {
+                (*contour)[1].splitInThirds(parts + 3 - 3 * corner);
+                parts[0].fColor = parts[1].fColor = colors[0];
+                parts[2].fColor = parts[3].fColor = colors[1];
+                parts[4].fColor = parts[5].fColor = colors[2];
+            } else {
+                parts[0].fColor = colors[0];
+                parts[1].fColor = colors[1];
+                parts[2].fColor = colors[2];
+            }
+            contour->clear();
+            contour->push_back_n(3 * count, parts);
+        }
+    } else {
+        // Change color at each corner, without giving the last spline the first one's color.
+        const int cornerCount = corners.size();
+        const int start = corners[0];
+        const int count = contour->size();
+        int spline = 0;
+        uint8_t color = kWhite;
+        switch_color(&color);
+        const uint8_t initialColor = color;
+        for (int i = 0; i < count; ++i) {
+            const int index = (start + i) % count;
+            if (spline + 1 < cornerCount && corners[spline + 1] == index) {
+                ++spline;
+                switch_color(&color, spline == cornerCount - 1 ? initialColor : uint8_t{kBlack});
+            }
+            (*contour)[index].fColor = color;
+        }
+    }
+}
+
+struct Texel {
+    float fChannels[3];
+    float fTrue;
+};
+
+float median(float a, float b, float c) {
+    return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+// Interpolating between texels a and b may make an artifact if two of the channels change by
+// more than threshold in the same direction while the third does not. Only flag the one of a
+// and b which is farther from the outline.
+bool detect_clash(const Texel& a, const Texel& b, float threshold) {
+    float a0 = a.fChannels[0], a1 = a.fChannels[1], a2 = a.fChannels[2];
+    float b0 = b.fChannels[0], b1 = b.fChannels[1], b2 = b.fChannels[2];
+    // Sort the channels from the largest change to the smallest.
+    if (std::fabs(b1 - a1) < std::fabs(b0 - a0)) {
+        std::swap(a0, a1);
+        std::swap(b0, b1);
+    }
+    if (std::fabs(b2 - a2) < std::fabs(b1 - a1)) {
+        std::swap(a1, a2);
+        std::swap(b1, b2);
+        if (std::fabs(b1 - a1) < std::fabs(b0 - a0)) {
+            std::swap(a0, a1);
+            std::swap(b0, b1);
+        }
+    }
+    return std::fabs(b1 - a1) >= threshold &&
+           !(b0 == b1 && b0 == b2) &&  // b has already been flattened.
+           std::fabs(a2) >= std::fabs(b2);
+}
+
+// The same encoding as the single channel distance fields, except that distance is positive
+// inside.
+uint8_t pack_distance(float distance) {
+    constexpr float kMagnitude = SK_DistanceFieldMagnitude;
+    distance = SkTPin(distance, -kMagnitude, kMagnitude * 127.0f / 128.0f);
+    return (uint8_t)SkScalarRoundToInt((distance + kMagnitude) / (2 * kMagnitude) * 256.0f);
+}
+}  // namespace
+
+bool SkGenerateMultiChannelDistanceField(uint8_t* distanceField,
+                                         const SkPath& path, const SkMatrix& matrix,
+                                         int width, int height, size_t rowBytes) {
+    SkASSERT(distanceField);
+    if (width <= 0 || height <= 0 || rowBytes < 4 * (size_t)width) {
+        return false;
+    }
+    const SkPath transformed = path.makeTransform(matrix);
+    if (!transformed.isFinite()) {
+        return false;
+    }
+
+    TArray<Contour> contours = contours_from_path(transformed);
+    for (Contour& contour : contours) {
+        color_edges(&contour);
+    }
+
+    const int texelCount = width * height;
+    std::unique_ptr<Texel[]> texels{new Texel[texelCount]};
+    std::unique_ptr<bool[]> inside{new bool[texelCount]};
+    int agree = 0, disagree = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const SkPoint p = {x + 0.5f, y + 0.5f};
+            SignedDistance channelMin[3], trueMin;
+            const Edge* channelEdge[3] = {nullptr, nullptr, nullptr};
+            float channelT[3] = {0, 0, 0};
+            for (const Contour& contour : contours) {
+                for (const Edge& edge : contour) {
+                    float t;
+                    const SignedDistance distance = edge.signedDistance(p, &t);
+                    if (distance < trueMin) {
+                        trueMin = distance;
+                    }
+                    for (int c = 0; c < 3; ++c) {
+                        if ((edge.fColor & (1 << c)) && distance < channelMin[c]) {
+                            channelMin[c] = distance;
+                            channelEdge[c] = &edge;
+                            channelT[c] = t;
+                        }
+                    }
+                }
+            }
+
+            const int index = y * width + x;
+            Texel& texel = texels[index];
+            for (int c = 0; c < 3; ++c) {
+                if (channelEdge[c] != nullptr) {
+                    channelEdge[c]->toPseudoDistance(&channelMin[c], p, channelT[c]);
+                    texel.fChannels[c] = channelMin[c].fDistance;
+                } else {
+                    texel.fChannels[c] = trueMin.fDistance;
+                }
+            }
+            texel.fTrue = trueMin.fDistance;
+
+            inside[index] = transformed.contains(p.fX, p.fY);
+            if (std::isfinite(texel.fTrue)) {
+                (texel.fTrue > 0) == inside[index] ? ++agree : ++disagree;
+            }
+        }
+    }
+
+    // Which side of an edge is inside depends on the orientation of the contours, so use the
+    // orientation that agrees with the fill for most of the texels. Then fix the sign of texels
+    // whose median still disagrees with the fill, which happens where contours overlap.
+    const float sign = agree >= disagree ? 1 : -1;
+    for (int i = 0; i < texelCount; ++i) {
+        Texel& texel = texels[i];
+        for (float& channel : texel.fChannels) {
+            channel *= sign;
+        }
+        const float distance = median(texel.fChannels[0], texel.fChannels[1],
+                                      texel.fChannels[2]);
+        if (distance != 0 && (distance > 0) != inside[i]) {
+            for (float& channel : texel.fChannels) {
+                channel = -channel;
+            }
+        }
+        texel.fTrue = inside[i] ? std::fabs(texel.fTrue) : -std::fabs(texel.fTrue);
+    }
+
+    // The distance between neighbors can't change by more than a texel, so a bigger change
+    // in two channels is an artifact. Flatten those texels to their median.
+    static constexpr float kClashThreshold = 1.001f;
+    std::unique_ptr<bool[]> clashes{new bool[texelCount]()};
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const int index = y * width + x;
+            const Texel& texel = texels[index];
+            clashes[index] =
+                    (x > 0          && detect_clash(texel, texels[index - 1], kClashThreshold)) ||
+                    (x < width - 1  && detect_clash(texel, texels[index + 1], kClashThreshold)) ||
+                    (y > 0          && detect_clash(texel, texels[index - width],
+                                                    kClashThreshold)) ||
+                    (y < height - 1 && detect_clash(texel, texels[index + width],
+                                                    kClashThreshold));
+        }
+    }
+    for (int i = 0; i < texelCount; ++i) {
+        if (clashes[i]) {
+            Texel& texel = texels[i];
+            const float distance = median(texel.fChannels[0], texel.fChannels[1],
+                                          texel.fChannels[2]);
+            std::fill_n(texel.fChannels, 3, distance);
+        }
+    }
+
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = distanceField + y * rowBytes;
+        for (int x = 0; x < width; ++x) {
+            const Texel& texel = texels[y * width + x];
+            row[4 * x + 0] = pack_distance(texel.fChannels[0]);
+            row[4 * x + 1] = pack_distance(texel.fChannels[1]);
+            row[4 * x + 2] = pack_distance(texel.fChannels[2]);
+            row[4 * x + 3] = pack_distance(texel.fTrue);
+        }
+    }
+    return true;
+}
+
+void SkGenerateMultiChannelDistanceFields(SkSpan<SkMultiChannelDistanceFieldJob> jobs,
+                                          SkExecutor* executor) {
+    auto generate = [jobs](int i) {
+        SkMultiChannelDistanceFieldJob& job = jobs[i];
+        job.fSucceeded = SkGenerateMultiChannelDistanceField(job.fDistanceField, *job.fPath,
+                                                             job.fMatrix, job.fWidth,
+                                                             job.fHeight, job.fRowBytes);
+    };
+    if (executor == nullptr) {
+        for (int i = 0; i < SkToInt(jobs.size()); ++i) {
+            generate(i);
+        }
+        return;
+    }
+    SkTaskGroup group{*executor};
+    group.batch(SkToInt(jobs.size()), generate);
+    group.wait();
+}
+
+#endif // !defined(SK_DISABLE_SDF_TEXT)
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMultiChannelDistanceField_DEFINED
+#define SkMultiChannelDistanceField_DEFINED
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkSpan.h"
+#include "include/core/SkTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(SK_DISABLE_SDF_TEXT)
+
+class SkExecutor;
+class SkPath;
+
+// A multi-channel signed distance field keeps the corners of an outline sharp when it is
+// magnified. Each edge of the outline is given two of the three color channels, so that at
+// a corner the two edges share just one channel. Each channel holds the distance to the
+// nearest edge of its color, and the median of the three channels is the distance to the
+// outline. Corners are then kept sharp because no single channel has to round them off.
+//
+// The fields are 4 bytes per texel. R, G and B hold the multi-channel field and A holds the
+// true distance, which a shader can use for effects that need it, like outlines. Every channel
+// is encoded like SkGenerateDistanceFieldFromA8Image encodes its field: 128 is on the outline,
+// larger values are inside, and the range is SK_DistanceFieldMagnitude texels each way.
+
+/** Given a path, generate the associated multi-channel distance field.
+
+ *  @param distanceField     The distance field to be generated. Should already be allocated
+ *                           by the client, 4 bytes per texel.
+ *  @param path              The path we're using to generate the distance field.
+ *  @param matrix            Maps the path into the distance field. This should include the
+ *                           SK_DistanceFieldPad offset if the path's bounds are the glyph's.
+ *  @param width             Width of the distance field.
+ *  @param height            Height of the distance field.
+ *  @param rowBytes          Size of each row in the distance field, in bytes.
+ */
+bool SkGenerateMultiChannelDistanceField(uint8_t* distanceField,
+                                         const SkPath& path, const SkMatrix& matrix,
+                                         int width, int height, size_t rowBytes);
+
+struct SkMultiChannelDistanceFieldJob {
+    const SkPath* fPath;
+    SkMatrix fMatrix;
+    int fWidth;
+    int fHeight;
+    uint8_t* fDistanceField;
+    size_t fRowBytes;
+    // Set by SkGenerateMultiChannelDistanceFields.
+    bool fSucceeded = false;
+};
+
+/** Generate the distance fields for all the jobs. If executor is not null, the jobs are run on
+ *  it and this returns once they are all done, otherwise they are run on the calling thread.
+ */
+void SkGenerateMultiChannelDistanceFields(SkSpan<SkMultiChannelDistanceFieldJob> jobs,
+                                          SkExecutor* executor);
+
+#endif // !defined(SK_DISABLE_SDF_TEXT)
+
+#endif
@@ -18,6 +18,7 @@
 #include "include/private/base/SkTo.h"
 #include "src/base/SkTSort.h"
 #include "src/core/SkAlphaRuns.h"
+#include "src/core/SkAlphaSpans.h"
 #include "src/core/SkAnalyticEdge.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkEdge.h"
@@ -88,6 +89,8 @@ number of scan lines in our algorithm is only about 3 + H while the
 
 */
 
+// Since the sums here are at most 0x100, which CatchOverflow clamps to 0xFF, the spans of them are
+// added with SkAlphaSpans::SaturatedAdd.
 static void add_alpha(SkAlpha* alpha, SkAlpha delta) {
     SkASSERT(*alpha + delta <= 256);
     *alpha = SkAlphaRuns::CatchOverflow(*alpha + delta);
@@ -237,10 +240,7 @@ void MaskAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
 
 void MaskAdditiveBlitter::blitAntiH(int x, int y, int width, const SkAlpha alpha) {
     SkASSERT(x >= fMask.fBounds.fLeft - 1);
-    uint8_t* row = this->getRow(y);
-    for (int i = 0; i < width; ++i) {
-        add_alpha(&row[x + i], alpha);
-    }
+    SkAlphaSpans::SaturatedAdd(this->getRow(y) + x, alpha, width);
 }
 
 void MaskAdditiveBlitter::blitV(int x, int y, int height, SkAlpha alpha) {
@@ -424,9 +424,7 @@ void RunBasedAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha antialias[],
         }
         fRuns.fRuns[x + i] = 1;
     }
-    for (int i = 0; i < len; ++i) {
-        add_alpha(&fRuns.fAlpha[x + i], antialias[i]);
-    }
+    SkAlphaSpans::SaturatedAdd(fRuns.fAlpha + x, antialias, len);
 }
 
 void RunBasedAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
@@ -494,9 +492,7 @@ void SafeRLEAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha antialias[],
         }
         fRuns.fRuns[x + i] = 1;
     }
-    for (int i = 0; i < len; ++i) {
-        safely_add_alpha(&fRuns.fAlpha[x + i], antialias[i]);
-    }
+    SkAlphaSpans::SaturatedAdd(fRuns.fAlpha + x, antialias, len);
 }
 
 void SafeRLEAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
@@ -605,10 +601,7 @@ static void compute_alpha_above_line(SkAlpha* alphas,
         SkFixed firstH  = SkFixedMul(first, dY);  // vertical edge of the left-most triangle
         alphas[0]       = SkFixedMul(first, firstH) >> 9;  // triangle alpha
         SkFixed alpha16 = firstH + (dY >> 1);              // rectangle plus triangle
-        for (int i = 1; i < R - 1; ++i) {
-            alphas[i] = alpha16 >> 8;
-            alpha16 += dY;
-        }
+        SkAlphaSpans::FillRamp(alphas + 1, R - 2, alpha16, dY);
         alphas[R - 1] = fullAlpha - partial_triangle_to_alpha(last, dY);
     }
 }
@@ -632,10 +625,8 @@ static void compute_alpha_below_line(SkAlpha* alphas,
         SkFixed lastH   = SkFixedMul(last, dY);          // vertical edge of the right-most triangle
         alphas[R - 1]   = SkFixedMul(last, lastH) >> 9;  // triangle alpha
         SkFixed alpha16 = lastH + (dY >> 1);             // rectangle plus triangle
-        for (int i = R - 2; i > 0; i--) {
-            alphas[i] = (alpha16 >> 8) & 0xFF;
-            alpha16 += dY;
-        }
+        // The ramp runs from right to left, so fill it from alphas[1] going down.
+        SkAlphaSpans::FillRamp(alphas + 1, R - 2, alpha16 + (R - 3) * dY, -dY);
         alphas[0] = fullAlpha - partial_triangle_to_alpha(first, dY);
     }
 }
@@ -692,9 +683,7 @@ static void blit_full_alpha(AdditiveBlitter* blitter,
                             SkAlpha* maskRow,
                             bool noRealBlitter) {
     if (maskRow) {
-        for (int i = 0; i < len; ++i) {
-            safely_add_alpha(&maskRow[x + i], fullAlpha);
-        }
+        SkAlphaSpans::SaturatedAdd(maskRow + x, fullAlpha, len);
     } else {
         if (fullAlpha == 0xFF && !noRealBlitter) {
             blitter->getRealBlitter()->blitH(x, y, len);
@@ -737,11 +726,9 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter,
     SkAlpha* tempAlphas = alphas + len + 1;
     int16_t* runs       = (int16_t*)(alphas + (len + 1) * 2);
 
-    for (int i = 0; i < len; ++i) {
-        runs[i]   = 1;
-        alphas[i] = fullAlpha;
-    }
+    std::fill_n(runs, len, 1);
     runs[len] = 0;
+    memset(alphas, fullAlpha, len);
 
     int uL = SkFixedFloorToInt(ul);
     int lL = SkFixedCeilToInt(ll);
@@ -755,13 +742,7 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter,
     } else {
         compute_alpha_below_line(
                 tempAlphas + uL - L, ul - SkIntToFixed(uL), ll - SkIntToFixed(uL), lDY, fullAlpha);
-        for (int i = uL; i < lL; ++i) {
-            if (alphas[i - L] > tempAlphas[i - L]) {
-                alphas[i - L] -= tempAlphas[i - L];
-            } else {
-                alphas[i - L] = 0;
-            }
-        }
+        SkAlphaSpans::SaturatedSubtract(alphas + uL - L, tempAlphas + uL - L, lL - uL);
     }
 
     int uR = SkFixedFloorToInt(ur);
@@ -776,19 +757,11 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter,
     } else {
         compute_alpha_above_line(
                 tempAlphas + uR - L, ur - SkIntToFixed(uR), lr - SkIntToFixed(uR), rDY, fullAlpha);
-        for (int i = uR; i < lR; ++i) {
-            if (alphas[i - L] > tempAlphas[i - L]) {
-                alphas[i - L] -= tempAlphas[i - L];
-            } else {
-                alphas[i - L] = 0;
-            }
-        }
+        SkAlphaSpans::SaturatedSubtract(alphas + uR - L, tempAlphas + uR - L, lR - uR);
     }
 
     if (maskRow) {
-        for (int i = 0; i < len; ++i) {
-            safely_add_alpha(&maskRow[L + i], alphas[i]);
-        }
+        SkAlphaSpans::SaturatedAdd(maskRow + L, alphas, len);
     } else {
         if (fullAlpha == 0xFF && !noRealBlitter) {
             // Real blitter is faster than RunBasedAdditiveBlitter
@@ -0,0 +1,875 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkSpan.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTPin.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkGeometry.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkScan.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+/*
+
+The sparse strip rasterizer is an alternative to the analytic AA scan converter in
+SkScan_AAAPath.cpp for very complex fills, like large glyphs and maps. Instead of keeping a sorted
+list of active edges and walking it scanline by scanline, it works in three passes:
+
+1. The path is flattened into lines, which are clipped to the bounds being drawn.
+
+2. Each line is split into pieces at the boundaries of the kTileSize x kTileSize tiles it
+   touches, and the (tile, piece) pairs are sorted by tile row, then tile column, using a single
+   sort of 64-bit keys.
+
+3. Each tile row is swept from left to right. The lines in a tile accumulate the signed area they
+   cover into a small buffer. A prefix sum across the buffer gives the winding number of every
+   pixel, and the winding at the right edge of the tile carries into the next tile. Between two
+   touched tiles there are no lines, so the carried winding fills the whole gap as one run.
+
+The result of each pixel row is a strip of anti-aliased pixels for the touched tiles and single
+runs for the gaps, which is handed to SkBlitter::blitAntiH. The amount of work depends on the
+number of tiles touched by lines, not the area of the path.
+
+The sum of the areas only gives the coverage of a pixel if the winding inside the pixel takes at
+most two consecutive values, like 0 and 1 (or, for nonzero fills, only nonzero values). Where more
+regions meet inside a pixel, e.g. 1, 0 and -1 at a self-intersection of a nonzero fill, it doesn't.
+To find those pixels, the integer winding is also tracked at kSampleRows rows of samples per pixel
+row. Wherever it takes values the areas can't resolve, the coverage of the pixel is computed from
+the sample rows instead, each contributing the exact extent of its filled spans.
+
+*/
+
+namespace {
+
+constexpr int kTileSize = 4;
+// The rows of samples per pixel row, for pixels the areas can't resolve.
+constexpr int kSampleRows = 16;
+constexpr int kTileSampleRows = kTileSize * kSampleRows;
+// The maximum distance between a curve and the lines approximating it, in pixels.
+constexpr float kFlatteningTolerance = 1.f / 16;
+constexpr int kMaxFlatteningSteps = 1024;
+
+struct Line {
+    SkPoint p0;
+    SkPoint p1;
+};
+
+// A line crossing the sample rows [first, end), with its x at sample row k = 0.
+struct Edge {
+    float x0, dxdk;
+    int first, end, direction;
+
+    float x(int k) const { return x0 + k * dxdk; }
+};
+
+// Split the line p0 -> p1 where it crosses the vertical lines at x = left and x = right, and call
+// emit for each piece with the piece and its mid point x.
+template <typename Fn>
+void split_at_x(SkPoint p0, SkPoint p1, float left, float right, Fn&& emit) {
+    float ts[2];
+    int count = 0;
+    for (float x : {left, right}) {
+        if ((p0.fX < x && x < p1.fX) || (p1.fX < x && x < p0.fX)) {
+            ts[count++] = (x - p0.fX) / (p1.fX - p0.fX);
+        }
+    }
+    if (count == 2 && ts[0] > ts[1]) {
+        std::swap(ts[0], ts[1]);
+    }
+
+    SkPoint start = p0;
+    for (int i = 0; i < count; ++i) {
+        const SkPoint end = {p0.fX + ts[i] * (p1.fX - p0.fX), p0.fY + ts[i] * (p1.fY - p0.fY)};
+        emit(start, end);
+        start = end;
+    }
+    emit(start, p1);
+}
+
+// Clip the line p0 -> p1 to top <= y <= bottom. Returns false if nothing is left.
+bool clip_to_y(SkPoint* p0, SkPoint* p1, float top, float bottom) {
+    if ((p0->fY <= top && p1->fY <= top) || (p0->fY >= bottom && p1->fY >= bottom)) {
+        return false;
+    }
+    const float dxdy = (p1->fX - p0->fX) / (p1->fY - p0->fY);
+    for (SkPoint* p : {p0, p1}) {
+        if (p->fY < top) {
+            *p = {p->fX + (top - p->fY) * dxdy, top};
+        } else if (p->fY > bottom) {
+            *p = {p->fX + (bottom - p->fY) * dxdy, bottom};
+        }
+    }
+    return p0->fY != p1->fY;
+}
+
+// The integral of clamp(s, 0, 1) from -infinity to t.
+float integral_of_clamp(float t) {
+    if (t <= 0) {
+        return 0;
+    }
+    if (t < 1) {
+        return 0.5f * t * t;
+    }
+    return t - 0.5f;
+}
+
+class SparseStripRasterizer {
+public:
+    SparseStripRasterizer(const SkIRect& bounds, SkPathFillType fillType)
+            : fBounds{bounds}
+            , fWidth{bounds.width()}
+            , fHeight{bounds.height()}
+            , fEvenOdd{SkPathFillType_IsEvenOdd(fillType)}
+            , fInverse{SkPathFillType_IsInverse(fillType)} {}
+
+    void addPath(const SkPath& path);
+    void blit(SkBlitter* blitter);
+
+private:
+    // The run-length encoded coverage of one pixel row, in the format used by blitAntiH.
+    struct Row {
+        SkAlpha* alphas;
+        int16_t* runs;
+        int      x = 0;
+        int      lastRun = -1;
+        bool     hasCoverage = false;
+
+        void reset(SkAlpha* a, int16_t* r) {
+            alphas = a;
+            runs = r;
+            x = 0;
+            lastRun = -1;
+            hasCoverage = false;
+        }
+
+        void append(SkAlpha alpha, int count) {
+            SkASSERT(count > 0);
+            if (lastRun >= 0 && alphas[lastRun] == alpha && runs[lastRun] + count <= SK_MaxS16) {
+                runs[lastRun] += count;
+            } else {
+                lastRun = x;
+                alphas[x] = alpha;
+                runs[x] = SkToS16(count);
+            }
+            x += count;
+            hasCoverage |= alpha != 0;
+        }
+    };
+
+    void addLine(SkPoint p0, SkPoint p1);
+    void addQuad(const SkPoint pts[3]);
+    void addCubic(const SkPoint pts[4]);
+    void binLine(SkPoint p0, SkPoint p1);
+    void accumulateLine(const Line& line);
+
+    // The winding at the sample rows of the left and right edges of the current tile.
+    void resetLeftWinding();
+    void findRightWinding(SkSpan<const Line* const> lines);
+    void advanceLeftWinding();
+    void leftWinding(int r, int winding[kSampleRows]) const;
+    // Find the rows of pixels of the current tile where the winding may take values the areas
+    // can't resolve.
+    void findMayMix(SkSpan<const Line* const> lines, bool mayMix[kTileSize]) const;
+    // Whether the sum of the areas gives the coverage of a pixel with windings in [lo, hi].
+    bool areasResolve(int lo, int hi) const {
+        return hi - lo <= 1 || (!fEvenOdd && (lo >= 1 || hi <= -1));
+    }
+    // Whether the areas resolve all the pixels of row r of the current tile, found without
+    // sampling.
+    bool bandsResolve(int r, SkSpan<const Edge> edges) const;
+    // Replace the alphas of the pixels of row r of the current tile where the winding takes values
+    // the areas can't resolve with their sampled coverage.
+    void resolveMixedWindings(int r, SkSpan<const Line* const> lines,
+                              SkAlpha alphas[kTileSize]) const;
+    // The alpha of the pixels of row r left of the current tile, with the given mean winding.
+    SkAlpha gapAlpha(int r, float winding) const;
+
+    bool isFilled(int winding) const { return fEvenOdd ? (winding & 1) : winding != 0; }
+    SkAlpha coverageToAlpha(float coverage) const;
+    SkAlpha windingToAlpha(float winding) const;
+
+    const SkIRect fBounds;
+    const int fWidth;
+    const int fHeight;
+    const bool fEvenOdd;
+    const bool fInverse;
+
+    // The pieces of the lines in each tile, relative to the tile.
+    skia_private::TArray<Line> fLines;
+    // (tile row << 48) | (tile column << 32) | line index
+    skia_private::TArray<uint64_t> fTileKeys;
+
+    // The winding along an edge of a tile only changes where edges of the path cross it, so it is
+    // kept as the changes from one sample row to the next, sorted by sample row, and its range in
+    // each row of pixels.
+    struct WindingStep {
+        int k;
+        int delta;
+    };
+    struct EdgeWinding {
+        skia_private::TArray<WindingStep> fSteps;
+        int fMin[kTileSize];
+        int fMax[kTileSize];
+    };
+    EdgeWinding fLeftWinding;
+    EdgeWinding fRightWinding;
+    skia_private::TArray<WindingStep> fLineSteps;
+
+    // The area covered by the lines of the current tile, for each pixel row, with an extra
+    // column that collects the winding leaving the right edge of the tile.
+    float fAccumulation[kTileSize][kTileSize + 1];
+};
+
+void SparseStripRasterizer::addPath(const SkPath& path) {
+    const SkPoint origin = {SkIntToScalar(fBounds.fLeft), SkIntToScalar(fBounds.fTop)};
+    SkPathEdgeIter iter(path);
+    while (auto e = iter.next()) {
+        SkPoint pts[4];
+        const int count = SkPathPriv::PtsInIter(SkPathEdgeIter::EdgeToVerb(e.fEdge));
+        for (int i = 0; i < count; ++i) {
+            pts[i] = e.fPts[i] - origin;
+        }
+        switch (e.fEdge) {
+            case SkPathEdgeIter::Edge::kLine:
+                this->addLine(pts[0], pts[1]);
+                break;
+            case SkPathEdgeIter::Edge::kQuad:
+                this->addQuad(pts);
+                break;
+            case SkPathEdgeIter::Edge::kConic: {
+                // Leave most of the tolerance to the flattening of the quads.
+                SkAutoConicToQuads quadder;
+                const SkPoint* quadPts =
+                        quadder.computeQuads(pts, iter.conicWeight(), kFlatteningTolerance / 4);
+                for (int i = 0; i < quadder.countQuads(); ++i) {
+                    this->addQuad(quadPts + 2 * i);
+                }
+                break;
+            }
+            case SkPathEdgeIter::Edge::kCubic:
+                this->addCubic(pts);
+                break;
+        }
+    }
+
+    std::sort(fTileKeys.begin(), fTileKeys.end());
+}
+
+// Wang's formula gives the number of lines needed to keep a curve within the tolerance.
+static int flattening_steps(float degreeFactor, float maxSecondDifference) {
+    const float steps = std::ceil(std::sqrt(degreeFactor * maxSecondDifference /
+                                            kFlatteningTolerance));
+    if (!(steps < kMaxFlatteningSteps)) {
+        return kMaxFlatteningSteps;
+    }
+    return std::max(1, (int)steps);
+}
+
+void SparseStripRasterizer::addQuad(const SkPoint pts[3]) {
+    const int steps = flattening_steps(2.f / 8, (pts[0] - pts[1] * 2 + pts[2]).length());
+    SkPoint p0 = pts[0];
+    for (int i = 1; i < steps; ++i) {
+        const SkPoint p1 = SkEvalQuadAt(pts, (float)i / steps);
+        this->addLine(p0, p1);
+        p0 = p1;
+    }
+    this->addLine(p0, pts[2]);
+}
+
+void SparseStripRasterizer::addCubic(const SkPoint pts[4]) {
+    const float d = std::max((pts[0] - pts[1] * 2 + pts[2]).length(),
+                             (pts[1] - pts[2] * 2 + pts[3]).length());
+    const int steps = flattening_steps(6.f / 8, d);
+    SkPoint p0 = pts[0];
+    for (int i = 1; i < steps; ++i) {
+        SkPoint p1;
+        SkEvalCubicAt(pts, (float)i / steps, &p1, nullptr, nullptr);
+        this->addLine(p0, p1);
+        p0 = p1;
+    }
+    this->addLine(p0, pts[3]);
+}
+
+void SparseStripRasterizer::addLine(SkPoint p0, SkPoint p1) {
+    // Horizontal lines do not change the winding.
+    if (!clip_to_y(&p0, &p1, 0, fHeight)) {
+        return;
+    }
+
+    // The part of a line to the left of the bounds still changes the winding of every pixel to its
+    // right, so it is moved onto the left edge. The part to the right can not be seen.
+    const float width = fWidth;
+    split_at_x(p0, p1, 0, width, [&](SkPoint a, SkPoint b) {
+        const float midX = 0.5f * (a.fX + b.fX);
+        if (midX < 0) {
+            a.fX = b.fX = 0;
+        } else if (midX >= width) {
+            return;
+        }
+        this->binLine({SkTPin(a.fX, 0.f, width), a.fY}, {SkTPin(b.fX, 0.f, width), b.fY});
+    });
+}
+
+void SparseStripRasterizer::binLine(SkPoint p0, SkPoint p1) {
+    const float top = std::min(p0.fY, p1.fY),
+                bottom = std::max(p0.fY, p1.fY);
+    const int lastColumn = (fWidth - 1) / kTileSize;
+
+    auto addPiece = [&](SkPoint a, SkPoint b, int row) {
+        // A piece on the boundary between two tiles belongs to the tile on its right.
+        const int column = (int)(0.5f * (a.fX + b.fX) / kTileSize);
+        if (column > lastColumn) {
+            return;
+        }
+        const SkPoint origin = {(float)(column * kTileSize), (float)(row * kTileSize)};
+        fTileKeys.push_back((uint64_t)row << 48 | (uint64_t)column << 32 | (uint32_t)fLines.size());
+        fLines.push_back({a - origin, b - origin});
+    };
+
+    const int firstRow = (int)(top / kTileSize),
+              lastRow = std::min((int)std::ceil(bottom / kTileSize) - 1, (fHeight - 1) / kTileSize);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        SkPoint a = p0,
+                b = p1;
+        if (!clip_to_y(&a, &b, row * kTileSize, (row + 1) * kTileSize)) {
+            continue;
+        }
+
+        // Split the line where it crosses the column boundaries, in the order of the line.
+        const float lo = std::min(a.fX, b.fX),
+                    hi = std::max(a.fX, b.fX);
+        const int firstBoundary = (int)(lo / kTileSize) + 1,
+                  endBoundary = (int)std::ceil(hi / kTileSize);
+        SkPoint start = a;
+        for (int i = firstBoundary; i < endBoundary; ++i) {
+            const int boundary = a.fX < b.fX ? i : firstBoundary + endBoundary - 1 - i;
+            const float x = (float)(boundary * kTileSize),
+                        t = (x - a.fX) / (b.fX - a.fX);
+            const SkPoint end = {x, a.fY + t * (b.fY - a.fY)};
+            addPiece(start, end, row);
+            start = end;
+        }
+        addPiece(start, b, row);
+    }
+}
+
+void SparseStripRasterizer::accumulateLine(const Line& line) {
+    SkPoint a = line.p0,
+            b = line.p1;
+    const float direction = a.fY < b.fY ? 1 : -1;
+    if (a.fY > b.fY) {
+        std::swap(a, b);
+    }
+
+    const float dxdy = (b.fX - a.fX) / (b.fY - a.fY);
+    const int firstRow = std::max(0, (int)a.fY),
+              lastRow = std::min(kTileSize - 1, (int)std::ceil(b.fY) - 1);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        const float y0 = std::max(a.fY, (float)row),
+                    y1 = std::min(b.fY, (float)(row + 1));
+        if (y0 >= y1) {
+            continue;
+        }
+        const float x0 = a.fX + (y0 - a.fY) * dxdy,
+                    x1 = a.fX + (y1 - a.fY) * dxdy;
+        const float cover = direction * (y1 - y0);
+
+        // The coverage of the pixels up to and including column c is the average, over the part
+        // of the line in this row, of how much of the row right of the line is left of c + 1.
+        const float lo = std::min(x0, x1),
+                    hi = std::max(x0, x1);
+        float* accumulation = fAccumulation[row];
+        float previous = 0;
+        for (int c = 0; c < kTileSize; ++c) {
+            float area;
+            if (hi - lo < 1e-6f) {
+                area = SkTPin(c + 1 - 0.5f * (lo + hi), 0.f, 1.f);
+            } else {
+                area = (integral_of_clamp(c + 1 - lo) - integral_of_clamp(c + 1 - hi)) / (hi - lo);
+            }
+            accumulation[c] += cover * area - previous;
+            previous = cover * area;
+        }
+        accumulation[kTileSize] += cover - previous;
+    }
+}
+
+// The sample rows [firstRow, endRow) crossed by the line, where sample row k is at
+// y = (k + 0.5) / kSampleRows. A line crosses the rows below its top, down to and including its
+// bottom, so lines meeting end to end cross each row once. Returns the direction of the line.
+static int sample_rows(const Line& line, int* firstRow, int* endRow) {
+    const float y0 = std::min(line.p0.fY, line.p1.fY),
+                y1 = std::max(line.p0.fY, line.p1.fY);
+    // The tile relative y is never negative, so the casts round down.
+    *firstRow = (int)(y0 * kSampleRows + 0.5f);
+    *endRow = std::min(kTileSampleRows, (int)(y1 * kSampleRows + 0.5f));
+    return line.p0.fY < line.p1.fY ? 1 : -1;
+}
+
+void SparseStripRasterizer::resetLeftWinding() {
+    fLeftWinding.fSteps.clear();
+    std::fill(std::begin(fLeftWinding.fMin), std::end(fLeftWinding.fMin), 0);
+    std::fill(std::begin(fLeftWinding.fMax), std::end(fLeftWinding.fMax), 0);
+}
+
+void SparseStripRasterizer::findRightWinding(SkSpan<const Line* const> lines) {
+    // Each line changes the winding over its sample rows. Where lines meet end to end, like at
+    // the vertices of the path or where it crosses into the next tile, the changes cancel.
+    fLineSteps.clear();
+    for (const Line* line : lines) {
+        int first, end;
+        const int direction = sample_rows(*line, &first, &end);
+        if (first < end) {
+            fLineSteps.push_back({first, direction});
+            fLineSteps.push_back({end, -direction});
+        }
+    }
+    auto byRow = [](const WindingStep& a, const WindingStep& b) { return a.k < b.k; };
+    std::sort(fLineSteps.begin(), fLineSteps.end(), byRow);
+
+    // Merge them into the changes along the left edge, which are already sorted.
+    skia_private::TArray<WindingStep>& steps = fRightWinding.fSteps;
+    steps.clear();
+    auto add = [&](const WindingStep& step) {
+        if (!steps.empty() && steps.back().k == step.k) {
+            steps.back().delta += step.delta;
+            if (steps.back().delta == 0) {
+                steps.pop_back();
+            }
+        } else {
+            steps.push_back(step);
+        }
+    };
+    int j = 0;
+    for (const WindingStep& step : fLeftWinding.fSteps) {
+        for (; j < fLineSteps.size() && byRow(fLineSteps[j], step); ++j) {
+            add(fLineSteps[j]);
+        }
+        add(step);
+    }
+    for (; j < fLineSteps.size(); ++j) {
+        add(fLineSteps[j]);
+    }
+
+    int winding = 0,
+        i = 0;
+    for (int r = 0; r < kTileSize; ++r) {
+        for (; i < steps.size() && steps[i].k <= r * kSampleRows; ++i) {
+            winding += steps[i].delta;
+        }
+        int lo = winding,
+            hi = winding;
+        for (; i < steps.size() && steps[i].k < (r + 1) * kSampleRows; ++i) {
+            winding += steps[i].delta;
+            lo = std::min(lo, winding);
+            hi = std::max(hi, winding);
+        }
+        fRightWinding.fMin[r] = lo;
+        fRightWinding.fMax[r] = hi;
+    }
+}
+
+void SparseStripRasterizer::advanceLeftWinding() {
+    std::swap(fLeftWinding, fRightWinding);
+}
+
+void SparseStripRasterizer::leftWinding(int r, int winding[kSampleRows]) const {
+    const skia_private::TArray<WindingStep>& steps = fLeftWinding.fSteps;
+    int w = 0,
+        i = 0;
+    for (int k = 0; k < kSampleRows; ++k) {
+        for (; i < steps.size() && steps[i].k <= r * kSampleRows + k; ++i) {
+            w += steps[i].delta;
+        }
+        winding[k] = w;
+    }
+}
+
+// The rows of pixels overlapped by the sample rows [first, end), as a bit mask.
+static unsigned row_mask(int first, int end) {
+    if (first >= end) {
+        return 0;
+    }
+    return (2u << ((end - 1) / kSampleRows)) - (1u << (first / kSampleRows));
+}
+
+void SparseStripRasterizer::findMayMix(SkSpan<const Line* const> lines,
+                                       bool mayMix[kTileSize]) const {
+    // Along a sample row, the winding is its value at the left edge plus the directions of the
+    // lines crossed from there, and its value at the right edge minus the directions of the lines
+    // crossed on the way there. Each line changes it by at most one either way, and so does each
+    // pair of lines meeting at a turn of the path, where they both cross. Count, in each row of
+    // pixels, the ones which may increase it and the ones which may decrease it.
+    int leftIncrease[kTileSize] = {},
+        leftDecrease[kTileSize] = {},
+        rightIncrease[kTileSize] = {},
+        rightDecrease[kTileSize] = {};
+    auto count = [&](unsigned leftUp, unsigned leftDown, unsigned rightUp, unsigned rightDown) {
+        for (int r = 0; r < kTileSize; ++r) {
+            leftIncrease[r] += (leftUp >> r) & 1;
+            leftDecrease[r] += (leftDown >> r) & 1;
+            rightIncrease[r] += (rightUp >> r) & 1;
+            rightDecrease[r] += (rightDown >> r) & 1;
+        }
+    };
+    for (size_t i = 0; i < lines.size(); ++i) {
+        const Line& a = *lines[i];
+        int firstA, endA;
+        const int directionA = sample_rows(a, &firstA, &endA);
+        const unsigned rowsA = row_mask(firstA, endA);
+
+        int firstB, endB;
+        if (i + 1 < lines.size() && lines[i + 1]->p0 == a.p1 &&
+            sample_rows(*lines[i + 1], &firstB, &endB) != directionA) {
+            // Where both lines cross a sample row, the winding between them changes by the
+            // direction of the one on the left, and is unchanged past them.
+            const Line& b = *lines[i + 1];
+            const SkVector u = a.p0 - a.p1,
+                           v = b.p1 - b.p0;
+            const int between = u.fX * std::abs(v.fY) < v.fX * std::abs(u.fY) ? directionA
+                                                                                : -directionA;
+            const int first = std::max(firstA, firstB),
+                      end = std::min(endA, endB);
+            const unsigned both = row_mask(first, end),
+                           onlyA = row_mask(firstA, std::min(first, endA)) |
+                                   row_mask(std::max(end, firstA), endA),
+                           onlyB = row_mask(firstB, std::min(first, endB)) |
+                                   row_mask(std::max(end, firstB), endB);
+            const unsigned up = directionA > 0 ? onlyA : onlyB,
+                           down = directionA > 0 ? onlyB : onlyA;
+            const unsigned bothUp = between > 0 ? both : 0,
+                           bothDown = between > 0 ? 0 : both;
+            count(bothUp | up, bothDown | down, bothUp | down, bothDown | up);
+            ++i;
+        } else {
+            count(directionA > 0 ? rowsA : 0, directionA > 0 ? 0 : rowsA,
+                  directionA > 0 ? 0 : rowsA, directionA > 0 ? rowsA : 0);
+        }
+    }
+    for (int r = 0; r < kTileSize; ++r) {
+        mayMix[r] = !this->areasResolve(
+                std::max(fLeftWinding.fMin[r] - leftDecrease[r],
+                         fRightWinding.fMin[r] - rightDecrease[r]),
+                std::min(fLeftWinding.fMax[r] + leftIncrease[r],
+                         fRightWinding.fMax[r] + rightIncrease[r]));
+    }
+}
+
+bool SparseStripRasterizer::bandsResolve(int r, SkSpan<const Edge> edges) const {
+    // The sample rows where the winding at the left edge changes, or edges start or end, split
+    // the row into bands.
+    const int top = r * kSampleRows,
+              bottom = top + kSampleRows;
+    skia_private::STArray<16, int> breaks;
+    const skia_private::TArray<WindingStep>& steps = fLeftWinding.fSteps;
+    for (const WindingStep& step : steps) {
+        if (step.k >= bottom) {
+            break;
+        }
+        if (step.k > top) {
+            breaks.push_back(step.k);
+        }
+    }
+    for (const Edge& edge : edges) {
+        breaks.push_back(edge.first);
+        breaks.push_back(edge.end);
+    }
+    breaks.push_back(bottom);
+    std::sort(breaks.begin(), breaks.end());
+
+    skia_private::STArray<8, const Edge*> order;
+    int min = INT_MAX,
+        max = INT_MIN;
+    int leftWinding = 0,
+        nextStep = 0,
+        first = top;
+    for (int end : breaks) {
+        if (end <= first) {
+            continue;
+        }
+        const int last = end - 1;
+        for (; nextStep < steps.size() && steps[nextStep].k <= first; ++nextStep) {
+            leftWinding += steps[nextStep].delta;
+        }
+
+        // Order the edges of the band by their x at its first sample row. If they stay in order
+        // at its last, the windings along every sample row of the band are the ones found by
+        // crossing them in that order. Otherwise they are at least bounded by the edges which
+        // increase and decrease them.
+        order.clear();
+        for (const Edge& edge : edges) {
+            if (edge.first <= first && last < edge.end) {
+                int i = order.size();
+                order.push_back();
+                for (; i > 0 && order[i - 1]->x(first) > edge.x(first); --i) {
+                    order[i] = order[i - 1];
+                }
+                order[i] = &edge;
+            }
+        }
+        int winding = leftWinding,
+            increase = 0,
+            decrease = 0;
+        bool ordered = true;
+        min = std::min(min, winding);
+        max = std::max(max, winding);
+        for (int i = 0; i < order.size(); ++i) {
+            ordered = ordered && (i == 0 || order[i - 1]->x(last) <= order[i]->x(last));
+            winding += order[i]->direction;
+            min = std::min(min, winding);
+            max = std::max(max, winding);
+            (order[i]->direction > 0 ? increase : decrease) += 1;
+        }
+        if (!ordered) {
+            min = std::min(min, leftWinding - decrease);
+            max = std::max(max, leftWinding + increase);
+        }
+        if (!this->areasResolve(min, max)) {
+            return false;
+        }
+        first = end;
+    }
+    return true;
+}
+
+void SparseStripRasterizer::resolveMixedWindings(int r,
+                                                 SkSpan<const Line* const> lines,
+                                                 SkAlpha alphas[kTileSize]) const {
+    skia_private::STArray<8, Edge> edges;
+    for (const Line* line : lines) {
+        int first, end;
+        const int direction = sample_rows(*line, &first, &end);
+        first = std::max(first, r * kSampleRows);
+        end = std::min(end, (r + 1) * kSampleRows);
+        if (first < end) {
+            const float dxdy = (line->p1.fX - line->p0.fX) / (line->p1.fY - line->p0.fY);
+            edges.push_back({line->p0.fX + (0.5f / kSampleRows - line->p0.fY) * dxdy,
+                             dxdy / kSampleRows, first, end, direction});
+        }
+    }
+
+    // Usually the edges don't cross each other. Then between the sample rows where edges start
+    // or end, or the winding at the left changes, every sample row steps through the same
+    // windings, and those may all be resolved by the areas. Where they cross, the windings
+    // around the crossings may still all be filled.
+    if (this->bandsResolve(r, edges)) {
+        return;
+    }
+
+    struct Crossing {
+        float x;
+        int direction;
+    };
+    skia_private::STArray<8, Crossing> crossings;
+
+    int left[kSampleRows];
+    this->leftWinding(r, left);
+    float coverage[kTileSize] = {};
+    int lo[kTileSize], hi[kTileSize];
+    std::fill(std::begin(lo), std::end(lo), INT_MAX);
+    std::fill(std::begin(hi), std::end(hi), INT_MIN);
+
+    for (int k = r * kSampleRows; k < (r + 1) * kSampleRows; ++k) {
+        crossings.clear();
+        for (const Edge& edge : edges) {
+            if (edge.first <= k && k < edge.end) {
+                const float x = SkTPin(edge.x(k), 0.f, (float)kTileSize);
+                // Insertion sort, there are only a few crossings.
+                int i = crossings.size();
+                crossings.push_back();
+                for (; i > 0 && crossings[i - 1].x > x; --i) {
+                    crossings[i] = crossings[i - 1];
+                }
+                crossings[i] = {x, edge.direction};
+            }
+        }
+
+        // Walk the spans between the crossings.
+        int winding = left[k - r * kSampleRows];
+        float x0 = 0;
+        for (int i = 0; i <= crossings.size(); ++i) {
+            const float x1 = i < crossings.size() ? crossings[i].x : (float)kTileSize;
+            if (x0 < x1) {
+                for (int c = (int)x0; c < kTileSize && c < x1; ++c) {
+                    lo[c] = std::min(lo[c], winding);
+                    hi[c] = std::max(hi[c], winding);
+                    if (this->isFilled(winding)) {
+                        coverage[c] += std::min(x1, c + 1.f) - std::max(x0, (float)c);
+                    }
+                }
+            }
+            if (i < crossings.size()) {
+                winding += crossings[i].direction;
+                x0 = x1;
+            }
+        }
+    }
+
+    for (int c = 0; c < kTileSize; ++c) {
+        if (!this->areasResolve(lo[c], hi[c])) {
+            alphas[c] = this->coverageToAlpha(coverage[c] / kSampleRows);
+        }
+    }
+}
+
+SkAlpha SparseStripRasterizer::gapAlpha(int r, float winding) const {
+    if (this->areasResolve(fLeftWinding.fMin[r], fLeftWinding.fMax[r])) {
+        return this->windingToAlpha(winding);
+    }
+    int left[kSampleRows];
+    this->leftWinding(r, left);
+    int filled = 0;
+    for (int k = 0; k < kSampleRows; ++k) {
+        filled += this->isFilled(left[k]);
+    }
+    return this->coverageToAlpha((float)filled / kSampleRows);
+}
+
+SkAlpha SparseStripRasterizer::coverageToAlpha(float coverage) const {
+    if (fInverse) {
+        coverage = 1 - coverage;
+    }
+    return SkToU8((int)(coverage * 255 + 0.5f));
+}
+
+SkAlpha SparseStripRasterizer::windingToAlpha(float winding) const {
+    float coverage = std::abs(winding);
+    if (fEvenOdd) {
+        coverage -= 2 * std::floor(coverage * 0.5f);
+        if (coverage > 1) {
+            coverage = 2 - coverage;
+        }
+    } else {
+        coverage = std::min(coverage, 1.f);
+    }
+    return this->coverageToAlpha(coverage);
+}
+
+void SparseStripRasterizer::blit(SkBlitter* blitter) {
+    const int rowStride = fWidth + 1;
+    skia_private::AutoTMalloc<SkAlpha> alphaStorage(kTileSize * rowStride);
+    skia_private::AutoTMalloc<int16_t> runStorage(kTileSize * rowStride);
+    Row rows[kTileSize];
+    skia_private::STArray<16, const Line*> tileLines;
+
+    auto blitEmptyTileRows = [&](int firstTileRow, int endTileRow) {
+        if (fInverse && firstTileRow < endTileRow) {
+            const int top = firstTileRow * kTileSize,
+                      bottom = std::min(fHeight, endTileRow * kTileSize);
+            blitter->blitRect(fBounds.fLeft, fBounds.fTop + top, fWidth, bottom - top);
+        }
+    };
+
+    int nextTileRow = 0;
+    for (int i = 0; i < fTileKeys.size();) {
+        const int tileY = (int)(fTileKeys[i] >> 48);
+        blitEmptyTileRows(nextTileRow, tileY);
+        nextTileRow = tileY + 1;
+
+        const int rowCount = std::min(kTileSize, fHeight - tileY * kTileSize);
+        for (int r = 0; r < kTileSize; ++r) {
+            rows[r].reset(alphaStorage.get() + r * rowStride, runStorage.get() + r * rowStride);
+        }
+        float carry[kTileSize] = {};
+        this->resetLeftWinding();
+
+        for (; i < fTileKeys.size() && (int)(fTileKeys[i] >> 48) == tileY;) {
+            const uint64_t tile = fTileKeys[i] >> 32;
+            const int tileX = (int)(tile & 0xFFFF);
+            const int left = tileX * kTileSize;
+
+            // Nothing changes the winding between the last tile and this one.
+            if (rows[0].x < left) {
+                for (int r = 0; r < rowCount; ++r) {
+                    rows[r].append(this->gapAlpha(r, carry[r]), left - rows[r].x);
+                }
+            }
+
+            memset(fAccumulation, 0, sizeof(fAccumulation));
+            tileLines.clear();
+            for (; i < fTileKeys.size() && (fTileKeys[i] >> 32) == tile; ++i) {
+                const Line& line = fLines[(int)(uint32_t)fTileKeys[i]];
+                this->accumulateLine(line);
+                tileLines.push_back(&line);
+            }
+
+            this->findRightWinding(tileLines);
+            bool mayMix[kTileSize];
+            this->findMayMix(tileLines, mayMix);
+
+            const int columnCount = std::min(kTileSize, fWidth - left);
+            for (int r = 0; r < rowCount; ++r) {
+                SkAlpha alphas[kTileSize];
+                float winding = carry[r];
+                for (int c = 0; c < kTileSize; ++c) {
+                    winding += fAccumulation[r][c];
+                    alphas[c] = this->windingToAlpha(winding);
+                }
+                carry[r] = winding + fAccumulation[r][kTileSize];
+
+                if (mayMix[r]) {
+                    this->resolveMixedWindings(r, tileLines, alphas);
+                }
+                for (int c = 0; c < columnCount; ++c) {
+                    rows[r].append(alphas[c], 1);
+                }
+            }
+            this->advanceLeftWinding();
+        }
+
+        for (int r = 0; r < rowCount; ++r) {
+            Row& row = rows[r];
+            if (row.x < fWidth) {
+                row.append(this->gapAlpha(r, carry[r]), fWidth - row.x);
+            }
+            if (row.hasCoverage) {
+                row.runs[row.x] = 0;
+                blitter->blitAntiH(fBounds.fLeft, fBounds.fTop + tileY * kTileSize + r,
+                                   row.alphas, row.runs);
+            }
+        }
+    }
+    blitEmptyTileRows(nextTileRow, (fHeight + kTileSize - 1) / kTileSize);
+}
+
+}  // namespace
+
+void SkScan::SparseStripFillPath(const SkPath& path,
+                                 SkBlitter* blitter,
+                                 const SkIRect& pathIR,
+                                 const SkIRect& clipBounds) {
+    // An inverse fill covers the whole width of the clip on the rows of the path. The rows above
+    // and below are handled by the caller.
+    SkIRect bounds = pathIR;
+    if (path.isInverseFillType()) {
+        bounds.fLeft = clipBounds.fLeft;
+        bounds.fRight = clipBounds.fRight;
+    }
+    if (!bounds.intersect(clipBounds)) {
+        return;
+    }
+
+    SparseStripRasterizer rasterizer{bounds, path.getFillType()};
+    rasterizer.addPath(path);
+    rasterizer.blit(blitter);
+}
@@ -8,6 +8,7 @@
 #include "src/core/SkStrike.h"
 
 #include "include/core/SkDrawable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
@@ -21,9 +22,11 @@
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrikeCache.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <algorithm>
 #include <cctype>
 #include <new>
 #include <optional>
@@ -114,6 +117,21 @@ SkStrike::FlattenGlyphsByType(SkWriteBuffer& buffer,
     }
 }
 
+void SkStrike::flattenGlyphs(SkWriteBuffer& buffer) const {
+    std::vector<SkGlyph> images;
+    std::vector<SkGlyph> paths;
+    SkAutoMutexExclusive lock{fStrikeLock};
+    for (const SkGlyph* glyph : fGlyphForIndex) {
+        if (glyph->setImageHasBeenCalled()) {
+            images.push_back(*glyph);
+        }
+        if (glyph->setPathHasBeenCalled()) {
+            paths.push_back(*glyph);
+        }
+    }
+    FlattenGlyphsByType(buffer, images, paths, {});
+}
+
 bool SkStrike::mergeFromBuffer(SkReadBuffer& buffer) {
     // Read glyphs with images for the current strike.
     const int imagesCount = buffer.readInt();
@@ -255,6 +273,85 @@ SkSpan<const SkGlyph*> SkStrike::prepareDrawables(
     return {results, glyphIDs.size()};
 }
 
+void SkStrike::prefillGlyphs(SkSpan<const SkPackedGlyphID> glyphIDs,
+                             bool includePaths,
+                             SkExecutor& executor) {
+    // Each task makes its own scaler context, so give it enough glyphs to be worth it.
+    static constexpr size_t kGlyphsPerTask = 32;
+
+    std::vector<SkPackedGlyphID> missing{glyphIDs.begin(), glyphIDs.end()};
+    std::sort(missing.begin(), missing.end());
+    missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+    {
+        Monitor m{this};
+        auto isDone = [&](SkPackedGlyphID glyphID) SK_REQUIRES(fStrikeLock) {
+            SkGlyphDigest* digest = fDigestForPackedGlyphID.find(glyphID);
+            if (digest == nullptr) {
+                return false;
+            }
+            const SkGlyph* glyph = fGlyphForIndex[digest->index()];
+            return glyph->setImageHasBeenCalled() &&
+                   (!includePaths || glyph->setPathHasBeenCalled());
+        };
+        missing.erase(std::remove_if(missing.begin(), missing.end(), isDone), missing.end());
+
+        // Too few glyphs to pay for the tasks, so make them here with the strike's scaler.
+        if (missing.size() <= kGlyphsPerTask) {
+            for (SkPackedGlyphID glyphID : missing) {
+                SkGlyph* glyph = this->glyph(glyphID);
+                this->prepareForImage(glyph);
+                if (includePaths) {
+                    this->prepareForPath(glyph);
+                }
+            }
+            return;
+        }
+    }
+
+    const int taskCount = SkToInt((missing.size() + kGlyphsPerTask - 1) / kGlyphsPerTask);
+    SkTaskGroup(executor).batch(taskCount, [&](int taskIndex) {
+        const size_t start = taskIndex * kGlyphsPerTask;
+        SkSpan<const SkPackedGlyphID> taskGlyphIDs =
+                SkSpan(missing).subspan(start, std::min(kGlyphsPerTask, missing.size() - start));
+
+        std::unique_ptr<SkScalerContext> scalerContext = fStrikeSpec.createScalerContext();
+        SkArenaAlloc alloc{kMinAllocAmount * 4};
+        std::vector<SkGlyph> glyphs;
+        glyphs.reserve(taskGlyphIDs.size());
+        for (SkPackedGlyphID glyphID : taskGlyphIDs) {
+            SkGlyph& glyph = glyphs.emplace_back(scalerContext->makeGlyph(glyphID, &alloc));
+            glyph.setImage(&alloc, scalerContext.get());
+            if (includePaths) {
+                glyph.setPath(&alloc, scalerContext.get());
+            }
+        }
+        this->mergePrefilledGlyphs(glyphs, includePaths);
+    });
+}
+
+void SkStrike::mergePrefilledGlyphs(SkSpan<const SkGlyph> glyphs, bool includePaths) {
+    Monitor m{this};
+    for (const SkGlyph& fromGlyph : glyphs) {
+        SkGlyphDigest* digest = fDigestForPackedGlyphID.find(fromGlyph.getPackedID());
+        SkGlyph* glyph;
+        if (digest != nullptr) {
+            // Another thread may have made this glyph, or even its image, in the meantime.
+            glyph = fGlyphForIndex[digest->index()];
+            if (!glyph->setImageHasBeenCalled()) {
+                fMemoryIncrease += glyph->setMetricsAndImage(&fAlloc, fromGlyph);
+            }
+        } else {
+            glyph = fAlloc.make<SkGlyph>(fromGlyph.getPackedID());
+            fMemoryIncrease += glyph->setMetricsAndImage(&fAlloc, fromGlyph) + sizeof(SkGlyph);
+            (void)this->addGlyphAndDigest(glyph);
+        }
+        if (includePaths && !glyph->setPathHasBeenCalled() &&
+            glyph->setPath(&fAlloc, fromGlyph.path(), fromGlyph.pathIsHairline())) {
+            fMemoryIncrease += glyph->path()->approximateBytesUsed();
+        }
+    }
+}
+
 void SkStrike::glyphIDsToPaths(SkSpan<sktext::IDOrPath> idsOrPaths) {
     Monitor m{this};
     for (sktext::IDOrPath& idOrPath : idsOrPaths) {
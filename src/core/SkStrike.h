@@ -27,6 +27,7 @@
 
 class SkDescriptor;
 class SkDrawable;
+class SkExecutor;
 class SkPath;
 class SkReadBuffer;
 class SkStrikeCache;
@@ -57,6 +58,8 @@ public:
     bool prepareForDrawable(SkGlyph*) override SK_REQUIRES(fStrikeLock);
 
     bool mergeFromBuffer(SkReadBuffer& buffer) SK_EXCLUDES(fStrikeLock);
+    // Write the glyphs that have images or paths in the format read by mergeFromBuffer.
+    void flattenGlyphs(SkWriteBuffer& buffer) const SK_EXCLUDES(fStrikeLock);
     static void FlattenGlyphsByType(SkWriteBuffer& buffer,
                                     SkSpan<SkGlyph> images,
                                     SkSpan<SkGlyph> paths,
@@ -99,6 +102,14 @@ public:
     SkSpan<const SkGlyph*> prepareDrawables(
             SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) SK_EXCLUDES(fStrikeLock);
 
+    // Generate the images, and the paths if includePaths is true, of the glyphs in glyphIDs that
+    // are not yet in this strike. The glyphs are split into tasks on the executor, each with its
+    // own scaler context, and the results are merged into this strike before returning. Use this
+    // before drawing large runs of new glyphs, so that prepareImages finds them already made.
+    void prefillGlyphs(SkSpan<const SkPackedGlyphID> glyphIDs,
+                       bool includePaths,
+                       SkExecutor& executor) SK_EXCLUDES(fStrikeLock);
+
     // SkStrikeForGPU APIs
     const SkDescriptor& getDescriptor() const override {
         return fStrikeSpec.descriptor();
@@ -150,6 +161,11 @@ private:
     bool mergeGlyphAndPathFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
     bool mergeGlyphAndDrawableFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
 
+    // Copy the metrics, images and maybe paths of glyphs made by another scaler context for
+    // this strike, skipping any that were added in the meantime.
+    void mergePrefilledGlyphs(SkSpan<const SkGlyph> glyphs,
+                              bool includePaths) SK_EXCLUDES(fStrikeLock);
+
     // Maintain memory use statistics.
     void updateMemoryUsage(size_t increase) SK_EXCLUDES(fStrikeLock);
 
@@ -7,6 +7,7 @@
 
 #include "src/core/SkStrikeCache.h"
 
+#include "include/core/SkData.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTraceMemoryDump.h"
@@ -19,6 +20,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 class SkScalerContext;
 struct SkFontMetrics;
@@ -37,15 +39,64 @@ SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
 }
 
 auto SkStrikeCache::findOrCreateStrike(const SkStrikeSpec& strikeSpec) -> sk_sp<SkStrike> {
+    sk_sp<SkGlyphStore> glyphStore;
+    {
+        SkAutoMutexExclusive ac(fLock);
+        sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
+        if (strike == nullptr && fGlyphStore == nullptr) {
+            strike = this->internalCreateStrike(strikeSpec);
+        }
+        if (strike != nullptr) {
+            this->internalPurge();
+            return strike;
+        }
+        glyphStore = fGlyphStore;
+    }
+
+    // Merging into a strike updates the cache's memory use, which takes fLock, so fill the new
+    // strike from the store before taking the lock to attach it. Until then it is not counted
+    // by the cache.
+    auto strike = sk_make_sp<SkStrike>(
+            this, strikeSpec, strikeSpec.createScalerContext(), nullptr, nullptr);
+    strike->fRemoved = true;
+    glyphStore->mergeInto(strike.get());
+
     SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
-    if (strike == nullptr) {
-        strike = this->internalCreateStrike(strikeSpec);
+    // Another thread may have made the strike in the meantime.
+    if (sk_sp<SkStrike> found = this->internalFindStrikeOrNull(strikeSpec.descriptor())) {
+        return found;
     }
+    strike->fRemoved = false;
+    this->internalAttachToHead(strike);
     this->internalPurge();
     return strike;
 }
 
+void SkStrikeCache::setGlyphStore(sk_sp<SkGlyphStore> glyphStore) {
+    SkAutoMutexExclusive ac(fLock);
+    fGlyphStore = std::move(glyphStore);
+}
+
+sk_sp<SkData> SkStrikeCache::serializeGlyphs() const {
+    std::vector<sk_sp<SkStrike>> strikes;
+    {
+        SkAutoMutexExclusive ac(fLock);
+        for (SkStrike* strike = fHead; strike != nullptr; strike = strike->fNext) {
+            strikes.push_back(sk_ref_sp(strike));
+        }
+    }
+    return SkGlyphStore::Serialize(strikes);
+}
+
+sk_sp<SkStrike> SkStrikeCache::findOrCreateAndPrefillStrike(const SkStrikeSpec& strikeSpec,
+                                                            SkSpan<const SkPackedGlyphID> glyphIDs,
+                                                            bool includePaths,
+                                                            SkExecutor& executor) {
+    sk_sp<SkStrike> strike = this->findOrCreateStrike(strikeSpec);
+    strike->prefillGlyphs(glyphIDs, includePaths, executor);
+    return strike;
+}
+
 sk_sp<StrikeForGPU> SkStrikeCache::findOrCreateScopedStrike(const SkStrikeSpec& strikeSpec) {
     return this->findOrCreateStrike(strikeSpec);
 }
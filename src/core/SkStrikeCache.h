@@ -12,6 +12,7 @@
 #include "include/private/base/SkLoadUserConfig.h" // IWYU pragma: keep
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkGlyphStore.h"
 #include "src/core/SkStrike.h"
 #include "src/core/SkTHash.h"
 #include "src/text/StrikeForGPU.h"
@@ -21,7 +22,9 @@
 #include <functional>
 #include <memory>
 
+class SkData;
 class SkDescriptor;
+class SkExecutor;
 class SkStrikeSpec;
 class SkTraceMemoryDump;
 struct SkFontMetrics;
@@ -53,9 +56,23 @@ public:
 
     sk_sp<SkStrike> findOrCreateStrike(const SkStrikeSpec& strikeSpec) SK_EXCLUDES(fLock);
 
+    // Find or create the strike for strikeSpec, and generate the glyphs in glyphIDs it does not
+    // have yet in parallel on executor. See SkStrike::prefillGlyphs.
+    sk_sp<SkStrike> findOrCreateAndPrefillStrike(const SkStrikeSpec& strikeSpec,
+                                                 SkSpan<const SkPackedGlyphID> glyphIDs,
+                                                 bool includePaths,
+                                                 SkExecutor& executor) SK_EXCLUDES(fLock);
+
     sk_sp<sktext::StrikeForGPU> findOrCreateScopedStrike(
             const SkStrikeSpec& strikeSpec) override SK_EXCLUDES(fLock);
 
+    // Use the glyphs in glyphStore for new strikes, before asking their scaler contexts. Pass
+    // nullptr to stop using a store.
+    void setGlyphStore(sk_sp<SkGlyphStore> glyphStore) SK_EXCLUDES(fLock);
+
+    // Serialize the glyphs of the strikes in this cache for SkGlyphStore::Make.
+    sk_sp<SkData> serializeGlyphs() const SK_EXCLUDES(fLock);
+
     static void PurgeAll();
     static void Dump();
 
@@ -112,6 +129,8 @@ private:
     int32_t fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
     int32_t fCacheCount SK_GUARDED_BY(fLock) {0};
     int32_t fPinnerCount SK_GUARDED_BY(fLock) {0};
+
+    sk_sp<SkGlyphStore> fGlyphStore SK_GUARDED_BY(fLock);
 };
 
 #endif  // SkStrikeCache_DEFINED
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/RectanizerGuillotine.h"
+
+#include "include/private/base/SkAssert.h"
+#include "src/core/SkIPoint16.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace skgpu {
+
+bool RectanizerGuillotine::addRect(int width, int height, SkIPoint16* loc) {
+    if ((unsigned)width > (unsigned)this->width() ||
+        (unsigned)height > (unsigned)this->height()) {
+        return false;
+    }
+
+    // find the free rect that leaves the shortest side, then the shortest long side
+    int bestIndex = -1;
+    int bestShortSide = INT_MAX;
+    int bestLongSide = INT_MAX;
+    for (int i = 0; i < fFreeRects.size(); ++i) {
+        const SkIRect& freeRect = fFreeRects[i];
+        int leftoverWidth = freeRect.width() - width;
+        int leftoverHeight = freeRect.height() - height;
+        if (leftoverWidth < 0 || leftoverHeight < 0) {
+            continue;
+        }
+        int shortSide = std::min(leftoverWidth, leftoverHeight);
+        int longSide = std::max(leftoverWidth, leftoverHeight);
+        if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+            bestIndex = i;
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+            if (shortSide == 0 && longSide == 0) {
+                break;
+            }
+        }
+    }
+
+    if (-1 == bestIndex) {
+        loc->fX = 0;
+        loc->fY = 0;
+        return false;
+    }
+
+    // Put the rect in the top left corner and cut what's left of the free rect in two. Cutting
+    // along the shorter leftover axis keeps the bigger of the two pieces as big as possible.
+    const SkIRect freeRect = fFreeRects[bestIndex];
+    fFreeRects.removeShuffle(bestIndex);
+
+    int leftoverWidth = freeRect.width() - width;
+    int leftoverHeight = freeRect.height() - height;
+    bool splitHorizontal = leftoverWidth <= leftoverHeight;
+    SkIRect bottom = SkIRect::MakeLTRB(freeRect.fLeft,
+                                       freeRect.fTop + height,
+                                       splitHorizontal ? freeRect.fRight : freeRect.fLeft + width,
+                                       freeRect.fBottom);
+    SkIRect right = SkIRect::MakeLTRB(freeRect.fLeft + width,
+                                      freeRect.fTop,
+                                      freeRect.fRight,
+                                      splitHorizontal ? freeRect.fTop + height : freeRect.fBottom);
+    if (!bottom.isEmpty()) {
+        fFreeRects.push_back(bottom);
+    }
+    if (!right.isEmpty()) {
+        fFreeRects.push_back(right);
+    }
+
+    loc->fX = freeRect.fLeft;
+    loc->fY = freeRect.fTop;
+
+    fAreaSoFar += width*height;
+    return true;
+}
+
+} // End of namespace skgpu
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_RectanizerGuillotine_DEFINED
+#define skgpu_RectanizerGuillotine_DEFINED
+
+#include "include/core/SkRect.h"
+#include "include/private/base/SkTArray.h"
+#include "src/gpu/Rectanizer.h"
+
+#include <cstdint>
+
+struct SkIPoint16;
+
+namespace skgpu {
+
+// Pack rectangles into a list of disjoint free rectangles. Each rect goes in the free rectangle
+// it fits best, the one that leaves the shortest side left over, and the rest of that free
+// rectangle is cut in two along the shorter leftover axis.
+// Based on Jukka Jylanki's "A Thousand Ways to Pack the Bin".
+//
+// Mark this class final in an effort to avoid the vtable when this subclass is used explicitly.
+class RectanizerGuillotine final : public Rectanizer {
+public:
+    RectanizerGuillotine(int w, int h) : Rectanizer(w, h) {
+        this->reset();
+    }
+
+    ~RectanizerGuillotine() final { }
+
+    void reset() final {
+        fAreaSoFar = 0;
+        fFreeRects.clear();
+        fFreeRects.push_back(SkIRect::MakeWH(this->width(), this->height()));
+    }
+
+    bool addRect(int w, int h, SkIPoint16* loc) final;
+
+    float percentFull() const final {
+        return fAreaSoFar / ((float)this->width() * this->height());
+    }
+
+private:
+    skia_private::TArray<SkIRect, true> fFreeRects;
+
+    int32_t fAreaSoFar;
+};
+
+} // End of namespace skgpu
+
+#endif
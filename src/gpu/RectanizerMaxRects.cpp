@@ -0,0 +1,124 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/RectanizerMaxRects.h"
+
+#include "include/private/base/SkAssert.h"
+#include "src/core/SkIPoint16.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace skgpu {
+
+bool RectanizerMaxRects::addRect(int width, int height, SkIPoint16* loc) {
+    if ((unsigned)width > (unsigned)this->width() ||
+        (unsigned)height > (unsigned)this->height()) {
+        return false;
+    }
+
+    // find the free rect that leaves the shortest side, then the shortest long side
+    int bestIndex = -1;
+    int bestShortSide = INT_MAX;
+    int bestLongSide = INT_MAX;
+    for (int i = 0; i < fFreeRects.size(); ++i) {
+        const SkIRect& freeRect = fFreeRects[i];
+        int leftoverWidth = freeRect.width() - width;
+        int leftoverHeight = freeRect.height() - height;
+        if (leftoverWidth < 0 || leftoverHeight < 0) {
+            continue;
+        }
+        int shortSide = std::min(leftoverWidth, leftoverHeight);
+        int longSide = std::max(leftoverWidth, leftoverHeight);
+        if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+            bestIndex = i;
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+        }
+    }
+
+    if (-1 == bestIndex) {
+        loc->fX = 0;
+        loc->fY = 0;
+        return false;
+    }
+
+    const SkIRect used = SkIRect::MakeXYWH(fFreeRects[bestIndex].fLeft,
+                                           fFreeRects[bestIndex].fTop,
+                                           width, height);
+    if (!used.isEmpty()) {
+        this->placeRect(used);
+    }
+
+    loc->fX = used.fLeft;
+    loc->fY = used.fTop;
+
+    fAreaSoFar += width*height;
+    return true;
+}
+
+void RectanizerMaxRects::placeRect(const SkIRect& used) {
+    SkASSERT(fNewFreeRects.empty());
+
+    // Replace each free rect the used rect overlaps with the up to four maximal rects around it.
+    for (int i = 0; i < fFreeRects.size();) {
+        const SkIRect freeRect = fFreeRects[i];
+        if (!SkIRect::Intersects(freeRect, used)) {
+            ++i;
+            continue;
+        }
+        fFreeRects.removeShuffle(i);
+
+        if (freeRect.fLeft < used.fLeft) {
+            this->addNewFreeRect(SkIRect::MakeLTRB(freeRect.fLeft, freeRect.fTop,
+                                                   used.fLeft, freeRect.fBottom));
+        }
+        if (used.fRight < freeRect.fRight) {
+            this->addNewFreeRect(SkIRect::MakeLTRB(used.fRight, freeRect.fTop,
+                                                   freeRect.fRight, freeRect.fBottom));
+        }
+        if (freeRect.fTop < used.fTop) {
+            this->addNewFreeRect(SkIRect::MakeLTRB(freeRect.fLeft, freeRect.fTop,
+                                                   freeRect.fRight, used.fTop));
+        }
+        if (used.fBottom < freeRect.fBottom) {
+            this->addNewFreeRect(SkIRect::MakeLTRB(freeRect.fLeft, used.fBottom,
+                                                   freeRect.fRight, freeRect.fBottom));
+        }
+    }
+
+    // The old free rects don't contain each other, and each new one is inside an old one that
+    // was split, so only a new one can be contained by an old one.
+    for (const SkIRect& freeRect : fFreeRects) {
+        for (int i = 0; i < fNewFreeRects.size();) {
+            if (freeRect.contains(fNewFreeRects[i])) {
+                fNewFreeRects.removeShuffle(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    fFreeRects.push_back_n(fNewFreeRects.size(), fNewFreeRects.data());
+    fNewFreeRects.clear();
+}
+
+void RectanizerMaxRects::addNewFreeRect(const SkIRect& rect) {
+    for (int i = 0; i < fNewFreeRects.size();) {
+        if (fNewFreeRects[i].contains(rect)) {
+            return;
+        }
+        if (rect.contains(fNewFreeRects[i])) {
+            fNewFreeRects.removeShuffle(i);
+        } else {
+            ++i;
+        }
+    }
+    fNewFreeRects.push_back(rect);
+}
+
+} // End of namespace skgpu
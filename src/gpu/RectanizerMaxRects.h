@@ -0,0 +1,64 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_RectanizerMaxRects_DEFINED
+#define skgpu_RectanizerMaxRects_DEFINED
+
+#include "include/core/SkRect.h"
+#include "include/private/base/SkTArray.h"
+#include "src/gpu/Rectanizer.h"
+
+#include <cstdint>
+
+struct SkIPoint16;
+
+namespace skgpu {
+
+// Pack rectangles and track every maximal free rectangle, which may overlap each other. Each
+// rect goes in the free rectangle that leaves the shortest side left over. This packs tighter
+// than the skyline, since it can use the space under overhangs, at the cost of a longer free
+// list to search.
+// Based on Jukka Jylanki's "A Thousand Ways to Pack the Bin".
+//
+// Mark this class final in an effort to avoid the vtable when this subclass is used explicitly.
+class RectanizerMaxRects final : public Rectanizer {
+public:
+    RectanizerMaxRects(int w, int h) : Rectanizer(w, h) {
+        this->reset();
+    }
+
+    ~RectanizerMaxRects() final { }
+
+    void reset() final {
+        fAreaSoFar = 0;
+        fFreeRects.clear();
+        fFreeRects.push_back(SkIRect::MakeWH(this->width(), this->height()));
+    }
+
+    bool addRect(int w, int h, SkIPoint16* loc) final;
+
+    float percentFull() const final {
+        return fAreaSoFar / ((float)this->width() * this->height());
+    }
+
+private:
+    skia_private::TArray<SkIRect, true> fFreeRects;
+    // The free rects made by the last split, before they are checked against the others.
+    skia_private::TArray<SkIRect, true> fNewFreeRects;
+
+    int32_t fAreaSoFar;
+
+    // Remove the used rect from the free rects, splitting those it overlaps into the parts that
+    // are still free.
+    void placeRect(const SkIRect& used);
+    // Add a new free rect unless another new one contains it.
+    void addNewFreeRect(const SkIRect& rect);
+};
+
+} // End of namespace skgpu
+
+#endif
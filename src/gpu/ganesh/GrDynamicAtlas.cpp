@@ -13,6 +13,8 @@
 #include "src/base/SkMathPriv.h"
 #include "src/core/SkIPoint16.h"
 #include "src/gpu/Rectanizer.h"
+#include "src/gpu/RectanizerGuillotine.h"
+#include "src/gpu/RectanizerMaxRects.h"
 #include "src/gpu/RectanizerPow2.h"
 #include "src/gpu/RectanizerSkyline.h"
 #include "src/gpu/ganesh/GrCaps.h"
@@ -126,9 +128,21 @@ void GrDynamicAtlas::reset(SkISize initialSize, const GrCaps& caps) {
 GrDynamicAtlas::Node* GrDynamicAtlas::makeNode(Node* previous, int l, int t, int r, int b) {
     int width = r - l;
     int height = b - t;
-    Rectanizer* rectanizer = (fRectanizerAlgorithm == RectanizerAlgorithm::kSkyline)
-            ? (Rectanizer*)fNodeAllocator.make<RectanizerSkyline>(width, height)
-            : fNodeAllocator.make<RectanizerPow2>(width, height);
+    Rectanizer* rectanizer = nullptr;
+    switch (fRectanizerAlgorithm) {
+        case RectanizerAlgorithm::kSkyline:
+            rectanizer = fNodeAllocator.make<RectanizerSkyline>(width, height);
+            break;
+        case RectanizerAlgorithm::kPow2:
+            rectanizer = fNodeAllocator.make<RectanizerPow2>(width, height);
+            break;
+        case RectanizerAlgorithm::kGuillotine:
+            rectanizer = fNodeAllocator.make<RectanizerGuillotine>(width, height);
+            break;
+        case RectanizerAlgorithm::kMaxRects:
+            rectanizer = fNodeAllocator.make<RectanizerMaxRects>(width, height);
+            break;
+    }
     return fNodeAllocator.make<Node>(previous, rectanizer, l, t);
 }
 
@@ -51,7 +51,9 @@ public:
 
     enum class RectanizerAlgorithm {
         kSkyline,
-        kPow2
+        kPow2,
+        kGuillotine,
+        kMaxRects
     };
 
     GrDynamicAtlas(GrColorType colorType, InternalMultisample, SkISize initialSize,
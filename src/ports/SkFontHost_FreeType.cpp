@@ -41,6 +41,7 @@
 #include "src/utils/SkCallableTraits.h"
 #include "src/utils/SkMatrix22.h"
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <tuple>
@@ -197,6 +198,8 @@ static SkMutex& f_t_mutex() {
 
 static FreeTypeLibrary* gFTLibrary;
 
+static std::atomic<bool> gScalerContextsOwnFaces{false};
+
 ///////////////////////////////////////////////////////////////////////////
 
 class SkTypeface_FreeType::FaceRec {
@@ -208,13 +211,21 @@ public:
     std::unique_ptr<SkColor[]> fSkPalette;
 
     static std::unique_ptr<FaceRec> Make(const SkTypeface_FreeType* typeface);
+    /** Like Make, but the face is opened in a new FT_Library owned by the FaceRec, so it may be
+     *  created, used and destroyed without holding f_t_mutex().
+     */
+    static std::unique_ptr<FaceRec> MakeWithOwnLibrary(const SkTypeface_FreeType* typeface);
     ~FaceRec();
 
 private:
-    FaceRec(std::unique_ptr<SkStreamAsset> stream);
+    FaceRec(std::unique_ptr<SkStreamAsset> stream, bool ownLibrary);
+    static std::unique_ptr<FaceRec> Make(const SkTypeface_FreeType* typeface, bool ownLibrary);
     void setupAxes(const SkFontData& data);
     void setupPalette(const SkFontData& data);
 
+    // If set, fFace belongs to this library instead of gFTLibrary.
+    std::unique_ptr<FreeTypeLibrary> fOwnLibrary;
+
     // Private to ref_ft_library and unref_ft_library
     static int gFTCount;
 
@@ -266,7 +277,7 @@ extern "C" {
     static void sk_ft_stream_close(FT_Stream) {}
 }
 
-SkTypeface_FreeType::FaceRec::FaceRec(std::unique_ptr<SkStreamAsset> stream)
+SkTypeface_FreeType::FaceRec::FaceRec(std::unique_ptr<SkStreamAsset> stream, bool ownLibrary)
         : fSkStream(std::move(stream))
 {
     sk_bzero(&fFTStream, sizeof(fFTStream));
@@ -275,13 +286,21 @@ SkTypeface_FreeType::FaceRec::FaceRec(std::unique_ptr<SkStreamAsset> stream)
     fFTStream.read  = sk_ft_stream_io;
     fFTStream.close = sk_ft_stream_close;
 
+    if (ownLibrary) {
+        fOwnLibrary = std::make_unique<FreeTypeLibrary>();
+        return;
+    }
     f_t_mutex().assertHeld();
     ref_ft_library();
 }
 
 SkTypeface_FreeType::FaceRec::~FaceRec() {
-    f_t_mutex().assertHeld();
     fFace.reset(); // Must release face before the library, the library frees existing faces.
+    if (fOwnLibrary) {
+        fOwnLibrary.reset();
+        return;
+    }
+    f_t_mutex().assertHeld();
     unref_ft_library();
 }
 
@@ -371,13 +390,27 @@ void SkTypeface_FreeType::FaceRec::setupPalette(const SkFontData& data) {
 std::unique_ptr<SkTypeface_FreeType::FaceRec>
 SkTypeface_FreeType::FaceRec::Make(const SkTypeface_FreeType* typeface) {
     f_t_mutex().assertHeld();
+    return Make(typeface, /*ownLibrary=*/false);
+}
+
+// Will return nullptr on failure
+std::unique_ptr<SkTypeface_FreeType::FaceRec>
+SkTypeface_FreeType::FaceRec::MakeWithOwnLibrary(const SkTypeface_FreeType* typeface) {
+    return Make(typeface, /*ownLibrary=*/true);
+}
 
+std::unique_ptr<SkTypeface_FreeType::FaceRec>
+SkTypeface_FreeType::FaceRec::Make(const SkTypeface_FreeType* typeface, bool ownLibrary) {
     std::unique_ptr<SkFontData> data = typeface->makeFontData();
     if (nullptr == data || !data->hasStream()) {
         return nullptr;
     }
 
-    std::unique_ptr<FaceRec> rec(new FaceRec(data->detachStream()));
+    std::unique_ptr<FaceRec> rec(new FaceRec(data->detachStream(), ownLibrary));
+    FT_Library library = ownLibrary ? rec->fOwnLibrary->library() : gFTLibrary->library();
+    if (!library) {
+        return nullptr;
+    }
 
     FT_Open_Args args;
     memset(&args, 0, sizeof(args));
@@ -393,7 +426,7 @@ SkTypeface_FreeType::FaceRec::Make(const SkTypeface_FreeType* typeface) {
 
     {
         FT_Face rawFace;
-        FT_Error err = FT_Open_Face(gFTLibrary->library(), &args, data->getIndex(), &rawFace);
+        FT_Error err = FT_Open_Face(library, &args, data->getIndex(), &rawFace);
         if (err) {
             SK_TRACEFTR(err, "unable to open font '%x'", (uint32_t)typeface->uniqueID());
             return nullptr;
@@ -466,6 +499,12 @@ private:
     // This value was chosen by eyeballing the result in Firefox and trying to match it.
     static const FT_Pos kBitmapEmboldenStrength = 1 << 6;
 
+    // If set, this context uses its own library and face (fOwnFaceRec), guarded by fFaceMutex
+    // instead of f_t_mutex(). See SkTypeface_FreeType::SetScalerContextsOwnFaces.
+    const bool fOwnsFace;
+    std::unique_ptr<SkTypeface_FreeType::FaceRec> fOwnFaceRec;
+    SkMutex fFaceMutex;
+
     SkTypeface_FreeType::FaceRec* fFaceRec; // Borrowed face from the typeface's FaceRec.
     FT_Face   fFace;  // Borrowed face from fFaceRec.
     FT_Size   fFTSize;  // The size to apply to the fFace.
@@ -487,14 +526,16 @@ private:
     bool      fDoLinearMetrics;
     bool      fLCDIsVert;
 
+    // The mutex which must be held to use fFace.
+    SkMutex& faceMutex() { return fOwnsFace ? fFaceMutex : f_t_mutex(); }
     FT_Error setupSize();
-    // Caller must lock f_t_mutex() before calling this function.
+    // Caller must lock faceMutex() before calling this function.
     static bool getBoundsOfCurrentOutlineGlyph(FT_GlyphSlot glyph, SkRect* bounds);
-    // Caller must lock f_t_mutex() before calling this function.
+    // Caller must lock faceMutex() before calling this function.
     bool getCBoxForLetter(char letter, FT_BBox* bbox);
     static void updateGlyphBoundsIfSubpixel(const SkGlyph&, SkRect* bounds, bool subpixel);
     void updateGlyphBoundsIfLCD(GlyphMetrics* mx);
-    // Caller must lock f_t_mutex() before calling this function.
+    // Caller must lock faceMutex() before calling this function.
     // update FreeType2 glyph slot with glyph emboldened
     void emboldenIfNeeded(FT_Face face, FT_GlyphSlot glyph, SkGlyphID gid);
     bool shouldSubpixelBitmap(const SkGlyph&, const SkMatrix&);
@@ -689,6 +730,14 @@ static bool isAxisAligned(const SkScalerContextRec& rec) {
             bothZero(rec.fPost2x2[0][0], rec.fPost2x2[1][1]));
 }
 
+void SkTypeface_FreeType::SetScalerContextsOwnFaces(bool ownFaces) {
+    gScalerContextsOwnFaces.store(ownFaces, std::memory_order_relaxed);
+}
+
+bool SkTypeface_FreeType::ScalerContextsOwnFaces() {
+    return gScalerContextsOwnFaces.load(std::memory_order_relaxed);
+}
+
 std::unique_ptr<SkScalerContext> SkTypeface_FreeType::onCreateScalerContext(
     const SkScalerContextEffects& effects, const SkDescriptor* desc) const
 {
@@ -896,12 +945,19 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface_FreeType> ty
                                                    const SkScalerContextEffects& effects,
                                                    const SkDescriptor* desc)
     : SkScalerContext(std::move(typeface), effects, desc)
+    , fOwnsFace(gScalerContextsOwnFaces.load(std::memory_order_relaxed))
     , fFace(nullptr)
     , fFTSize(nullptr)
     , fStrikeIndex(-1)
 {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-    fFaceRec = static_cast<SkTypeface_FreeType*>(this->getTypeface())->getFaceRec();
+    SkAutoMutexExclusive  ac(this->faceMutex());
+    if (fOwnsFace) {
+        fOwnFaceRec = SkTypeface_FreeType::FaceRec::MakeWithOwnLibrary(
+                static_cast<SkTypeface_FreeType*>(this->getTypeface()));
+        fFaceRec = fOwnFaceRec.get();
+    } else {
+        fFaceRec = static_cast<SkTypeface_FreeType*>(this->getTypeface())->getFaceRec();
+    }
 
     // load the font file
     if (nullptr == fFaceRec) {
@@ -1078,20 +1134,21 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface_FreeType> ty
 }
 
 SkScalerContext_FreeType::~SkScalerContext_FreeType() {
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(this->faceMutex());
 
     if (fFTSize != nullptr) {
         FT_Done_Size(fFTSize);
     }
 
     fFaceRec = nullptr;
+    fOwnFaceRec.reset();
 }
 
 /*  We call this before each use of the fFace, since we may be sharing
     this face with other context (at different sizes).
 */
 FT_Error SkScalerContext_FreeType::setupSize() {
-    f_t_mutex().assertHeld();
+    this->faceMutex().assertHeld();
     FT_Error err = FT_Activate_Size(fFTSize);
     if (err != 0) {
         return err;
@@ -1171,7 +1228,7 @@ bool SkScalerContext_FreeType::shouldSubpixelBitmap(const SkGlyph& glyph, const
 
 SkScalerContext::GlyphMetrics SkScalerContext_FreeType::generateMetrics(const SkGlyph& glyph,
                                                                         SkArenaAlloc* alloc) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(this->faceMutex());
 
     GlyphMetrics mx(glyph.maskFormat());
 
@@ -1350,7 +1407,7 @@ SkScalerContext::GlyphMetrics SkScalerContext_FreeType::generateMetrics(const Sk
 }
 
 void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph, void* imageBuffer) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(this->faceMutex());
 
     if (this->setupSize()) {
         sk_bzero(imageBuffer, glyph.imageSize());
@@ -1419,11 +1476,11 @@ void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph, void* imageBu
 sk_sp<SkDrawable> SkScalerContext_FreeType::generateDrawable(const SkGlyph& glyph) {
     // Because FreeType's FT_Face is stateful (not thread safe) and the current design of this
     // SkTypeface and SkScalerContext does not work around this, it is necessary lock at least the
-    // FT_Face when using it (this implementation currently locks the whole FT_Library).
+    // FT_Face when using it (by default this implementation locks the whole FT_Library).
     // It should be possible to draw the drawable straight out of the FT_Face. However, this would
     // mean locking each time any such drawable is drawn. To avoid locking, this implementation
     // creates drawables backed as pictures so that they can be played back later without locking.
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(this->faceMutex());
 
     if (this->setupSize()) {
         return nullptr;
@@ -1474,7 +1531,7 @@ sk_sp<SkDrawable> SkScalerContext_FreeType::generateDrawable(const SkGlyph& glyp
 bool SkScalerContext_FreeType::generatePath(const SkGlyph& glyph, SkPath* path) {
     SkASSERT(path);
 
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(this->faceMutex());
 
     SkGlyphID glyphID = glyph.getGlyphID();
     // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
@@ -1516,7 +1573,7 @@ void SkScalerContext_FreeType::generateFontMetrics(SkFontMetrics* metrics) {
         return;
     }
 
-    SkAutoMutexExclusive ac(f_t_mutex());
+    SkAutoMutexExclusive ac(this->faceMutex());
 
     if (this->setupSize()) {
         sk_bzero(metrics, sizeof(*metrics));
@@ -39,6 +39,14 @@ public:
     class FaceRec;
     FaceRec* getFaceRec() const;
 
+    /** When enabled, each scaler context created afterwards opens its own FT_Library and FT_Face
+     *  from the typeface's (usually memory mapped and so shared) font data. Glyphs of different
+     *  scaler contexts are then generated concurrently instead of under one global lock, at the
+     *  cost of a parsed face per scaler context. Disabled by default.
+     */
+    static void SetScalerContextsOwnFaces(bool);
+    static bool ScalerContextsOwnFaces();
+
     static constexpr SkTypeface::FactoryId FactoryId = SkSetFourByteTag('f','r','e','e');
     static sk_sp<SkTypeface> MakeFromStream(std::unique_ptr<SkStreamAsset>, const SkFontArguments&);
 
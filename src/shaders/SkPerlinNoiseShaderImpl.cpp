@@ -7,10 +7,16 @@
 
 #include "src/shaders/SkPerlinNoiseShaderImpl.h"
 
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
 #include "include/core/SkShader.h"
+#include "include/core/SkTileMode.h"
 #include "include/effects/SkPerlinNoiseShader.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkEffectPriv.h"
@@ -18,9 +24,11 @@
 #include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkRasterPipelineOpList.h"
 #include "src/core/SkReadBuffer.h"
+#include "src/core/SkResourceCache.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/shaders/SkPerlinNoiseShaderType.h"
 
+#include <cstdint>
 #include <optional>
 
 SkPerlinNoiseShader::SkPerlinNoiseShader(SkPerlinNoiseShaderType type,
@@ -125,6 +133,113 @@ static bool valid_input(
     return true;
 }
 
+static sk_sp<SkShader> make_noise(SkPerlinNoiseShaderType type,
+                                  SkScalar baseFrequencyX,
+                                  SkScalar baseFrequencyY,
+                                  int numOctaves,
+                                  SkScalar seed,
+                                  const SkISize* tileSize) {
+    return type == SkPerlinNoiseShaderType::kFractalNoise
+                   ? SkShaders::MakeFractalNoise(
+                             baseFrequencyX, baseFrequencyY, numOctaves, seed, tileSize)
+                   : SkShaders::MakeTurbulence(
+                             baseFrequencyX, baseFrequencyY, numOctaves, seed, tileSize);
+}
+
+namespace {
+static unsigned gPerlinNoiseTileKeyNamespaceLabel;
+
+struct PerlinNoiseTileKey : public SkResourceCache::Key {
+public:
+    PerlinNoiseTileKey(SkPerlinNoiseShaderType type,
+                       SkScalar baseFrequencyX,
+                       SkScalar baseFrequencyY,
+                       int numOctaves,
+                       SkScalar seed,
+                       const SkISize& tileSize)
+            : fType(static_cast<int32_t>(type))
+            , fBaseFrequencyX(baseFrequencyX)
+            , fBaseFrequencyY(baseFrequencyY)
+            , fNumOctaves(numOctaves)
+            , fSeed(seed)
+            , fTileWidth(tileSize.width())
+            , fTileHeight(tileSize.height()) {
+        this->init(&gPerlinNoiseTileKeyNamespaceLabel, 0,
+                   sizeof(fType) + sizeof(fBaseFrequencyX) + sizeof(fBaseFrequencyY) +
+                   sizeof(fNumOctaves) + sizeof(fSeed) + sizeof(fTileWidth) +
+                   sizeof(fTileHeight));
+    }
+
+    int32_t  fType;
+    SkScalar fBaseFrequencyX;
+    SkScalar fBaseFrequencyY;
+    int32_t  fNumOctaves;
+    SkScalar fSeed;
+    int32_t  fTileWidth;
+    int32_t  fTileHeight;
+};
+
+struct PerlinNoiseTileRec : public SkResourceCache::Rec {
+    PerlinNoiseTileRec(const PerlinNoiseTileKey& key, const SkBitmap& tile)
+            : fKey(key), fTile(tile) {}
+
+    PerlinNoiseTileKey fKey;
+    SkBitmap           fTile;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fTile.computeByteSize(); }
+    const char* getCategory() const override { return "perlin-noise-tile"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const PerlinNoiseTileRec& rec = static_cast<const PerlinNoiseTileRec&>(baseRec);
+        *static_cast<SkBitmap*>(contextData) = rec.fTile;
+        return true;
+    }
+};
+}  // namespace
+
+static sk_sp<SkShader> make_cached_noise(SkPerlinNoiseShaderType type,
+                                         SkScalar baseFrequencyX,
+                                         SkScalar baseFrequencyY,
+                                         int numOctaves,
+                                         SkScalar seed,
+                                         const SkISize& tileSize) {
+    sk_sp<SkShader> noise =
+            make_noise(type, baseFrequencyX, baseFrequencyY, numOctaves, seed, &tileSize);
+    if (!noise || tileSize.isEmpty() || numOctaves == 0) {
+        // Invalid, not tileable, or a solid color.
+        return noise;
+    }
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(tileSize);
+    const size_t limit = SkResourceCache::GetEffectiveSingleAllocationByteLimit();
+    if (limit && info.computeMinByteSize() > limit) {
+        return noise;
+    }
+
+    PerlinNoiseTileKey key(type, baseFrequencyX, baseFrequencyY, numOctaves, seed, tileSize);
+    SkBitmap tile;
+    if (!SkResourceCache::Find(key, PerlinNoiseTileRec::Visitor, &tile)) {
+        if (!tile.tryAllocPixels(info)) {
+            return noise;
+        }
+        // The noise is not color managed, and neither is the tile, so leave its color space
+        // unspecified and sample it as a raw image.
+        SkCanvas canvas(tile);
+        SkPaint paint;
+        paint.setShader(std::move(noise));
+        paint.setBlendMode(SkBlendMode::kSrc);
+        canvas.drawPaint(paint);
+        tile.setImmutable();
+        SkResourceCache::Add(new PerlinNoiseTileRec(key, tile));
+    }
+
+    // The tile is immutable, so the image shares its pixels, and has the same unique ID for every
+    // shader made from the cached tile.
+    return SkImages::RasterFromBitmap(tile)->makeRawShader(
+            SkTileMode::kRepeat, SkTileMode::kRepeat, SkSamplingOptions(SkFilterMode::kLinear));
+}
+
 void SkRegisterPerlinNoiseShaderFlattenable() {
     SK_REGISTER_FLATTENABLE(SkPerlinNoiseShader);
     // Previous name
@@ -179,4 +294,30 @@ sk_sp<SkShader> MakeTurbulence(SkScalar baseFrequencyX,
                                                    tileSize));
 }
 
+sk_sp<SkShader> MakeCachedFractalNoise(SkScalar baseFrequencyX,
+                                       SkScalar baseFrequencyY,
+                                       int numOctaves,
+                                       SkScalar seed,
+                                       const SkISize& tileSize) {
+    return make_cached_noise(SkPerlinNoiseShaderType::kFractalNoise,
+                             baseFrequencyX,
+                             baseFrequencyY,
+                             numOctaves,
+                             seed,
+                             tileSize);
+}
+
+sk_sp<SkShader> MakeCachedTurbulence(SkScalar baseFrequencyX,
+                                     SkScalar baseFrequencyY,
+                                     int numOctaves,
+                                     SkScalar seed,
+                                     const SkISize& tileSize) {
+    return make_cached_noise(SkPerlinNoiseShaderType::kTurbulence,
+                             baseFrequencyX,
+                             baseFrequencyY,
+                             numOctaves,
+                             seed,
+                             tileSize);
+}
+
 }  // namespace SkShaders
@@ -13,21 +13,27 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkTileMode.h"
 #include "include/private/SkColorData.h"
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTo.h"
+#include "modules/skcms/skcms.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkFloatBits.h"
+#include "src/base/SkNoDestructor.h"
 #include "src/base/SkVx.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkConvertPixels.h"
 #include "src/core/SkEffectPriv.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
@@ -37,7 +43,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <optional>
+#include <tuple>
 #include <utility>
 
 using namespace skia_private;
@@ -369,11 +377,12 @@ static void init_stop_pos(SkRasterPipeline_GradientCtx* ctx,
     add_stop_color(ctx, stop, Fs, Bs);
 }
 
-void SkGradientBaseShader::AppendGradientFillStages(SkRasterPipeline* p,
-                                                    SkArenaAlloc* alloc,
-                                                    const SkPMColor4f* pmColors,
-                                                    const SkScalar* positions,
-                                                    int count) {
+// Evaluate the stops into the context of one of the gradient stages, allocated in alloc, and return
+// the stage and its context.
+static std::pair<SkRasterPipelineOp, void*> make_gradient_fill_ctx(SkArenaAlloc* alloc,
+                                                                   const SkPMColor4f* pmColors,
+                                                                   const SkScalar* positions,
+                                                                   int count) {
     // The two-stop case with stops at 0 and 1.
     if (count == 2 && positions == nullptr) {
         const SkPMColor4f c_l = pmColors[0], c_r = pmColors[1];
@@ -383,7 +392,7 @@ void SkGradientBaseShader::AppendGradientFillStages(SkRasterPipeline* p,
         (skvx::float4::Load(c_r.vec()) - skvx::float4::Load(c_l.vec())).store(ctx->f);
         (skvx::float4::Load(c_l.vec())).store(ctx->b);
 
-        p->append(SkRasterPipelineOp::evenly_spaced_2_stop_gradient, ctx);
+        return {SkRasterPipelineOp::evenly_spaced_2_stop_gradient, ctx};
     } else {
         auto* ctx = alloc->make<SkRasterPipeline_GradientCtx>();
 
@@ -410,7 +419,7 @@ void SkGradientBaseShader::AppendGradientFillStages(SkRasterPipeline* p,
             add_const_color(ctx, stopCount - 1, c_l);
 
             ctx->stopCount = stopCount;
-            p->append(SkRasterPipelineOp::evenly_spaced_gradient, ctx);
+            return {SkRasterPipelineOp::evenly_spaced_gradient, ctx};
         } else {
             // Handle arbitrary stops.
 
@@ -452,11 +461,20 @@ void SkGradientBaseShader::AppendGradientFillStages(SkRasterPipeline* p,
             add_const_color(ctx, stopCount++, c_l);
 
             ctx->stopCount = stopCount;
-            p->append(SkRasterPipelineOp::gradient, ctx);
+            return {SkRasterPipelineOp::gradient, ctx};
         }
     }
 }
 
+void SkGradientBaseShader::AppendGradientFillStages(SkRasterPipeline* p,
+                                                    SkArenaAlloc* alloc,
+                                                    const SkPMColor4f* pmColors,
+                                                    const SkScalar* positions,
+                                                    int count) {
+    auto [op, ctx] = make_gradient_fill_ctx(alloc, pmColors, positions, count);
+    p->append(op, ctx);
+}
+
 void SkGradientBaseShader::AppendInterpolatedToDstStages(SkRasterPipeline* p,
                                                          SkArenaAlloc* alloc,
                                                          bool colorsAreOpaque,
@@ -526,6 +544,106 @@ void SkGradientBaseShader::AppendInterpolatedToDstStages(SkRasterPipeline* p,
             ->apply(p);
 }
 
+namespace {
+
+// The stops of a gradient converted to the intermediate color space, and evaluated into the
+// context of one of the raster pipeline gradient stages. These only depend on the stops and how
+// they are interpolated, and not on the geometry of the gradient, so they are shared by every
+// shader with the same stops. The context is only read while drawing.
+struct GradientStops : public SkNVRefCnt<GradientStops> {
+    SkArenaAlloc fAlloc{256};
+    SkRasterPipelineOp fOp;
+    void* fCtx;
+    sk_sp<SkColorSpace> fIntermediateColorSpace;
+};
+
+// Everything SkColor4fXformer reads from the shader, and the destination color space.
+class GradientStopsKey {
+public:
+    GradientStopsKey(const SkGradientBaseShader& shader, const SkColorSpace* dstCS) {
+        const SkGradientShader::Interpolation& interpolation = shader.fInterpolation;
+        this->add(shader.fColorCount);
+        this->add(shader.fPositions != nullptr);
+        this->add(shader.fFirstStopIsImplicit);
+        this->add(shader.fLastStopIsImplicit);
+        this->add(static_cast<uint32_t>(interpolation.fInPremul));
+        this->add(static_cast<uint32_t>(interpolation.fColorSpace));
+        this->add(static_cast<uint32_t>(interpolation.fHueMethod));
+        this->add(shader.fColorSpace.get());
+        this->add(dstCS);
+        for (int i = 0; i < shader.fColorCount; ++i) {
+            this->add(shader.fColors[i].vec(), 4);
+        }
+        if (shader.fPositions) {
+            this->add(shader.fPositions, shader.fColorCount);
+        }
+        fHash = SkChecksum::Hash32(fData.data(), fData.size_bytes());
+    }
+
+    bool operator==(const GradientStopsKey& that) const {
+        return fHash == that.fHash && fData == that.fData;
+    }
+
+    struct Hash {
+        uint32_t operator()(const GradientStopsKey& key) const { return key.fHash; }
+    };
+
+private:
+    void add(uint32_t value) { fData.push_back(value); }
+
+    void add(const float* values, int count) {
+        uint32_t* dst = fData.push_back_n(count);
+        memcpy(dst, values, count * sizeof(float));
+    }
+
+    void add(const SkColorSpace* colorSpace) {
+        this->add(colorSpace != nullptr);
+        if (colorSpace) {
+            skcms_TransferFunction transferFn;
+            skcms_Matrix3x3 toXYZD50;
+            colorSpace->transferFn(&transferFn);
+            colorSpace->toXYZD50(&toXYZD50);
+            this->add(&transferFn.g, 7);
+            this->add(&toXYZD50.vals[0][0], 9);
+        }
+    }
+
+    STArray<64, uint32_t> fData;
+    uint32_t fHash;
+};
+
+// Return the evaluated stops of shader for dstCS, from the cache if a shader with the same stops
+// was drawn recently.
+sk_sp<GradientStops> find_or_make_stops(const SkGradientBaseShader& shader, SkColorSpace* dstCS) {
+    static SkNoDestructor<SkMutex> mutex;
+    static SkNoDestructor<SkLRUCache<GradientStopsKey, sk_sp<GradientStops>,
+                                     GradientStopsKey::Hash>> cache(32 /*arbitrary*/);
+
+    GradientStopsKey key(shader, dstCS);
+    {
+        SkAutoMutexExclusive _(*mutex);
+        if (sk_sp<GradientStops>* found = cache->find(key)) {
+            return *found;
+        }
+    }
+
+    auto stops = sk_make_sp<GradientStops>();
+    SkColor4fXformer xformedColors(&shader, dstCS);
+    std::tie(stops->fOp, stops->fCtx) = make_gradient_fill_ctx(&stops->fAlloc,
+                                                               xformedColors.fColors.begin(),
+                                                               xformedColors.fPositions,
+                                                               xformedColors.fColors.size());
+    stops->fIntermediateColorSpace = std::move(xformedColors.fIntermediateColorSpace);
+
+    {
+        SkAutoMutexExclusive _(*mutex);
+        cache->insert_or_update(key, stops);
+    }
+    return stops;
+}
+
+}  // namespace
+
 bool SkGradientBaseShader::appendStages(const SkStageRec& rec,
                                         const SkShaders::MatrixRec& mRec) const {
     SkRasterPipeline* p = rec.fPipeline;
@@ -566,14 +684,13 @@ bool SkGradientBaseShader::appendStages(const SkStageRec& rec,
             break;
     }
 
-    // Transform all of the colors to destination color space, possibly premultiplied
-    SkColor4fXformer xformedColors(this, rec.fDstCS);
-    AppendGradientFillStages(p, alloc,
-                             xformedColors.fColors.begin(),
-                             xformedColors.fPositions,
-                             xformedColors.fColors.size());
+    // Transform all of the colors to destination color space, possibly premultiplied. The stage
+    // reads the stops from the cache entry, so the entry is kept alive by the alloc.
+    sk_sp<GradientStops> stops = find_or_make_stops(*this, rec.fDstCS);
+    p->append(stops->fOp, stops->fCtx);
     AppendInterpolatedToDstStages(p, alloc, fColorsAreOpaque, fInterpolation,
-                                  xformedColors.fIntermediateColorSpace.get(), rec.fDstCS);
+                                  stops->fIntermediateColorSpace.get(), rec.fDstCS);
+    alloc->make<sk_sp<GradientStops>>(std::move(stops));
 
     if (decal_ctx) {
         p->append(SkRasterPipelineOp::check_decal_mask, decal_ctx);
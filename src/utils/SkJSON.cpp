@@ -11,16 +11,22 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTo.h"
 #include "include/utils/SkParse.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkMathPriv.h"
 #include "src/base/SkUTF.h"
+#include "src/base/SkUtils.h"
+#include "src/base/SkVx.h"
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <new>
 #include <tuple>
@@ -298,11 +304,74 @@ static inline bool is_digit(char c)    { return g_token_flags[static_cast<uint8_
 static inline bool is_numeric(char c)  { return g_token_flags[static_cast<uint8_t>(c)] & 0x10; }
 static inline bool is_eoscope(char c)  { return g_token_flags[static_cast<uint8_t>(c)] & 0x20; }
 
-static inline const char* skip_ws(const char* p) {
+// Block scanning, for long runs of whitespace or string characters (indented documents,
+// embedded base64 images, etc): classify kScanBlockSize bytes at a time, and locate the first
+// byte of interest with a movemask, simdjson-style [4].
+//
+// [4] https://github.com/simdjson/simdjson
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+static constexpr ptrdiff_t kScanBlockSize = 32;
+#else
+static constexpr ptrdiff_t kScanBlockSize = 16;
+#endif
+
+using ScanBlock = skvx::Vec<kScanBlockSize, uint8_t>;
+
+// Returns the index of the first set lane in the mask, or kScanBlockSize if none are set.
+static inline ptrdiff_t first_set_lane(const ScanBlock& mask) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    const auto bits = SkToU32(_mm256_movemask_epi8(sk_bit_cast<__m256i>(mask)));
+    return bits ? SkCTZ(bits) : kScanBlockSize;
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    const auto bits = SkToU32(_mm_movemask_epi8(sk_bit_cast<__m128i>(mask)));
+    return bits ? SkCTZ(bits) : kScanBlockSize;
+#else
+    if (!any(mask)) {
+        return kScanBlockSize;
+    }
+    ptrdiff_t i = 0;
+    while (!mask[i]) ++i;
+    return i;
+#endif
+}
+
+// The scanners below only look at whole blocks within [p, p_stop], and finish the scalar way.
+
+static inline const char* skip_ws(const char* p, const char* p_stop) {
+    // Minified documents don't have any whitespace: check before loading blocks.
+    if (!is_ws(*p)) {
+        return p;
+    }
+
+    while (p_stop - p >= kScanBlockSize) {
+        const auto c = ScanBlock::Load(p);
+        const auto i = first_set_lane(~((c == ' ') | (c == '\t') | (c == '\n') | (c == '\r')));
+        p += i;
+        if (i < kScanBlockSize) {
+            break;
+        }
+    }
+
     while (is_ws(*p)) ++p;
     return p;
 }
 
+// Skips to the first string terminator (see is_eostring).
+static inline const char* skip_string_chars(const char* p, const char* p_stop) {
+    while (p_stop - p >= kScanBlockSize) {
+        const auto c = ScanBlock::Load(p);
+        const auto i = first_set_lane((c < 0x20) | (c == '"') | (c == '\\') |
+                                      (c == ']')  | (c == '}'));
+        p += i;
+        if (i < kScanBlockSize) {
+            return p;
+        }
+    }
+
+    while (!is_eostring(*p)) ++p;
+    return p;
+}
+
 static inline float pow10(int32_t exp) {
     static constexpr float g_pow10_table[63] =
     {
@@ -349,7 +418,7 @@ public:
             return this->error(NullValue(), p_stop, "invalid top-level value");
         }
 
-        p = skip_ws(p);
+        p = skip_ws(p, p_stop);
 
         switch (*p) {
         case '{':
@@ -362,7 +431,7 @@ public:
 
     match_object:
         SkASSERT(*p == '{');
-        p = skip_ws(p + 1);
+        p = skip_ws(p + 1, p_stop);
 
         this->pushObjectScope();
 
@@ -370,7 +439,7 @@ public:
 
         // goto match_object_key;
     match_object_key:
-        p = skip_ws(p);
+        p = skip_ws(p, p_stop);
         if (*p != '"') return this->error(NullValue(), p, "expected object key");
 
         p = this->matchString(p, p_stop, [this](const char* key, size_t size, const char* eos) {
@@ -378,14 +447,14 @@ public:
         });
         if (!p) return NullValue();
 
-        p = skip_ws(p);
+        p = skip_ws(p, p_stop);
         if (*p != ':') return this->error(NullValue(), p, "expected ':' separator");
 
         ++p;
 
         // goto match_value;
     match_value:
-        p = skip_ws(p);
+        p = skip_ws(p, p_stop);
 
         switch (*p) {
         case '\0':
@@ -419,7 +488,7 @@ public:
     match_post_value:
         SkASSERT(!this->inTopLevelScope());
 
-        p = skip_ws(p);
+        p = skip_ws(p, p_stop);
         switch (*p) {
         case ',':
             ++p;
@@ -472,7 +541,7 @@ public:
 
     match_array:
         SkASSERT(*p == '[');
-        p = skip_ws(p + 1);
+        p = skip_ws(p + 1, p_stop);
 
         this->pushArrayScope();
 
@@ -679,11 +748,15 @@ private:
         fUnescapeBuffer.clear();
 
         for (const auto* p = begin; p != end; ++p) {
-            if (*p != '\\') {
-                fUnescapeBuffer.push_back(*p);
-                continue;
+            // Copy the chars up to the next escape sequence in bulk: escaped strings can be
+            // large (e.g. base64 images with escaped slashes).
+            const auto* esc = static_cast<const char*>(memchr(p, '\\', SkToSizeT(end - p)));
+            fUnescapeBuffer.insert(fUnescapeBuffer.end(), p, esc ? esc : end);
+            if (!esc) {
+                break;
             }
 
+            p = esc;
             if (++p == end) {
                 return nullptr;
             }
@@ -730,7 +803,7 @@ private:
         do {
             // Consume string chars.
             // This is the fast path, and hopefully we only hit it once then quick-exit below.
-            for (p = p + 1; !is_eostring(*p); ++p);
+            p = skip_string_chars(p + 1, p_stop);
 
             if (*p == '"') {
                 // Valid string found.
@@ -956,4 +1029,251 @@ void DOM::write(SkWStream* stream) const {
     Write(fRoot, stream);
 }
 
+// Binary images are a header followed by a copy of the DOM's records, where payload pointers
+// are replaced with offsets from the start of the records:
+//
+//   [header] [root Value] [vector slab 0] ... [vector slab n-1]
+//
+// The slabs keep the in-memory vector layout (see MakeVector), padded to kRecAlign.  They are
+// laid out in depth-first order, so the loader knows exactly where each one must start, which
+// rules out overlapping, shared or cyclic slabs without any bookkeeping.
+namespace {
+
+struct BinaryHeader {
+    char     fMagic[4];
+    uint16_t fVersion;
+    uint8_t  fSizeOfSizeT;
+    uint8_t  fReserved;
+    uint64_t fRecordsSize;
+};
+static_assert(sizeof(BinaryHeader) == 16, "");
+
+static constexpr char     kBinaryMagic[4] = {'s', 'k', 'j', 'b'};
+static constexpr uint16_t kBinaryVersion  = 1;
+
+// Gives the image writer and loader access to the record internals.
+class RecordValue final : public Value {
+public:
+    using Value::Tag;
+
+    Tag tag() const { return this->getTag(); }
+
+    uintptr_t payload() const { return reinterpret_cast<uintptr_t>(this->ptr<void>()); }
+
+    void setPayload(uintptr_t payload) {
+        this->init_tagged_pointer(this->getTag(), reinterpret_cast<void*>(payload));
+    }
+
+    const uint8_t* bytes() const { return reinterpret_cast<const uint8_t*>(this); }
+};
+
+const RecordValue& as_record(const Value& v) { return static_cast<const RecordValue&>(v); }
+
+class ImageWriter {
+public:
+    explicit ImageWriter(const Value& root) : fRecords(sizeof(Value) / sizeof(uint64_t)) {
+        this->place(root, 0);
+    }
+
+    const void* data() const { return fRecords.data(); }
+    size_t size() const { return fRecords.size() * sizeof(uint64_t); }
+
+private:
+    char* at(size_t offset) { return reinterpret_cast<char*>(fRecords.data()) + offset; }
+
+    size_t allocSlab(size_t vec_size, size_t elem_size, size_t extra_size = 0) {
+        const size_t offset = this->size();
+        const size_t slab_size = sizeof(size_t) + vec_size * elem_size + extra_size;
+        // Also zeroes the padding, and the \0 terminator of strings.
+        fRecords.resize(fRecords.size() + SkAlignTo(slab_size, kRecAlign) / sizeof(uint64_t));
+        memcpy(this->at(offset), &vec_size, sizeof(size_t));
+        return offset;
+    }
+
+    void setPayload(size_t offset, size_t slab) {
+        reinterpret_cast<RecordValue*>(this->at(offset))->setPayload(slab);
+    }
+
+    // Copies v to the given record offset, and its payload (if any) to new slabs.
+    void place(const Value& v, size_t offset) {
+        memcpy(this->at(offset), &v, sizeof(Value));
+
+        switch (v.getType()) {
+        case Value::Type::kString: {
+            if (as_record(v).tag() != RecordValue::Tag::kString) {
+                break;  // Short strings are stored inline.
+            }
+            const auto& str = v.as<StringValue>();
+            const size_t slab = this->allocSlab(str.size(), sizeof(char), 1);
+            memcpy(this->at(slab + sizeof(size_t)), str.begin(), str.size());
+            this->setPayload(offset, slab);
+            break;
+        }
+        case Value::Type::kArray: {
+            const auto& array = v.as<ArrayValue>();
+            const size_t slab = this->allocSlab(array.size(), sizeof(Value));
+            this->setPayload(offset, slab);
+            for (size_t i = 0; i < array.size(); ++i) {
+                this->place(array[i], slab + sizeof(size_t) + i * sizeof(Value));
+            }
+            break;
+        }
+        case Value::Type::kObject: {
+            const auto& object = v.as<ObjectValue>();
+            const size_t slab = this->allocSlab(object.size(), sizeof(Member));
+            this->setPayload(offset, slab);
+            for (size_t i = 0; i < object.size(); ++i) {
+                const Member& src = object.begin()[i];
+                const size_t member = slab + sizeof(size_t) + i * sizeof(Member);
+                this->place(src.fKey  , member + offsetof(Member, fKey));
+                this->place(src.fValue, member + offsetof(Member, fValue));
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    std::vector<uint64_t> fRecords;
+};
+
+// Validates the records and turns their payload offsets back into pointers.
+bool relocate_records(char* records, size_t size) {
+    // Slabs must follow each other in the order the writer visited their records.
+    size_t next_slab = sizeof(Value);
+    std::vector<size_t> pending = {0};
+
+    while (!pending.empty()) {
+        const size_t offset = pending.back();
+        pending.pop_back();
+
+        auto* rec = reinterpret_cast<RecordValue*>(records + offset);
+        size_t elem_size, extra_size = 0;
+        switch (rec->tag()) {
+        case RecordValue::Tag::kShortString:
+            // Inline strings are \0 terminated by their last byte at the latest.
+            if (rec->bytes()[sizeof(Value) - 1] != '\0') {
+                return false;
+            }
+            continue;
+        case RecordValue::Tag::kBool:
+            if (rec->bytes()[1] > 1) {
+                return false;
+            }
+            continue;
+        case RecordValue::Tag::kNull:
+        case RecordValue::Tag::kInt:
+        case RecordValue::Tag::kFloat:
+            continue;
+        case RecordValue::Tag::kString:
+            elem_size  = sizeof(char);
+            extra_size = 1;
+            break;
+        case RecordValue::Tag::kArray:
+            elem_size = sizeof(Value);
+            break;
+        case RecordValue::Tag::kObject:
+            elem_size = sizeof(Member);
+            break;
+        }
+
+        if (rec->payload() != next_slab || size - next_slab < sizeof(size_t) + extra_size) {
+            return false;
+        }
+        size_t vec_size;
+        memcpy(&vec_size, records + next_slab, sizeof(size_t));
+        if (vec_size > (size - next_slab - sizeof(size_t) - extra_size) / elem_size) {
+            return false;
+        }
+        const size_t vec_begin = next_slab + sizeof(size_t),
+                     slab_size = SkAlignTo(sizeof(size_t) + vec_size * elem_size + extra_size,
+                                           kRecAlign);
+        if (slab_size > size - next_slab) {
+            return false;
+        }
+
+        switch (rec->tag()) {
+        case RecordValue::Tag::kString:
+            if (records[vec_begin + vec_size] != '\0') {
+                return false;
+            }
+            break;
+        case RecordValue::Tag::kArray:
+            for (size_t i = vec_size; i-- > 0;) {
+                pending.push_back(vec_begin + i * sizeof(Value));
+            }
+            break;
+        case RecordValue::Tag::kObject:
+            for (size_t i = vec_size; i-- > 0;) {
+                const size_t member = vec_begin + i * sizeof(Member);
+                const auto* key = reinterpret_cast<const Value*>(records + member +
+                                                                 offsetof(Member, fKey));
+                if (!key->is<StringValue>()) {
+                    return false;
+                }
+                pending.push_back(member + offsetof(Member, fValue));
+                pending.push_back(member + offsetof(Member, fKey));
+            }
+            break;
+        default:
+            SkUNREACHABLE;
+        }
+
+        rec->setPayload(reinterpret_cast<uintptr_t>(records + next_slab));
+        next_slab += slab_size;
+    }
+
+    return next_slab == size;
+}
+
+} // namespace
+
+DOM::DOM() : fAlloc(kMinChunkSize) {}
+
+bool DOM::IsBinary(const void* data, size_t size) {
+    return size >= sizeof(BinaryHeader) &&
+           !memcmp(data, kBinaryMagic, sizeof(kBinaryMagic));
+}
+
+std::unique_ptr<DOM> DOM::MakeFromBinary(const void* data, size_t size) {
+    if (!IsBinary(data, size)) {
+        return nullptr;
+    }
+
+    BinaryHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header.fVersion != kBinaryVersion ||
+        header.fSizeOfSizeT != sizeof(size_t) ||
+        header.fRecordsSize != size - sizeof(header) ||
+        header.fRecordsSize < sizeof(Value) ||
+        !SkIsAlign8(header.fRecordsSize)) {
+        return nullptr;
+    }
+
+    const size_t records_size = SkToSizeT(header.fRecordsSize);
+    std::unique_ptr<DOM> dom(new DOM());
+    auto* records = static_cast<char*>(dom->fAlloc.makeBytesAlignedTo(records_size, kRecAlign));
+    memcpy(records, static_cast<const char*>(data) + sizeof(header), records_size);
+    if (!relocate_records(records, records_size)) {
+        return nullptr;
+    }
+
+    dom->fRoot = *reinterpret_cast<const Value*>(records);
+    return dom;
+}
+
+void DOM::writeBinary(SkWStream* stream) const {
+    const ImageWriter writer(fRoot);
+
+    BinaryHeader header = {};
+    memcpy(header.fMagic, kBinaryMagic, sizeof(kBinaryMagic));
+    header.fVersion     = kBinaryVersion;
+    header.fSizeOfSizeT = SkToU8(sizeof(size_t));
+    header.fRecordsSize = writer.size();
+
+    stream->write(&header, sizeof(header));
+    stream->write(writer.data(), writer.size());
+}
+
 } // namespace skjson
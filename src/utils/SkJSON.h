@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string_view>
 
 class SkString;
@@ -359,11 +360,34 @@ class DOM final : public SkNoncopyable {
 public:
     DOM(const char*, size_t);
 
+    /**
+     * Loads a DOM from a binary image written by writeBinary().  This copies the image and
+     * rebases its internal offsets in one pass, without parsing any text.
+     *
+     * @return    The DOM, or nullptr if the data is not a valid image for this build.
+     */
+    static std::unique_ptr<DOM> MakeFromBinary(const void* data, size_t size);
+
+    /**
+     * @return    True if the data starts like a binary image (see writeBinary()).
+     */
+    static bool IsBinary(const void* data, size_t size);
+
     const Value& root() const { return fRoot; }
 
     void write(SkWStream*) const;
 
+    /**
+     * Writes a position independent image of the DOM's records, for MakeFromBinary().
+     *
+     * Images are meant for caching parsed documents: they are only loadable by builds with the
+     * same image version and pointer size.
+     */
+    void writeBinary(SkWStream*) const;
+
 private:
+    DOM();
+
     SkArenaAlloc fAlloc;
     Value        fRoot;
 };
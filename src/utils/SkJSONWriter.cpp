@@ -5,30 +5,171 @@
  * found in the LICENSE file.
  */
 
-// Make sure that the PRI format string macros are defined
-#ifndef __STDC_FORMAT_MACROS
-#define __STDC_FORMAT_MACROS
-#endif
-
 #include "src/utils/SkJSONWriter.h"
 
-#include <inttypes.h>
+#include "include/private/base/SkTo.h"
+#include "src/base/SkUtils.h"
+
+#include <cmath>
+#include <iterator>
 #include <stdarg.h>
 #include <stdio.h>
 
+namespace {
+
+constexpr size_t kMaxFormattedFloatSize = 16;
+
+// Formats finite floats in [1e-4, 1e6) exactly like printf's "%g" (six significant digits, fixed
+// notation, trailing zeros stripped), without the printf overhead.  Scaling a float by 10^k is
+// exact in double precision for k <= 9, so the rounding to six digits is exact too.
+//
+// Returns nullptr for the values left to printf: the other ranges, non-finite values, and exact
+// ties (rounding of which varies across C runtimes).
+char* format_g(char* out, float value) {
+    static constexpr double kPow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+
+    double v = value;
+    if (std::signbit(v)) {
+        *out++ = '-';
+        v = -v;
+    }
+    if (v == 0) {
+        *out++ = '0';
+        return out;
+    }
+    if (!(v >= 1e-4 && v < 1e6)) {
+        return nullptr;
+    }
+
+    // Fractional digits: 5 - floor(log10(v)).
+    int frac_digits = 5;
+    while (v >= kPow10[6 - frac_digits]) {
+        --frac_digits;
+    }
+    while (frac_digits < 9 && v * kPow10[frac_digits] < 1e5) {
+        ++frac_digits;
+    }
+
+    const double scaled = v * kPow10[frac_digits],
+                 whole  = std::floor(scaled),
+                 rem    = scaled - whole;
+    if (rem == 0.5) {
+        return nullptr;
+    }
+    auto digits = static_cast<uint32_t>(whole) + (rem > 0.5 ? 1 : 0);
+    if (digits == 1000000) {
+        // Rounded up to the next power of 10.
+        if (frac_digits == 0) {
+            return nullptr;
+        }
+        digits = 100000;
+        frac_digits -= 1;
+    }
+
+    while (frac_digits > 0 && digits % 10 == 0) {
+        digits /= 10;
+        frac_digits -= 1;
+    }
+
+    char buf[kSkStrAppendU32_MaxSize];
+    const int len = SkToInt(SkStrAppendU32(buf, digits) - buf);
+    if (frac_digits == 0) {
+        memcpy(out, buf, len);
+        return out + len;
+    }
+    if (len > frac_digits) {
+        memcpy(out, buf, len - frac_digits);
+        out += len - frac_digits;
+        *out++ = '.';
+        memcpy(out, buf + len - frac_digits, frac_digits);
+        return out + frac_digits;
+    }
+    *out++ = '0';
+    *out++ = '.';
+    memset(out, '0', frac_digits - len);
+    out += frac_digits - len;
+    memcpy(out, buf, len);
+    return out + len;
+}
+
+}  // namespace
+
+void SkJSONWriter::appendS32(int32_t value) {
+    this->beginValue();
+    fWrite = SkStrAppendS32(this->reserve(kSkStrAppendS32_MaxSize), value);
+}
+
 void SkJSONWriter::appendS64(int64_t value) {
     this->beginValue();
-    this->appendf("%" PRId64, value);
+    fWrite = SkStrAppendS64(this->reserve(kSkStrAppendS64_MaxSize), value, 0);
+}
+
+void SkJSONWriter::appendU32(uint32_t value) {
+    this->beginValue();
+    fWrite = SkStrAppendU32(this->reserve(kSkStrAppendU32_MaxSize), value);
 }
 
 void SkJSONWriter::appendU64(uint64_t value) {
     this->beginValue();
-    this->appendf("%" PRIu64, value);
+    fWrite = SkStrAppendU64(this->reserve(kSkStrAppendU64_MaxSize), value, 0);
+}
+
+void SkJSONWriter::appendFloat(float value) {
+    this->beginValue();
+    if (char* end = format_g(this->reserve(kMaxFormattedFloatSize), value)) {
+        fWrite = end;
+    } else {
+        this->appendf("%g", value);
+    }
+}
+
+void SkJSONWriter::appendDouble(double value) {
+    this->beginValue();
+    // Most doubles written out are widened floats.
+    const auto f = static_cast<float>(value);
+    char* end = static_cast<double>(f) == value
+            ? format_g(this->reserve(kMaxFormattedFloatSize), f)
+            : nullptr;
+    if (end) {
+        fWrite = end;
+    } else {
+        this->appendf("%g", value);
+    }
+}
+
+void SkJSONWriter::appendHexU32(uint32_t value) {
+    this->beginValue();
+    this->appendHex(value);
 }
 
 void SkJSONWriter::appendHexU64(uint64_t value) {
     this->beginValue();
-    this->appendf("\"0x%" PRIx64 "\"", value);
+    this->appendHex(value);
+}
+
+void SkJSONWriter::appendHex(uint64_t value) {
+    char buf[2 * sizeof(uint64_t)];
+    char* p = buf + std::size(buf);
+    do {
+        *--p = SkHexadecimalDigits::gLower[value & 0xf];
+        value >>= 4;
+    } while (value);
+
+    this->write("\"0x", 3);
+    this->write(p, buf + std::size(buf) - p);
+    this->write("\"", 1);
+}
+
+void SkJSONWriter::writeUnicodeEscape(SkUnichar u) {
+    SkASSERT(u >= 0 && u <= 0xffff);
+    const char escape[] = {
+        '\\', 'u',
+        SkHexadecimalDigits::gUpper[(u >> 12) & 0xf],
+        SkHexadecimalDigits::gUpper[(u >>  8) & 0xf],
+        SkHexadecimalDigits::gUpper[(u >>  4) & 0xf],
+        SkHexadecimalDigits::gUpper[(u >>  0) & 0xf],
+    };
+    this->write(escape, std::size(escape));
 }
 
 void SkJSONWriter::appendf(const char* fmt, ...) {
@@ -8,6 +8,7 @@
 #ifndef SkJSONWriter_DEFINED
 #define SkJSONWriter_DEFINED
 
+#include "include/core/SkSpan.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
@@ -17,6 +18,7 @@
 
 #include <cstring>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <type_traits>
 
@@ -34,6 +36,8 @@
  *
  *  Note that all error checking is in the form of asserts - invalid usage in a non-debug build
  *  will simply produce invalid JSON.
+ *
+ *  For compressed output, write to an SkDeflateWStream (in gzip mode) wrapping the destination.
  */
 class SkJSONWriter : SkNoncopyable {
 public:
@@ -55,19 +59,25 @@ public:
      *  Construct a JSON writer that will serialize all the generated JSON to 'stream'.
      */
     SkJSONWriter(SkWStream* stream, Mode mode = Mode::kFast)
-            : fBlock(new char[kBlockSize])
-            , fWrite(fBlock)
-            , fBlockEnd(fBlock + kBlockSize)
-            , fStream(stream)
-            , fMode(mode)
-            , fState(State::kStart) {
-        fScopeStack.push_back(Scope::kNone);
-        fNewlineStack.push_back(true);
+            : SkJSONWriter(stream, new char[kBlockSize], kBlockSize, mode) {
+        fOwnedBlock.reset(fBlock);
+    }
+
+    static constexpr size_t kMinBufferSize = 256;
+
+    /**
+     *  Construct a JSON writer that buffers its output in a caller-supplied block instead of
+     *  allocating one. For bulk output (e.g. large debugger dumps), a large block can be allocated
+     *  once and reused across writers. The block must be at least kMinBufferSize chars, and must
+     *  outlive the writer.
+     */
+    SkJSONWriter(SkWStream* stream, SkSpan<char> buffer, Mode mode = Mode::kFast)
+            : SkJSONWriter(stream, buffer.data(), buffer.size(), mode) {
+        SkASSERT(buffer.size() >= kMinBufferSize);
     }
 
     ~SkJSONWriter() {
         this->flush();
-        delete[] fBlock;
         SkASSERT(fScopeStack.size() == 1);
         SkASSERT(fNewlineStack.size() == 1);
     }
@@ -179,6 +189,17 @@ public:
         if (value) {
             char const * const end = value + size;
             while (value < end) {
+                // Copy runs of plain ASCII in bulk.
+                char const * run = value;
+                while (run < end && !NeedsEscapeOrValidation(*run)) {
+                    ++run;
+                }
+                if (run != value) {
+                    this->write(value, run - value);
+                    value = run;
+                    continue;
+                }
+
                 char const * next = value;
                 SkUnichar u = SkUTF::NextUTF8(&next, end);
                 switch (u) {
@@ -192,13 +213,9 @@ public:
                     default: {
                         if (u < 0) {
                             next = value + 1;
-                            SkString s("\\u");
-                            s.appendHex((unsigned char)*value, 4);
-                            this->write(s.c_str(), s.size());
+                            this->writeUnicodeEscape((unsigned char)*value);
                         } else if (u < 0x20) {
-                            SkString s("\\u");
-                            s.appendHex(u, 4);
-                            this->write(s.c_str(), s.size());
+                            this->writeUnicodeEscape(u);
                         } else {
                             this->write(value, next - value);
                         }
@@ -234,12 +251,12 @@ public:
             this->write("false", 5);
         }
     }
-    void appendS32(int32_t value) { this->beginValue(); this->appendf("%d", value); }
+    void appendS32(int32_t value);
     void appendS64(int64_t value);
-    void appendU32(uint32_t value) { this->beginValue(); this->appendf("%u", value); }
+    void appendU32(uint32_t value);
     void appendU64(uint64_t value);
-    void appendFloat(float value) { this->beginValue(); this->appendf("%g", value); }
-    void appendDouble(double value) { this->beginValue(); this->appendf("%g", value); }
+    void appendFloat(float value);
+    void appendDouble(double value);
     void appendFloatDigits(float value, int digits) {
         this->beginValue();
         this->appendf("%.*g", digits, value);
@@ -248,7 +265,7 @@ public:
         this->beginValue();
         this->appendf("%.*g", digits, value);
     }
-    void appendHexU32(uint32_t value) { this->beginValue(); this->appendf("\"0x%x\"", value); }
+    void appendHexU32(uint32_t value);
     void appendHexU64(uint64_t value);
 
     void appendString(const char* name, const char* value, size_t size) {
@@ -327,7 +344,25 @@ private:
         kArrayValue,
     };
 
+    SkJSONWriter(SkWStream* stream, char* block, size_t blockSize, Mode mode)
+            : fBlock(block)
+            , fWrite(fBlock)
+            , fBlockEnd(fBlock + blockSize)
+            , fStream(stream)
+            , fMode(mode)
+            , fState(State::kStart) {
+        fScopeStack.push_back(Scope::kNone);
+        fNewlineStack.push_back(true);
+    }
+
     void appendf(const char* fmt, ...) SK_PRINTF_LIKE(2, 3);
+    void appendHex(uint64_t value);
+    void writeUnicodeEscape(SkUnichar u);
+
+    static bool NeedsEscapeOrValidation(char c) {
+        const auto u = static_cast<unsigned char>(c);
+        return u < 0x20 || u >= 0x80 || c == '"' || c == '\\';
+    }
 
     void beginValue(bool structure = false) {
         SkASSERT(State::kObjectName == fState ||
@@ -366,14 +401,24 @@ private:
         if (static_cast<size_t>(fBlockEnd - fWrite) < length) {
             // Don't worry about splitting writes that overflow our block.
             this->flush();
+            if (static_cast<size_t>(fBlockEnd - fBlock) < length) {
+                // Send particularly large writes straight through to the stream (unbuffered).
+                fStream->write(buf, length);
+                return;
+            }
         }
-        if (length > kBlockSize) {
-            // Send particularly large writes straight through to the stream (unbuffered).
-            fStream->write(buf, length);
-        } else {
-            memcpy(fWrite, buf, length);
-            fWrite += length;
+        memcpy(fWrite, buf, length);
+        fWrite += length;
+    }
+
+    // Returns space for at least 'length' (<= kMinBufferSize) chars, to format values in place.
+    // Callers advance fWrite past the chars they actually write.
+    char* reserve(size_t length) {
+        SkASSERT(length <= kMinBufferSize);
+        if (static_cast<size_t>(fBlockEnd - fWrite) < length) {
+            this->flush();
         }
+        return fWrite;
     }
 
     Scope scope() const {
@@ -405,6 +450,7 @@ private:
         }
     }
 
+    std::unique_ptr<char[]> fOwnedBlock;
     char* fBlock;
     char* fWrite;
     char* fBlockEnd;
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkColor.h"
+#include "include/private/base/SkFixed.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkAlphaSpans.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Each test compares the SIMD span helpers with the one pixel at a time loops that
+// SkScan_AAAPath.cpp used before, on random spans of a buffer that start at any offset.
+static constexpr int kBufferSize = 160;
+static constexpr int kIterations = 2000;
+
+struct Span {
+    int offset;
+    int len;
+};
+
+static Span random_span(SkRandom* rand) {
+    const int len = rand->nextULessThan(kBufferSize / 2 + 1);
+    return {static_cast<int>(rand->nextULessThan(kBufferSize - len + 1)), len};
+}
+
+static void fill_random(SkRandom* rand, SkAlpha alphas[]) {
+    for (int i = 0; i < kBufferSize; ++i) {
+        alphas[i] = rand->nextULessThan(256);
+    }
+}
+
+static void check_equal(skiatest::Reporter* r, const SkAlpha expected[], const SkAlpha actual[],
+                        const Span& span) {
+    REPORTER_ASSERT(r, !memcmp(expected, actual, kBufferSize),
+                    "span at %d of length %d", span.offset, span.len);
+}
+
+DEF_TEST(AlphaSpans_SaturatedAdd, r) {
+    SkRandom rand;
+    SkAlpha deltas[kBufferSize], expected[kBufferSize], actual[kBufferSize];
+    for (int iteration = 0; iteration < kIterations; ++iteration) {
+        fill_random(&rand, deltas);
+        fill_random(&rand, expected);
+        memcpy(actual, expected, kBufferSize);
+
+        const Span span = random_span(&rand);
+        for (int i = span.offset; i < span.offset + span.len; ++i) {
+            expected[i] = std::min(0xFF, expected[i] + deltas[i]);
+        }
+        SkAlphaSpans::SaturatedAdd(actual + span.offset, deltas + span.offset, span.len);
+        check_equal(r, expected, actual, span);
+
+        const SkAlpha delta = rand.nextULessThan(256);
+        for (int i = span.offset; i < span.offset + span.len; ++i) {
+            expected[i] = std::min(0xFF, expected[i] + delta);
+        }
+        SkAlphaSpans::SaturatedAdd(actual + span.offset, delta, span.len);
+        check_equal(r, expected, actual, span);
+    }
+}
+
+DEF_TEST(AlphaSpans_SaturatedSubtract, r) {
+    SkRandom rand;
+    SkAlpha deltas[kBufferSize], expected[kBufferSize], actual[kBufferSize];
+    for (int iteration = 0; iteration < kIterations; ++iteration) {
+        fill_random(&rand, deltas);
+        fill_random(&rand, expected);
+        memcpy(actual, expected, kBufferSize);
+
+        const Span span = random_span(&rand);
+        for (int i = span.offset; i < span.offset + span.len; ++i) {
+            if (expected[i] > deltas[i]) {
+                expected[i] -= deltas[i];
+            } else {
+                expected[i] = 0;
+            }
+        }
+        SkAlphaSpans::SaturatedSubtract(actual + span.offset, deltas + span.offset, span.len);
+        check_equal(r, expected, actual, span);
+    }
+}
+
+DEF_TEST(AlphaSpans_FillRamp, r) {
+    SkRandom rand;
+    SkAlpha expected[kBufferSize], actual[kBufferSize];
+    for (int iteration = 0; iteration < kIterations; ++iteration) {
+        fill_random(&rand, expected);
+        memcpy(actual, expected, kBufferSize);
+
+        // Ramps go up and down, and may run past 0 or 0xFF, where only the low 8 bits are kept.
+        const Span span = random_span(&rand);
+        const SkFixed alpha16 = rand.nextRangeU(0, 0x10000),
+                      dY = static_cast<SkFixed>(rand.nextRangeU(0, 0x20000)) - 0x10000;
+        SkFixed ramp = alpha16;
+        for (int i = span.offset; i < span.offset + span.len; ++i) {
+            expected[i] = (ramp >> 8) & 0xFF;
+            ramp += dY;
+        }
+        SkAlphaSpans::FillRamp(actual + span.offset, span.len, alpha16, dY);
+        check_equal(r, expected, actual, span);
+    }
+}
@@ -5,12 +5,15 @@
 * found in the LICENSE file.
 */
 
+#include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/private/base/SkTDArray.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkIPoint16.h"
 #include "src/gpu/Rectanizer.h"
+#include "src/gpu/RectanizerGuillotine.h"
+#include "src/gpu/RectanizerMaxRects.h"
 #include "src/gpu/RectanizerPow2.h"
 #include "src/gpu/RectanizerSkyline.h"
 #include "tests/CtsEnforcement.h"
@@ -36,15 +39,26 @@ static void test_rectanizer_basic(skiatest::Reporter* reporter, Rectanizer* rect
     REPORTER_ASSERT(reporter, rectanizer->percentFull() == 0.0f);
 }
 
-static void test_rectanizer_inserts(skiatest::Reporter*,
+static void test_rectanizer_inserts(skiatest::Reporter* reporter,
                                     Rectanizer* rectanizer,
                                     const SkTDArray<SkISize>& rects) {
+    SkTDArray<SkIRect> placed;
     int i;
     for (i = 0; i < rects.size(); ++i) {
         SkIPoint16 loc;
         if (!rectanizer->addRect(rects[i].fWidth, rects[i].fHeight, &loc)) {
             break;
         }
+        placed.push_back(SkIRect::MakeXYWH(loc.fX, loc.fY, rects[i].fWidth, rects[i].fHeight));
+    }
+
+    // Every rect is inside the rectanizer and they don't overlap.
+    const SkIRect bounds = SkIRect::MakeWH(rectanizer->width(), rectanizer->height());
+    for (int j = 0; j < placed.size(); ++j) {
+        REPORTER_ASSERT(reporter, bounds.contains(placed[j]));
+        for (int k = 0; k < j; ++k) {
+            REPORTER_ASSERT(reporter, !SkIRect::Intersects(placed[j], placed[k]));
+        }
     }
 
     //SkDebugf("\n***%d %f\n", i, rectanizer->percentFull());
@@ -64,6 +78,20 @@ static void test_pow2(skiatest::Reporter* reporter, const SkTDArray<SkISize>& re
     test_rectanizer_inserts(reporter, &pow2Rectanizer, rects);
 }
 
+static void test_guillotine(skiatest::Reporter* reporter, const SkTDArray<SkISize>& rects) {
+    RectanizerGuillotine guillotineRectanizer(kWidth, kHeight);
+
+    test_rectanizer_basic(reporter, &guillotineRectanizer);
+    test_rectanizer_inserts(reporter, &guillotineRectanizer, rects);
+}
+
+static void test_maxrects(skiatest::Reporter* reporter, const SkTDArray<SkISize>& rects) {
+    RectanizerMaxRects maxRectsRectanizer(kWidth, kHeight);
+
+    test_rectanizer_basic(reporter, &maxRectsRectanizer);
+    test_rectanizer_inserts(reporter, &maxRectsRectanizer, rects);
+}
+
 DEF_GANESH_TEST(GpuRectanizer, reporter, factory, CtsEnforcement::kNever) {
     SkTDArray<SkISize> rects;
     SkRandom rand;
@@ -75,4 +103,16 @@ DEF_GANESH_TEST(GpuRectanizer, reporter, factory, CtsEnforcement::kNever) {
 
     test_skyline(reporter, rects);
     test_pow2(reporter, rects);
+    test_guillotine(reporter, rects);
+    test_maxrects(reporter, rects);
+
+    // Many small rects, like glyphs, fill the rectanizers up.
+    SkTDArray<SkISize> glyphs;
+    for (int i = 0; i < 5000; i++) {
+        glyphs.push_back(SkISize::Make(rand.nextRangeU(4, 40), rand.nextRangeU(4, 40)));
+    }
+    test_skyline(reporter, glyphs);
+    test_pow2(reporter, glyphs);
+    test_guillotine(reporter, glyphs);
+    test_maxrects(reporter, glyphs);
 }
@@ -616,3 +616,42 @@ DEF_TEST(Gradient, reporter) {
     test_sweep_fuzzer(reporter);
     test_unsorted_degenerate(reporter);
 }
+
+// Gradients with the same stops share their evaluated stops when drawn with the raster backend.
+// Make sure that shaders which differ only in their stops, or destinations which differ in their
+// color space, don't get each other's stops.
+DEF_TEST(Gradient_SharedStops, reporter) {
+    const SkPoint pts[] = {{0, 0}, {64, 0}};
+    const SkColor4f colors[] = {SkColors::kRed, SkColors::kGreen, SkColors::kBlue,
+                                SkColors::kYellow, SkColors::kCyan, SkColors::kMagenta};
+    const float positions[] = {0, 0.1f, 0.4f, 0.45f, 0.8f, 1};
+    const float otherPositions[] = {0, 0.1f, 0.4f, 0.5f, 0.8f, 1};
+
+    auto draw = [&](const float* pos, sk_sp<SkColorSpace> dstCS) {
+        sk_sp<SkShader> shader = SkGradientShader::MakeLinear(
+                pts, colors, /*colorSpace=*/nullptr, pos, std::size(colors), SkTileMode::kClamp);
+        SkBitmap bitmap;
+        bitmap.allocPixels(SkImageInfo::MakeN32Premul(64, 1, std::move(dstCS)));
+        SkCanvas canvas(bitmap);
+        SkPaint paint;
+        paint.setShader(std::move(shader));
+        canvas.drawPaint(paint);
+        return bitmap;
+    };
+    auto same_pixels = [](const SkBitmap& a, const SkBitmap& b) {
+        return 0 == memcmp(a.getPixels(), b.getPixels(), a.computeByteSize());
+    };
+
+    sk_sp<SkColorSpace> p3 = SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB,
+                                                   SkNamedGamut::kDisplayP3);
+    const SkBitmap srgb = draw(positions, nullptr),
+                   displayP3 = draw(positions, p3),
+                   other = draw(otherPositions, nullptr);
+    REPORTER_ASSERT(reporter, !same_pixels(srgb, displayP3));
+    REPORTER_ASSERT(reporter, !same_pixels(srgb, other));
+
+    // New shaders with the same stops draw the same pixels.
+    REPORTER_ASSERT(reporter, same_pixels(srgb, draw(positions, nullptr)));
+    REPORTER_ASSERT(reporter, same_pixels(displayP3, draw(positions, p3)));
+    REPORTER_ASSERT(reporter, same_pixels(other, draw(otherPositions, nullptr)));
+}
@@ -11,10 +11,17 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkFloatBits.h"
+#include "src/base/SkRandom.h"
 #include "src/utils/SkJSON.h"
+#include "src/utils/SkJSONWriter.h"
 #include "tests/Test.h"
 
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <limits>
+#include <string>
 #include <string_view>
 
 using namespace skjson;
@@ -151,6 +158,51 @@ DEF_TEST(JSON_Parse, reporter) {
 
 }
 
+DEF_TEST(JSON_ParseLongRuns, reporter) {
+    // Whitespace and string runs straddling the block scanning boundaries, with the terminating
+    // chars at all possible block offsets.
+    for (size_t len = 0; len < 80; ++len) {
+        const std::string chars(len, 'a'),
+                          ws(len, ' ');
+
+        auto parse = [&](const std::string& json) -> std::string {
+            const DOM dom(json.c_str(), json.size());
+            if (dom.root().is<NullValue>()) {
+                return "<fail>";
+            }
+            SkDynamicMemoryWStream str;
+            dom.write(&str);
+            const auto data = str.detachAsData();
+            return std::string(static_cast<const char*>(data->data()), data->size());
+        };
+
+        const std::string expected = "[\"" + chars + "\"]";
+
+        REPORTER_ASSERT(reporter, parse("[\"" + chars + "\"]") == expected);
+        REPORTER_ASSERT(reporter, parse(ws + "[" + ws + "\"" + chars + "\"" + ws + "]" + ws)
+                                  == expected);
+        REPORTER_ASSERT(reporter, parse("[\n\t\r" + ws + "\"" + chars + "\"\r\t\n]")
+                                  == expected);
+
+        // Escapes and structural chars embedded in long strings.
+        REPORTER_ASSERT(reporter, parse("[\"" + chars + "\\/" + chars + "\"]")
+                                  == "[\"" + chars + "/" + chars + "\"]");
+        REPORTER_ASSERT(reporter, parse("[\"" + chars + "]}" + chars + "\"]")
+                                  == "[\"" + chars + "]}" + chars + "\"]");
+
+        // Unterminated or invalid long strings.
+        REPORTER_ASSERT(reporter, parse("[\"" + chars) == "<fail>");
+        REPORTER_ASSERT(reporter, parse("[\"" + chars + "\n" + chars + "\"]") == "<fail>");
+        REPORTER_ASSERT(reporter, parse("[\"" + chars + "\"" + ws) == "<fail>");
+
+        // Control chars in (long) whitespace runs.
+        REPORTER_ASSERT(reporter, parse("[ \x01 1" + ws + "]") == "<fail>");
+        REPORTER_ASSERT(reporter, parse("[" + ws + "\x01" + ws + "1]") == "<fail>");
+        REPORTER_ASSERT(reporter, parse("[1" + ws + "\x0b" + ws + "]") == "<fail>");
+        REPORTER_ASSERT(reporter, parse("[1" + ws + std::string(1, '\0') + ws + "]") == "<fail>");
+    }
+}
+
 template <typename T, typename VT>
 static void check_primitive(skiatest::Reporter* reporter, const Value& v, T pv,
                             bool is_type) {
@@ -535,3 +587,150 @@ DEF_TEST(JSON_Writable, r) {
     REPORTER_ASSERT(r, root.toString() ==
         SkString(R"({"null":42,"num":"foo","new":true,"newobj":{"newprop":-1}})"));
 }
+
+DEF_TEST(JSON_Binary, r) {
+    static constexpr const char* gTests[] = {
+        "{}",
+        "[]",
+        R"({"a": null, "b": [true, false, 1, -2.5, "short", "a somewhat longer string"]})",
+        R"([[[[]]], {"": {"nested": {"deeper": [1, [2, [3]]]}}}, "", "123456", "1234567"])",
+        R"({"layers": [{"ty": 4, "ks": {"o": {"a": 0, "k": 100}}, "nm": "Shape Layer 1"}]})",
+    };
+
+    for (const char* json : gTests) {
+        const DOM dom(json, strlen(json));
+        SkDynamicMemoryWStream stream;
+        dom.writeBinary(&stream);
+        const sk_sp<SkData> image = stream.detachAsData();
+        REPORTER_ASSERT(r, DOM::IsBinary(image->data(), image->size()));
+        REPORTER_ASSERT(r, !DOM::IsBinary(json, strlen(json)));
+
+        const auto loaded = DOM::MakeFromBinary(image->data(), image->size());
+        REPORTER_ASSERT(r, loaded);
+        if (!loaded) {
+            continue;
+        }
+        REPORTER_ASSERT(r, loaded->root().toString() == dom.root().toString(), "%s", json);
+
+        // Truncated and corrupted images must be rejected, or at least load safely.
+        for (size_t size = 0; size < image->size(); ++size) {
+            REPORTER_ASSERT(r, !DOM::MakeFromBinary(image->data(), size));
+        }
+        auto corrupt = SkData::MakeWithCopy(image->data(), image->size());
+        auto* bytes = static_cast<uint8_t*>(corrupt->writable_data());
+        for (size_t i = 0; i < corrupt->size(); ++i) {
+            for (uint8_t bit = 1; bit; bit <<= 1) {
+                bytes[i] ^= bit;
+                if (const auto dom = DOM::MakeFromBinary(bytes, corrupt->size())) {
+                    dom->root().toString();
+                }
+                bytes[i] ^= bit;
+            }
+        }
+    }
+}
+
+DEF_TEST(JSON_Writer_Numbers, r) {
+    // Float formatting matches "%g".
+    auto check_float = [&](float f) {
+        SkDynamicMemoryWStream stream;
+        {
+            SkJSONWriter writer(&stream);
+            writer.beginArray();
+            writer.appendFloat(f);
+            writer.appendDouble(f);
+            writer.endArray();
+        }
+        char expected[64];
+        snprintf(expected, sizeof(expected), "[%g,%g]", f, f);
+        const auto data = stream.detachAsData();
+        const std::string actual(static_cast<const char*>(data->data()), data->size());
+        REPORTER_ASSERT(r, actual == expected, "%s vs. %s", actual.c_str(), expected);
+    };
+
+    for (float f : { 0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 0.25f, 1.5f, 100.0f, 123456.0f, 999999.0f,
+                     1000000.0f, 999999.5f, 999999.4f, 9.9999999f, 0.1f, 0.2f, 0.3f, 1e-4f,
+                     9.9999e-5f, 1e-5f, 3.14159265f, 1e10f, 1e-10f, 65535.99f,
+                     std::numeric_limits<float>::max(), std::numeric_limits<float>::min(),
+                     std::numeric_limits<float>::denorm_min(),
+                     std::numeric_limits<float>::infinity() }) {
+        check_float( f);
+        check_float(-f);
+    }
+
+    SkRandom rand;
+    for (int i = 0; i < 10000; ++i) {
+        check_float(rand.nextRangeF(-1000, 1000));
+        check_float(rand.nextRangeF(-1, 1));
+        check_float(static_cast<float>(rand.nextULessThan(4000000)) * 0.25f);
+        check_float(SkBits2Float(rand.nextU()));
+    }
+
+    // Doubles which are not floats, and integers.
+    SkDynamicMemoryWStream stream;
+    {
+        SkJSONWriter writer(&stream);
+        writer.beginArray();
+        writer.appendDouble(0.1);
+        writer.appendDouble(1e100);
+        writer.appendS32(std::numeric_limits<int32_t>::min());
+        writer.appendS32(0);
+        writer.appendU32(std::numeric_limits<uint32_t>::max());
+        writer.appendS64(std::numeric_limits<int64_t>::min());
+        writer.appendU64(std::numeric_limits<uint64_t>::max());
+        writer.appendHexU32(0);
+        writer.appendHexU32(0xdeadbeef);
+        writer.appendHexU64(0x0123456789abcdef);
+        writer.endArray();
+    }
+    const auto data = stream.detachAsData();
+    const std::string actual(static_cast<const char*>(data->data()), data->size());
+    REPORTER_ASSERT(r, actual == "[0.1,1e+100,-2147483648,0,4294967295,"
+                                 "-9223372036854775808,18446744073709551615,"
+                                 "\"0x0\",\"0xdeadbeef\",\"0x123456789abcdef\"]",
+                    "%s", actual.c_str());
+}
+
+DEF_TEST(JSON_Writer_Buffer, r) {
+    const std::string long_str(3 * SkJSONWriter::kMinBufferSize, 'x');
+    const char escaped[] = "quote\" backslash\\ tab\t ctrl\x01 invalid\xff utf8\xc3\xa9";
+
+    auto write = [&](SkJSONWriter& writer) {
+        writer.beginObject();
+        for (int i = 0; i < 20; ++i) {
+            writer.appendString("long", long_str);
+            writer.appendNString("escaped", escaped);
+            writer.appendFloat("float", 1.25f * i);
+            writer.appendS32("int", -i);
+        }
+        writer.endObject();
+    };
+
+    for (auto mode : { SkJSONWriter::Mode::kFast, SkJSONWriter::Mode::kPretty }) {
+        SkDynamicMemoryWStream expected_stream;
+        {
+            SkJSONWriter writer(&expected_stream, mode);
+            write(writer);
+        }
+        const auto expected = expected_stream.detachAsData();
+
+        // A small caller-supplied buffer, reused across writers.
+        char buffer[SkJSONWriter::kMinBufferSize];
+        for (int i = 0; i < 2; ++i) {
+            SkDynamicMemoryWStream stream;
+            {
+                SkJSONWriter writer(&stream, buffer, mode);
+                write(writer);
+            }
+            REPORTER_ASSERT(r, stream.detachAsData()->equals(expected.get()));
+        }
+
+        // The default writer output parses back.
+        const DOM dom(static_cast<const char*>(expected->data()), expected->size());
+        const ObjectValue* root = dom.root();
+        REPORTER_ASSERT(r, root && root->size() == 80);
+        const StringValue* str = (*root)["escaped"];
+        REPORTER_ASSERT(r, str && str->str() ==
+                           "quote\" backslash\\ tab\t ctrl\x01 invalid\u00FF utf8\xc3\xa9");
+    }
+}
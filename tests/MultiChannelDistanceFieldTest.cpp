@@ -0,0 +1,211 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+
+#if !defined(SK_DISABLE_SDF_TEXT)
+
+#include "include/core/SkExecutor.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkFontTypes.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSpan.h"
+#include "src/core/SkDistanceFieldGen.h"
+#include "src/core/SkMultiChannelDistanceField.h"
+#include "tests/Test.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace {
+struct Field {
+    int fWidth, fHeight;
+    std::vector<uint8_t> fTexels;
+
+    // Sample channel c with bilinear filtering, as the GPU would, and return the distance in
+    // texels, positive inside.
+    float sample(float x, float y, int c) const {
+        x = std::clamp(x - 0.5f, 0.0f, fWidth - 1.0f);
+        y = std::clamp(y - 0.5f, 0.0f, fHeight - 1.0f);
+        int x0 = std::min((int)x, fWidth - 2), y0 = std::min((int)y, fHeight - 2);
+        float fx = x - x0, fy = y - y0;
+        auto at = [&](int tx, int ty) { return (float)fTexels[4 * (ty * fWidth + tx) + c]; };
+        float top = at(x0, y0) + (at(x0 + 1, y0) - at(x0, y0)) * fx;
+        float bottom = at(x0, y0 + 1) + (at(x0 + 1, y0 + 1) - at(x0, y0 + 1)) * fx;
+        float value = top + (bottom - top) * fy;
+        return (value / 256.0f * 2 - 1) * SK_DistanceFieldMagnitude;
+    }
+
+    float median(float x, float y) const {
+        float r = this->sample(x, y, 0), g = this->sample(x, y, 1), b = this->sample(x, y, 2);
+        return std::max(std::min(r, g), std::min(std::max(r, g), b));
+    }
+};
+
+Field make_field(skiatest::Reporter* reporter, const SkPath& path, float scale) {
+    SkRect bounds = SkMatrix::Scale(scale, scale).mapRect(path.getBounds());
+    Field field;
+    field.fWidth = SkScalarCeilToInt(bounds.width()) + 2 * SK_DistanceFieldPad;
+    field.fHeight = SkScalarCeilToInt(bounds.height()) + 2 * SK_DistanceFieldPad;
+    field.fTexels.resize(4 * field.fWidth * field.fHeight);
+    SkMatrix matrix = SkMatrix::Scale(scale, scale)
+                              .postTranslate(SK_DistanceFieldPad - bounds.fLeft,
+                                             SK_DistanceFieldPad - bounds.fTop);
+    REPORTER_ASSERT(reporter,
+                    SkGenerateMultiChannelDistanceField(field.fTexels.data(), path, matrix,
+                                                        field.fWidth, field.fHeight,
+                                                        4 * field.fWidth));
+    return field;
+}
+
+// Count the points, on a grid finer than the texels, that the median puts on the wrong side
+// of the outline. Points within margin texels of the outline are left out.
+int count_misses(const Field& field, const SkPath& path, float scale, float margin,
+                 int channel = -1) {
+    SkRect bounds = SkMatrix::Scale(scale, scale).mapRect(path.getBounds());
+    SkMatrix toPath = SkMatrix::Translate(bounds.fLeft - SK_DistanceFieldPad,
+                                          bounds.fTop - SK_DistanceFieldPad)
+                              .postScale(1 / scale, 1 / scale);
+    int misses = 0;
+    for (float y = 0; y < field.fHeight; y += 0.25f) {
+        for (float x = 0; x < field.fWidth; x += 0.25f) {
+            float distance = channel < 0 ? field.median(x, y) : field.sample(x, y, channel);
+            if (std::fabs(distance) < margin) {
+                continue;
+            }
+            SkPoint p = toPath.mapPoint({x, y});
+            if ((distance > 0) != path.contains(p.fX, p.fY)) {
+                misses += 1;
+            }
+        }
+    }
+    return misses;
+}
+
+SkPath star() {
+    SkPath path;
+    for (int i = 0; i < 10; ++i) {
+        float angle = i * SK_ScalarPI / 5, radius = i % 2 ? 4 : 10;
+        SkPoint p = {10 + radius * std::sin(angle), 10 - radius * std::cos(angle)};
+        i == 0 ? path.moveTo(p) : path.lineTo(p);
+    }
+    path.close();
+    return path;
+}
+
+SkPath ring() {
+    // An 'o' with the counter wound the other way, like a glyph.
+    SkPath path;
+    path.addCircle(10, 10, 10, SkPathDirection::kCW);
+    path.addCircle(10, 10, 5, SkPathDirection::kCCW);
+    return path;
+}
+
+SkPath teardrop() {
+    // One corner, between two curves.
+    SkPath path;
+    path.moveTo(10, 0);
+    path.quadTo(25, 20, 10, 20);
+    path.quadTo(-5, 20, 10, 0);
+    path.close();
+    return path;
+}
+
+SkPath letter_d() {
+    SkPath path;
+    path.moveTo(0, 0);
+    path.lineTo(8, 0);
+    path.cubicTo(20, 0, 20, 20, 8, 20);
+    path.lineTo(0, 20);
+    path.close();
+    path.moveTo(4, 4);
+    path.lineTo(4, 16);
+    path.lineTo(8, 16);
+    path.quadTo(14, 10, 8, 4);
+    path.close();
+    return path;
+}
+}  // namespace
+
+DEF_TEST(SkMultiChannelDistanceField_Fill, reporter) {
+    SkPath reversedStar;
+    reversedStar.reverseAddPath(star());
+    for (const SkPath& path : {star(), reversedStar, ring(), teardrop(), letter_d()}) {
+        for (float scale : {0.5f, 1.0f, 3.0f}) {
+            Field field = make_field(reporter, path, scale);
+            REPORTER_ASSERT(reporter, count_misses(field, path, scale, 0.5f) == 0,
+                            "scale %g", scale);
+        }
+    }
+}
+
+DEF_TEST(SkMultiChannelDistanceField_SharpCorners, reporter) {
+    // Magnified, a single channel field rounds off the points of the star.
+    const SkPath path = star();
+    const float scale = 0.5f;
+    Field field = make_field(reporter, path, scale);
+    int multiChannelMisses = count_misses(field, path, scale, 0.05f);
+    int singleChannelMisses = count_misses(field, path, scale, 0.05f, /*channel=*/3);
+    REPORTER_ASSERT(reporter, multiChannelMisses < singleChannelMisses / 2,
+                    "%d %d", multiChannelMisses, singleChannelMisses);
+}
+
+DEF_TEST(SkMultiChannelDistanceField_SmoothOutline, reporter) {
+    // Without corners, all the channels are the same.
+    SkPath path = SkPath::Circle(10, 10, 10);
+    Field field = make_field(reporter, path, 1);
+    for (size_t i = 0; i < field.fTexels.size(); i += 4) {
+        REPORTER_ASSERT(reporter, field.fTexels[i] == field.fTexels[i + 1] &&
+                                  field.fTexels[i] == field.fTexels[i + 2]);
+    }
+}
+
+DEF_TEST(SkMultiChannelDistanceField_Glyphs, reporter) {
+    SkFont font(ToolUtils::DefaultPortableTypeface(), 48);
+    SkGlyphID glyphs[4];
+    REPORTER_ASSERT(reporter, font.textToGlyphs("Skia", 4, SkTextEncoding::kUTF8, glyphs, 4) == 4);
+    for (SkGlyphID glyph : glyphs) {
+        SkPath path;
+        REPORTER_ASSERT(reporter, font.getPath(glyph, &path) && !path.isEmpty());
+        Field field = make_field(reporter, path, 1);
+        REPORTER_ASSERT(reporter, count_misses(field, path, 1, 0.5f) == 0, "glyph %d", glyph);
+    }
+}
+
+DEF_TEST(SkMultiChannelDistanceField_Executor, reporter) {
+    const SkPath paths[] = {star(), ring(), teardrop(), letter_d(),
+                            SkPath::Rect({0, 0, 12, 7})};
+    auto generate = [&](SkExecutor* executor) {
+        std::vector<std::vector<uint8_t>> fields;
+        std::vector<SkMultiChannelDistanceFieldJob> jobs;
+        fields.reserve(std::size(paths));
+        for (const SkPath& path : paths) {
+            const int size = 20 + 2 * SK_DistanceFieldPad;
+            fields.emplace_back(4 * size * size);
+            jobs.push_back({&path, SkMatrix::Translate(SK_DistanceFieldPad, SK_DistanceFieldPad),
+                            size, size, fields.back().data(), 4 * (size_t)size});
+        }
+        SkGenerateMultiChannelDistanceFields(jobs, executor);
+        for (const SkMultiChannelDistanceFieldJob& job : jobs) {
+            REPORTER_ASSERT(reporter, job.fSucceeded);
+        }
+        return fields;
+    };
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    REPORTER_ASSERT(reporter, generate(nullptr) == generate(executor.get()));
+}
+
+#endif // !defined(SK_DISABLE_SDF_TEXT)
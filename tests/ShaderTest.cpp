@@ -104,6 +104,57 @@ DEF_TEST(ComposeShaderSingle, reporter) {
     canvas.drawRRect(rr, p);
 }
 
+DEF_TEST(PerlinNoise_CachedTile, reporter) {
+    const SkISize tileSize = {40, 30};
+    auto draw = [&](sk_sp<SkShader> shader) {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(2 * tileSize.width(), 2 * tileSize.height());
+        SkCanvas canvas(bitmap);
+        SkPaint paint;
+        paint.setShader(std::move(shader));
+        paint.setBlendMode(SkBlendMode::kSrc);
+        canvas.drawPaint(paint);
+        return bitmap;
+    };
+
+    for (bool turbulence : {false, true}) {
+        auto make = turbulence ? SkShaders::MakeTurbulence : SkShaders::MakeFractalNoise;
+        auto makeCached = turbulence ? SkShaders::MakeCachedTurbulence
+                                     : SkShaders::MakeCachedFractalNoise;
+
+        sk_sp<SkShader> cached = makeCached(0.05f, 0.1f, 3, 4, tileSize);
+        const SkBitmap expected = draw(make(0.05f, 0.1f, 3, 4, &tileSize)),
+                       actual = draw(cached);
+
+        // Inside the tile the noise is the same, and outside it repeats.
+        int mismatches = 0;
+        for (int y = 0; y < actual.height(); ++y) {
+            for (int x = 0; x < actual.width(); ++x) {
+                const SkColor tileColor = expected.getColor(x % tileSize.width(),
+                                                            y % tileSize.height());
+                mismatches += actual.getColor(x, y) != tileColor;
+            }
+        }
+        REPORTER_ASSERT(reporter, mismatches == 0, "%d mismatches", mismatches);
+
+        // Shaders with the same parameters share the tile.
+        sk_sp<SkShader> same = makeCached(0.05f, 0.1f, 3, 4, tileSize),
+                        other = makeCached(0.05f, 0.1f, 3, 5, tileSize);
+        SkImage* image = cached->isAImage(nullptr, nullptr);
+        SkImage* sameImage = same->isAImage(nullptr, nullptr);
+        SkImage* otherImage = other->isAImage(nullptr, nullptr);
+        REPORTER_ASSERT(reporter, image && sameImage && otherImage);
+        if (image && sameImage && otherImage) {
+            REPORTER_ASSERT(reporter, image->uniqueID() == sameImage->uniqueID());
+            REPORTER_ASSERT(reporter, image->uniqueID() != otherImage->uniqueID());
+        }
+    }
+
+    // Noise that can't be tiled isn't cached.
+    sk_sp<SkShader> untiled = SkShaders::MakeCachedFractalNoise(0.05f, 0.1f, 3, 4, {0, 0});
+    REPORTER_ASSERT(reporter, untiled && !untiled->isAImage());
+}
+
 // Tests that nested blending will render as expected.
 static void test_nested_blends(skiatest::Reporter* reporter, SkSurface* surface) {
     auto [redEffect, redError] = SkRuntimeEffect::MakeForShader(SkString(R"(
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkData.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkMatrix.h"
@@ -12,6 +13,8 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypeface.h"
+#include "src/core/SkGlyph.h"
+#include "src/core/SkGlyphStore.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrike.h"  // IWYU pragma: keep
 #include "src/core/SkStrikeCache.h"
@@ -20,6 +23,9 @@
 #include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#include <cstring>
+#include <vector>
+
 DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
     SkStrikeCache cache;
 
@@ -61,3 +67,75 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
 
 
 }
+
+DEF_TEST(SkStrikeCache_GlyphStore, Reporter) {
+    SkFont font = ToolUtils::DefaultFont();
+    font.setTypeface(ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Italic()));
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setSize(20);
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    std::vector<SkPackedGlyphID> glyphIDs;
+    for (SkUnichar c = ' '; c < 'z'; c++) {
+        glyphIDs.push_back(SkPackedGlyphID{font.unicharToGlyph(c)});
+    }
+    std::vector<const SkGlyph*> glyphs(glyphIDs.size());
+
+    sk_sp<SkData> data;
+    std::vector<std::vector<uint8_t>> images;
+    {
+        SkStrikeCache cache;
+        sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+        for (const SkGlyph* glyph : strike->prepareImages(glyphIDs, glyphs.data())) {
+            auto image = static_cast<const uint8_t*>(glyph->image());
+            images.emplace_back(image, image + (image ? glyph->imageSize() : 0));
+        }
+        data = cache.serializeGlyphs();
+    }
+
+    sk_sp<SkGlyphStore> store = SkGlyphStore::Make(data);
+    REPORTER_ASSERT(Reporter, store && store->count() == 1);
+    if (!store) {
+        return;
+    }
+
+    // A truncated store is rejected.
+    REPORTER_ASSERT(Reporter,
+                    !SkGlyphStore::Make(SkData::MakeSubset(data.get(), 0, data->size() - 8)));
+
+    SkStrikeCache cache;
+    cache.setGlyphStore(store);
+    {
+        sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+        REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() > 0);
+
+        // The glyphs come from the store, and match the ones made by the scaler context.
+        SkSpan<const SkGlyph*> loaded = strike->prepareImages(glyphIDs, glyphs.data());
+        for (size_t i = 0; i < loaded.size(); ++i) {
+            const void* image = loaded[i]->image();
+            REPORTER_ASSERT(Reporter, (image == nullptr) == images[i].empty());
+            if (image != nullptr) {
+                REPORTER_ASSERT(Reporter, loaded[i]->imageSize() == images[i].size());
+                REPORTER_ASSERT(Reporter,
+                                memcmp(image, images[i].data(), images[i].size()) == 0);
+            }
+        }
+    }
+
+    // Glyphs merged from the store are counted once.
+    cache.purgeAll();
+    REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
+
+    // Only strikes with the same descriptor are found in the store.
+    font.setSize(21);
+    SkStrikeSpec otherSpec = SkStrikeSpec::MakeMask(
+            font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+    SkStrikeCache scratch;
+    SkStrike same{&scratch, strikeSpec, strikeSpec.createScalerContext(), nullptr, nullptr};
+    REPORTER_ASSERT(Reporter, store->mergeInto(&same));
+    SkStrike other{&scratch, otherSpec, otherSpec.createScalerContext(), nullptr, nullptr};
+    REPORTER_ASSERT(Reporter, !store->mergeInto(&other));
+}
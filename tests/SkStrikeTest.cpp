@@ -41,6 +41,7 @@
 #include "tools/fonts/FontToolUtils.h"
 
 #include <atomic>
+#include <cstring>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -292,3 +293,60 @@ DEF_TEST(SkStrike_FlattenByType, reporter) {
     REPORTER_ASSERT(reporter, dstDrawableGlyph->setDrawableHasBeenCalled());
     REPORTER_ASSERT(reporter, dstDrawableGlyph->drawable() != nullptr);
 }
+
+DEF_TEST(SkStrike_PrefillGlyphs, reporter) {
+    SkFont font = ToolUtils::DefaultFont();
+    font.setTypeface(ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Italic()));
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setSubpixel(true);
+    font.setSize(24);
+
+    // Enough glyphs for several tasks, with some repeats.
+    std::vector<SkPackedGlyphID> glyphIDs;
+    for (int repeat = 0; repeat < 2; ++repeat) {
+        for (SkUnichar c = ' '; c < 'z'; c++) {
+            glyphIDs.push_back(SkPackedGlyphID{font.unicharToGlyph(c),
+                                               SkFixed{repeat * SK_FixedHalf}, 0});
+        }
+    }
+    glyphIDs.push_back(glyphIDs.front());
+
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+    SkStrikeCache strikeCache;
+    SkStrike prefilled{&strikeCache, strikeSpec, strikeSpec.createScalerContext(), nullptr,
+                       nullptr};
+
+    // Make some of the glyphs before the prefill, so it has to skip them.
+    std::vector<const SkGlyph*> results(glyphIDs.size());
+    (void)prefilled.prepareImages(SkSpan(glyphIDs).first(10), results.data());
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    prefilled.prefillGlyphs(glyphIDs, /*includePaths=*/true, *executor);
+
+    // The glyphs should match ones made directly with a scaler context.
+    std::unique_ptr<SkScalerContext> scalerContext = strikeSpec.createScalerContext();
+    SkArenaAlloc alloc{1024};
+    for (SkPackedGlyphID glyphID : glyphIDs) {
+        SkGlyph* actual = SkStrikeTestingPeer::GetGlyph(&prefilled, glyphID);
+        REPORTER_ASSERT(reporter, actual->setImageHasBeenCalled());
+        REPORTER_ASSERT(reporter, actual->setPathHasBeenCalled());
+
+        SkGlyph glyph = scalerContext->makeGlyph(glyphID, &alloc);
+        glyph.setImage(&alloc, scalerContext.get());
+        glyph.setPath(&alloc, scalerContext.get());
+        REPORTER_ASSERT(reporter, actual->rect() == glyph.rect());
+        REPORTER_ASSERT(reporter, actual->advanceX() == glyph.advanceX());
+        REPORTER_ASSERT(reporter, actual->maskFormat() == glyph.maskFormat());
+        REPORTER_ASSERT(reporter, (actual->image() == nullptr) == (glyph.image() == nullptr));
+        if (actual->image() && glyph.image()) {
+            REPORTER_ASSERT(reporter,
+                            memcmp(actual->image(), glyph.image(), glyph.imageSize()) == 0);
+        }
+        REPORTER_ASSERT(reporter, (actual->path() == nullptr) == (glyph.path() == nullptr));
+        if (actual->path() && glyph.path()) {
+            REPORTER_ASSERT(reporter, *actual->path() == *glyph.path());
+        }
+    }
+}
@@ -5,10 +5,13 @@
 #include "src/base/SkUTF.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
+#include <string>
+#include <vector>
 
 DEF_TEST(SkUTF_UTF16, reporter) {
     // Test non-basic-multilingual-plane unicode.
@@ -146,3 +149,60 @@ DEF_TEST(SkUTF_NextUTF8_ToUTF8, r) {
 #undef LEADING_THREE_BYTE
 #undef LEADING_FOUR_BYTE
 #undef INVALID_BYTE
+
+// The bulk functions take a faster path for runs of 16 ASCII code units; check them against
+// decoding one codepoint at a time with the runs starting and ending at every offset.
+DEF_TEST(SkUTF_BulkASCII, r) {
+    const char* const kNonASCII[] = {"", "\xC3\xA9", "\xE4\xB8\xAD", "\xF0\x9F\x98\x80"};
+    for (const char* other : kNonASCII) {
+        for (size_t before = 0; before < 40; before += 3) {
+            for (size_t after = 0; after < 40; after += 5) {
+                std::string utf8(before, 'a');
+                utf8 += other;
+                utf8.append(after, 'z');
+
+                // Decode one codepoint at a time
+                std::vector<uint16_t> expected16;
+                const char* ptr = utf8.data();
+                const char* end = ptr + utf8.size();
+                while (ptr < end) {
+                    uint16_t units[2];
+                    size_t count = SkUTF::ToUTF16(SkUTF::NextUTF8(&ptr, end), units);
+                    expected16.insert(expected16.end(), units, units + count);
+                }
+
+                REPORTER_ASSERT(r, SkUTF::CountASCIIPrefix(utf8.data(), utf8.size()) ==
+                                   (*other ? before : utf8.size()));
+                REPORTER_ASSERT(r, SkUTF::CountUTF8(utf8.data(), utf8.size()) ==
+                                   (int)(before + after + (*other ? 1 : 0)));
+
+                std::vector<uint16_t> utf16(expected16.size());
+                int count16 = SkUTF::UTF8ToUTF16(utf16.data(), utf16.size(),
+                                                 utf8.data(), utf8.size());
+                REPORTER_ASSERT(r, count16 == (int)expected16.size());
+                REPORTER_ASSERT(r, utf16 == expected16);
+
+                // A short buffer gets the start of the text, and the full length is returned
+                std::vector<uint16_t> short16(expected16.size() / 2 + 1, 0);
+                count16 = SkUTF::UTF8ToUTF16(short16.data(), short16.size() - 1,
+                                             utf8.data(), utf8.size());
+                REPORTER_ASSERT(r, count16 == (int)expected16.size());
+                REPORTER_ASSERT(r, std::equal(short16.begin(), short16.end() - 1,
+                                              expected16.begin()));
+                REPORTER_ASSERT(r, short16.back() == 0);
+
+                std::string back(utf8.size(), '\0');
+                int count8 = SkUTF::UTF16ToUTF8(back.data(), back.size(),
+                                                utf16.data(), utf16.size());
+                REPORTER_ASSERT(r, count8 == (int)utf8.size());
+                REPORTER_ASSERT(r, back == utf8);
+            }
+        }
+    }
+
+    // An invalid byte after a run of ASCII is still found
+    std::string invalid(20, 'a');
+    invalid += "\xFC";
+    REPORTER_ASSERT(r, SkUTF::CountUTF8(invalid.data(), invalid.size()) == -1);
+    REPORTER_ASSERT(r, SkUTF::UTF8ToUTF16(nullptr, 0, invalid.data(), invalid.size()) == -1);
+}
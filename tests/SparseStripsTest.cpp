@@ -0,0 +1,164 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkSurfaceProps.h"
+#include "src/base/SkRandom.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+static constexpr int kWidth = 96;
+static constexpr int kHeight = 64;
+
+static SkBitmap draw_path(const SkPath& path, const SkRect* clip, int scale, bool antiAlias) {
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeA8(kWidth * scale, kHeight * scale));
+    bitmap.eraseColor(SK_ColorTRANSPARENT);
+
+    SkCanvas canvas(bitmap,
+                    SkSurfaceProps(antiAlias ? SkSurfaceProps::kSparseStripRasterizer_Flag : 0,
+                                   kUnknown_SkPixelGeometry));
+    canvas.scale(scale, scale);
+    if (clip) {
+        canvas.clipRect(*clip, antiAlias);
+    }
+    SkPaint paint;
+    paint.setAntiAlias(antiAlias);
+    canvas.drawPath(path, paint);
+    return bitmap;
+}
+
+// The sparse strip rasterizer computes the area covered in each pixel, resolving the pixels where
+// the winding takes more than one nonzero value from rows of samples, so it should be close to a
+// supersampled rendering, within the error of the supersampling and of flattening curves.
+static void check_path(skiatest::Reporter* r, const SkPath& path, const SkRect* clip) {
+    static constexpr int kScale = 16;
+    const SkBitmap actual = draw_path(path, clip, 1, /*antiAlias=*/true),
+                   supersampled = draw_path(path, clip, kScale, /*antiAlias=*/false);
+
+    int worst = 0;
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            int sum = 0;
+            for (int j = 0; j < kScale; ++j) {
+                for (int i = 0; i < kScale; ++i) {
+                    sum += *supersampled.getAddr8(x * kScale + i, y * kScale + j);
+                }
+            }
+            const int expected = (sum + kScale * kScale / 2) / (kScale * kScale);
+            worst = std::max(worst, abs(expected - *actual.getAddr8(x, y)));
+        }
+    }
+    REPORTER_ASSERT(r, worst <= 10, "worst difference %d", worst);
+}
+
+DEF_TEST(SparseStrips_SimpleShapes, r) {
+    // Anti-aliased clips scale the coverage of the path instead of intersecting with it, so keep
+    // the clip on pixel boundaries to compare with the supersampled rendering.
+    const SkRect clip = SkRect::MakeLTRB(10, 7, 80, 51);
+    const SkPath paths[] = {
+        SkPath::Rect(SkRect::MakeLTRB(3.3f, 5.7f, 70.2f, 41.1f)),
+        SkPath::Circle(40, 30, 27.5f),
+        SkPath::Oval(SkRect::MakeLTRB(-20, 10, 130, 22.5f)),
+        SkPath::RRect(SkRRect::MakeRectXY(SkRect::MakeLTRB(12, 3, 90, 60), 9, 14)),
+        SkPath::Polygon({{48, -5}, {101, 70}, {-7, 40}}, /*isClosed=*/true),
+    };
+    for (SkPath path : paths) {
+        for (SkPathFillType fillType : {SkPathFillType::kWinding,
+                                        SkPathFillType::kEvenOdd,
+                                        SkPathFillType::kInverseWinding,
+                                        SkPathFillType::kInverseEvenOdd}) {
+            path.setFillType(fillType);
+            check_path(r, path, nullptr);
+            check_path(r, path, &clip);
+        }
+    }
+}
+
+DEF_TEST(SparseStrips_RandomPolygons, r) {
+    SkRandom random;
+    for (int trial = 0; trial < 50; ++trial) {
+        // Star shaped polygons never cross themselves.
+        const SkPoint center = {random.nextRangeF(0, kWidth), random.nextRangeF(0, kHeight)};
+        const int count = 3 + random.nextULessThan(20);
+        SkPath path;
+        for (int i = 0; i < count; ++i) {
+            const float angle = (i + random.nextF()) * 2 * SK_ScalarPI / count,
+                        radius = random.nextRangeF(1, 50);
+            const SkPoint p = center + SkPoint{radius * SkScalarCos(angle),
+                                               radius * SkScalarSin(angle)};
+            i == 0 ? path.moveTo(p) : path.lineTo(p);
+        }
+        path.close();
+        if (trial & 1) {
+            path.toggleInverseFillType();
+        }
+        check_path(r, path, nullptr);
+    }
+}
+
+DEF_TEST(SparseStrips_SelfIntersecting, r) {
+    // Regions of winding 2 (or -1 and 1) meet inside pixels, where the areas of the edges cancel.
+    SkPath bowtie = SkPath::Polygon({{5, 5}, {90, 58}, {90, 5}, {5, 58}}, /*isClosed=*/true);
+
+    SkPath overlapping;
+    overlapping.addRect(SkRect::MakeLTRB(4.5f, 6.25f, 60.3f, 50.1f));
+    overlapping.addRect(SkRect::MakeLTRB(30.7f, 20.4f, 91.2f, 57.8f));
+    overlapping.addRect(SkRect::MakeLTRB(20.1f, 2.6f, 40.9f, 61.3f), SkPathDirection::kCCW);
+
+    // Edges of the two circles run through the same pixels in the same direction.
+    SkPath circles;
+    circles.addCircle(40, 30, 25);
+    circles.addCircle(40.3f, 30.2f, 25.1f);
+    circles.addCircle(55, 34, 20, SkPathDirection::kCCW);
+
+    SkPath pentagram;
+    for (int i = 0; i < 5; ++i) {
+        const float angle = i * 4 * SK_ScalarPI / 5;
+        const SkPoint p = {48 + 30 * SkScalarSin(angle), 32 - 30 * SkScalarCos(angle)};
+        i == 0 ? pentagram.moveTo(p) : pentagram.lineTo(p);
+    }
+    pentagram.close();
+
+    for (SkPath path : {bowtie, overlapping, circles, pentagram}) {
+        for (SkPathFillType fillType : {SkPathFillType::kWinding,
+                                        SkPathFillType::kEvenOdd,
+                                        SkPathFillType::kInverseWinding,
+                                        SkPathFillType::kInverseEvenOdd}) {
+            path.setFillType(fillType);
+            check_path(r, path, nullptr);
+        }
+    }
+}
+
+DEF_TEST(SparseStrips_Empty, r) {
+    // Degenerate and offscreen paths draw nothing.
+    for (const SkPath& path : {SkPath(),
+                               SkPath::Rect(SkRect::MakeLTRB(10, 10, 10, 40)),
+                               SkPath::Circle(-100, -100, 20),
+                               SkPath::Circle(300, 30, 20)}) {
+        const SkBitmap bitmap = draw_path(path, nullptr, 1, /*antiAlias=*/true);
+        bool empty = true;
+        for (int y = 0; y < kHeight; ++y) {
+            for (int x = 0; x < kWidth; ++x) {
+                empty &= *bitmap.getAddr8(x, y) == 0;
+            }
+        }
+        REPORTER_ASSERT(r, empty);
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+
+#if defined(SK_TYPEFACE_FACTORY_FREETYPE)
+
+#include "include/core/SkFont.h"
+#include "include/core/SkFontArguments.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/core/SkTypeface.h"
+#include "include/private/base/SkTo.h"
+#include "src/core/SkGlyph.h"
+#include "src/core/SkStrikeCache.h"
+#include "src/core/SkStrikeSpec.h"
+#include "src/ports/SkTypeface_FreeType.h"
+#include "tests/Test.h"
+#include "tools/Resources.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// The glyph images of a strike of typeface, made with cache.
+static std::vector<uint8_t> glyph_images(const sk_sp<SkTypeface>& typeface,
+                                         float size,
+                                         SkStrikeCache* cache) {
+    SkFont font(typeface, size);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    const SkSurfaceProps props(0, kUnknown_SkPixelGeometry);
+    const SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, SkPaint(), props, SkScalerContextFlags::kNone, SkMatrix::I());
+
+    std::vector<SkPackedGlyphID> ids;
+    for (int glyphID = 0; glyphID < std::min(typeface->countGlyphs(), 300); ++glyphID) {
+        ids.push_back(SkPackedGlyphID(SkTo<SkGlyphID>(glyphID)));
+    }
+
+    std::vector<uint8_t> images;
+    SkBulkGlyphMetricsAndImages bulk{strikeSpec.findOrCreateStrike(cache)};
+    for (const SkGlyph* glyph : bulk.glyphs(ids)) {
+        const int16_t bounds[] = {SkTo<int16_t>(glyph->left()),  SkTo<int16_t>(glyph->top()),
+                                  SkTo<int16_t>(glyph->width()), SkTo<int16_t>(glyph->height())};
+        const auto* boundsBytes = reinterpret_cast<const uint8_t*>(bounds);
+        images.insert(images.end(), boundsBytes, boundsBytes + sizeof(bounds));
+        if (glyph->image()) {
+            const auto* image = static_cast<const uint8_t*>(glyph->image());
+            images.insert(images.end(), image, image + glyph->imageSize());
+        }
+    }
+    return images;
+}
+
+// Scaler contexts owning their faces rasterize the same typeface concurrently, with the same
+// results as the shared face.
+DEF_TEST(TypefaceFreeType_ScalerContextsOwnFaces, reporter) {
+    sk_sp<SkTypeface> typeface = SkTypeface_FreeType::MakeFromStream(
+            GetResourceAsStream("fonts/Roboto-Regular.ttf"), SkFontArguments());
+    if (!typeface) {
+        ERRORF(reporter, "Could not load fonts/Roboto-Regular.ttf.");
+        return;
+    }
+
+    static constexpr int kThreadCount = 4;
+    const auto size = [](int threadIndex) { return 12.0f + 5 * threadIndex; };
+
+    const bool ownedFaces = SkTypeface_FreeType::ScalerContextsOwnFaces();
+
+    std::vector<std::vector<uint8_t>> expected(kThreadCount);
+    {
+        SkTypeface_FreeType::SetScalerContextsOwnFaces(false);
+        SkStrikeCache cache;
+        for (int i = 0; i < kThreadCount; ++i) {
+            expected[i] = glyph_images(typeface, size(i), &cache);
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> actual(kThreadCount);
+    {
+        SkTypeface_FreeType::SetScalerContextsOwnFaces(true);
+        SkStrikeCache cache;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < kThreadCount; ++i) {
+            threads.emplace_back([&, i] { actual[i] = glyph_images(typeface, size(i), &cache); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    SkTypeface_FreeType::SetScalerContextsOwnFaces(ownedFaces);
+
+    for (int i = 0; i < kThreadCount; ++i) {
+        REPORTER_ASSERT(reporter, !expected[i].empty());
+        REPORTER_ASSERT(reporter, actual[i] == expected[i], "size %g", size(i));
+    }
+}
+
+#endif  // defined(SK_TYPEFACE_FACTORY_FREETYPE)
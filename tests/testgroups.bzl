@@ -74,6 +74,7 @@ CORE_TESTS = [
     "MemsetTest.cpp",
     "MeshTest.cpp",
     "MetaDataTest.cpp",
+    "MultiChannelDistanceFieldTest.cpp",
     "NdkDecodeTest.cpp",
     "NdkEncodeTest.cpp",
     "NonlinearBlendingTest.cpp",
@@ -135,6 +136,7 @@ CORE_TESTS = [
     "SkVxTest.cpp",
     "SkXmpTest.cpp",
     "SortTest.cpp",
+    "SparseStripsTest.cpp",
     "SrcOverTest.cpp",
     "StreamTest.cpp",
     "StringTest.cpp",
@@ -192,6 +194,7 @@ TEXT_TESTS = [
     "DrawTextTest.cpp",
     "FontHostStreamTest.cpp",
     "TextBlobTest.cpp",
+    "TypefaceFreeTypeTest.cpp",
     "TypefaceTest.cpp",
     "UnicodeTest.cpp",
 ]
@@ -11,9 +11,11 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
 #include "include/private/base/SkTPin.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skresources/include/SkResources.h"
 #include "src/base/SkTime.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/utils/SkOSPath.h"
 
 #include "tools/CodecUtils.h"
@@ -25,6 +27,10 @@
 #include "include/gpu/ganesh/SkSurfaceGanesh.h"
 #include "modules/skshaper/utils/FactoryHelpers.h"
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #if defined(SK_BUILD_FOR_MAC) && defined(SK_FONTMGR_CORETEXT_AVAILABLE)
 #include "include/ports/SkFontMgr_mac_ct.h"
 #elif defined(SK_BUILD_FOR_UNIX) && defined(SK_FONTMGR_FONTCONFIG_AVAILABLE)
@@ -41,6 +47,7 @@ static DEFINE_bool2(verbose, v, false, "verbose mode");
 static DEFINE_bool2(loop, l, false, "loop mode for profiling");
 static DEFINE_int(set_dst_width, 0, "set destination width (height will be computed)");
 static DEFINE_bool2(gpu, g, false, "use GPU for rendering");
+static DEFINE_int(threads, 0, "number of CPU rendering threads (0 -> cores count)");
 
 static void produce_frame(SkSurface* surf, skottie::Animation* anim, double frame) {
     anim->seekFrame(frame);
@@ -89,7 +96,7 @@ int main(int argc, char** argv) {
     sk_sp<SkFontMgr> fontMgr = SkFontMgr_New_Custom_Empty();
 #endif
 
-    auto animation = skottie::Animation::Builder()
+    auto animation = skottie::Animation::Builder(skottie::Animation::Builder::kRetainSource)
         .setResourceProvider(skresources::FileResourceProvider::Make(assetPath))
         .setTextShapingFactory(SkShapers::BestAvailable())
         .setFontManager(fontMgr)
@@ -121,9 +128,17 @@ int main(int argc, char** argv) {
     SkVideoEncoder encoder;
 
     GrDirectContext* grctx = nullptr;
-    sk_sp<SkSurface> surf;
     sk_sp<SkData> data;
 
+    // On the CPU, frames are rendered a batch at a time, each on its own copy of the animation
+    // and surface, and then encoded in order.
+    const int thread_count = FLAGS_threads > 0
+            ? FLAGS_threads
+            : std::max(1, SkToInt(std::thread::hardware_concurrency()));
+    SkTaskGroup::Enabler enabler(FLAGS_gpu ? 0 : thread_count - 1);
+    std::vector<sk_sp<SkSurface>> surfs;
+    std::vector<sk_sp<skottie::Animation>> animations = {animation};
+
     const auto info = SkImageInfo::MakeN32Premul(dim);
     do {
         double loop_start = SkTime::GetSecs();
@@ -134,7 +149,8 @@ int main(int argc, char** argv) {
         }
 
         // lazily allocate the surfaces
-        if (!surf) {
+        if (surfs.empty()) {
+            sk_sp<SkSurface> surf;
             if (FLAGS_gpu) {
                 grctx = factory.getContextInfo(contextType).directContext();
                 surf = SkSurfaces::RenderTarget(grctx,
@@ -151,18 +167,37 @@ int main(int argc, char** argv) {
                 surf = SkSurfaces::Raster(info);
             }
             surf->getCanvas()->scale(scale, scale);
+            surfs.push_back(std::move(surf));
+
+            for (int t = 1; !grctx && t < thread_count; ++t) {
+                auto copy = animation->makeCopy();
+                surf = SkSurfaces::Raster(info);
+                if (!copy || !surf) {
+                    break;
+                }
+                surf->getCanvas()->scale(scale, scale);
+                surfs.push_back(std::move(surf));
+                animations.push_back(std::move(copy));
+            }
         }
 
-        for (int i = 0; i <= frames; ++i) {
-            const double frame = i * fps_scale;
+        const int batch_size = SkToInt(surfs.size());
+        for (int i = 0; i <= frames; i += batch_size) {
+            const int batch_count = std::min(batch_size, frames + 1 - i);
             if (FLAGS_verbose) {
-                SkDebugf("rendering frame %g\n", frame);
+                SkDebugf("rendering frames %g to %g\n", i * fps_scale,
+                         (i + batch_count - 1) * fps_scale);
             }
 
-            produce_frame(surf.get(), animation.get(), frame);
+            SkTaskGroup tg;
+            tg.batch(batch_count, [&](int j) {
+                produce_frame(surfs[j].get(), animations[j].get(), (i + j) * fps_scale);
+            });
+            tg.wait();
 
             AsyncRec asyncRec = { info, &encoder };
             if (grctx) {
+                sk_sp<SkSurface>& surf = surfs[0];
                 auto read_pixels_cb = [](SkSurface::ReadPixelsContext ctx,
                                          std::unique_ptr<const SkSurface::AsyncReadResult> result) {
                     if (result && result->count() == 1) {
@@ -176,9 +211,11 @@ int main(int argc, char** argv) {
                                                 read_pixels_cb, &asyncRec);
                 grctx->submit();
             } else {
-                SkPixmap pm;
-                SkAssertResult(surf->peekPixels(&pm));
-                encoder.addFrame(pm);
+                for (int j = 0; j < batch_count; ++j) {
+                    SkPixmap pm;
+                    SkAssertResult(surfs[j]->peekPixels(&pm));
+                    encoder.addFrame(pm);
+                }
             }
         }
 